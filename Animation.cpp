@@ -0,0 +1,327 @@
+#include "Animation.h"
+#include <algorithm>
+#include <cmath>
+
+namespace FD2D
+{
+    namespace
+    {
+        // A spring that still moves after this long (e.g. zero damping) is
+        // snapped to its target rather than animating forever.
+        constexpr std::uint64_t kMaxSpringMs = 10000;
+
+        float Epsilon(const Spring& spring) { return (std::max)(spring.epsilon, 0.0f); }
+        float Epsilon(const Follow& follow) { return (std::max)(follow.epsilon, 0.0f); }
+    }
+
+    float Ease(Easing easing, float t)
+    {
+        t = (std::max)(0.0f, (std::min)(1.0f, t));
+        switch (easing)
+        {
+        case Easing::Linear:
+            return t;
+        case Easing::EaseInQuad:
+            return t * t;
+        case Easing::EaseOutQuad:
+            return 1.0f - (1.0f - t) * (1.0f - t);
+        case Easing::EaseInOutQuad:
+            return (t < 0.5f) ? 2.0f * t * t : 1.0f - 2.0f * (1.0f - t) * (1.0f - t);
+        case Easing::EaseInCubic:
+            return t * t * t;
+        case Easing::EaseOutCubic:
+        {
+            const float u = 1.0f - t;
+            return 1.0f - u * u * u;
+        }
+        case Easing::EaseInOutCubic:
+        {
+            const float u = 1.0f - t;
+            return (t < 0.5f) ? 4.0f * t * t * t : 1.0f - 4.0f * u * u * u;
+        }
+        case Easing::Smoothstep:
+            return t * t * (3.0f - 2.0f * t);
+        }
+        return t;
+    }
+
+    AnimationEngine::AnimationEngine(Clock clock)
+        : m_clock(std::move(clock))
+    {
+    }
+
+    std::uint64_t AnimationEngine::Now() const
+    {
+        return m_clock ? m_clock() : m_lastTickMs;
+    }
+
+    AnimationEngine::Track* AnimationEngine::Find(const void* property)
+    {
+        for (Track& track : m_tracks)
+        {
+            if (track.property == property)
+            {
+                return &track;
+            }
+        }
+        return nullptr;
+    }
+
+    void AnimationEngine::StartTrack(
+        const void* owner,
+        void* property,
+        StoreFn store,
+        std::size_t channels,
+        const float* current,
+        const float* goal,
+        const Params& params)
+    {
+        const std::uint64_t now = Now();
+        Track* track = Find(property);
+
+        // Retargeting keeps the running velocity (only springs use it).
+        float velocity[kMaxChannels] {};
+        if (track != nullptr)
+        {
+            float value[kMaxChannels] {};
+            (void)Evaluate(*track, now, value, velocity);
+        }
+
+        float epsilon = 0.0f;
+        if (params.kind == Kind::Spring)
+        {
+            epsilon = Epsilon(params.spring);
+        }
+        else if (params.kind == Kind::Follow)
+        {
+            epsilon = Epsilon(params.follow);
+        }
+
+        bool atRest = true;
+        for (std::size_t c = 0; c < channels; ++c)
+        {
+            const bool moving = (params.kind == Kind::Spring) && velocity[c] != 0.0f;
+            if (std::fabs(goal[c] - current[c]) > epsilon || moving)
+            {
+                atRest = false;
+                break;
+            }
+        }
+        if (atRest)
+        {
+            store(property, goal);
+            if (track != nullptr)
+            {
+                (void)Stop(property);
+            }
+            return;
+        }
+
+        if (track == nullptr)
+        {
+            m_tracks.emplace_back();
+            track = &m_tracks.back();
+        }
+
+        track->owner = owner;
+        track->property = property;
+        track->store = store;
+        track->channels = channels;
+        track->params = params;
+        track->startMs = now;
+        for (std::size_t c = 0; c < kMaxChannels; ++c)
+        {
+            const bool used = c < channels;
+            track->from[c] = used ? current[c] : 0.0f;
+            track->to[c] = used ? goal[c] : 0.0f;
+            track->velocity[c] = used ? velocity[c] : 0.0f;
+        }
+    }
+
+    bool AnimationEngine::Evaluate(const Track& track, std::uint64_t nowMs, float* value, float* velocity)
+    {
+        const std::uint64_t elapsedMs = (nowMs > track.startMs) ? (nowMs - track.startMs) : 0;
+        const double t = static_cast<double>(elapsedMs) / 1000.0;
+        bool settled = true;
+
+        switch (track.params.kind)
+        {
+        case Kind::Tween:
+        {
+            const std::uint32_t durationMs = (std::max)(1u, track.params.tween.durationMs);
+            if (elapsedMs >= durationMs)
+            {
+                break;
+            }
+
+            // Slope of the curve by finite difference, for retargeting.
+            const float u = static_cast<float>(elapsedMs) / static_cast<float>(durationMs);
+            const float eased = Ease(track.params.tween.easing, u);
+            constexpr float kDu = 1.0e-3f;
+            const float slope = (Ease(track.params.tween.easing, u + kDu) - eased) / kDu;
+            const float perSecond = 1000.0f / static_cast<float>(durationMs);
+            for (std::size_t c = 0; c < track.channels; ++c)
+            {
+                const float delta = track.to[c] - track.from[c];
+                value[c] = track.from[c] + delta * eased;
+                velocity[c] = delta * slope * perSecond;
+            }
+            settled = false;
+            break;
+        }
+
+        case Kind::Follow:
+        {
+            const double tau = static_cast<double>((std::max)(1u, track.params.follow.timeConstantMs)) / 1000.0;
+            const double k = std::exp(-t / tau);
+            const float epsilon = Epsilon(track.params.follow);
+            for (std::size_t c = 0; c < track.channels; ++c)
+            {
+                const double x = static_cast<double>(track.from[c] - track.to[c]) * k;
+                value[c] = track.to[c] + static_cast<float>(x);
+                velocity[c] = static_cast<float>(-x / tau);
+                if (std::fabs(x) > epsilon)
+                {
+                    settled = false;
+                }
+            }
+            break;
+        }
+
+        case Kind::Spring:
+        {
+            if (elapsedMs >= kMaxSpringMs)
+            {
+                break;
+            }
+
+            const Spring& spring = track.params.spring;
+            const double mass = (std::max)(static_cast<double>(spring.mass), 1.0e-4);
+            const double stiffness = (std::max)(static_cast<double>(spring.stiffness), 1.0e-4);
+            const double damping = (std::max)(static_cast<double>(spring.damping), 0.0);
+            const double w0 = std::sqrt(stiffness / mass);
+            const double zeta = damping / (2.0 * std::sqrt(stiffness * mass));
+            const float epsilon = Epsilon(spring);
+
+            for (std::size_t c = 0; c < track.channels; ++c)
+            {
+                // Closed form of m*x'' + c*x' + k*x = 0 for the displacement
+                // from the target, starting at (x0, v0).
+                const double x0 = static_cast<double>(track.from[c] - track.to[c]);
+                const double v0 = static_cast<double>(track.velocity[c]);
+                double x = 0.0;
+                double v = 0.0;
+                if (zeta < 1.0 - 1.0e-4)
+                {
+                    const double wd = w0 * std::sqrt(1.0 - zeta * zeta);
+                    const double decay = std::exp(-zeta * w0 * t);
+                    const double b = (v0 + zeta * w0 * x0) / wd;
+                    const double cosT = std::cos(wd * t);
+                    const double sinT = std::sin(wd * t);
+                    x = decay * (x0 * cosT + b * sinT);
+                    v = decay * ((b * wd - zeta * w0 * x0) * cosT - (x0 * wd + zeta * w0 * b) * sinT);
+                }
+                else if (zeta <= 1.0 + 1.0e-4)
+                {
+                    const double decay = std::exp(-w0 * t);
+                    const double b = v0 + w0 * x0;
+                    x = decay * (x0 + b * t);
+                    v = decay * (b - w0 * (x0 + b * t));
+                }
+                else
+                {
+                    const double s = std::sqrt(zeta * zeta - 1.0);
+                    const double r1 = -w0 * (zeta - s);
+                    const double r2 = -w0 * (zeta + s);
+                    const double c1 = (v0 - r2 * x0) / (r1 - r2);
+                    const double c2 = x0 - c1;
+                    const double e1 = std::exp(r1 * t);
+                    const double e2 = std::exp(r2 * t);
+                    x = c1 * e1 + c2 * e2;
+                    v = c1 * r1 * e1 + c2 * r2 * e2;
+                }
+
+                value[c] = track.to[c] + static_cast<float>(x);
+                velocity[c] = static_cast<float>(v);
+                if (std::fabs(x) > epsilon || std::fabs(v) * 0.1 > epsilon)
+                {
+                    settled = false;
+                }
+            }
+            break;
+        }
+        }
+
+        if (settled)
+        {
+            for (std::size_t c = 0; c < track.channels; ++c)
+            {
+                value[c] = track.to[c];
+                velocity[c] = 0.0f;
+            }
+        }
+        return settled;
+    }
+
+    bool AnimationEngine::Tick(std::uint64_t nowMs)
+    {
+        m_lastTickMs = nowMs;
+        if (m_tracks.empty())
+        {
+            return false;
+        }
+
+        for (std::size_t i = 0; i < m_tracks.size();)
+        {
+            Track& track = m_tracks[i];
+            float value[kMaxChannels] {};
+            float velocity[kMaxChannels] {};
+            const bool settled = Evaluate(track, nowMs, value, velocity);
+            track.store(track.property, value);
+            if (settled)
+            {
+                // Order does not matter: swap the last track in.
+                if (i + 1 < m_tracks.size())
+                {
+                    m_tracks[i] = m_tracks.back();
+                }
+                m_tracks.pop_back();
+                continue;
+            }
+            ++i;
+        }
+        return true;
+    }
+
+    bool AnimationEngine::Stop(const void* property)
+    {
+        const auto it = std::find_if(m_tracks.begin(), m_tracks.end(), [property](const Track& track)
+        {
+            return track.property == property;
+        });
+        if (it == m_tracks.end())
+        {
+            return false;
+        }
+        m_tracks.erase(it);
+        return true;
+    }
+
+    void AnimationEngine::StopAll(const void* owner)
+    {
+        m_tracks.erase(
+            std::remove_if(m_tracks.begin(), m_tracks.end(), [owner](const Track& track)
+            {
+                return track.owner == owner;
+            }),
+            m_tracks.end());
+    }
+
+    bool AnimationEngine::IsAnimating(const void* property) const
+    {
+        return std::any_of(m_tracks.begin(), m_tracks.end(), [property](const Track& track)
+        {
+            return track.property == property;
+        });
+    }
+}
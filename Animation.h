@@ -0,0 +1,250 @@
+#pragma once
+
+// Animation.h - declarative property animation.
+//
+// Platform-neutral: a control asks the engine to move one of its properties
+// (float, color with r/g/b/a, rect with left/top/right/bottom) to a target
+// with a tween (duration + easing), a spring, or an exponential follow. The
+// owner (Backplate) calls Tick() once per frame; it advances every running
+// animation in one batch and writes the results straight into the
+// properties, so render code only reads them.
+//
+// Every value is a closed-form function of the elapsed time (no per-frame
+// integration), so a given clock produces the same values whatever the
+// frame cadence; pass a fake clock for deterministic runs. Retargeting a
+// running animation starts from the property's current value and, for
+// springs, keeps its velocity.
+//
+// Not thread-safe (UI thread only). Properties must stay alive while they
+// animate: owners Stop()/StopAll() before they go away.
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace FD2D
+{
+    enum class Easing : std::uint8_t
+    {
+        Linear,
+        EaseInQuad,
+        EaseOutQuad,
+        EaseInOutQuad,
+        EaseInCubic,
+        EaseOutCubic,
+        EaseInOutCubic,
+        Smoothstep
+    };
+
+    // Maps t in [0,1] (clamped) through the curve.
+    float Ease(Easing easing, float t);
+
+    // Fixed-duration interpolation along an easing curve.
+    struct Tween
+    {
+        std::uint32_t durationMs { 150 };
+        Easing easing { Easing::EaseOutCubic };
+    };
+
+    // Damped spring (critically damped at damping = 2 * sqrt(stiffness * mass)).
+    // Settles once every channel is within `epsilon` of the target and moves
+    // less than `epsilon` per 100ms.
+    struct Spring
+    {
+        float stiffness { 300.0f };
+        float damping { 30.0f };
+        float mass { 1.0f };
+        float epsilon { 0.001f };
+    };
+
+    // Exponential approach: the remaining distance shrinks by 1/e every
+    // `timeConstantMs` (smooth scrolling). Settles within `epsilon`.
+    struct Follow
+    {
+        std::uint32_t timeConstantMs { 100 };
+        float epsilon { 0.001f };
+    };
+
+    // Channel packing for animatable types. float, plus any type with r/g/b/a
+    // (D2D1_COLOR_F) or left/top/right/bottom (D2D1_RECT_F) float members.
+    template <typename T>
+    struct AnimationTraits;
+
+    template <>
+    struct AnimationTraits<float>
+    {
+        static constexpr std::size_t kChannels = 1;
+        static void Pack(const float& value, float* channels) { channels[0] = value; }
+        static void Unpack(const float* channels, float& value) { value = channels[0]; }
+    };
+
+    template <typename T>
+        requires requires (T v) { v.r; v.g; v.b; v.a; }
+    struct AnimationTraits<T>
+    {
+        static constexpr std::size_t kChannels = 4;
+        static void Pack(const T& value, float* channels)
+        {
+            channels[0] = value.r;
+            channels[1] = value.g;
+            channels[2] = value.b;
+            channels[3] = value.a;
+        }
+        static void Unpack(const float* channels, T& value)
+        {
+            value.r = channels[0];
+            value.g = channels[1];
+            value.b = channels[2];
+            value.a = channels[3];
+        }
+    };
+
+    template <typename T>
+        requires requires (T v) { v.left; v.top; v.right; v.bottom; }
+    struct AnimationTraits<T>
+    {
+        static constexpr std::size_t kChannels = 4;
+        static void Pack(const T& value, float* channels)
+        {
+            channels[0] = value.left;
+            channels[1] = value.top;
+            channels[2] = value.right;
+            channels[3] = value.bottom;
+        }
+        static void Unpack(const float* channels, T& value)
+        {
+            value.left = channels[0];
+            value.top = channels[1];
+            value.right = channels[2];
+            value.bottom = channels[3];
+        }
+    };
+
+    class AnimationEngine
+    {
+    public:
+        using Clock = std::function<std::uint64_t()>;
+
+        // `clock` stamps animation start times (ms). Without one, animations
+        // start at the last Tick() time.
+        explicit AnimationEngine(Clock clock = {});
+
+        void SetClock(Clock clock) { m_clock = std::move(clock); }
+
+        // Animates `*property` from its current value to `target`. `owner`
+        // groups animations for StopAll (usually the control). Animating a
+        // property that already runs retargets it. A property already at rest
+        // on the target is written and not tracked.
+        template <typename T>
+        void Animate(const void* owner, T* property, const T& target, const Tween& tween)
+        {
+            Params params {};
+            params.kind = Kind::Tween;
+            params.tween = tween;
+            Start<T>(owner, property, target, params);
+        }
+
+        template <typename T>
+        void Animate(const void* owner, T* property, const T& target, const Spring& spring)
+        {
+            Params params {};
+            params.kind = Kind::Spring;
+            params.spring = spring;
+            Start<T>(owner, property, target, params);
+        }
+
+        template <typename T>
+        void Animate(const void* owner, T* property, const T& target, const Follow& follow)
+        {
+            Params params {};
+            params.kind = Kind::Follow;
+            params.follow = follow;
+            Start<T>(owner, property, target, params);
+        }
+
+        // Stops animating, leaving the property at its current value.
+        bool Stop(const void* property);
+        void StopAll(const void* owner);
+        bool IsAnimating(const void* property) const;
+
+        // Advances every animation to `nowMs`, writing the properties; settled
+        // animations land exactly on their target and are dropped. Returns
+        // true when any property was written.
+        bool Tick(std::uint64_t nowMs);
+
+        // True while anything animates (the frame loop must keep ticking).
+        bool Active() const { return !m_tracks.empty(); }
+        std::size_t Count() const { return m_tracks.size(); }
+
+    private:
+        static constexpr std::size_t kMaxChannels = 4;
+
+        enum class Kind : std::uint8_t
+        {
+            Tween,
+            Spring,
+            Follow
+        };
+
+        struct Params
+        {
+            Kind kind { Kind::Tween };
+            Tween tween {};
+            Spring spring {};
+            Follow follow {};
+        };
+
+        using StoreFn = void (*)(void* property, const float* channels);
+
+        struct Track
+        {
+            const void* owner { nullptr };
+            void* property { nullptr };
+            StoreFn store { nullptr };
+            std::size_t channels { 0 };
+            Params params {};
+            std::uint64_t startMs { 0 };
+            float from[kMaxChannels] {};
+            float to[kMaxChannels] {};
+            float velocity[kMaxChannels] {}; // per second, at startMs
+        };
+
+        template <typename T>
+        static void StoreAs(void* property, const float* channels)
+        {
+            AnimationTraits<T>::Unpack(channels, *static_cast<T*>(property));
+        }
+
+        template <typename T>
+        void Start(const void* owner, T* property, const T& target, const Params& params)
+        {
+            static_assert(AnimationTraits<T>::kChannels <= kMaxChannels);
+            float current[kMaxChannels] {};
+            float goal[kMaxChannels] {};
+            AnimationTraits<T>::Pack(*property, current);
+            AnimationTraits<T>::Pack(target, goal);
+            StartTrack(owner, property, &StoreAs<T>, AnimationTraits<T>::kChannels, current, goal, params);
+        }
+
+        void StartTrack(
+            const void* owner,
+            void* property,
+            StoreFn store,
+            std::size_t channels,
+            const float* current,
+            const float* goal,
+            const Params& params);
+
+        std::uint64_t Now() const;
+        Track* Find(const void* property);
+        // Value and velocity (per second) of `track` at `nowMs`; returns true
+        // when it has settled (value/velocity then hold the target / zero).
+        static bool Evaluate(const Track& track, std::uint64_t nowMs, float* value, float* velocity);
+
+        Clock m_clock {};
+        std::uint64_t m_lastTickMs { 0 };
+        std::vector<Track> m_tracks {};
+    };
+}
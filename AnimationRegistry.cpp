@@ -0,0 +1,110 @@
+#include "AnimationRegistry.h"
+#include <algorithm>
+
+namespace FD2D
+{
+    namespace
+    {
+        void UnionInto(AnimationRegistry::Bounds& target, bool& hasTarget, const AnimationRegistry::Bounds& bounds)
+        {
+            if (bounds.Empty())
+            {
+                return;
+            }
+            if (!hasTarget)
+            {
+                target = bounds;
+                hasTarget = true;
+                return;
+            }
+
+            target.left = (std::min)(target.left, bounds.left);
+            target.top = (std::min)(target.top, bounds.top);
+            target.right = (std::max)(target.right, bounds.right);
+            target.bottom = (std::max)(target.bottom, bounds.bottom);
+        }
+    }
+
+    void AnimationRegistry::Register(const void* owner, const Bounds& bounds, std::uint64_t endMs)
+    {
+        for (Entry& entry : m_entries)
+        {
+            if (entry.owner == owner)
+            {
+                const Bounds& old = entry.bounds;
+                if (old.left != bounds.left || old.top != bounds.top ||
+                    old.right != bounds.right || old.bottom != bounds.bottom)
+                {
+                    Retire(old); // erase it where it was
+                    entry.bounds = bounds;
+                }
+                entry.endMs = endMs;
+                return;
+            }
+        }
+
+        m_entries.push_back({ owner, bounds, endMs });
+    }
+
+    bool AnimationRegistry::Unregister(const void* owner)
+    {
+        const auto it = std::find_if(m_entries.begin(), m_entries.end(), [owner](const Entry& entry)
+        {
+            return entry.owner == owner;
+        });
+        if (it == m_entries.end())
+        {
+            return false;
+        }
+
+        Retire(it->bounds);
+        m_entries.erase(it);
+        return true;
+    }
+
+    bool AnimationRegistry::IsRegistered(const void* owner) const
+    {
+        return std::any_of(m_entries.begin(), m_entries.end(), [owner](const Entry& entry)
+        {
+            return entry.owner == owner;
+        });
+    }
+
+    bool AnimationRegistry::CollectDamage(std::uint64_t nowMs, Bounds& damage)
+    {
+        bool hasDamage = false;
+        if (m_hasRetired)
+        {
+            UnionInto(damage, hasDamage, m_retired);
+            m_retired = {};
+            m_hasRetired = false;
+        }
+
+        for (const Entry& entry : m_entries)
+        {
+            UnionInto(damage, hasDamage, entry.bounds);
+        }
+
+        // Finished animations contributed their final frame above; drop them.
+        m_entries.erase(
+            std::remove_if(m_entries.begin(), m_entries.end(), [nowMs](const Entry& entry)
+            {
+                return entry.endMs != kOpenEnded && entry.endMs <= nowMs;
+            }),
+            m_entries.end());
+
+        return hasDamage;
+    }
+
+    void AnimationRegistry::Clear()
+    {
+        m_entries.clear();
+        m_retired = {};
+        m_hasRetired = false;
+    }
+
+    void AnimationRegistry::Retire(const Bounds& bounds)
+    {
+        UnionInto(m_retired, m_hasRetired, bounds);
+    }
+}
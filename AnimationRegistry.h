@@ -0,0 +1,67 @@
+#pragma once
+
+// AnimationRegistry.h - which parts of a window are animating, and until when.
+//
+// Platform-neutral: controls register an animation with the bounds it repaints
+// each frame (render-target pixels) and an optional end time; the window's
+// frame tick collects the union of those bounds as the frame's damage. An
+// animation that ends, moves or is unregistered damages its last bounds once
+// more so its final state is painted.
+//
+// Not thread-safe (UI thread only).
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace FD2D
+{
+    class AnimationRegistry
+    {
+    public:
+        struct Bounds
+        {
+            float left { 0.0f };
+            float top { 0.0f };
+            float right { 0.0f };
+            float bottom { 0.0f };
+
+            bool Empty() const { return !(right > left && bottom > top); }
+        };
+
+        // endMs value for animations that run until Unregister().
+        static constexpr std::uint64_t kOpenEnded = 0;
+
+        // Adds or updates `owner`'s animation (one per owner).
+        void Register(const void* owner, const Bounds& bounds, std::uint64_t endMs);
+        // Returns false when `owner` had nothing registered.
+        bool Unregister(const void* owner);
+        bool IsRegistered(const void* owner) const;
+
+        // True while any animation (or a final repaint of one) is pending.
+        bool Active() const { return !m_entries.empty() || m_hasRetired; }
+        std::size_t Count() const { return m_entries.size(); }
+
+        // Union of everything to repaint this frame: live animations plus the
+        // last bounds of those that ended, moved or were unregistered since
+        // the previous call. Animations with endMs <= nowMs are dropped after
+        // contributing. Returns false when there is nothing to repaint.
+        bool CollectDamage(std::uint64_t nowMs, Bounds& damage);
+
+        void Clear();
+
+    private:
+        struct Entry
+        {
+            const void* owner { nullptr };
+            Bounds bounds {};
+            std::uint64_t endMs { kOpenEnded };
+        };
+
+        void Retire(const Bounds& bounds);
+
+        std::vector<Entry> m_entries {};
+        Bounds m_retired {};
+        bool m_hasRetired { false };
+    };
+}
@@ -1,5 +1,6 @@
 #include "Application.h"
 #include "Util.h"
+#include <algorithm>
 #include <vector>
 
 namespace FD2D
@@ -24,6 +25,19 @@ namespace FD2D
             return hr;
         }
 
+        // High-resolution waitable timers (Windows 10 1803+) fire within
+        // ~0.5ms; older systems fall back to a normal timer (~1 tick slack).
+        m_frameTimer = CreateWaitableTimerExW(
+            nullptr,
+            nullptr,
+            CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+            TIMER_MODIFY_STATE | SYNCHRONIZE);
+        if (m_frameTimer == nullptr)
+        {
+            m_frameTimer = CreateWaitableTimerW(nullptr, FALSE, nullptr);
+        }
+        m_scheduler.SetClock([]() { return Util::NowUs(); });
+
         m_initialized = true;
         return S_OK;
     }
@@ -31,26 +45,33 @@ namespace FD2D
     void Application::Shutdown()
     {
         m_backplates.clear();
+        if (m_frameTimer != nullptr)
+        {
+            CloseHandle(m_frameTimer);
+            m_frameTimer = nullptr;
+        }
         Core::Shutdown();
         m_initialized = false;
     }
 
     std::shared_ptr<Backplate> Application::CreateBackplate(const std::wstring& name)
     {
-        if (name.empty() || m_backplates.find(name) != m_backplates.end())
+        const NameId id = NameInterner::Global().Intern(name);
+        if (id == kNoName || m_backplates.find(id) != m_backplates.end())
         {
             return nullptr;
         }
 
         auto backplate = std::make_shared<Backplate>(name);
         // Use insert instead of emplace (prevents optimization issues in Release mode)
-        m_backplates[name] = backplate;
+        m_backplates[id] = backplate;
         return backplate;
     }
 
     std::shared_ptr<Backplate> Application::CreateWindowedBackplate(const std::wstring& name, const WindowOptions& options)
     {
-        if (name.empty() || m_backplates.find(name) != m_backplates.end())
+        const NameId id = NameInterner::Global().Intern(name);
+        if (id == kNoName || m_backplates.find(id) != m_backplates.end())
         {
             return nullptr;
         }
@@ -63,7 +84,7 @@ namespace FD2D
         }
 
         // Use insert instead of emplace (prevents optimization issues in Release mode)
-        m_backplates[name] = backplate;
+        m_backplates[id] = backplate;
         return backplate;
     }
 
@@ -74,19 +95,19 @@ namespace FD2D
             return false;
         }
 
-        const std::wstring name = backplate->Name();
-        if (name.empty() || m_backplates.find(name) != m_backplates.end())
+        const NameId id = NameInterner::Global().Intern(backplate->Name());
+        if (id == kNoName || m_backplates.find(id) != m_backplates.end())
         {
             return false;
         }
 
-        m_backplates[name] = backplate;
+        m_backplates[id] = backplate;
         return true;
     }
 
     std::shared_ptr<Backplate> Application::GetBackplate(const std::wstring& name) const
     {
-        auto it = m_backplates.find(name);
+        auto it = m_backplates.find(NameInterner::Global().Find(name));
         if (it != m_backplates.end())
         {
             return it->second;
@@ -114,64 +135,84 @@ namespace FD2D
                 }
             }
 
-            const DWORD waitCount = static_cast<DWORD>(events.size());
+            const DWORD eventCount = static_cast<DWORD>(events.size());
 
-            // If any backplate has an active animation, wake at ~60fps to paint smoothly.
-            // Otherwise, keep a safety heartbeat (prevents "stuck forever" if a wakeup is missed).
-            DWORD timeoutMs = 1000;
-            const unsigned long long now = Util::NowMs();
+            // Sleep until the earliest deadline any window reports: its next
+            // animation frame (paced to the display refresh) or a timed event
+            // such as tooltip dwell or toast expiry. With nothing scheduled,
+            // keep a safety heartbeat (prevents "stuck forever" if a wakeup is missed).
+            constexpr unsigned long long kHeartbeatUs = 1000000ULL;
+            m_scheduler.Begin();
+            const unsigned long long nowUs = m_scheduler.NowUs();
             for (const auto& kv : m_backplates)
             {
-                if (kv.second && kv.second->HasActiveAnimation(now))
+                if (kv.second)
                 {
-                    timeoutMs = 16;
-                    break;
+                    kv.second->CollectDeadlines(m_scheduler, nowUs);
                 }
             }
+            const unsigned long long waitUs = m_scheduler.WaitUs(kHeartbeatUs);
 
-            DWORD waitRes = WAIT_TIMEOUT;
-            if (waitCount > 0)
+            // The frame timer joins the wait set so the wake is precise; the
+            // MsgWait timeout (rounded up to whole ms) is only a backstop.
+            bool timerArmed = false;
+            if (m_frameTimer != nullptr && waitUs > 0 && waitUs < kHeartbeatUs)
             {
-                waitRes = MsgWaitForMultipleObjectsEx(
-                    waitCount,
-                    waitCount > 0 ? events.data() : nullptr,
-                    timeoutMs,
-                    QS_ALLINPUT,
-                    MWMO_INPUTAVAILABLE);
-
-                if (waitRes == WAIT_FAILED)
+                LARGE_INTEGER due {};
+                due.QuadPart = -static_cast<LONGLONG>(waitUs * 10ULL); // relative, 100ns units
+                timerArmed = SetWaitableTimer(m_frameTimer, &due, 0, nullptr, nullptr, FALSE) != FALSE;
+                if (timerArmed)
                 {
-                    return -1;
+                    events.push_back(m_frameTimer);
                 }
+            }
 
-                // One of our async redraw events fired.
-                if (waitRes >= WAIT_OBJECT_0 && waitRes < WAIT_OBJECT_0 + waitCount)
-                {
-                    for (const auto& kv : m_backplates)
-                    {
-                        if (kv.second)
-                        {
-                            kv.second->ProcessAsyncRedraw();
-                        }
-                    }
-                    // Do NOT continue here:
-                    // When worker completions arrive frequently (e.g., heavy I/O), we can starve the animation tick
-                    // and make spinners/fades appear to "pause". We'll fall through to drain messages and run a
-                    // throttled animation tick each loop.
-                }
+            // A deadline that is already due still polls (timeout 0) so input
+            // is drained even when frames run late back-to-back.
+            const DWORD timeoutMs = static_cast<DWORD>((waitUs + 999ULL) / 1000ULL) + (timerArmed ? 1 : 0);
+            DWORD waitRes = MsgWaitForMultipleObjectsEx(
+                static_cast<DWORD>(events.size()),
+                events.empty() ? nullptr : events.data(),
+                timeoutMs,
+                QS_ALLINPUT,
+                MWMO_INPUTAVAILABLE);
+
+            if (waitRes == WAIT_FAILED)
+            {
+                return -1;
             }
 
-            // Animation tick timeout (no messages/events, but animations are active).
-            if (waitRes == WAIT_TIMEOUT)
+            // One of our async redraw events fired.
+            if (waitRes >= WAIT_OBJECT_0 && waitRes < WAIT_OBJECT_0 + eventCount)
             {
-                const unsigned long long t = Util::NowMs();
                 for (const auto& kv : m_backplates)
                 {
                     if (kv.second)
                     {
-                        kv.second->ProcessAnimationTick(t);
+                        kv.second->ProcessAsyncRedraw();
                     }
                 }
+                // Do NOT continue here:
+                // When worker completions arrive frequently (e.g., heavy I/O), we can starve the animation tick
+                // and make spinners/fades appear to "pause". We'll fall through to drain messages and run a
+                // throttled animation tick each loop.
+            }
+            else if (timerArmed && waitRes == WAIT_OBJECT_0 + eventCount)
+            {
+                waitRes = WAIT_TIMEOUT; // deadline reached
+            }
+
+            if (timerArmed && waitRes != WAIT_TIMEOUT)
+            {
+                // Woken early by a message/event: drop the stale deadline;
+                // the next iteration re-arms from fresh deadlines.
+                (void)CancelWaitableTimer(m_frameTimer);
+            }
+
+            // Deadline reached (no messages/events): advance animations and timed events.
+            if (waitRes == WAIT_TIMEOUT)
+            {
+                TickBackplates();
                 continue;
             }
 
@@ -190,15 +231,48 @@ namespace FD2D
 
             // Important: animations must advance even when the message queue is busy and we never hit WAIT_TIMEOUT.
             // So after draining messages, run a throttled animation tick.
-            const unsigned long long t = Util::NowMs();
-            for (const auto& kv : m_backplates)
+            TickBackplates();
+        }
+    }
+
+    void Application::TickBackplates()
+    {
+        // Earliest deadline first, so a late window (or one deferred by the
+        // budget below) goes before windows that ticked recently, and the
+        // order no longer depends on the map.
+        const unsigned long long startUs = Util::NowUs();
+        std::vector<TickEntry> order; // local: a tick may re-enter the loop (modal UI)
+        order.reserve(m_backplates.size());
+        for (const auto& kv : m_backplates)
+        {
+            if (kv.second)
             {
-                if (kv.second)
+                order.push_back({ kv.second->NextTickDeadlineUs(startUs), kv.second });
+            }
+        }
+        std::stable_sort(order.begin(), order.end(), [](const TickEntry& a, const TickEntry& b)
+        {
+            return a.deadlineUs < b.deadlineUs;
+        });
+
+        // Bound UI-thread time per pass: once one heavy window has used the
+        // budget, the rest wait until input has been drained again. They stay
+        // due, so the loop comes straight back to them.
+        // Each window reads the clock when its turn comes, so one that waits
+        // behind a heavy window does not animate with a stale time.
+        constexpr unsigned long long kTickBudgetUs = 12000ULL;
+        for (const TickEntry& entry : order)
+        {
+            const unsigned long long nowUs = Util::NowUs();
+            if (nowUs - startUs >= kTickBudgetUs)
+            {
+                if (entry.deadlineUs <= nowUs)
                 {
-                    kv.second->ProcessAnimationTick(t);
+                    entry.backplate->NoteTickDeferred();
                 }
+                continue;
             }
-            Sleep(0);
+            entry.backplate->ProcessAnimationTick(nowUs / 1000ULL);
         }
     }
 
@@ -3,6 +3,7 @@
 #include <memory>
 #include <unordered_map>
 #include <string>
+#include <vector>
 
 #include "Core.h"
 #include "Backplate.h"
@@ -33,9 +34,24 @@ namespace FD2D
         Application(const Application&) = delete;
         Application& operator=(const Application&) = delete;
 
+        // Runs each window's animation tick, earliest deadline first, within
+        // a per-pass UI-thread time budget.
+        void TickBackplates();
+
+        struct TickEntry
+        {
+            unsigned long long deadlineUs { 0 };
+            std::shared_ptr<Backplate> backplate {};
+        };
+
         bool m_initialized { false };
         InitContext m_context {};
-        std::unordered_map<std::wstring, std::shared_ptr<Backplate>> m_backplates {};
+        // Wakes the message loop at the next frame/timed-event deadline
+        // (high-resolution where the OS supports it).
+        HANDLE m_frameTimer { nullptr };
+        FrameScheduler m_scheduler {};
+        // Keyed by the interned window name (NameInterner).
+        std::unordered_map<NameId, std::shared_ptr<Backplate>> m_backplates {};
     };
 }
 
@@ -2,11 +2,15 @@
 #include "Core.h"
 #include "Util.h"
 #include "FD2DLog.h"
+#include "PixelCopy.h"
 #include <cmath>
 #include <cstring>
+#include <d3d11_4.h>
 #include <dxgi1_3.h>
+#include <dxgi1_5.h>
 #include <string>
 #include <algorithm>
+#include <iterator>
 #include <shellapi.h>
 #include <windowsx.h>  // For GET_X_LPARAM, GET_Y_LPARAM, MAKELPARAM
 #include <ole2.h>
@@ -122,17 +126,17 @@ namespace FD2D
 
     Backplate::Backplate()
     {
-        m_asyncRedrawEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        m_animationEngine.SetClock([]() { return Util::NowMs(); });
         m_asyncRedrawControl = std::make_shared<AsyncRedrawToken::ControlBlock>();
-        m_asyncRedrawControl->backplate = this;
+        ConnectDispatcher();
     }
 
     Backplate::Backplate(const std::wstring& name)
         : m_name(name)
     {
-        m_asyncRedrawEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        m_animationEngine.SetClock([]() { return Util::NowMs(); });
         m_asyncRedrawControl = std::make_shared<AsyncRedrawToken::ControlBlock>();
-        m_asyncRedrawControl->backplate = this;
+        ConnectDispatcher();
     }
 
     Backplate::~Backplate()
@@ -140,46 +144,58 @@ namespace FD2D
         // Drop the HWND first so any Invalidate/Render triggered by the
         // Shutdown invalidation cascade cannot touch a destroyed window.
         m_window = nullptr;
-        DetachAsyncRedrawControl();
+        StopRenderThread();
+        CancelComposedPixelReadbacks();
+        if (m_imagePipeline)
+        {
+            m_imagePipeline->SetWakeCallback(this, nullptr);
+        }
+        if (m_asyncRedrawControl)
+        {
+            m_asyncRedrawControl->signal.Close(); // outstanding tokens become no-ops
+        }
+        m_dispatcher->Close();
         NotifyGraphicsInvalidated(GraphicsInvalidationReason::Shutdown);
         UnregisterDropTarget();
+    }
+
+    AsyncRedrawToken::ControlBlock::ControlBlock()
+        : event(CreateEventW(nullptr, TRUE, FALSE, nullptr))
+        , signal([this]()
+        {
+            if (event)
+            {
+                SetEvent(event);
+            }
+        })
+    {
+    }
 
-        if (m_asyncRedrawEvent)
+    AsyncRedrawToken::ControlBlock::~ControlBlock()
+    {
+        if (event)
         {
-            CloseHandle(m_asyncRedrawEvent);
-            m_asyncRedrawEvent = nullptr;
+            CloseHandle(event);
+            event = nullptr;
         }
     }
 
-    AsyncRedrawToken::AsyncRedrawToken(std::weak_ptr<ControlBlock> control)
+    AsyncRedrawToken::AsyncRedrawToken(std::shared_ptr<ControlBlock> control)
         : m_control(std::move(control))
     {
     }
 
     void AsyncRedrawToken::RequestAsyncRedraw() const
     {
-        auto control = m_control.lock();
-        if (!control)
+        if (m_control)
         {
-            return;
-        }
-
-        std::lock_guard<std::mutex> lock(control->mutex);
-        if (control->backplate)
-        {
-            control->backplate->RequestAsyncRedraw();
+            (void)m_control->signal.Signal();
         }
     }
 
-    void Backplate::DetachAsyncRedrawControl()
+    bool Backplate::AsyncRedrawPending() const
     {
-        if (!m_asyncRedrawControl)
-        {
-            return;
-        }
-
-        std::lock_guard<std::mutex> lock(m_asyncRedrawControl->mutex);
-        m_asyncRedrawControl->backplate = nullptr;
+        return m_asyncRedrawControl && m_asyncRedrawControl->signal.Pending();
     }
 
     std::shared_ptr<AsyncRedrawToken> Backplate::GetAsyncRedrawToken() const
@@ -191,6 +207,20 @@ namespace FD2D
         return std::shared_ptr<AsyncRedrawToken>(new AsyncRedrawToken(m_asyncRedrawControl));
     }
 
+    void Backplate::ConnectDispatcher()
+    {
+        // Set once, before anything can post; the token turns into a no-op
+        // when this window goes away.
+        std::shared_ptr<AsyncRedrawToken> token = GetAsyncRedrawToken();
+        m_dispatcher->SetWakeCallback([token]()
+        {
+            if (token)
+            {
+                token->RequestAsyncRedraw();
+            }
+        });
+    }
+
     void Backplate::InvalidateGraphics(
         GraphicsInvalidationReason reason,
         bool bumpDevice,
@@ -297,13 +327,27 @@ namespace FD2D
             return;
         }
 
-        if (m_placeAutosaveTimerId == 0)
+        // Debounce (reset timer each time).
+        CancelTimer(m_placeAutosaveTimer);
+        m_placeAutosaveTimer = SetTimeout(200, [this]() { OnPlacementAutosaveTimer(); });
+    }
+
+    void Backplate::OnPlacementAutosaveTimer()
+    {
+        m_placeAutosaveTimer = kInvalidTimer;
+
+        // Avoid synchronous placement persistence during interactive resize.
+        // WM_EXITSIZEMOVE already performs a single final flush.
+        if (m_inSizeMove)
         {
-            m_placeAutosaveTimerId = 0xFD22;
+            m_placeAutosaveTimer = SetTimeout(200, [this]() { OnPlacementAutosaveTimer(); });
+            return;
         }
 
-        // Debounce (reset timer each time).
-        (void)SetTimer(m_window, m_placeAutosaveTimerId, 200, nullptr);
+        if (m_onWindowPlacementChanged && m_window != nullptr)
+        {
+            m_onWindowPlacementChanged(m_window);
+        }
     }
 
     void Backplate::FlushPlacementAutosave()
@@ -313,11 +357,7 @@ namespace FD2D
             return;
         }
 
-        if (m_placeAutosaveTimerId != 0)
-        {
-            KillTimer(m_window, m_placeAutosaveTimerId);
-        }
-
+        CancelTimer(m_placeAutosaveTimer);
         m_onWindowPlacementChanged(m_window);
     }
 
@@ -644,29 +684,137 @@ namespace FD2D
 
     void Backplate::RequestAsyncRedraw()
     {
-        if (!m_asyncRedrawEvent || !m_window || !IsWindow(m_window))
+        if (!m_asyncRedrawControl || !m_window || !IsWindow(m_window))
         {
             return;
         }
 
         // Coalesce multiple worker completions into a single wakeup.
-        const bool wasPending = m_asyncRedrawPending.exchange(true);
-        if (!wasPending)
+        (void)m_asyncRedrawControl->signal.Signal();
+    }
+
+    void Backplate::SetImagePipeline(std::shared_ptr<ImagePipeline> pipeline)
+    {
+        if (m_imagePipeline == pipeline)
+        {
+            return;
+        }
+
+        if (m_imagePipeline)
+        {
+            m_imagePipeline->SetWakeCallback(this, nullptr);
+        }
+        m_imagePipeline = std::move(pipeline);
+        if (m_imagePipeline)
+        {
+            // Keyed by this window: only deliveries for requests its own
+            // controls made (see Image::RequestSource) wake it.
+            std::shared_ptr<AsyncRedrawToken> token = GetAsyncRedrawToken();
+            m_imagePipeline->SetWakeCallback(this, [token]()
+            {
+                if (token)
+                {
+                    token->RequestAsyncRedraw();
+                }
+            });
+        }
+    }
+
+    void Backplate::DeliverDecodedImages()
+    {
+        if (!m_imagePipeline)
+        {
+            return;
+        }
+
+        // Bounded per slice: each delivered image is uploaded by its Image on
+        // the next render, so this caps the upload work landing in one frame.
+        constexpr std::size_t kMaxImageDeliveriesPerSlice = 8;
+        constexpr std::uint64_t kMaxImageDeliveryBytesPerSlice = 64ull * 1024ull * 1024ull;
+
+        // Completions Invalidate() their Image; defer so the whole batch is
+        // presented by one frame instead of one Render() per image.
+        BeginDeferredRender();
+        const bool more = m_imagePipeline->DeliverCompleted(
+            kMaxImageDeliveriesPerSlice,
+            kMaxImageDeliveryBytesPerSlice,
+            this);
+        EndDeferredRender();
+
+        if (more)
         {
-            SetEvent(m_asyncRedrawEvent);
+            RequestAnimationFrame();
+        }
+    }
+
+    void Backplate::AddFrameObserver(std::function<bool()> observer)
+    {
+        if (observer)
+        {
+            m_frameObservers.push_back(std::move(observer));
+        }
+    }
+
+    void Backplate::RunFrameObservers()
+    {
+        // Observers may add new ones (or re-request work) while running.
+        std::vector<std::function<bool()>> observers;
+        observers.swap(m_frameObservers);
+        observers.erase(
+            std::remove_if(
+                observers.begin(),
+                observers.end(),
+                [](const std::function<bool()>& observer) { return !observer(); }),
+            observers.end());
+        observers.insert(
+            observers.end(),
+            std::make_move_iterator(m_frameObservers.begin()),
+            std::make_move_iterator(m_frameObservers.end()));
+        m_frameObservers = std::move(observers);
+    }
+
+    void Backplate::RunPostedTasks()
+    {
+        if (!m_dispatcher->Pending())
+        {
+            return;
         }
+
+        // Bounded per slice so a flood of posts cannot delay input or the next
+        // frame; leftovers keep the loop ticking (CollectDeadlines).
+        constexpr unsigned long long kPostedTaskBudgetUs = 4000ULL;
+
+        // Tasks typically Invalidate() what they changed; present the whole
+        // slice with one frame.
+        BeginDeferredRender();
+        (void)m_dispatcher->Drain(kPostedTaskBudgetUs);
+        EndDeferredRender();
     }
 
     void Backplate::ProcessAsyncRedraw()
     {
-        if (!m_window || !IsWindow(m_window) || !m_asyncRedrawEvent)
+        if (!m_asyncRedrawControl)
+        {
+            return;
+        }
+
+        // Reset the event, then drain the pending flag: a signal landing in
+        // between is handled by this pass, any later one sets the event again.
+        // Done even without a window so a stray signal cannot leave the
+        // (manual-reset) event set and spin the message loop.
+        ResetEvent(m_asyncRedrawControl->event);
+        (void)m_asyncRedrawControl->signal.Consume();
+        if (!m_window || !IsWindow(m_window))
         {
             return;
         }
 
-        // Drain the pending flag and reset the event for future signals.
-        m_asyncRedrawPending.store(false);
-        ResetEvent(m_asyncRedrawEvent);
+        RunPostedTasks();
+        if (!m_window)
+        {
+            return; // a posted task destroyed the window
+        }
+        DeliverDecodedImages();
 
         // During interactive resizing, avoid synchronous repaint pressure.
         if (m_inSizeMove)
@@ -691,7 +839,45 @@ namespace FD2D
         m_lastAnimationRequestMs.store(Util::NowMs());
     }
 
+    void Backplate::RegisterAnimation(const Wnd* owner, const D2D1_RECT_F& bounds, unsigned long long endMs)
+    {
+        m_animations.Register(owner, { bounds.left, bounds.top, bounds.right, bounds.bottom }, endMs);
+    }
+
+    void Backplate::UnregisterAnimation(const Wnd* owner)
+    {
+        (void)m_animations.Unregister(owner);
+    }
+
+    bool Backplate::OutsideRenderDamage(const D2D1_RECT_F& layoutRect, const D2D1_MATRIX_3X2_F* toRender) const
+    {
+        if (!m_cullToDamage)
+        {
+            return false;
+        }
+
+        const D2D1_MATRIX_3X2_F m = toRender
+            ? *toRender
+            : D2D1::Matrix3x2F::Scale(m_logicalToRenderScale.width, m_logicalToRenderScale.height);
+        if (m._12 != 0.0f || m._21 != 0.0f)
+        {
+            return false;
+        }
+
+        const float x0 = layoutRect.left * m._11 + m._31;
+        const float x1 = layoutRect.right * m._11 + m._31;
+        const float y0 = layoutRect.top * m._22 + m._32;
+        const float y1 = layoutRect.bottom * m._22 + m._32;
+        return (std::max)(x0, x1) <= m_tickDamage.left || (std::min)(x0, x1) >= m_tickDamage.right ||
+            (std::max)(y0, y1) <= m_tickDamage.top || (std::min)(y0, y1) >= m_tickDamage.bottom;
+    }
+
     bool Backplate::HasActiveAnimation(unsigned long long nowMs) const
+    {
+        return m_animations.Active() || m_animationEngine.Active() || FullFrameAnimationActive(nowMs);
+    }
+
+    bool Backplate::FullFrameAnimationActive(unsigned long long nowMs) const
     {
         const unsigned long long last = m_lastAnimationRequestMs.load();
         // Consider animation active if someone requested frames recently.
@@ -707,41 +893,94 @@ namespace FD2D
             return;
         }
 
-        // Advance tooltip dwell / toast expiry first: it re-arms the animation
-        // while a tooltip is pending or a toast is showing, so these keep
-        // ticking even when nothing else animates.
-        AdvanceHoverToast(nowMs);
+        // Deliver finished (or abandoned) async pixel readbacks. Runs before the
+        // render below so callbacks see the frame they asked for, not a newer one.
+        PollComposedPixelReadbacks();
+        RunPostedTasks();
+        if (!m_window)
+        {
+            return; // a posted task destroyed the window
+        }
+        DeliverDecodedImages();
+
+        // Due timers (tooltip dwell, toast expiry, autosave, app timers). The
+        // loop wakes for the earliest one via CollectDeadlines, so none of them
+        // keeps the animation alive just to watch the clock.
+        (void)m_timers.Advance(nowMs);
+        if (!m_window)
+        {
+            return; // a timer callback destroyed the window
+        }
+        ArmTimerFallback();
 
         if (!HasActiveAnimation(nowMs))
         {
             return;
         }
 
-        // Adaptive animation cadence:
-        // - Default: ~60fps for smooth interactions.
-        // - While async redraw bursts are pending or during live resize:
-        //   back off to ~30fps to reduce UI-thread render pressure.
-        const bool asyncPending = m_asyncRedrawPending.load();
-        const unsigned long long minTickIntervalMs =
-            (m_inSizeMove || asyncPending) ? 33ULL : 16ULL;
-
         // Diagnostic: log only when the cadence actually changes (not every tick), so we
         // get crisp "throttle engaged/lifted" markers to correlate with the [FPS] summary.
-        if (minTickIntervalMs != m_lastLoggedTickIntervalMs)
+        const unsigned long long tickIntervalUs = AnimationFrameIntervalUs();
+        if (tickIntervalUs != m_lastLoggedTickIntervalUs)
         {
             FD2D_LOG_INFO(
-                "[FPS] animation tick cadence -> {}ms ({}fps target)  inSizeMove={} asyncRedrawPending={}",
-                minTickIntervalMs, minTickIntervalMs > 0 ? (1000ULL / minTickIntervalMs) : 0ULL,
-                m_inSizeMove, asyncPending);
-            m_lastLoggedTickIntervalMs = minTickIntervalMs;
+                "[FPS] animation tick cadence -> {:.2f}ms ({:.1f}fps target)  inSizeMove={} asyncRedrawPending={} refresh={:.2f}ms",
+                tickIntervalUs / 1000.0, tickIntervalUs > 0 ? (1000000.0 / tickIntervalUs) : 0.0,
+                m_inSizeMove, AsyncRedrawPending(), m_refreshIntervalUs / 1000.0);
+            m_lastLoggedTickIntervalUs = tickIntervalUs;
         }
 
-        const unsigned long long lastTick = m_lastAnimationTickMs.load();
-        if (lastTick != 0 && (nowMs - lastTick) < minTickIntervalMs)
+        // The waitable timer wakes us at the deadline; allow for it firing a
+        // little early so the tick is not skipped and re-slept for ~0.5ms.
+        constexpr unsigned long long kTickSlackUs = 1000ULL;
+        const unsigned long long nowUs = Util::NowUs();
+        if (nowUs + kTickSlackUs < NextAnimationTickUs())
         {
             return;
         }
-        m_lastAnimationTickMs.store(nowMs);
+        m_lastAnimationTickUs.store(nowUs);
+
+        // A tick driven only by registered animations repaints just their
+        // damage (Render falls back to a full frame where it cannot). Pending
+        // invalidation or layout, or a RequestAnimationFrame user, needs all.
+        // Property animations land in one batch before the frame; the
+        // controls they write to are repainted with a full frame.
+        const bool animated = m_animationEngine.Tick(nowMs);
+        AnimationRegistry::Bounds damage {};
+        const bool hasDamage = m_animations.CollectDamage(nowMs, damage);
+        if (!CanPresentAnimation())
+        {
+            // Values and leases above still advance (so they settle/expire);
+            // the window repaints in full when it shows again.
+            ++m_frameStats.hiddenTicks;
+            m_animationFramesSkipped = true;
+            return;
+        }
+        if (m_animationFramesSkipped)
+        {
+            // Damage gathered while hidden was dropped: repaint everything once.
+            m_animationFramesSkipped = false;
+            InvalidateRect(m_window, nullptr, FALSE);
+        }
+        const bool fullFrame =
+            animated ||
+            FullFrameAnimationActive(nowMs) ||
+            m_layoutDirty ||
+            GetUpdateRect(m_window, nullptr, FALSE) != FALSE;
+        if (!fullFrame && !hasDamage)
+        {
+            return; // animations registered, but nothing visible to repaint
+        }
+        m_tickDamageValid = !fullFrame;
+        if (m_tickDamageValid)
+        {
+            // Whole pixels, plus one for antialiased edges.
+            m_tickDamage = D2D1::RectF(
+                std::floor(damage.left) - 1.0f,
+                std::floor(damage.top) - 1.0f,
+                std::ceil(damage.right) + 1.0f,
+                std::ceil(damage.bottom) + 1.0f);
+        }
 
         // Direct rendering: bypass message loop for smoother 60fps animation.
         // Log frames that take > 100ms (rate-limited to one log per 100ms to avoid flooding).
@@ -761,16 +1000,220 @@ namespace FD2D
         }
     }
 
-    Wnd* Backplate::FindTargetWnd(const POINT& ptClient)
+    namespace
     {
-        UNREFERENCED_PARAMETER(ptClient);
-        return nullptr;
+        constexpr unsigned int kTooltipDwellMs = 500;
+        constexpr unsigned int kToastDurationMs = 1800;
     }
 
-    namespace
+    unsigned long long Backplate::AnimationFrameIntervalUs() const
+    {
+        // Adaptive animation cadence:
+        // - Default: ~60fps for smooth interactions.
+        // - While async redraw bursts are pending or during live resize:
+        //   back off to ~30fps to reduce UI-thread render pressure.
+        // Snapped to whole display refreshes so ticks line up with vsync.
+        // - Minimized / hidden / occluded: nothing to show, so only probe
+        //   (and keep animation bookkeeping moving) a few times a second.
+        if (m_occluded || (m_window != nullptr && (IsIconic(m_window) || !IsWindowVisible(m_window))))
+        {
+            constexpr unsigned long long kHiddenProbeIntervalUs = 250000ULL;
+            return kHiddenProbeIntervalUs;
+        }
+
+        const bool asyncPending = AsyncRedrawPending();
+        const unsigned long long targetUs = (m_inSizeMove || asyncPending) ? 33000ULL : 16000ULL;
+        return FrameScheduler::AlignToRefresh(targetUs, m_refreshIntervalUs);
+    }
+
+    bool Backplate::CanPresentAnimation()
+    {
+        if (!m_window || IsIconic(m_window) || !IsWindowVisible(m_window))
+        {
+            return false;
+        }
+
+        if (m_occluded && m_swapChain)
+        {
+            // The render thread may be presenting this swap chain right now.
+            if (m_renderThread && m_renderThreadLock)
+            {
+                m_renderThreadLock->Enter();
+            }
+            m_occluded = (m_swapChain->Present(0, DXGI_PRESENT_TEST) == DXGI_STATUS_OCCLUDED);
+            if (m_renderThread && m_renderThreadLock)
+            {
+                m_renderThreadLock->Leave();
+            }
+        }
+        return !m_occluded;
+    }
+
+    unsigned long long Backplate::NextAnimationTickUs() const
+    {
+        const unsigned long long lastTick = m_lastAnimationTickUs.load();
+        const unsigned long long intervalUs = AnimationFrameIntervalUs();
+        if (m_presentMode == PresentMode::Deadline)
+        {
+            return m_pacer.NextFrameStartUs(lastTick, intervalUs);
+        }
+        return (lastTick != 0) ? lastTick + intervalUs : 0;
+    }
+
+    void Backplate::WaitForFrameLatency()
+    {
+        if (m_frameLatencyWaitable == nullptr || m_frameLatencySlotHeld)
+        {
+            return;
+        }
+
+        // Bounded, so a signal lost to device removal cannot hang the UI thread.
+        constexpr DWORD kFrameLatencyTimeoutMs = 100;
+        const unsigned long long startUs = Util::NowUs();
+        m_frameLatencySlotHeld =
+            (WaitForSingleObjectEx(m_frameLatencyWaitable, kFrameLatencyTimeoutMs, TRUE) == WAIT_OBJECT_0);
+
+        // Having to block means the previous frame just left the queue, i.e.
+        // a vblank happened now: the fallback phase when DXGI has no stats.
+        const unsigned long long endUs = Util::NowUs();
+        if (m_frameLatencySlotHeld && endUs - startUs >= 1000ULL)
+        {
+            m_frameLatencyWakeUs = endUs;
+        }
+    }
+
+    void Backplate::ObserveVblank()
+    {
+        DXGI_FRAME_STATISTICS stats {};
+        if (m_swapChain && SUCCEEDED(m_swapChain->GetFrameStatistics(&stats)) && stats.SyncQPCTime.QuadPart != 0)
+        {
+            m_pacer.OnVblank(Util::QpcToUs(stats.SyncQPCTime.QuadPart));
+        }
+        else if (m_frameLatencyWakeUs != 0)
+        {
+            m_pacer.OnVblank(m_frameLatencyWakeUs);
+        }
+    }
+
+    void Backplate::UpdateRefreshInterval()
+    {
+        if (m_window == nullptr)
+        {
+            return;
+        }
+
+        MONITORINFOEXW monitorInfo {};
+        monitorInfo.cbSize = sizeof(monitorInfo);
+        DEVMODEW mode {};
+        mode.dmSize = sizeof(mode);
+        const HMONITOR monitor = MonitorFromWindow(m_window, MONITOR_DEFAULTTONEAREST);
+        if (monitor == nullptr ||
+            !GetMonitorInfoW(monitor, &monitorInfo) ||
+            !EnumDisplaySettingsW(monitorInfo.szDevice, ENUM_CURRENT_SETTINGS, &mode) ||
+            mode.dmDisplayFrequency <= 1) // 0/1 = "hardware default"
+        {
+            m_refreshIntervalUs = 0;
+            m_pacer.SetRefreshIntervalUs(0);
+            return;
+        }
+
+        m_refreshIntervalUs = 1000000ULL / mode.dmDisplayFrequency;
+        m_pacer.SetRefreshIntervalUs(m_refreshIntervalUs);
+    }
+
+    void Backplate::CollectDeadlines(FrameScheduler& scheduler, unsigned long long nowUs) const
+    {
+        if (!m_window)
+        {
+            return;
+        }
+
+        // Posted tasks left over from a budget-limited slice run on the next frame.
+        if (HasActiveAnimation(nowUs / 1000ULL) || m_dispatcher->Pending())
+        {
+            if (m_presentMode == PresentMode::Deadline)
+            {
+                scheduler.AddDeadline(NextAnimationTickUs());
+            }
+            else
+            {
+                scheduler.AddFrame(m_lastAnimationTickUs.load(), AnimationFrameIntervalUs());
+            }
+        }
+
+        const std::uint64_t nextTimerMs = m_timers.NextDeadline();
+        if (nextTimerMs != TimerWheel::kNoDeadline)
+        {
+            scheduler.AddDeadline(nextTimerMs * 1000ULL);
+        }
+    }
+
+    unsigned long long Backplate::NextTickDeadlineUs(unsigned long long nowUs) const
+    {
+        FrameScheduler scheduler {};
+        scheduler.Begin(nowUs);
+        CollectDeadlines(scheduler, nowUs);
+        return scheduler.NextWakeUs();
+    }
+
+    Backplate::TimerId Backplate::SetTimeout(unsigned int delayMs, std::function<void()> callback)
+    {
+        const TimerId id = m_timers.Schedule(Util::NowMs() + delayMs, 0, std::move(callback));
+        ArmTimerFallback();
+        return id;
+    }
+
+    Backplate::TimerId Backplate::SetInterval(unsigned int periodMs, std::function<void()> callback)
+    {
+        const unsigned long long period = (std::max)(1u, periodMs);
+        const TimerId id = m_timers.Schedule(Util::NowMs() + period, period, std::move(callback));
+        ArmTimerFallback();
+        return id;
+    }
+
+    void Backplate::ArmTimerFallback()
     {
-        constexpr unsigned long long kTooltipDwellMs = 500ULL;
-        constexpr unsigned long long kToastDurationMs = 1800ULL;
+        // FD2D's own loop wakes for the deadline first (CollectDeadlines) and
+        // Advance is idempotent, so the fallback only does work when some
+        // other pump is dispatching. A cancelled timer leaves it armed; the
+        // stale WM_TIMER advances nothing and re-arms or kills it.
+        const unsigned long long dueMs = m_timers.NextDeadline();
+        if (m_window == nullptr || dueMs == m_timerFallbackDueMs)
+        {
+            return;
+        }
+        if (dueMs == TimerWheel::kNoDeadline)
+        {
+            KillTimer(m_window, kTimerFallbackId);
+            m_timerFallbackDueMs = dueMs;
+            return;
+        }
+
+        // One extra ms so tick-clock rounding does not deliver it just early.
+        const unsigned long long nowMs = Util::NowMs();
+        const unsigned long long delayMs = (dueMs > nowMs) ? dueMs - nowMs + 1ULL : 0ULL;
+        const unsigned long long clampedMs = (std::min)((std::max)(delayMs, static_cast<unsigned long long>(USER_TIMER_MINIMUM)),
+            static_cast<unsigned long long>(USER_TIMER_MAXIMUM));
+        const UINT elapse = static_cast<UINT>(clampedMs);
+        if (SetTimer(m_window, kTimerFallbackId, elapse, nullptr) != 0)
+        {
+            m_timerFallbackDueMs = dueMs;
+        }
+    }
+
+    void Backplate::CancelTimer(TimerId& id)
+    {
+        if (id != kInvalidTimer)
+        {
+            (void)m_timers.Cancel(id);
+            id = kInvalidTimer;
+        }
+    }
+
+    Wnd* Backplate::FindTargetWnd(const POINT& ptClient)
+    {
+        UNREFERENCED_PARAMETER(ptClient);
+        return nullptr;
     }
 
     Wnd* Backplate::HitTestTopLevel(const POINT& pt)
@@ -804,11 +1247,21 @@ namespace FD2D
         const bool wasShown = m_tipShown;
         m_hoverWnd = hit;
         m_hoverTip = std::move(tip);
-        m_hoverSinceMs = Util::NowMs();
         m_tipShown = false;
+        CancelTimer(m_tipTimer);
         if (!m_hoverTip.empty())
         {
-            RequestAnimationFrame(); // drive the dwell timer via ProcessAnimationTick
+            // Dwell: once elapsed, show the tip with the next repaint.
+            m_tipTimer = SetTimeout(kTooltipDwellMs, [this]()
+            {
+                m_tipTimer = kInvalidTimer;
+                m_tipShown = true;
+                m_tipAnchor = m_hoverPt;
+                if (m_window != nullptr)
+                {
+                    InvalidateRect(m_window, nullptr, FALSE);
+                }
+            });
         }
         else if (wasShown && m_window != nullptr)
         {
@@ -820,7 +1273,7 @@ namespace FD2D
     {
         m_hoverWnd = nullptr;
         m_hoverTip.clear();
-        m_hoverSinceMs = 0;
+        CancelTimer(m_tipTimer);
         if (m_tipShown)
         {
             m_tipShown = false;
@@ -834,8 +1287,17 @@ namespace FD2D
     void Backplate::ShowToast(const std::wstring& text)
     {
         m_toastText = text;
-        m_toastExpireMs = Util::NowMs() + kToastDurationMs;
-        RequestAnimationFrame();
+        CancelTimer(m_toastTimer);
+        m_toastTimer = SetTimeout(kToastDurationMs, [this]()
+        {
+            // Expired: one more repaint erases it.
+            m_toastTimer = kInvalidTimer;
+            m_toastText.clear();
+            if (m_window != nullptr)
+            {
+                InvalidateRect(m_window, nullptr, FALSE);
+            }
+        });
         if (m_window != nullptr)
         {
             InvalidateRect(m_window, nullptr, FALSE);
@@ -870,45 +1332,6 @@ namespace FD2D
         return ok;
     }
 
-    void Backplate::AdvanceHoverToast(unsigned long long nowMs)
-    {
-        bool needAnim = false;
-
-        // Tooltip dwell: once elapsed, flip m_tipShown so the next render (this
-        // tick's Render, since animation is active) paints it. Keep re-arming
-        // the animation until then.
-        if (m_hoverWnd != nullptr && !m_hoverTip.empty() && !m_tipShown)
-        {
-            if (nowMs - m_hoverSinceMs >= kTooltipDwellMs)
-            {
-                m_tipShown = true;
-                m_tipAnchor = m_hoverPt;
-            }
-            else
-            {
-                needAnim = true;
-            }
-        }
-
-        // Toast expiry: clear it (one more render this tick erases it).
-        if (!m_toastText.empty())
-        {
-            if (nowMs >= m_toastExpireMs)
-            {
-                m_toastText.clear();
-            }
-            else
-            {
-                needAnim = true;
-            }
-        }
-
-        if (needAnim)
-        {
-            RequestAnimationFrame();
-        }
-    }
-
     bool Backplate::HasActiveOverlay(OverlayLayer layer) const
     {
         for (const auto& child : m_childrenOrdered)
@@ -1132,10 +1555,18 @@ namespace FD2D
             }
             // User finished an interactive move/resize; persist immediately.
             FlushPlacementAutosave();
+            // The window may now be on a monitor with a different refresh rate.
+            UpdateRefreshInterval();
             result = 0;
             return true;
         }
 
+        case WM_DISPLAYCHANGE:
+        {
+            UpdateRefreshInterval();
+            return false;
+        }
+
         case WM_ERASEBKGND:
         {
             // We render via swapchain; prevent GDI background erase to avoid flicker.
@@ -1193,7 +1624,28 @@ namespace FD2D
         case WM_CREATE:
         {
             // Create render target after the window is fully created
+            UpdateRefreshInterval();
             EnsureRenderTarget();
+            // Timers set before the window existed.
+            ArmTimerFallback();
+            result = 0;
+            return true;
+        }
+
+        case WM_TIMER:
+        {
+            if (wParam != kTimerFallbackId)
+            {
+                return false;
+            }
+            // Another pump is running (or ours is late): fire what is due.
+            (void)m_timers.Advance(Util::NowMs());
+            if (m_window != nullptr)
+            {
+                KillTimer(m_window, kTimerFallbackId);
+                m_timerFallbackDueMs = TimerWheel::kNoDeadline;
+                ArmTimerFallback();
+            }
             result = 0;
             return true;
         }
@@ -1243,45 +1695,13 @@ namespace FD2D
             return true;
         }
 
-        case WM_TIMER:
-        {
-            if (m_placeAutosaveTimerId != 0 && wParam == m_placeAutosaveTimerId)
-            {
-                // Avoid synchronous placement persistence during interactive resize.
-                // WM_EXITSIZEMOVE already performs a single final flush.
-                if (m_inSizeMove)
-                {
-                    if (m_window != nullptr)
-                    {
-                        (void)SetTimer(m_window, m_placeAutosaveTimerId, 200, nullptr);
-                    }
-                    result = 0;
-                    return true;
-                }
-
-                if (m_window != nullptr)
-                {
-                    KillTimer(m_window, m_placeAutosaveTimerId);
-                }
-                if (m_onWindowPlacementChanged && m_window != nullptr)
-                {
-                    m_onWindowPlacementChanged(m_window);
-                }
-                result = 0;
-                return true;
-            }
-            break;
-        }
-
         case WM_DESTROY:
         {
             // WM_CLOSE isn't guaranteed (e.g., DestroyWindow()); ensure we still persist once.
             InvokeBeforeDestroyOnce();
-            if (m_window != nullptr && m_placeAutosaveTimerId != 0)
-            {
-                KillTimer(m_window, m_placeAutosaveTimerId);
-                m_placeAutosaveTimerId = 0;
-            }
+            CancelTimer(m_placeAutosaveTimer);
+            CancelTimer(m_tipTimer);
+            CancelTimer(m_toastTimer);
             // HWND is about to become invalid; clear before any late Invalidate/Render.
             m_window = nullptr;
             PostQuitMessage(0);
@@ -1310,6 +1730,14 @@ namespace FD2D
             inputEvent.modifiers.middleButton = (wParam & MK_MBUTTON) != 0;
             inputEvent.modifiers.alt = (GetKeyState(VK_MENU) & 0x8000) != 0;
 
+            // Latency counts from when the input was queued (GetMessageTime,
+            // ms on the tick clock), not from when we got to it.
+            const unsigned long long inputNowUs = Util::NowUs();
+            const DWORD inputAgeMs = GetTickCount() - static_cast<DWORD>(GetMessageTime());
+            m_pacer.NoteInput((inputAgeMs < 1000 && inputNowUs > inputAgeMs * 1000ULL)
+                ? inputNowUs - inputAgeMs * 1000ULL
+                : inputNowUs);
+
             if (isMouseMessage && m_window != nullptr && message != WM_CAPTURECHANGED)
             {
                 POINT ptClient { GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam) };
@@ -1598,6 +2026,7 @@ namespace FD2D
     HRESULT Backplate::Attach(HWND windowHandle)
     {
         m_window = windowHandle;
+        UpdateRefreshInterval();
 
         RECT clientRect {};
         GetClientRect(m_window, &clientRect);
@@ -1639,6 +2068,7 @@ namespace FD2D
         }
 
         m_rendererId = (opts.rendererId != nullptr) ? opts.rendererId : L"";
+        m_presentMode = opts.presentMode;
 
         HWND window = CreateWindowExW(
             exStyle,
@@ -2002,6 +2432,32 @@ namespace FD2D
         scd.SwapEffect = DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL;
         scd.AlphaMode = DXGI_ALPHA_MODE_IGNORE;
 
+        // Present mode (see PresentMode).
+        const bool waitable = (m_presentMode == PresentMode::LowLatency || m_presentMode == PresentMode::Deadline);
+        bool tearing = false;
+        if (m_presentMode == PresentMode::Tearing)
+        {
+            Microsoft::WRL::ComPtr<IDXGIFactory5> factory5;
+            BOOL allowTearing = FALSE;
+            tearing = SUCCEEDED(dxgiFactory.As(&factory5)) &&
+                SUCCEEDED(factory5->CheckFeatureSupport(DXGI_FEATURE_PRESENT_ALLOW_TEARING, &allowTearing, sizeof(allowTearing))) &&
+                allowTearing;
+            if (!tearing)
+            {
+                FD2D_LOG_INFO("[Graphics] tearing not supported; presenting unsynchronized without it");
+            }
+        }
+        m_swapChainFlags =
+            (waitable ? DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT : 0) |
+            (tearing ? DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING : 0);
+        m_presentSyncInterval = (m_presentMode == PresentMode::Tearing) ? 0 : 1;
+        m_presentFlags = tearing ? DXGI_PRESENT_ALLOW_TEARING : 0;
+        if (m_presentMode != PresentMode::Vsync)
+        {
+            scd.SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD;
+        }
+        scd.Flags = m_swapChainFlags;
+
         hr = dxgiFactory->CreateSwapChainForHwnd(
             m_d3dDevice.Get(),
             m_window,
@@ -2009,11 +2465,34 @@ namespace FD2D
             nullptr,
             nullptr,
             &m_swapChain);
+        if (FAILED(hr) && scd.SwapEffect == DXGI_SWAP_EFFECT_FLIP_DISCARD)
+        {
+            // Flip-discard needs Windows 10; the flags work with flip-sequential.
+            scd.SwapEffect = DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL;
+            hr = dxgiFactory->CreateSwapChainForHwnd(
+                m_d3dDevice.Get(),
+                m_window,
+                &scd,
+                nullptr,
+                nullptr,
+                &m_swapChain);
+        }
         if (FAILED(hr))
         {
             return hr;
         }
 
+        if (waitable)
+        {
+            Microsoft::WRL::ComPtr<IDXGISwapChain2> swapChain2;
+            if (SUCCEEDED(m_swapChain.As(&swapChain2)))
+            {
+                (void)swapChain2->SetMaximumFrameLatency(1);
+                m_frameLatencyWaitable = swapChain2->GetFrameLatencyWaitableObject();
+                m_frameLatencySlotHeld = false;
+            }
+        }
+
         // Create D2D target bitmap from swap chain back buffer
         Microsoft::WRL::ComPtr<ID3D11Texture2D> backBufferTex;
         hr = m_swapChain->GetBuffer(0, IID_PPV_ARGS(&backBufferTex));
@@ -2048,41 +2527,261 @@ namespace FD2D
 
     void Backplate::DiscardD2DTargets()
     {
+        // The render thread presents this swap chain; stop it before any
+        // swapchain operation.
+        StopRenderThread();
+
         if (m_d2dContext)
         {
-            // Release swapchain backbuffer references held by D2D before any swapchain operations.
-            m_d2dContext->SetTarget(nullptr);
-            m_d2dContext->Flush();
+            // Release swapchain backbuffer references held by D2D before any swapchain operations.
+            m_d2dContext->SetTarget(nullptr);
+            m_d2dContext->Flush();
+        }
+
+        m_rtv.Reset();
+        m_d2dTargetBitmap.Reset();
+        m_offscreenBitmap.Reset();
+        m_offscreenRTV.Reset();
+        m_offscreenTexture.Reset();
+        m_offscreenD2DTarget.Reset();
+    }
+
+    void Backplate::DiscardDeviceResources()
+    {
+        DiscardD2DTargets();
+        AbandonComposedPixelReadbacks();
+
+        if (m_d3dContext)
+        {
+            // Force deferred destruction of swapchain-related resources before releasing the swapchain.
+            m_d3dContext->OMSetRenderTargets(0, nullptr, nullptr);
+            m_d3dContext->ClearState();
+            m_d3dContext->Flush();
+        }
+
+        if (m_frameLatencyWaitable != nullptr)
+        {
+            CloseHandle(m_frameLatencyWaitable);
+            m_frameLatencyWaitable = nullptr;
+        }
+        m_frameLatencySlotHeld = false;
+
+        m_d2dContext.Reset();
+        m_d2dDevice.Reset();
+        m_swapChain.Reset();
+        m_d3dContext.Reset();
+        m_d3dDevice.Reset();
+
+        m_hwndRenderTarget.Reset();
+        m_offscreenRT.Reset();
+        m_damageScissorState.Reset();
+        m_retainedFrameValid = false;
+    }
+
+    HRESULT Backplate::CreateOffscreenTarget(
+        Microsoft::WRL::ComPtr<ID3D11Texture2D>& texture,
+        Microsoft::WRL::ComPtr<ID3D11RenderTargetView>& rtv,
+        Microsoft::WRL::ComPtr<ID2D1Bitmap1>& d2dTarget)
+    {
+        if (!m_d3dDevice)
+        {
+            return E_UNEXPECTED;
+        }
+
+        D3D11_TEXTURE2D_DESC texDesc = {};
+        texDesc.Width = m_size.width;
+        texDesc.Height = m_size.height;
+        texDesc.MipLevels = 1;
+        texDesc.ArraySize = 1;
+        texDesc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
+        texDesc.SampleDesc.Count = 1;
+        texDesc.SampleDesc.Quality = 0;
+        texDesc.Usage = D3D11_USAGE_DEFAULT;
+        texDesc.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
+        texDesc.CPUAccessFlags = 0;
+        texDesc.MiscFlags = 0;
+
+        HRESULT hr = m_d3dDevice->CreateTexture2D(&texDesc, nullptr, &texture);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+        (void)m_d3dDevice->CreateRenderTargetView(texture.Get(), nullptr, &rtv);
+
+        // Create D2D bitmap from offscreen texture
+        if (m_d2dContext && texture)
+        {
+            Microsoft::WRL::ComPtr<IDXGISurface> surface;
+            if (SUCCEEDED(texture.As(&surface)))
+            {
+                // Off-screen texture needs PREMULTIPLIED alpha (can be used as both target and source)
+                D2D1_BITMAP_PROPERTIES1 bp = {};
+                bp.pixelFormat.format = DXGI_FORMAT_B8G8R8A8_UNORM;
+                bp.pixelFormat.alphaMode = D2D1_ALPHA_MODE_PREMULTIPLIED;
+                m_d2dContext->GetDpi(&bp.dpiX, &bp.dpiY);
+                bp.bitmapOptions = D2D1_BITMAP_OPTIONS_TARGET;
+
+                hr = m_d2dContext->CreateBitmapFromDxgiSurface(
+                    surface.Get(),
+                    &bp,
+                    &d2dTarget);
+            }
+        }
+        return hr;
+    }
+
+    bool Backplate::SetRenderThreadEnabled(bool enable)
+    {
+        if (!enable)
+        {
+            m_renderThreadEnabled = false;
+            StopRenderThread();
+            return true;
+        }
+
+        Microsoft::WRL::ComPtr<ID2D1Multithread> lock {};
+        ID2D1Factory* factory = Core::D2DFactory();
+        if (!factory || FAILED(factory->QueryInterface(IID_PPV_ARGS(&lock))) || !lock->GetMultithreadProtected())
+        {
+            FD2D_LOG_INFO("[Render] render thread needs a multithreaded D2D factory; staying on the UI thread");
+            return false;
+        }
+
+        m_renderThreadEnabled = true;
+        if (m_window)
+        {
+            InvalidateRect(m_window, nullptr, FALSE);
+        }
+        return true;
+    }
+
+    void Backplate::SetPresentMode(PresentMode mode)
+    {
+        if (mode == m_presentMode)
+        {
+            return;
+        }
+
+        m_presentMode = mode;
+        if (m_swapChain)
+        {
+            // Swap effect and flags are fixed at creation.
+            DiscardDeviceResources();
+            if (m_window)
+            {
+                InvalidateRect(m_window, nullptr, FALSE);
+            }
+        }
+    }
+
+    bool Backplate::EnsureRenderThread()
+    {
+        if (m_renderThread)
+        {
+            return true;
+        }
+        if (!m_swapChain || !m_d3dContext)
+        {
+            return false;
+        }
+
+        Microsoft::WRL::ComPtr<ID2D1Multithread> lock {};
+        ID2D1Factory* factory = Core::D2DFactory();
+        if (!factory || FAILED(factory->QueryInterface(IID_PPV_ARGS(&lock))) || !lock->GetMultithreadProtected())
+        {
+            return false;
+        }
+
+        // Both threads use the immediate context (UI: drawing, render thread:
+        // copy + Present); let D3D serialize the individual calls.
+        Microsoft::WRL::ComPtr<ID3D11Multithread> d3dLock {};
+        if (SUCCEEDED(m_d3dContext.As(&d3dLock)) && d3dLock)
+        {
+            (void)d3dLock->SetMultithreadProtected(TRUE);
+        }
+
+        if (!m_renderThreadHr)
+        {
+            m_renderThreadHr = std::make_shared<std::atomic<HRESULT>>(S_FALSE);
+        }
+        if (!m_renderThreadPresentUs)
+        {
+            m_renderThreadPresentUs = std::make_shared<std::atomic<std::uint64_t>>(0);
         }
+        m_renderThreadLock = lock;
 
-        m_rtv.Reset();
-        m_d2dTargetBitmap.Reset();
-        m_offscreenBitmap.Reset();
-        m_offscreenRTV.Reset();
-        m_offscreenTexture.Reset();
-        m_offscreenD2DTarget.Reset();
+        // Captured by value: the render thread never touches the Backplate,
+        // only the published slot and these device objects.
+        // The frame-latency wait moves with Present; the waitable handle
+        // outlives the thread (closed in DiscardDeviceResources).
+        Microsoft::WRL::ComPtr<IDXGISwapChain1> swapChain = m_swapChain;
+        Microsoft::WRL::ComPtr<ID3D11DeviceContext> context = m_d3dContext;
+        std::shared_ptr<std::atomic<HRESULT>> result = m_renderThreadHr;
+        std::shared_ptr<std::atomic<std::uint64_t>> presentedUs = m_renderThreadPresentUs;
+        const HANDLE latencyWaitable = m_frameLatencyWaitable;
+        bool slotHeld = m_frameLatencySlotHeld;
+        m_frameLatencySlotHeld = false;
+        const UINT syncInterval = m_presentSyncInterval;
+        const UINT presentFlags = m_presentFlags;
+        m_renderThread = std::make_unique<RenderThread<PresentSlot>>(
+            [swapChain, context, lock, result, presentedUs, latencyWaitable, slotHeld, syncInterval, presentFlags](PresentSlot& slot) mutable
+            {
+                if (!slot.texture)
+                {
+                    return;
+                }
+
+                if (latencyWaitable != nullptr && !slotHeld)
+                {
+                    (void)WaitForSingleObjectEx(latencyWaitable, 100, FALSE);
+                }
+                slotHeld = false;
+
+                // D2D drives the same context from the UI thread; hold its
+                // lock so the copy cannot land inside one of its batches.
+                lock->Enter();
+                Microsoft::WRL::ComPtr<ID3D11Texture2D> backBuffer {};
+                HRESULT hr = swapChain->GetBuffer(0, IID_PPV_ARGS(&backBuffer));
+                if (SUCCEEDED(hr))
+                {
+                    context->CopyResource(backBuffer.Get(), slot.texture.Get());
+                    backBuffer.Reset();
+                    hr = swapChain->Present(syncInterval, presentFlags);
+                }
+                lock->Leave();
+
+                if (SUCCEEDED(hr))
+                {
+                    presentedUs->store(Util::NowUs());
+                }
+
+                // Keep a failure until the UI thread has seen it.
+                if (!FAILED(result->load()))
+                {
+                    result->store(hr);
+                }
+            });
+        FD2D_LOG_INFO("[Render] render thread started");
+        return true;
     }
 
-    void Backplate::DiscardDeviceResources()
+    void Backplate::StopRenderThread()
     {
-        DiscardD2DTargets();
-
-        if (m_d3dContext)
+        if (!m_renderThread)
         {
-            // Force deferred destruction of swapchain-related resources before releasing the swapchain.
-            m_d3dContext->OMSetRenderTargets(0, nullptr, nullptr);
-            m_d3dContext->ClearState();
-            m_d3dContext->Flush();
+            return;
         }
 
-        m_d2dContext.Reset();
-        m_d2dDevice.Reset();
-        m_swapChain.Reset();
-        m_d3dContext.Reset();
-        m_d3dDevice.Reset();
+        // Joins after the frame being presented, if any.
+        m_renderThread.reset();
+        m_renderThreadLock.Reset();
 
-        m_hwndRenderTarget.Reset();
-        m_offscreenRT.Reset();
+        // m_offscreen* aliased a mailbox slot; a dedicated target is created
+        // on demand, and nothing retained survives the switch.
+        m_offscreenTexture.Reset();
+        m_offscreenRTV.Reset();
+        m_offscreenD2DTarget.Reset();
+        m_retainedFrameValid = false;
     }
 
     void Backplate::Resize(UINT width, UINT height)
@@ -2113,11 +2812,12 @@ namespace FD2D
             }
             else if (m_swapChain && m_d2dContext)
             {
+                StopRenderThread();
                 m_d2dTargetBitmap.Reset();
                 (void)m_d2dContext->SetTarget(nullptr);
                 m_rtv.Reset();
 
-                const HRESULT hrResize = m_swapChain->ResizeBuffers(0, m_size.width, m_size.height, DXGI_FORMAT_UNKNOWN, 0);
+                const HRESULT hrResize = m_swapChain->ResizeBuffers(0, m_size.width, m_size.height, DXGI_FORMAT_UNKNOWN, m_swapChainFlags);
                 if (HandleDeviceLostHr(hrResize, "ResizeBuffers(inSizeMove)"))
                 {
                     // Device discarded; recover on the next frame.
@@ -2163,6 +2863,7 @@ namespace FD2D
         }
         else if (m_swapChain && m_d2dContext)
         {
+            StopRenderThread();
             m_d2dTargetBitmap.Reset();
             (void)m_d2dContext->SetTarget(nullptr);
             m_rtv.Reset();
@@ -2174,7 +2875,7 @@ namespace FD2D
             m_offscreenResizePending = false;
 
             // Resize swap chain buffers (same device resources — do NOT bump content generations)
-            const HRESULT hrResize = m_swapChain->ResizeBuffers(0, m_size.width, m_size.height, DXGI_FORMAT_UNKNOWN, 0);
+            const HRESULT hrResize = m_swapChain->ResizeBuffers(0, m_size.width, m_size.height, DXGI_FORMAT_UNKNOWN, m_swapChainFlags);
             if (HandleDeviceLostHr(hrResize, "ResizeBuffers"))
             {
                 m_layoutDirty = true;
@@ -2310,23 +3011,16 @@ namespace FD2D
         }
     }
 
-    HRESULT Backplate::ReadComposedPixels(
-        const D2D1_RECT_F& logicalRect,
-        std::vector<std::uint8_t>& pixels,
-        UINT& width,
-        UINT& height,
-        UINT& stride)
+    HRESULT Backplate::QueueComposedPixelCopy(const D2D1_RECT_F& logicalRect, ReadbackSlot*& slot, ReadbackSlot* overflow)
     {
-        pixels.clear();
-        width = 0;
-        height = 0;
-        stride = 0;
+        slot = nullptr;
 
         if (!m_d3dDevice || !m_d3dContext)
         {
             return E_NOINTERFACE;
         }
-        if (!m_useOffscreenBuffer ||
+        if (!m_window ||
+            !m_useOffscreenBuffer ||
             m_inSizeMove ||
             !m_offscreenTexture)
         {
@@ -2372,28 +3066,68 @@ namespace FD2D
             return E_INVALIDARG;
         }
 
-        width = static_cast<UINT>(right - left);
-        height = static_cast<UINT>(bottom - top);
-        stride = width * 4;
+        const UINT width = static_cast<UINT>(right - left);
+        const UINT height = static_cast<UINT>(bottom - top);
 
-        D3D11_TEXTURE2D_DESC stagingDesc {};
-        stagingDesc.Width = width;
-        stagingDesc.Height = height;
-        stagingDesc.MipLevels = 1;
-        stagingDesc.ArraySize = 1;
-        stagingDesc.Format = sourceDesc.Format;
-        stagingDesc.SampleDesc.Count = 1;
-        stagingDesc.Usage = D3D11_USAGE_STAGING;
-        stagingDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
-
-        Microsoft::WRL::ComPtr<ID3D11Texture2D> staging;
-        HRESULT result = m_d3dDevice->CreateTexture2D(
-            &stagingDesc,
-            nullptr,
-            &staging);
-        if (FAILED(result))
+        // Prefer an idle slot whose staging texture already has the requested
+        // size (repeated thumbnail/screenshot captures of the same region), then
+        // any idle slot, which is (re)allocated at the new size.
+        ReadbackSlot* chosen = nullptr;
+        for (auto& candidate : m_readbackRing)
         {
-            return result;
+            if (!candidate.inFlight && candidate.staging &&
+                candidate.width == width && candidate.height == height)
+            {
+                chosen = &candidate;
+                break;
+            }
+        }
+        if (!chosen)
+        {
+            for (auto& candidate : m_readbackRing)
+            {
+                if (!candidate.inFlight)
+                {
+                    chosen = &candidate;
+                    break;
+                }
+            }
+        }
+        if (!chosen)
+        {
+            if (!overflow)
+            {
+                return HRESULT_FROM_WIN32(ERROR_BUSY);
+            }
+            chosen = overflow;
+        }
+
+        if (!chosen->staging || chosen->width != width || chosen->height != height)
+        {
+            chosen->staging.Reset();
+            chosen->width = 0;
+            chosen->height = 0;
+
+            D3D11_TEXTURE2D_DESC stagingDesc {};
+            stagingDesc.Width = width;
+            stagingDesc.Height = height;
+            stagingDesc.MipLevels = 1;
+            stagingDesc.ArraySize = 1;
+            stagingDesc.Format = sourceDesc.Format;
+            stagingDesc.SampleDesc.Count = 1;
+            stagingDesc.Usage = D3D11_USAGE_STAGING;
+            stagingDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+
+            HRESULT hr = m_d3dDevice->CreateTexture2D(
+                &stagingDesc,
+                nullptr,
+                &chosen->staging);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+            chosen->width = width;
+            chosen->height = height;
         }
 
         D3D11_BOX sourceBox {};
@@ -2404,7 +3138,7 @@ namespace FD2D
         sourceBox.bottom = static_cast<UINT>(bottom);
         sourceBox.back = 1;
         m_d3dContext->CopySubresourceRegion(
-            staging.Get(),
+            chosen->staging.Get(),
             0,
             0,
             0,
@@ -2413,9 +3147,37 @@ namespace FD2D
             0,
             &sourceBox);
 
+        slot = chosen;
+        return S_OK;
+    }
+
+    HRESULT Backplate::ReadComposedPixels(
+        const D2D1_RECT_F& logicalRect,
+        std::vector<std::uint8_t>& pixels,
+        UINT& width,
+        UINT& height,
+        UINT& stride)
+    {
+        pixels.clear();
+        width = 0;
+        height = 0;
+        stride = 0;
+
+        // With every ring slot waiting on an async readback, copy through a
+        // one-off staging texture rather than fail.
+        ReadbackSlot overflow {};
+        ReadbackSlot* slot = nullptr;
+        HRESULT result = QueueComposedPixelCopy(logicalRect, slot, &overflow);
+        if (FAILED(result))
+        {
+            return result;
+        }
+
+        // Synchronous path: blocking Map (stalls until the GPU has finished the
+        // copy). A ring staging texture stays in the ring for reuse.
         D3D11_MAPPED_SUBRESOURCE mapped {};
         result = m_d3dContext->Map(
-            staging.Get(),
+            slot->staging.Get(),
             0,
             D3D11_MAP_READ,
             0,
@@ -2425,21 +3187,169 @@ namespace FD2D
             return result;
         }
 
+        width = slot->width;
+        height = slot->height;
+        stride = width * 4;
         pixels.resize(
             static_cast<std::size_t>(stride) * height);
-        for (UINT row = 0; row < height; ++row)
+        Pixels::CopyRows(
+            pixels.data(),
+            stride,
+            static_cast<const std::uint8_t*>(mapped.pData),
+            mapped.RowPitch,
+            stride,
+            height);
+        m_d3dContext->Unmap(slot->staging.Get(), 0);
+        return S_OK;
+    }
+
+    HRESULT Backplate::ReadComposedPixelsAsync(
+        const D2D1_RECT_F& logicalRect,
+        ComposedPixelsCallback callback)
+    {
+        if (!callback)
+        {
+            return E_INVALIDARG;
+        }
+
+        ReadbackSlot* slot = nullptr;
+        const HRESULT hr = QueueComposedPixelCopy(logicalRect, slot);
+        if (FAILED(hr))
         {
-            std::memcpy(
-                pixels.data() +
-                    static_cast<std::size_t>(row) * stride,
-                static_cast<const std::uint8_t*>(mapped.pData) +
-                    static_cast<std::size_t>(row) * mapped.RowPitch,
-                stride);
+            return hr;
         }
-        m_d3dContext->Unmap(staging.Get(), 0);
+
+        slot->inFlight = true;
+        slot->callback = std::move(callback);
+
+        // Make sure the copy is submitted now rather than with the next frame,
+        // and keep the animation tick alive so the slot gets polled.
+        m_d3dContext->Flush();
+        RequestAnimationFrame();
         return S_OK;
     }
 
+    void Backplate::PollComposedPixelReadbacks()
+    {
+        if (!m_abandonedReadbacks.empty())
+        {
+            std::vector<ComposedPixelsCallback> abandoned;
+            abandoned.swap(m_abandonedReadbacks);
+            for (auto& callback : abandoned)
+            {
+                if (callback)
+                {
+                    callback(DXGI_ERROR_DEVICE_REMOVED, ComposedPixels {});
+                }
+            }
+        }
+
+        bool stillPending = false;
+        for (auto& slot : m_readbackRing)
+        {
+            if (!slot.inFlight)
+            {
+                continue;
+            }
+
+            ComposedPixels result {};
+            HRESULT hr = E_UNEXPECTED;
+            if (m_d3dContext && slot.staging)
+            {
+                D3D11_MAPPED_SUBRESOURCE mapped {};
+                hr = m_d3dContext->Map(
+                    slot.staging.Get(),
+                    0,
+                    D3D11_MAP_READ,
+                    D3D11_MAP_FLAG_DO_NOT_WAIT,
+                    &mapped);
+                if (hr == DXGI_ERROR_WAS_STILL_DRAWING)
+                {
+                    stillPending = true;
+                    continue;
+                }
+                if (SUCCEEDED(hr))
+                {
+                    result.width = slot.width;
+                    result.height = slot.height;
+                    result.stride = slot.width * 4;
+                    result.pixels.resize(
+                        static_cast<std::size_t>(result.stride) * result.height);
+                    Pixels::CopyRows(
+                        result.pixels.data(),
+                        result.stride,
+                        static_cast<const std::uint8_t*>(mapped.pData),
+                        mapped.RowPitch,
+                        result.stride,
+                        result.height);
+                    m_d3dContext->Unmap(slot.staging.Get(), 0);
+                }
+            }
+
+            // Release the slot before invoking the callback so it can queue
+            // another readback (e.g. capture-per-frame loops).
+            ComposedPixelsCallback callback = std::move(slot.callback);
+            slot.callback = nullptr;
+            slot.inFlight = false;
+            if (callback)
+            {
+                callback(hr, std::move(result));
+            }
+        }
+
+        if (stillPending)
+        {
+            RequestAnimationFrame();
+        }
+    }
+
+    void Backplate::AbandonComposedPixelReadbacks()
+    {
+        for (auto& slot : m_readbackRing)
+        {
+            if (slot.inFlight && slot.callback)
+            {
+                m_abandonedReadbacks.push_back(std::move(slot.callback));
+            }
+            slot = ReadbackSlot {};
+        }
+
+        if (!m_abandonedReadbacks.empty())
+        {
+            RequestAnimationFrame();
+        }
+    }
+
+    void Backplate::CancelComposedPixelReadbacks()
+    {
+        // Teardown: nothing polls the ring after this, so every pending
+        // callback is told now instead of being dropped. Collect them first;
+        // a callback cannot queue another readback (no window any more).
+        std::vector<ComposedPixelsCallback> abandoned;
+        abandoned.swap(m_abandonedReadbacks);
+        std::vector<ComposedPixelsCallback> cancelled;
+        for (auto& slot : m_readbackRing)
+        {
+            if (slot.inFlight && slot.callback)
+            {
+                cancelled.push_back(std::move(slot.callback));
+            }
+            slot = ReadbackSlot {};
+        }
+
+        for (auto& callback : abandoned)
+        {
+            if (callback)
+            {
+                callback(DXGI_ERROR_DEVICE_REMOVED, ComposedPixels {});
+            }
+        }
+        for (auto& callback : cancelled)
+        {
+            callback(E_ABORT, ComposedPixels {});
+        }
+    }
+
     void Backplate::Render()
     {
         // Prevent recursive rendering (e.g., layout changes during OnRender triggering Invalidate)
@@ -2454,37 +3364,84 @@ namespace FD2D
             return;
         }
 
+        // Scratch from the previous frame (and from layout run between
+        // frames) is dead by now.
+        m_scratchArena.Reset();
+
         // Always clear m_isRendering, including early returns (e.g. D2DERR_RECREATE_TARGET).
+        // Also records the frame time for GetFrameStats().
         struct RenderingGuard
         {
             Backplate& self;
+            unsigned long long startUs { 0 };
             explicit RenderingGuard(Backplate& s)
                 : self(s)
+                , startUs(Util::NowUs())
             {
                 self.m_isRendering = true;
             }
             ~RenderingGuard()
             {
                 self.m_isRendering = false;
+                const unsigned long long frameUs = Util::NowUs() - startUs;
+                FrameStats& stats = self.m_frameStats;
+                ++stats.frames;
+                stats.lastFrameUs = frameUs;
+                stats.maxFrameUs = (std::max)(stats.maxFrameUs, frameUs);
+                stats.totalFrameUs += frameUs;
+                self.m_pacer.OnFrameRendered(frameUs);
             }
         } renderingGuard(*this);
 
+        // Background pool work holds off until this frame is done.
+        struct ExecutorFrameGuard
+        {
+            std::shared_ptr<Executor> executor;
+            explicit ExecutorFrameGuard(std::shared_ptr<Executor> e)
+                : executor(std::move(e))
+            {
+                if (executor)
+                {
+                    executor->BeginFrame();
+                }
+            }
+            ~ExecutorFrameGuard()
+            {
+                if (executor)
+                {
+                    executor->EndFrame();
+                }
+            }
+        } executorFrameGuard(m_executor);
+
         // Diagnostic: snapshot+reset what triggered this call and whether an async
         // decode-completion redraw was already pending, for the [FPS] summary below.
         const RenderTrigger renderTrigger = m_pendingRenderTrigger;
         m_pendingRenderTrigger = RenderTrigger::Other;
-        const bool asyncPendingAtStart = m_asyncRedrawPending.load();
+        const bool asyncPendingAtStart = AsyncRedrawPending();
 
         // Render loop: continue until no more render requests
         int renderLoopIterations = 0;
+        bool lastFrameDamageOnly = false;
         const auto t_renderLoop = std::chrono::steady_clock::now();
         do
         {
             ++renderLoopIterations;
+            ++m_frameIndex;
+            m_frameTimeMs = Util::NowMs();
             m_renderRequested = false;
             m_renderSurfaceSize = m_size;
             m_logicalToRenderScale = D2D1::SizeF(1.0f, 1.0f);
 
+            // Damage-only frame (see ProcessAnimationTick): repaint just
+            // m_tickDamage over the previous frame kept in the offscreen
+            // buffer. Each path below drops to a full frame when that buffer
+            // is not retained; a re-render requested mid-frame is always full.
+            bool damageOnly = m_tickDamageValid && renderLoopIterations == 1;
+            m_tickDamageValid = false;
+            const bool retainedFrame = m_retainedFrameValid;
+            m_retainedFrameValid = false;
+
             const auto updateRenderMapping = [this](UINT surfaceW, UINT surfaceH)
             {
                 if (surfaceW == 0 || surfaceH == 0)
@@ -2520,6 +3477,7 @@ namespace FD2D
             if (m_layoutDirty)
             {
                 Layout();
+                damageOnly = false;
             }
             const auto t_ensure = std::chrono::steady_clock::now();
             HRESULT hrEnsure = EnsureRenderTarget();
@@ -2550,6 +3508,7 @@ namespace FD2D
 
             // During live resize, avoid off-screen path to reduce realloc/copy overhead.
             const bool useOffscreenThisFrame = m_useOffscreenBuffer && !m_inSizeMove;
+            damageOnly = damageOnly && retainedFrame && useOffscreenThisFrame && m_offscreenRT;
             if (useOffscreenThisFrame)
             {
                 if (!m_offscreenRT)
@@ -2581,17 +3540,23 @@ namespace FD2D
 
             renderTarget->BeginDraw();
             renderTarget->SetTransform(D2D1::Matrix3x2F::Identity());
+            if (damageOnly)
+            {
+                renderTarget->PushAxisAlignedClip(m_tickDamage, D2D1_ANTIALIAS_MODE_ALIASED);
+            }
             // Dark neutral gray with a *tiny* blue bias (low saturation)
             renderTarget->Clear(m_clearColor);
             renderTarget->SetTransform(logicalToRender);
 
+            m_cullToDamage = damageOnly;
             for (const auto& child : m_childrenOrdered)
             {
-                if (child)
+                if (child && !OutsideRenderDamage(child->LayoutRect()))
                 {
                     child->OnRender(renderTarget);
                 }
             }
+            m_cullToDamage = false;
             RenderOverlayLayer(renderTarget, OverlayLayer::Chrome);
             RenderOverlayLayer(renderTarget, OverlayLayer::Inspector);
             RenderOverlayLayer(renderTarget, OverlayLayer::Popup);
@@ -2602,6 +3567,10 @@ namespace FD2D
             DrawHoverAndToast(renderTarget, !transientOverlay, false);
             RenderOverlayLayer(renderTarget, OverlayLayer::Modal);
             DrawHoverAndToast(renderTarget, false, true);
+            if (damageOnly)
+            {
+                renderTarget->PopAxisAlignedClip();
+            }
 
             HRESULT hr = renderTarget->EndDraw();
             if (hr == D2DERR_RECREATE_TARGET)
@@ -2612,6 +3581,7 @@ namespace FD2D
                 ScheduleNextFrame();
                 return;
             }
+            m_retainedFrameValid = SUCCEEDED(hr) && useOffscreenThisFrame && m_offscreenRT;
 
             // Copy offscreen buffer to window if double-buffering is active
             if (useOffscreenThisFrame && m_offscreenRT)
@@ -2644,54 +3614,81 @@ namespace FD2D
                 }
             }
             
+            // EndDraw presented the frame.
+            m_pacer.NotePresented(Util::NowUs());
+
             // D2D-only path complete - continue to check if re-render needed
         }
         else
         {
+        // Failures (device loss) and occlusion reported by the render thread.
+        if (m_renderThreadHr)
+        {
+            const HRESULT threadHr = m_renderThreadHr->exchange(S_FALSE);
+            if (threadHr != S_FALSE)
+            {
+                m_occluded = (threadHr == DXGI_STATUS_OCCLUDED);
+                if (HandleDeviceLostHr(threadHr, "SwapChain::Present (render thread)"))
+                {
+                    return;
+                }
+            }
+        }
+        if (m_renderThreadPresentUs)
+        {
+            const std::uint64_t presentedUs = m_renderThreadPresentUs->exchange(0);
+            if (presentedUs != 0)
+            {
+                m_pacer.NotePresented(presentedUs);
+            }
+        }
+
         // Create D3D11 off-screen resources if enabled
         const bool useOffscreenThisFrame = m_useOffscreenBuffer && !m_inSizeMove;
+
+        // Render-thread mode: draw into the mailbox's back slot, which the
+        // render thread presents once published. The slot holds an older
+        // frame than the last one, so nothing can be retained from it.
+        const bool presentOnThread =
+            m_renderThreadEnabled && useOffscreenThisFrame &&
+            m_size.width > 0 && m_size.height > 0 && EnsureRenderThread();
+        if (!presentOnThread)
+        {
+            StopRenderThread(); // e.g. live resize started
+        }
+        else
+        {
+            PresentSlot& slot = m_renderThread->Back();
+            D3D11_TEXTURE2D_DESC slotDesc {};
+            if (slot.texture)
+            {
+                slot.texture->GetDesc(&slotDesc);
+            }
+            if (!slot.texture || !slot.rtv || !slot.d2dTarget ||
+                slotDesc.Width != m_size.width || slotDesc.Height != m_size.height)
+            {
+                slot = {};
+                (void)CreateOffscreenTarget(slot.texture, slot.rtv, slot.d2dTarget);
+            }
+            m_offscreenTexture = slot.texture;
+            m_offscreenRTV = slot.rtv;
+            m_offscreenD2DTarget = slot.d2dTarget;
+        }
+
+        // Low-latency modes: start drawing only once the swap chain can take
+        // the frame (the render thread does its own wait).
+        if (!presentOnThread)
+        {
+            WaitForFrameLatency();
+        }
+
+        damageOnly = damageOnly && !presentOnThread && retainedFrame && useOffscreenThisFrame && m_d3dContext &&
+            m_offscreenTexture && m_offscreenRTV && m_offscreenD2DTarget;
         if (useOffscreenThisFrame && m_d3dDevice && m_size.width > 0 && m_size.height > 0)
         {
             if (!m_offscreenTexture || !m_offscreenRTV)
             {
-                // Create off-screen texture
-                D3D11_TEXTURE2D_DESC texDesc = {};
-                texDesc.Width = m_size.width;
-                texDesc.Height = m_size.height;
-                texDesc.MipLevels = 1;
-                texDesc.ArraySize = 1;
-                texDesc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
-                texDesc.SampleDesc.Count = 1;
-                texDesc.SampleDesc.Quality = 0;
-                texDesc.Usage = D3D11_USAGE_DEFAULT;
-                texDesc.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
-                texDesc.CPUAccessFlags = 0;
-                texDesc.MiscFlags = 0;
-
-                if (SUCCEEDED(m_d3dDevice->CreateTexture2D(&texDesc, nullptr, &m_offscreenTexture)))
-                {
-                    (void)m_d3dDevice->CreateRenderTargetView(m_offscreenTexture.Get(), nullptr, &m_offscreenRTV);
-                    
-                    // Create D2D bitmap from offscreen texture
-                    if (m_d2dContext && m_offscreenTexture)
-                    {
-                        Microsoft::WRL::ComPtr<IDXGISurface> surface;
-                        if (SUCCEEDED(m_offscreenTexture.As(&surface)))
-                        {
-                            // Off-screen texture needs PREMULTIPLIED alpha (can be used as both target and source)
-                            D2D1_BITMAP_PROPERTIES1 bp = {};
-                            bp.pixelFormat.format = DXGI_FORMAT_B8G8R8A8_UNORM;
-                            bp.pixelFormat.alphaMode = D2D1_ALPHA_MODE_PREMULTIPLIED;
-                            m_d2dContext->GetDpi(&bp.dpiX, &bp.dpiY);
-                            bp.bitmapOptions = D2D1_BITMAP_OPTIONS_TARGET;
-                            
-                            (void)m_d2dContext->CreateBitmapFromDxgiSurface(
-                                surface.Get(),
-                                &bp,
-                                &m_offscreenD2DTarget);
-                        }
-                    }
-                }
+                (void)CreateOffscreenTarget(m_offscreenTexture, m_offscreenRTV, m_offscreenD2DTarget);
             }
         }
 
@@ -2724,9 +3721,44 @@ namespace FD2D
         {
             const float clearColor[4] = { m_clearColor.r, m_clearColor.g, m_clearColor.b, m_clearColor.a };
             m_d3dContext->OMSetRenderTargets(1, &d3dRenderTarget, nullptr);
-            m_d3dContext->ClearRenderTargetView(d3dRenderTarget, clearColor);
             m_activeD3DRenderTarget = d3dRenderTarget;
 
+            // Damage-only: clear and scissor to the damaged rect (GPU images
+            // intersect their own scissor with it); the rest of the offscreen
+            // texture keeps the previous frame.
+            D3D11_RECT damageRect {};
+            Microsoft::WRL::ComPtr<ID3D11DeviceContext1> context1 {};
+            if (damageOnly)
+            {
+                damageRect.left = (std::max)(0L, static_cast<LONG>(m_tickDamage.left));
+                damageRect.top = (std::max)(0L, static_cast<LONG>(m_tickDamage.top));
+                damageRect.right = (std::min)(static_cast<LONG>(m_renderSurfaceSize.width), static_cast<LONG>(m_tickDamage.right));
+                damageRect.bottom = (std::min)(static_cast<LONG>(m_renderSurfaceSize.height), static_cast<LONG>(m_tickDamage.bottom));
+
+                if (!m_damageScissorState && m_d3dDevice)
+                {
+                    D3D11_RASTERIZER_DESC rd {};
+                    rd.FillMode = D3D11_FILL_SOLID;
+                    rd.CullMode = D3D11_CULL_NONE;
+                    rd.DepthClipEnable = TRUE;
+                    rd.ScissorEnable = TRUE;
+                    (void)m_d3dDevice->CreateRasterizerState(&rd, &m_damageScissorState);
+                }
+                damageOnly =
+                    damageRect.right > damageRect.left && damageRect.bottom > damageRect.top &&
+                    m_damageScissorState && SUCCEEDED(m_d3dContext.As(&context1)) && context1;
+            }
+            if (damageOnly)
+            {
+                context1->ClearView(d3dRenderTarget, clearColor, &damageRect, 1);
+                m_d3dContext->RSSetState(m_damageScissorState.Get());
+                m_d3dContext->RSSetScissorRects(1, &damageRect);
+            }
+            else
+            {
+                m_d3dContext->ClearRenderTargetView(d3dRenderTarget, clearColor);
+            }
+
             D3D11_VIEWPORT vp {};
             vp.TopLeftX = 0.0f;
             vp.TopLeftY = 0.0f;
@@ -2737,13 +3769,20 @@ namespace FD2D
             m_d3dContext->RSSetViewports(1, &vp);
 
             const auto t_d3dPass = std::chrono::steady_clock::now();
+            m_cullToDamage = damageOnly;
             for (const auto& child : m_childrenOrdered)
             {
-                if (child)
+                if (child && !OutsideRenderDamage(child->LayoutRect()))
                 {
                     child->OnRenderD3D(m_d3dContext.Get());
                 }
             }
+            m_cullToDamage = false;
+            if (damageOnly)
+            {
+                m_d3dContext->RSSetScissorRects(0, nullptr);
+                m_d3dContext->RSSetState(nullptr);
+            }
             {
                 const auto d3dPassMs = FD2D_ELAPSED_MS(t_d3dPass);
                 if (d3dPassMs > 30)
@@ -2782,17 +3821,24 @@ namespace FD2D
         }
 
         m_d2dContext->BeginDraw();
+        if (damageOnly)
+        {
+            m_d2dContext->SetTransform(D2D1::Matrix3x2F::Identity());
+            m_d2dContext->PushAxisAlignedClip(m_tickDamage, D2D1_ANTIALIAS_MODE_ALIASED);
+        }
         m_d2dContext->SetTransform(D2D1::Matrix3x2F::Scale(
             m_logicalToRenderScale.width,
             m_logicalToRenderScale.height));
 
+        m_cullToDamage = damageOnly;
         for (const auto& child : m_childrenOrdered)
         {
-            if (child)
+            if (child && !OutsideRenderDamage(child->LayoutRect()))
             {
                 child->OnRender(m_d2dContext.Get());
             }
         }
+        m_cullToDamage = false;
         RenderOverlayLayer(m_d2dContext.Get(), OverlayLayer::Chrome);
         RenderOverlayLayer(m_d2dContext.Get(), OverlayLayer::Inspector);
         RenderOverlayLayer(m_d2dContext.Get(), OverlayLayer::Popup);
@@ -2803,9 +3849,14 @@ namespace FD2D
         DrawHoverAndToast(m_d2dContext.Get(), !transientOverlay, false);
         RenderOverlayLayer(m_d2dContext.Get(), OverlayLayer::Modal);
         DrawHoverAndToast(m_d2dContext.Get(), false, true);
+        if (damageOnly)
+        {
+            m_d2dContext->PopAxisAlignedClip();
+        }
 
         const auto t_endDraw = std::chrono::steady_clock::now();
         HRESULT hr = m_d2dContext->EndDraw();
+        m_retainedFrameValid = SUCCEEDED(hr) && useOffscreenThisFrame && m_offscreenD2DTarget && !presentOnThread;
         {
             const auto endDrawMs = FD2D_ELAPSED_MS(t_endDraw);
             if (endDrawMs > 30)
@@ -2814,8 +3865,9 @@ namespace FD2D
             }
         }
         
-        // Copy offscreen to swap chain backbuffer if double-buffering
-        if (SUCCEEDED(hr) && useOffscreenThisFrame && m_offscreenD2DTarget && m_d2dTargetBitmap)
+        // Copy offscreen to swap chain backbuffer if double-buffering (the
+        // render thread does this itself)
+        if (SUCCEEDED(hr) && !presentOnThread && useOffscreenThisFrame && m_offscreenD2DTarget && m_d2dTargetBitmap)
         {
             m_d2dContext->SetTarget(m_d2dTargetBitmap.Get());
             m_d2dContext->BeginDraw();
@@ -2860,14 +3912,30 @@ namespace FD2D
             m_d2dContext->SetTarget(nullptr);
         }
 
-        if (m_swapChain)
+        if (presentOnThread)
+        {
+            if (d2dOk && m_renderThread)
+            {
+                // The latency sample closes when the render thread reports
+                // the present, picked up at the start of a later frame.
+                m_renderThread->Publish();
+            }
+        }
+        else if (m_swapChain)
         {
             const auto t_present = std::chrono::steady_clock::now();
-            const HRESULT hrPresent = m_swapChain->Present(1, 0);
+            const HRESULT hrPresent = m_swapChain->Present(m_presentSyncInterval, m_presentFlags);
+            m_frameLatencySlotHeld = false;
+            m_occluded = (hrPresent == DXGI_STATUS_OCCLUDED);
+            m_pacer.NotePresented(Util::NowUs());
             const auto presentMs = FD2D_ELAPSED_MS(t_present);
             if (presentMs > 30)
             {
-                FD2D_LOG_INFO("[Render] SwapChain::Present(1,0) took {}ms", presentMs);
+                FD2D_LOG_INFO("[Render] SwapChain::Present({},{}) took {}ms", m_presentSyncInterval, m_presentFlags, presentMs);
+            }
+            if (SUCCEEDED(hrPresent))
+            {
+                ObserveVblank();
             }
 
             if (HandleDeviceLostHr(hrPresent, "SwapChain::Present"))
@@ -2883,6 +3951,11 @@ namespace FD2D
         }
         } // end else (D3D11 path)
 
+            lastFrameDamageOnly = damageOnly;
+            if (!damageOnly)
+            {
+                m_lastFullFrameIndex = m_frameIndex;
+            }
         } while (m_renderRequested); // Render again if requested during this frame
 
         if (renderLoopIterations > 1)
@@ -2891,6 +3964,26 @@ namespace FD2D
             FD2D_LOG_INFO("[Render] do-while loop ran {} iterations in {}ms", renderLoopIterations, loopMs);
         }
 
+        // Every on-screen Image has stamped this frame by now, so anything older
+        // is off screen and may be evicted to get back under the texture budget.
+        // A damage-only frame skipped everything outside the damage, so what the
+        // last full frame drew is still on screen and stays.
+        const std::size_t evicted = m_residency.EnforceBudget(lastFrameDamageOnly ? m_lastFullFrameIndex : m_frameIndex);
+        if (evicted > 0)
+        {
+            const ResidencyManager::Stats residency = m_residency.GetStats();
+            FD2D_LOG_INFO(
+                "[Residency] evicted {} item(s); resident={:.1f}MB ({} items) budget={:.1f}MB",
+                evicted,
+                static_cast<double>(residency.residentBytes) / (1024.0 * 1024.0),
+                residency.residentCount,
+                static_cast<double>(residency.budgetBytes) / (1024.0 * 1024.0));
+        }
+        if (!lastFrameDamageOnly && !m_frameObservers.empty())
+        {
+            RunFrameObservers();
+        }
+
         // Diagnostic: roll this frame into a once-per-second [FPS] summary so a sluggish
         // period (e.g. right after startup while async work is still completing) shows up
         // as objective fps/frame-time numbers, broken down by what triggered each frame
@@ -2926,13 +4019,17 @@ namespace FD2D
                 const double avgMs = m_fpsWindowTotalMs / (std::max)(1, m_fpsWindowFrames);
                 const double fps = static_cast<double>(m_fpsWindowFrames) * 1000.0 /
                     static_cast<double>((std::max)(windowElapsedMs, 1ULL));
+                const ResidencyManager::Stats residency = m_residency.GetStats();
                 FD2D_LOG_INFO(
                     "[FPS] {:.1f} fps  frames={} avg={:.1f}ms max={:.1f}ms  "
-                    "trigger(tick={} invalidate={} paint={} other={})  asyncPending={}/{}",
+                    "trigger(tick={} invalidate={} paint={} other={})  asyncPending={}/{}  "
+                    "gpuContent={:.1f}MB/{} items (evictions={})",
                     fps, m_fpsWindowFrames, avgMs, m_fpsWindowMaxMs,
                     m_fpsWindowTickFrames, m_fpsWindowInvalidateFrames,
                     m_fpsWindowPaintFrames, m_fpsWindowOtherFrames,
-                    m_fpsWindowAsyncPendingFrames, m_fpsWindowFrames);
+                    m_fpsWindowAsyncPendingFrames, m_fpsWindowFrames,
+                    static_cast<double>(residency.residentBytes) / (1024.0 * 1024.0),
+                    residency.residentCount, residency.evictionCount);
 
                 m_fpsWindowStartMs = nowMs;
                 m_fpsWindowFrames = 0;
@@ -2951,11 +4048,17 @@ namespace FD2D
     {
         D2D1_SIZE_F size { static_cast<FLOAT>(m_size.width), static_cast<FLOAT>(m_size.height) };
 
+        // Top-level controls are independent: measure them all (concurrently
+        // with parallel layout on), then arrange in order.
+        const Size available { size.width, size.height };
+        std::pmr::vector<Size> measured(m_childrenOrdered.size(), Size {}, &m_scratchArena);
+        Wnd::MeasureIndependent(ParallelLayout() ? m_executor.get() : nullptr,
+            m_childrenOrdered.data(), m_childrenOrdered.size(), &available, 0, measured.data());
+
         for (const auto& child : m_childrenOrdered)
         {
             if (child)
             {
-                child->Measure({ size.width, size.height });
                 child->Arrange({ 0.0f, 0.0f, size.width, size.height });
             }
         }
@@ -2975,20 +4078,20 @@ namespace FD2D
 
     bool Backplate::AddWnd(const std::shared_ptr<Wnd>& wnd)
     {
-        if (!wnd || wnd->Name().empty())
+        if (!wnd || wnd->Id() == kNoName)
         {
             return false;
         }
 
-        if (m_children.find(wnd->Name()) != m_children.end())
+        if (m_childIndex.Find(m_childrenOrdered, wnd->Id()) != ChildNameIndex::npos)
         {
             return false;
         }
 
         FD2D_TIMER_START(t_addwnd);
 
-        m_children.emplace(wnd->Name(), wnd);
         m_childrenOrdered.push_back(wnd);
+        m_childIndex.NoteAppended(m_childrenOrdered);
         wnd->OnAttached(*this);
         FD2D_LOG_STEP(t_addwnd, "[AddWnd] OnAttached");
 
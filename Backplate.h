@@ -6,21 +6,35 @@
 #include <dxgi1_2.h>
 #include <d3d11_1.h>
 #include <wrl/client.h>
+#include <array>
 #include <cstdint>
 #include <memory>
-#include <mutex>
 #include <unordered_map>
 #include <string>
 #include <atomic>
 #include <functional>
 #include <vector>
 
+#include "Animation.h"
+#include "AnimationRegistry.h"
+#include "Executor.h"
+#include "FrameScheduler.h"
+#include "FramePacer.h"
+#include "FrameArena.h"
+#include "ImagePipeline.h"
+#include "RedrawSignal.h"
+#include "RenderThread.h"
+#include "ResidencyManager.h"
+#include "TimerWheel.h"
+#include "UiDispatcher.h"
 #include "Wnd.h"
 
 namespace FD2D
 {
-    // Thread-safe redraw handle for worker threads. Does not retain a raw Backplate*.
-    // After Backplate destruction the token becomes a no-op.
+    // Thread-safe redraw handle for worker threads. Does not retain a raw Backplate*:
+    // it shares the window's wake event and coalescing flag, so a request is
+    // wait-free (one atomic RMW; the first request of a burst also sets the
+    // event). After Backplate destruction the token becomes a no-op.
     class AsyncRedrawToken
     {
     public:
@@ -29,14 +43,21 @@ namespace FD2D
     private:
         friend class Backplate;
 
+        // Outlives the Backplate while tokens exist, so the event stays valid.
         struct ControlBlock
         {
-            mutable std::mutex mutex;
-            Backplate* backplate { nullptr };
+            ControlBlock();
+            ~ControlBlock();
+
+            ControlBlock(const ControlBlock&) = delete;
+            ControlBlock& operator=(const ControlBlock&) = delete;
+
+            HANDLE event { nullptr };
+            RedrawSignal signal;
         };
 
-        explicit AsyncRedrawToken(std::weak_ptr<ControlBlock> control);
-        std::weak_ptr<ControlBlock> m_control {};
+        explicit AsyncRedrawToken(std::shared_ptr<ControlBlock> control);
+        std::shared_ptr<ControlBlock> m_control {};
     };
 
     enum class ChromeStyle
@@ -45,6 +66,24 @@ namespace FD2D
         Borderless
     };
 
+    // How the D3D11 swap chain presents (ignored by the d2d_hwndrt renderer).
+    enum class PresentMode
+    {
+        // Flip-sequential, Present(1, 0): the driver may queue up to three
+        // frames ahead of the display.
+        Vsync,
+        // Flip-discard with a frame-latency waitable and a maximum latency of
+        // one frame: each frame waits until the previous one is on its way to
+        // the display before it starts, so it never runs ahead with old input.
+        LowLatency,
+        // LowLatency, plus animation frames start as late as the recent render
+        // cost allows ("render just before vsync"; see FramePacer).
+        Deadline,
+        // Flip-discard, Present(0, ALLOW_TEARING) when the system supports it.
+        // Unthrottled and tearing; for benchmarking.
+        Tearing
+    };
+
     struct WindowOptions
     {
         HINSTANCE instance { nullptr };
@@ -65,6 +104,7 @@ namespace FD2D
         // - nullptr or L"d3d11_swapchain": D3D11 swapchain + D2D interop (default, fastest, supports GPU DDS)
         // - L"d2d_hwndrt": D2D-only ID2D1HwndRenderTarget (more compatible, no D3D pass, no GPU DDS)
         const wchar_t* rendererId { nullptr };
+        PresentMode presentMode { PresentMode::Vsync };
     };
 
     class Backplate
@@ -120,6 +160,8 @@ namespace FD2D
         // offscreen frame (D3D + D2D) into tightly packed BGRA8 pixels. This is
         // independent of desktop occlusion. Call Render() first when a current
         // frame is required. Returns E_NOINTERFACE for the D2D-only backend.
+        // Reuses an idle staging texture of the async ring; while every ring
+        // slot is in flight it reads through a temporary one instead.
         HRESULT ReadComposedPixels(
             const D2D1_RECT_F& logicalRect,
             std::vector<std::uint8_t>& pixels,
@@ -127,27 +169,184 @@ namespace FD2D
             UINT& height,
             UINT& stride);
 
+        // Result of an asynchronous composed-frame readback (tightly packed BGRA8).
+        struct ComposedPixels
+        {
+            std::vector<std::uint8_t> pixels {};
+            UINT width { 0 };
+            UINT height { 0 };
+            UINT stride { 0 };
+        };
+        using ComposedPixelsCallback = std::function<void(HRESULT hr, ComposedPixels&& pixels)>;
+
+        // Non-blocking variant of ReadComposedPixels: queues the GPU copy into one
+        // of a small ring of reusable staging textures and returns immediately.
+        // The callback runs later on the UI thread (from ProcessAnimationTick)
+        // once the copy has landed; it is never invoked from inside this call.
+        // On device loss pending callbacks receive DXGI_ERROR_DEVICE_REMOVED;
+        // callbacks still pending when the Backplate is destroyed receive
+        // E_ABORT from its destructor.
+        // Returns HRESULT_FROM_WIN32(ERROR_BUSY) while every ring slot is in flight.
+        HRESULT ReadComposedPixelsAsync(
+            const D2D1_RECT_F& logicalRect,
+            ComposedPixelsCallback callback);
+
         // Cross-thread redraw signaling without PostMessage:
         // worker thread calls RequestAsyncRedraw() -> signals event (coalesced)
         // UI thread waits on AsyncRedrawEvent() and calls ProcessAsyncRedraw().
-        HANDLE AsyncRedrawEvent() const { return m_asyncRedrawEvent; }
+        HANDLE AsyncRedrawEvent() const { return m_asyncRedrawControl ? m_asyncRedrawControl->event : nullptr; }
         void RequestAsyncRedraw();
         void ProcessAsyncRedraw();
 
         // Prefer this over capturing raw Backplate* from worker threads.
         std::shared_ptr<AsyncRedrawToken> GetAsyncRedrawToken() const;
 
+        // Runs `task` on the UI thread. Safe (and lock-free) from any thread;
+        // the async redraw event wakes the loop, which runs posted tasks in
+        // bounded slices (ProcessAsyncRedraw / ProcessAnimationTick) by
+        // priority, deferring one repaint to the end of each slice. Workers
+        // that may outlive the window should keep GetDispatcher() instead of
+        // the Backplate: once the window is destroyed posts return false and
+        // the tasks are dropped unrun.
+        template <typename F>
+        bool Post(F&& task, TaskPriority priority = TaskPriority::Normal)
+        {
+            return m_dispatcher->Post(std::forward<F>(task), priority);
+        }
+        std::shared_ptr<UiDispatcher> GetDispatcher() const { return m_dispatcher; }
+
         // Monotonic graphics resource generations (device / target / renderer backend).
         GraphicsGeneration GetGraphicsGeneration() const { return m_graphicsGeneration; }
 
         // Animation scheduling (spinner / cross-fade): avoids busy WM_PAINT loops.
+        // RequestAnimationFrame keeps the whole window ticking for ~100ms and
+        // repaints all of it. Registered animations instead name the bounds
+        // they change (render-target pixels, i.e. through the target's current
+        // transform) and optionally when they end (Util::NowMs; 0 = until
+        // unregistered): ticks driven only by them repaint just those bounds
+        // over the retained previous frame. Re-registering updates an owner's
+        // bounds/end; an ended or unregistered animation is repainted once more.
         void RequestAnimationFrame();
+        void RegisterAnimation(const Wnd* owner, const D2D1_RECT_F& bounds, unsigned long long endMs = 0);
+        void UnregisterAnimation(const Wnd* owner);
+
+        // Property animations (fades, smooth scroll, ...) for controls in this
+        // window: advanced once per animation tick, before the frame renders,
+        // and keep ticks coming until they settle. Use the control as owner;
+        // Wnd::OnDetached stops its animations.
+        AnimationEngine& Animations() { return m_animationEngine; }
         bool HasActiveAnimation(unsigned long long nowMs) const;
         void ProcessAnimationTick(unsigned long long nowMs);
+        // Reports this window's next animation frame (paced to the display
+        // refresh) and its earliest timer so the message loop sleeps until
+        // exactly then instead of polling.
+        void CollectDeadlines(FrameScheduler& scheduler, unsigned long long nowUs) const;
+        // Earliest of the above (FrameScheduler::kNoDeadline when idle); the
+        // Application ticks windows in this order.
+        unsigned long long NextTickDeadlineUs(unsigned long long nowUs) const;
+
+        // Per-window frame statistics. Ticks of a minimized, hidden or
+        // occluded window run timers, posted tasks and animation bookkeeping
+        // but skip the render (and are paced at a slow probe cadence);
+        // deferred ticks were pushed to the next loop pass because the
+        // Application's per-pass time budget was spent on other windows.
+        struct FrameStats
+        {
+            std::uint64_t frames { 0 };          // Render() calls
+            std::uint64_t hiddenTicks { 0 };
+            std::uint64_t deferredTicks { 0 };
+            unsigned long long lastFrameUs { 0 };
+            unsigned long long maxFrameUs { 0 };
+            unsigned long long totalFrameUs { 0 };
+        };
+        const FrameStats& GetFrameStats() const { return m_frameStats; }
+        void ResetFrameStats() { m_frameStats = {}; }
+        void NoteTickDeferred() { ++m_frameStats.deferredTicks; }
+
+        // Input-to-present latency: from the time the oldest input message
+        // not yet on screen was queued to the Present (or, with the render
+        // thread, the hand-off) of the frame that followed it.
+        using LatencyStats = FramePacer::LatencyStats;
+        const LatencyStats& GetLatencyStats() const { return m_pacer.Latency(); }
+        void ResetLatencyStats() { m_pacer.ResetLatency(); }
+
+        // UI-thread timers on this window's timer wheel (tooltip dwell, toast
+        // expiry, placement autosave, app timers). Callbacks run on the UI
+        // thread from ProcessAnimationTick and may set/cancel timers; the
+        // message loop wakes for the earliest one. A Win32 timer armed for
+        // the same deadline fires them from WM_TIMER when another message
+        // pump runs (modal dialogs, menus, a host-owned loop), at its
+        // ~10ms resolution. Cancelling an id that has fired (one-shot) or
+        // was cancelled is a no-op.
+        using TimerId = TimerWheel::TimerId;
+        static constexpr TimerId kInvalidTimer = TimerWheel::kInvalidTimer;
+        TimerId SetTimeout(unsigned int delayMs, std::function<void()> callback);
+        TimerId SetInterval(unsigned int periodMs, std::function<void()> callback);
+        void CancelTimer(TimerId& id);
+
+        // Time (Util::NowMs) sampled once at the start of each rendered frame,
+        // so every animation advanced in that frame uses the same clock.
+        unsigned long long FrameTimeMs() const { return m_frameTimeMs; }
 
         // Force layout recalculation on next render.
         void RequestLayout();
 
+        // Scratch memory for layout/render temporaries, reset at the start of
+        // every rendered frame (see FrameArena.h; controls use
+        // Wnd::ScratchMemory). UI thread only.
+        FrameArena& ScratchArena() { return m_scratchArena; }
+
+        // Optional async image loading (see ImagePipeline.h / Image::SetSource).
+        // The pipeline's wake callback is routed through this window's async
+        // redraw event; decoded images are delivered on the UI thread in small
+        // batches (ProcessAsyncRedraw / ProcessAnimationTick) so a burst of
+        // completions is uploaded over several frames instead of one long one.
+        // A pipeline may be shared by several windows: each registers its own
+        // wake callback and delivers only the requests its controls made.
+        void SetImagePipeline(std::shared_ptr<ImagePipeline> pipeline);
+        const std::shared_ptr<ImagePipeline>& GetImagePipeline() const { return m_imagePipeline; }
+
+        // Optional shared background pool for this window's controls (see
+        // Executor.h). While the window renders a frame the executor holds
+        // back background-lane work; pair submissions with
+        // Wnd::LifetimeToken() so they are dropped once the control goes away.
+        void SetExecutor(std::shared_ptr<Executor> executor) { m_executor = std::move(executor); }
+        const std::shared_ptr<Executor>& GetExecutor() const { return m_executor; }
+
+        // Opt-in parallel measure: containers fork sibling subtrees of at
+        // least a few dozen controls onto the executor (Wnd::MeasureChildren),
+        // and the top-level controls are measured the same way. Needs an
+        // executor, and every control in the window must follow the Measure
+        // contract in Wnd.h. Layout results are identical either way.
+        void SetParallelLayout(bool enable) { m_parallelLayout = enable; }
+        bool ParallelLayout() const { return m_parallelLayout && m_executor != nullptr; }
+
+        // Monotonic count of rendered frames (one per pass of the Render loop).
+        // Controls stamp GPU content with it so residency can tell what is on screen.
+        std::uint64_t FrameIndex() const { return m_frameIndex; }
+
+        // True while a damage-only frame is being drawn (see
+        // ProcessAnimationTick) and `layoutRect`, mapped to render-target
+        // pixels by `toRender`, misses the damage: the control and its
+        // subtree can be skipped. Wnd::OnRender/OnRenderD3D cull children
+        // this way. A null `toRender` means the plain logical-to-render
+        // scale; rotated or skewed transforms are never culled.
+        bool OutsideRenderDamage(const D2D1_RECT_F& layoutRect, const D2D1_MATRIX_3X2_F* toRender = nullptr) const;
+
+        // GPU content residency. Image registers its bitmap/SRV here; once the
+        // budget is exceeded, content that was not drawn in the last frame is
+        // evicted least-recently-drawn first (see ResidencyManager.h and
+        // Image::SetContentRestorer). Budget 0 (default) = accounting only.
+        ResidencyManager& Residency() { return m_residency; }
+        void SetTextureBudget(std::uint64_t bytes) { m_residency.SetBudget(bytes); }
+        ResidencyManager::Stats GetResidencyStats() const { return m_residency.GetStats(); }
+
+        // Runs `observer` after every full (not damage-only) frame until it
+        // returns false. Lets a control notice frames it was not painted in,
+        // e.g. inside a hidden or culled subtree whose OnRender never runs.
+        // UI thread only.
+        void AddFrameObserver(std::function<bool()> observer);
+
         // Transient notification banner (e.g. "Path copied to clipboard"),
         // drawn over the UI near the bottom of the window and auto-dismissed
         // after a short delay. The Windows-native-feel confirmation for
@@ -178,6 +377,23 @@ namespace FD2D
         void SetUseOffscreenBuffer(bool enable) { m_useOffscreenBuffer = enable; }
         bool UseOffscreenBuffer() const { return m_useOffscreenBuffer; }
 
+        // Optional render thread (D3D11 backend with the offscreen buffer).
+        // The UI thread still lays out and draws every frame, but into one of
+        // three offscreen textures that it hands to a dedicated thread through
+        // a triple-buffered mailbox (RenderThread.h); that thread copies the
+        // newest finished frame to the swap chain and waits for vsync in
+        // Present, so input handling never blocks on the display. Frames are
+        // drawn in full in this mode (no damage-only repaints) and it pauses
+        // during live resize. Needs a multithreaded D2D factory
+        // (InitContext::factoryType, the default); returns false otherwise.
+        bool SetRenderThreadEnabled(bool enable);
+        bool RenderThreadEnabled() const { return m_renderThreadEnabled; }
+
+        // Swap chain present mode (see PresentMode). Changing it on a live
+        // window recreates the device resources on the next frame.
+        void SetPresentMode(PresentMode mode);
+        PresentMode GetPresentMode() const { return m_presentMode; }
+
         // Check if currently rendering (to prevent recursive layout changes)
         bool IsRendering() const { return m_isRendering; }
         bool IsInSizeMove() const { return m_inSizeMove; }
@@ -215,6 +431,19 @@ namespace FD2D
         HRESULT FallbackToD2DOnly(HRESULT causeHr);
         void DiscardD2DTargets();
         void DiscardDeviceResources();
+        HRESULT CreateOffscreenTarget(
+            Microsoft::WRL::ComPtr<ID3D11Texture2D>& texture,
+            Microsoft::WRL::ComPtr<ID3D11RenderTargetView>& rtv,
+            Microsoft::WRL::ComPtr<ID2D1Bitmap1>& d2dTarget);
+        bool EnsureRenderThread();
+        void StopRenderThread();
+        // Frame-latency waitable (LowLatency / Deadline modes): blocks until
+        // the swap chain can take another frame, at most once per Present.
+        void WaitForFrameLatency();
+        // Feeds the last vblank time to the pacer after a Present.
+        void ObserveVblank();
+        // When the next animation tick is due (Deadline mode: per FramePacer).
+        unsigned long long NextAnimationTickUs() const;
         void InvalidateGraphics(
             GraphicsInvalidationReason reason,
             bool bumpDevice,
@@ -222,18 +451,20 @@ namespace FD2D
             bool bumpRenderer);
         void NotifyGraphicsInvalidated(GraphicsInvalidationReason reason);
         void ScheduleNextFrame();
+        void UpdateRefreshInterval();
+        unsigned long long AnimationFrameIntervalUs() const;
+        bool FullFrameAnimationActive(unsigned long long nowMs) const;
         bool HandleDeviceLostHr(HRESULT hr, const char* where);
         void LogDeviceRemovedReason(HRESULT triggerHr, const char* where) const;
         void Layout();
 
         // Hover-tooltip + toast support (see the .cpp). UpdateHoverTarget runs
         // on mouse move to find the control under the cursor and (re)arm the
-        // dwell; AdvanceHoverToast advances the dwell/toast timers each frame;
+        // dwell timer; dwell and toast expiry are one-shot timers;
         // Hover and toast can be emitted in separate priority bands.
         Wnd* HitTestTopLevel(const POINT& pt);
         void UpdateHoverTarget(const POINT& ptClient);
         void ClearHoverTooltip();
-        void AdvanceHoverToast(unsigned long long nowMs);
         void DrawHoverAndToast(
             ID2D1RenderTarget* target,
             bool drawHover,
@@ -245,7 +476,34 @@ namespace FD2D
         void InvokeBeforeDestroyOnce();
         void SchedulePlacementAutosave();
         void FlushPlacementAutosave();
-        void DetachAsyncRedrawControl();
+        void OnPlacementAutosaveTimer();
+        // (Re)arms the WM_TIMER fallback for the timer wheel's earliest
+        // deadline, or kills it when nothing is pending.
+        void ArmTimerFallback();
+        bool AsyncRedrawPending() const;
+        // Minimized, hidden and occluded windows skip animation renders.
+        bool CanPresentAnimation();
+        void ConnectDispatcher();
+
+        // Composed-frame readback ring (see ReadComposedPixelsAsync).
+        struct ReadbackSlot
+        {
+            Microsoft::WRL::ComPtr<ID3D11Texture2D> staging {};
+            UINT width { 0 };
+            UINT height { 0 };
+            bool inFlight { false };
+            ComposedPixelsCallback callback {};
+        };
+        static constexpr std::size_t kReadbackRingSize = 3;
+        // Copies into an idle ring slot, or into `overflow` (when given) while
+        // every ring slot is in flight.
+        HRESULT QueueComposedPixelCopy(const D2D1_RECT_F& logicalRect, ReadbackSlot*& slot, ReadbackSlot* overflow = nullptr);
+        void PollComposedPixelReadbacks();
+        void AbandonComposedPixelReadbacks();
+        void CancelComposedPixelReadbacks();
+        void DeliverDecodedImages();
+        void RunFrameObservers();
+        void RunPostedTasks();
 
         class DropTarget;
 
@@ -294,24 +552,76 @@ namespace FD2D
         
         bool m_useOffscreenBuffer { true };
 
-        std::unordered_map<std::wstring, std::shared_ptr<Wnd>> m_children {};
+        // Render-thread mode: one offscreen target per mailbox slot. While the
+        // thread runs, m_offscreen* alias the UI thread's current slot.
+        struct PresentSlot
+        {
+            Microsoft::WRL::ComPtr<ID3D11Texture2D> texture {};
+            Microsoft::WRL::ComPtr<ID3D11RenderTargetView> rtv {};
+            Microsoft::WRL::ComPtr<ID2D1Bitmap1> d2dTarget {};
+        };
+        bool m_renderThreadEnabled { false };
+        std::unique_ptr<RenderThread<PresentSlot>> m_renderThread {};
+        // D2D's lock; the render thread holds it while it touches the device.
+        Microsoft::WRL::ComPtr<ID2D1Multithread> m_renderThreadLock {};
+        // Latest Present result from the render thread (S_FALSE = none new).
+        std::shared_ptr<std::atomic<HRESULT>> m_renderThreadHr {};
+        // When the render thread's latest Present returned (0 = none new);
+        // closes the pacer's input-latency sample on the UI thread.
+        std::shared_ptr<std::atomic<std::uint64_t>> m_renderThreadPresentUs {};
+
+        // Present mode and what it resolved to when the swap chain was made.
+        PresentMode m_presentMode { PresentMode::Vsync };
+        UINT m_swapChainFlags { 0 };           // creation flags; ResizeBuffers must repeat them
+        UINT m_presentSyncInterval { 1 };
+        UINT m_presentFlags { 0 };
+        HANDLE m_frameLatencyWaitable { nullptr };
+        bool m_frameLatencySlotHeld { false }; // waited, not yet presented
+        unsigned long long m_frameLatencyWakeUs { 0 };
+        FramePacer m_pacer {};
+        FrameArena m_scratchArena {};
+
         std::vector<std::shared_ptr<Wnd>> m_childrenOrdered {};
+        ChildNameIndex m_childIndex {};
         WNDPROC m_prevWndProc { nullptr };
         bool m_classRegistered { false };
         std::wstring m_name {};
         bool m_layoutDirty { true };
 
-        HANDLE m_asyncRedrawEvent { nullptr };
-        std::atomic<bool> m_asyncRedrawPending { false };
         std::shared_ptr<AsyncRedrawToken::ControlBlock> m_asyncRedrawControl {};
+        std::shared_ptr<UiDispatcher> m_dispatcher { std::make_shared<UiDispatcher>() };
+
+        std::array<ReadbackSlot, kReadbackRingSize> m_readbackRing {};
+        // Callbacks of readbacks lost to device removal; delivered (as failures)
+        // on the next poll so they never run inside DiscardDeviceResources.
+        std::vector<ComposedPixelsCallback> m_abandonedReadbacks {};
         GraphicsGeneration m_graphicsGeneration {};
+        std::uint64_t m_frameIndex { 0 };
+        ResidencyManager m_residency {};
+        std::shared_ptr<ImagePipeline> m_imagePipeline {};
+        std::vector<std::function<bool()>> m_frameObservers {};
+        std::shared_ptr<Executor> m_executor {};
+        bool m_parallelLayout { false };
 
         std::atomic<unsigned long long> m_lastAnimationRequestMs { 0 };
-        std::atomic<unsigned long long> m_lastAnimationTickMs { 0 };
+        std::atomic<unsigned long long> m_lastAnimationTickUs { 0 };
+        // Refresh period of the monitor the window is on (0 = unknown); animation
+        // ticks are paced in whole refreshes of it.
+        unsigned long long m_refreshIntervalUs { 0 };
+        unsigned long long m_frameTimeMs { 0 };
+        FrameStats m_frameStats {};
+        // Last Present reported DXGI_STATUS_OCCLUDED; re-probed (Present test)
+        // on each animation tick until the window shows again.
+        bool m_occluded { false };
+        bool m_animationFramesSkipped { false };
+        TimerWheel m_timers {};
+        static constexpr UINT_PTR kTimerFallbackId = 0x4644; // 'FD'
+        // Deadline the WM_TIMER fallback is armed for (kNoDeadline = not armed).
+        unsigned long long m_timerFallbackDueMs { TimerWheel::kNoDeadline };
         // Diagnostic-only: last animation-tick cadence we logged, so ProcessAnimationTick
         // can log a one-line transition ("throttled to ~30fps" / "back to ~60fps") instead
         // of logging every single tick.
-        unsigned long long m_lastLoggedTickIntervalMs { 0 };
+        unsigned long long m_lastLoggedTickIntervalUs { 0 };
 
         Wnd* m_focusedWnd { nullptr };
 
@@ -319,7 +629,7 @@ namespace FD2D
         bool m_beforeDestroyInvoked { false };
 
         std::function<void(HWND)> m_onWindowPlacementChanged {};
-        UINT_PTR m_placeAutosaveTimerId { 0 };
+        TimerId m_placeAutosaveTimer { kInvalidTimer };
         bool m_inSizeMove { false };
         bool m_resizeResourcesPending { false };
         bool m_offscreenResizePending { false };
@@ -336,12 +646,12 @@ namespace FD2D
         std::wstring m_hoverTip {};
         POINT m_hoverPt { 0, 0 };
         POINT m_tipAnchor { 0, 0 };
-        unsigned long long m_hoverSinceMs { 0 };
+        TimerId m_tipTimer { kInvalidTimer };
         bool m_tipShown { false };
         bool m_mouseTracking { false };
-        // Transient toast banner text + its expiry time (0 = none).
+        // Transient toast banner text + its expiry timer.
         std::wstring m_toastText {};
-        unsigned long long m_toastExpireMs { 0 };
+        TimerId m_toastTimer { kInvalidTimer };
         // Lazily created DWrite format for tooltip/toast text.
         Microsoft::WRL::ComPtr<IDWriteTextFormat> m_tipFormat {};
 
@@ -352,6 +662,22 @@ namespace FD2D
         // Prevent recursive rendering (e.g., when layout changes during OnRender)
         bool m_isRendering { false };
         bool m_renderRequested { false };
+
+        // Animation damage: set by ProcessAnimationTick when only registered
+        // animations need this frame; Render then repaints just m_tickDamage
+        // (render-target pixels) if the offscreen buffer still holds the
+        // previous complete frame (m_retainedFrameValid).
+        AnimationRegistry m_animations {};
+        AnimationEngine m_animationEngine {};
+        D2D1_RECT_F m_tickDamage { 0.0f, 0.0f, 0.0f, 0.0f };
+        bool m_tickDamageValid { false };
+        bool m_retainedFrameValid { false };
+        // Set around the child passes of a damage-only frame.
+        bool m_cullToDamage { false };
+        // Frame index of the last complete frame: what it drew is still on
+        // screen through the damage-only frames after it.
+        std::uint64_t m_lastFullFrameIndex { 0 };
+        Microsoft::WRL::ComPtr<ID3D11RasterizerState> m_damageScissorState {};
         int m_deferRenderDepth { 0 };
 
         // Diagnostic-only frame-time/FPS aggregation (see Render()). Logged once per
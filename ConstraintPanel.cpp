@@ -0,0 +1,340 @@
+#include "ConstraintPanel.h"
+
+#include <algorithm>
+#include <memory_resource>
+
+namespace FD2D
+{
+    namespace
+    {
+        // Anything at or beyond this is an unconstrained probe (matches
+        // DynamicPanel and LayoutEngine).
+        constexpr float kUnboundedExtent = 1.0e9f;
+
+        float Extent(double value)
+        {
+            return (std::max)(0.0f, static_cast<float>(value));
+        }
+    }
+
+    ConstraintPanel::ConstraintPanel()
+        : Panel()
+    {
+        m_panel = CreateBox(true);
+    }
+
+    ConstraintPanel::ConstraintPanel(const std::wstring& name)
+        : Panel(name)
+    {
+        m_panel = CreateBox(true);
+    }
+
+    ConstraintPanel::Box ConstraintPanel::CreateBox(bool panel) const
+    {
+        Box box {};
+        box.left = m_solver.AddVariable();
+        box.top = m_solver.AddVariable();
+        box.width = m_solver.AddVariable();
+        box.height = m_solver.AddVariable();
+        box.implicit[0] = m_solver.AddConstraint(LinearExpr {}.Add(box.width), ConstraintOp::GreaterEqual);
+        box.implicit[1] = m_solver.AddConstraint(LinearExpr {}.Add(box.height), ConstraintOp::GreaterEqual);
+
+        if (panel)
+        {
+            // The panel's content box is anchored at the origin; its size is
+            // suggested from the space it gets.
+            (void)m_solver.AddConstraint(LinearExpr {}.Add(box.left), ConstraintOp::Equal);
+            (void)m_solver.AddConstraint(LinearExpr {}.Add(box.top), ConstraintOp::Equal);
+            (void)m_solver.AddEditVariable(box.width, ConstraintStrength::Strong);
+            (void)m_solver.AddEditVariable(box.height, ConstraintStrength::Strong);
+        }
+        else
+        {
+            // Children prefer their measured size.
+            (void)m_solver.AddEditVariable(box.width, ConstraintStrength::Weak);
+            (void)m_solver.AddEditVariable(box.height, ConstraintStrength::Weak);
+        }
+        return box;
+    }
+
+    ConstraintPanel::Box& ConstraintPanel::BoxFor(const std::shared_ptr<Wnd>& wnd) const
+    {
+        if (!wnd)
+        {
+            return m_panel;
+        }
+        auto it = m_boxes.find(wnd);
+        if (it == m_boxes.end())
+        {
+            it = m_boxes.emplace(wnd, CreateBox(false)).first;
+        }
+        return it->second;
+    }
+
+    void ConstraintPanel::AppendEdge(LinearExpr& expr, const Box& box, ConstraintEdge edge, double coefficient) const
+    {
+        switch (edge)
+        {
+        case ConstraintEdge::Left:
+            expr.Add(box.left, coefficient);
+            break;
+        case ConstraintEdge::Top:
+            expr.Add(box.top, coefficient);
+            break;
+        case ConstraintEdge::Right:
+            expr.Add(box.left, coefficient).Add(box.width, coefficient);
+            break;
+        case ConstraintEdge::Bottom:
+            expr.Add(box.top, coefficient).Add(box.height, coefficient);
+            break;
+        case ConstraintEdge::Width:
+            expr.Add(box.width, coefficient);
+            break;
+        case ConstraintEdge::Height:
+            expr.Add(box.height, coefficient);
+            break;
+        case ConstraintEdge::CenterX:
+            expr.Add(box.left, coefficient).Add(box.width, 0.5 * coefficient);
+            break;
+        case ConstraintEdge::CenterY:
+            expr.Add(box.top, coefficient).Add(box.height, 0.5 * coefficient);
+            break;
+        }
+    }
+
+    ConstraintId ConstraintPanel::AddConstraint(const std::shared_ptr<Wnd>& first, ConstraintEdge firstEdge, ConstraintOp op,
+                                                const std::shared_ptr<Wnd>& second, ConstraintEdge secondEdge,
+                                                float multiplier, float constant, double strength)
+    {
+        // first - (second * multiplier + constant)  op  0
+        LinearExpr expr;
+        AppendEdge(expr, BoxFor(first), firstEdge, 1.0);
+        AppendEdge(expr, BoxFor(second), secondEdge, -static_cast<double>(multiplier));
+        expr.Add(-static_cast<double>(constant));
+
+        const ConstraintId id = m_solver.AddConstraint(expr, op, strength);
+        if (id != kNoConstraint)
+        {
+            m_owners.emplace(id, std::make_pair(WndKey(first), WndKey(second)));
+            Invalidate();
+        }
+        return id;
+    }
+
+    ConstraintId ConstraintPanel::AddConstraint(const std::shared_ptr<Wnd>& first, ConstraintEdge edge, ConstraintOp op,
+                                                float constant, double strength)
+    {
+        LinearExpr expr;
+        AppendEdge(expr, BoxFor(first), edge, 1.0);
+        expr.Add(-static_cast<double>(constant));
+
+        const ConstraintId id = m_solver.AddConstraint(expr, op, strength);
+        if (id != kNoConstraint)
+        {
+            m_owners.emplace(id, std::make_pair(WndKey(first), WndKey()));
+            Invalidate();
+        }
+        return id;
+    }
+
+    bool ConstraintPanel::RemoveConstraint(ConstraintId id)
+    {
+        if (m_owners.erase(id) == 0)
+        {
+            return false;
+        }
+        Invalidate();
+        return m_solver.RemoveConstraint(id);
+    }
+
+    void ConstraintPanel::SyncChildren() const
+    {
+        ++m_stamp;
+        std::size_t live = 0;
+        for (const auto& child : ChildrenInOrder())
+        {
+            if (child)
+            {
+                Box& box = BoxFor(child);
+                box.seen = true;
+                box.stamp = m_stamp;
+                UpdateMinimum(box, child->MinSize());
+                ++live;
+            }
+        }
+
+        std::size_t seen = 0;
+        bool expired = false;
+        for (const auto& [key, box] : m_boxes)
+        {
+            seen += box.seen ? 1 : 0;
+            expired = expired || key.expired();
+        }
+        if (seen == live && !expired)
+        {
+            return;
+        }
+
+        // A child that was laid out before and is gone now, or a Wnd that
+        // was destroyed (including one only named in a constraint, never
+        // added): drop its constraints and variables. Boxes of live Wnds
+        // that were only named in a constraint, not added yet, stay.
+        for (auto it = m_boxes.begin(); it != m_boxes.end();)
+        {
+            Box& box = it->second;
+            const bool removed = box.seen && box.stamp != m_stamp;
+            if (!removed && !it->first.expired())
+            {
+                ++it;
+                continue;
+            }
+            DropBox(it->first, box);
+            it = m_boxes.erase(it);
+        }
+    }
+
+    void ConstraintPanel::UpdateMinimum(Box& box, Size minimum) const
+    {
+        if (minimum.w != box.minSize.w)
+        {
+            (void)m_solver.RemoveConstraint(box.minimum[0]);
+            // A minimum that conflicts with the app's required constraints
+            // is left out (kNoConstraint) rather than failing the layout.
+            box.minimum[0] = (minimum.w > 0.0f)
+                ? m_solver.AddConstraint(LinearExpr {}.Add(box.width).Add(-static_cast<double>(minimum.w)), ConstraintOp::GreaterEqual)
+                : kNoConstraint;
+        }
+        if (minimum.h != box.minSize.h)
+        {
+            (void)m_solver.RemoveConstraint(box.minimum[1]);
+            box.minimum[1] = (minimum.h > 0.0f)
+                ? m_solver.AddConstraint(LinearExpr {}.Add(box.height).Add(-static_cast<double>(minimum.h)), ConstraintOp::GreaterEqual)
+                : kNoConstraint;
+        }
+        box.minSize = minimum;
+    }
+
+    void ConstraintPanel::DropBox(const WndKey& key, Box& box) const
+    {
+        const KeyLess less {};
+        const auto same = [&](const WndKey& other)
+        {
+            return !less(key, other) && !less(other, key);
+        };
+        for (auto owner = m_owners.begin(); owner != m_owners.end();)
+        {
+            if (same(owner->second.first) || same(owner->second.second))
+            {
+                (void)m_solver.RemoveConstraint(owner->first);
+                owner = m_owners.erase(owner);
+            }
+            else
+            {
+                ++owner;
+            }
+        }
+        (void)m_solver.RemoveEditVariable(box.width);
+        (void)m_solver.RemoveEditVariable(box.height);
+        (void)m_solver.RemoveConstraint(box.implicit[0]);
+        (void)m_solver.RemoveConstraint(box.implicit[1]);
+        (void)m_solver.RemoveConstraint(box.minimum[0]);
+        (void)m_solver.RemoveConstraint(box.minimum[1]);
+        m_solver.RemoveVariable(box.left);
+        m_solver.RemoveVariable(box.top);
+        m_solver.RemoveVariable(box.width);
+        m_solver.RemoveVariable(box.height);
+    }
+
+    void ConstraintPanel::SuggestPanelSize(Size size) const
+    {
+        if (size.w != m_panelSuggested.w)
+        {
+            (void)m_solver.SuggestValue(m_panel.width, size.w);
+        }
+        if (size.h != m_panelSuggested.h)
+        {
+            (void)m_solver.SuggestValue(m_panel.height, size.h);
+        }
+        m_panelSuggested = size;
+    }
+
+    Size ConstraintPanel::Measure(Size available)
+    {
+        SyncChildren();
+
+        const auto& children = ChildrenInOrder();
+        std::pmr::vector<Size> measured(children.size(), Size {}, ScratchMemory());
+        MeasureChildren(children.data(), children.size(), available, measured.data());
+
+        // Only changed preferences reach the solver, so a resize that leaves
+        // the children's sizes alone re-solves for the panel size only.
+        for (std::size_t i = 0; i < children.size(); ++i)
+        {
+            if (!children[i])
+            {
+                continue;
+            }
+            Box& box = BoxFor(children[i]);
+            if (measured[i].w != box.suggested.w)
+            {
+                (void)m_solver.SuggestValue(box.width, measured[i].w);
+            }
+            if (measured[i].h != box.suggested.h)
+            {
+                (void)m_solver.SuggestValue(box.height, measured[i].h);
+            }
+            box.suggested = measured[i];
+        }
+
+        SuggestPanelSize({
+            (available.w < kUnboundedExtent) ? available.w : 0.0f,
+            (available.h < kUnboundedExtent) ? available.h : 0.0f });
+        m_solver.UpdateVariables();
+
+        m_desired = { Extent(m_solver.Value(m_panel.width)), Extent(m_solver.Value(m_panel.height)) };
+        return m_desired;
+    }
+
+    Size ConstraintPanel::MinSize() const
+    {
+        // Squeeze the panel to nothing; the solve stops where the required
+        // constraints (the children's minimums among them) push back. The
+        // previous suggestion is restored after.
+        SyncChildren();
+        const Size previous = m_panelSuggested;
+        SuggestPanelSize({ 0.0f, 0.0f });
+        m_solver.UpdateVariables();
+        const Size minimum { Extent(m_solver.Value(m_panel.width)), Extent(m_solver.Value(m_panel.height)) };
+
+        if (previous.w >= 0.0f && previous.h >= 0.0f)
+        {
+            SuggestPanelSize(previous);
+            m_solver.UpdateVariables();
+        }
+        return minimum;
+    }
+
+    void ConstraintPanel::Arrange(Rect finalRect)
+    {
+        SyncChildren();
+        SuggestPanelSize({ finalRect.w, finalRect.h });
+        m_solver.UpdateVariables();
+
+        for (const auto& child : ChildrenInOrder())
+        {
+            if (!child)
+            {
+                continue;
+            }
+            const Box& box = BoxFor(child);
+            child->Arrange({
+                finalRect.x + static_cast<float>(m_solver.Value(box.left)),
+                finalRect.y + static_cast<float>(m_solver.Value(box.top)),
+                Extent(m_solver.Value(box.width)),
+                Extent(m_solver.Value(box.height)) });
+        }
+
+        m_bounds = finalRect;
+        m_layoutRect = ToD2D(finalRect);
+    }
+}
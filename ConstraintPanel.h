@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Panel.h"
+#include "ConstraintSolver.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+namespace FD2D
+{
+    enum class ConstraintEdge : std::uint8_t
+    {
+        Left,
+        Top,
+        Right,
+        Bottom,
+        Width,
+        Height,
+        CenterX,
+        CenterY
+    };
+
+    // Places children by linear constraints between their edges (and the
+    // panel's), solved with ConstraintSolver:
+    //
+    //   panel->AddConstraint(label, ConstraintEdge::Right, ConstraintOp::LessEqual,
+    //                        field, ConstraintEdge::Left, 1.0f, -8.0f);
+    //
+    // reads "label.right <= field.left - 8". A null Wnd stands for the panel
+    // itself, whose content box is (0, 0, width, height). Each child prefers
+    // its measured size (weak), the panel's size follows the space it is
+    // given (strong), and anything stronger than weak can override the
+    // children's preferences. The solver keeps its tableau between passes,
+    // so a resize only re-solves incrementally.
+    //
+    // Every child is also held at or above its own MinSize() (required). The
+    // panel's MinSize() is the smallest size the required constraints allow,
+    // so a window hosting the panel cannot be resized below it. With
+    // unbounded space along an axis, Measure reports that minimum as well.
+    //
+    // Children are tracked by identity, not address: a Wnd that is destroyed
+    // (added or only named in a constraint) takes its constraints with it,
+    // and a new Wnd reusing its memory starts without them.
+    class ConstraintPanel : public Panel
+    {
+    public:
+        ConstraintPanel();
+        explicit ConstraintPanel(const std::wstring& name);
+
+        // first.firstEdge op second.secondEdge * multiplier + constant.
+        // Returns kNoConstraint when a required constraint conflicts with the
+        // required ones already present. Constraints of a child are dropped
+        // when it is removed from the panel.
+        ConstraintId AddConstraint(const std::shared_ptr<Wnd>& first, ConstraintEdge firstEdge, ConstraintOp op,
+                                   const std::shared_ptr<Wnd>& second, ConstraintEdge secondEdge,
+                                   float multiplier = 1.0f, float constant = 0.0f,
+                                   double strength = ConstraintStrength::Required);
+        // first.edge op constant.
+        ConstraintId AddConstraint(const std::shared_ptr<Wnd>& first, ConstraintEdge edge, ConstraintOp op,
+                                   float constant, double strength = ConstraintStrength::Required);
+        bool RemoveConstraint(ConstraintId id);
+
+        Size Measure(Size available) override;
+        Size MinSize() const override;
+        void Arrange(Rect finalRect) override;
+
+    private:
+        // Solver variables of one child (or of the panel).
+        struct Box
+        {
+            ConstraintVar left { 0 };
+            ConstraintVar top { 0 };
+            ConstraintVar width { 0 };
+            ConstraintVar height { 0 };
+            ConstraintId implicit[2] { kNoConstraint, kNoConstraint };
+            // width >= child MinSize().w, height >= child MinSize().h.
+            ConstraintId minimum[2] { kNoConstraint, kNoConstraint };
+            Size minSize { -1.0f, -1.0f };
+            Size suggested { -1.0f, -1.0f };
+            bool seen { false };
+            std::uint32_t stamp { 0 };
+        };
+
+        // Keyed by control block, so an expired key stays distinct from any
+        // later Wnd at the same address.
+        using WndKey = std::weak_ptr<const Wnd>;
+        using KeyLess = std::owner_less<>;
+
+        Box CreateBox(bool panel) const;
+        Box& BoxFor(const std::shared_ptr<Wnd>& wnd) const;
+        void AppendEdge(LinearExpr& expr, const Box& box, ConstraintEdge edge, double coefficient) const;
+        // Drops the constraints and variables of children that left the panel
+        // and of Wnds that no longer exist, and refreshes the children's
+        // minimum-size constraints.
+        void SyncChildren() const;
+        void UpdateMinimum(Box& box, Size minimum) const;
+        void DropBox(const WndKey& key, Box& box) const;
+        void SuggestPanelSize(Size size) const;
+
+        mutable ConstraintSolver m_solver {};
+        mutable Box m_panel {};
+        mutable std::map<WndKey, Box, KeyLess> m_boxes {};
+        // Null keys stand for the panel.
+        mutable std::unordered_map<ConstraintId, std::pair<WndKey, WndKey>> m_owners {};
+        mutable Size m_panelSuggested { -1.0f, -1.0f };
+        mutable std::uint32_t m_stamp { 0 };
+    };
+}
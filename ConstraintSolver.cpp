@@ -0,0 +1,686 @@
+#include "ConstraintSolver.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace FD2D
+{
+    namespace
+    {
+        constexpr double kEpsilon = 1.0e-8;
+
+        bool NearZero(double value)
+        {
+            return std::fabs(value) < kEpsilon;
+        }
+    }
+
+    double ConstraintSolver::Row::CoefficientFor(Symbol symbol) const
+    {
+        const auto it = std::lower_bound(m_cells.begin(), m_cells.end(), symbol,
+            [](const Cell& cell, Symbol s) { return cell.symbol < s; });
+        return (it != m_cells.end() && it->symbol == symbol) ? it->coefficient : 0.0;
+    }
+
+    void ConstraintSolver::Row::Insert(Symbol symbol, double coefficient)
+    {
+        const auto it = std::lower_bound(m_cells.begin(), m_cells.end(), symbol,
+            [](const Cell& cell, Symbol s) { return cell.symbol < s; });
+        if (it != m_cells.end() && it->symbol == symbol)
+        {
+            it->coefficient += coefficient;
+            if (NearZero(it->coefficient))
+            {
+                m_cells.erase(it);
+            }
+            return;
+        }
+        if (!NearZero(coefficient))
+        {
+            m_cells.insert(it, { symbol, coefficient });
+        }
+    }
+
+    void ConstraintSolver::Row::Insert(const Row& other, double coefficient)
+    {
+        m_constant += other.m_constant * coefficient;
+
+        // Merge of two sorted cell lists.
+        std::vector<Cell> merged;
+        merged.reserve(m_cells.size() + other.m_cells.size());
+        auto a = m_cells.begin();
+        auto b = other.m_cells.begin();
+        while (a != m_cells.end() || b != other.m_cells.end())
+        {
+            if (b == other.m_cells.end() || (a != m_cells.end() && a->symbol < b->symbol))
+            {
+                merged.push_back(*a++);
+                continue;
+            }
+            double value = b->coefficient * coefficient;
+            const Symbol symbol = b->symbol;
+            ++b;
+            if (a != m_cells.end() && a->symbol == symbol)
+            {
+                value += a->coefficient;
+                ++a;
+            }
+            if (!NearZero(value))
+            {
+                merged.push_back({ symbol, value });
+            }
+        }
+        m_cells.swap(merged);
+    }
+
+    void ConstraintSolver::Row::Remove(Symbol symbol)
+    {
+        const auto it = std::lower_bound(m_cells.begin(), m_cells.end(), symbol,
+            [](const Cell& cell, Symbol s) { return cell.symbol < s; });
+        if (it != m_cells.end() && it->symbol == symbol)
+        {
+            m_cells.erase(it);
+        }
+    }
+
+    void ConstraintSolver::Row::ReverseSign()
+    {
+        m_constant = -m_constant;
+        for (Cell& cell : m_cells)
+        {
+            cell.coefficient = -cell.coefficient;
+        }
+    }
+
+    void ConstraintSolver::Row::SolveFor(Symbol symbol)
+    {
+        const double coefficient = -1.0 / CoefficientFor(symbol);
+        Remove(symbol);
+        m_constant *= coefficient;
+        for (Cell& cell : m_cells)
+        {
+            cell.coefficient *= coefficient;
+        }
+    }
+
+    void ConstraintSolver::Row::SolveFor(Symbol lhs, Symbol rhs)
+    {
+        Insert(lhs, -1.0);
+        SolveFor(rhs);
+    }
+
+    void ConstraintSolver::Row::Substitute(Symbol symbol, const Row& row)
+    {
+        const double coefficient = CoefficientFor(symbol);
+        if (coefficient != 0.0)
+        {
+            Remove(symbol);
+            Insert(row, coefficient);
+        }
+    }
+
+    ConstraintVar ConstraintSolver::AddVariable()
+    {
+        if (!m_freeVars.empty())
+        {
+            const ConstraintVar reused = m_freeVars.back();
+            m_freeVars.pop_back();
+            return reused;
+        }
+
+        const ConstraintVar var = static_cast<ConstraintVar>(m_values.size());
+        m_values.push_back(0.0);
+        m_varSymbols.push_back(0);
+        return var;
+    }
+
+    void ConstraintSolver::RemoveVariable(ConstraintVar var)
+    {
+        if (var >= m_values.size())
+        {
+            return;
+        }
+
+        // With its constraints gone the variable's symbol constrains nothing:
+        // a row still defining it is dead and is dropped. The reused id gets
+        // a fresh symbol on first use.
+        if (m_varSymbols[var] != 0)
+        {
+            m_rows.erase(m_varSymbols[var]);
+            m_varSymbols[var] = 0;
+        }
+        m_values[var] = 0.0;
+        m_freeVars.push_back(var);
+    }
+
+    ConstraintSolver::Symbol ConstraintSolver::NewSymbol(SymbolType type)
+    {
+        m_symbolTypes.push_back(type);
+        return static_cast<Symbol>(m_symbolTypes.size() - 1);
+    }
+
+    ConstraintSolver::Symbol ConstraintSolver::VarSymbol(ConstraintVar var)
+    {
+        if (m_varSymbols[var] == 0)
+        {
+            m_varSymbols[var] = NewSymbol(SymbolType::External);
+        }
+        return m_varSymbols[var];
+    }
+
+    ConstraintId ConstraintSolver::AddConstraint(const LinearExpr& expr, ConstraintOp op, double strength)
+    {
+        for (const LinearExpr::Term& term : expr.terms)
+        {
+            if (term.var >= m_values.size())
+            {
+                return kNoConstraint;
+            }
+        }
+
+        strength = (std::min)((std::max)(strength, 0.0), ConstraintStrength::Required);
+        ConstraintInfo info {};
+        info.strength = strength;
+        Row row = CreateRow(expr, op, strength, info.tag);
+        Symbol subject = ChooseSubject(row, info.tag);
+
+        // Only dummies left: the constraint is redundant if the constant is
+        // zero and unsatisfiable otherwise.
+        if (subject == 0 && AllDummies(row))
+        {
+            if (!NearZero(row.Constant()))
+            {
+                return kNoConstraint;
+            }
+            subject = info.tag.marker;
+        }
+
+        const ConstraintId id = m_nextConstraint++;
+        if (subject == 0)
+        {
+            if (!AddWithArtificialVariable(row))
+            {
+                // The row is in the tableau already; take it back out.
+                m_constraints.emplace(id, info);
+                (void)RemoveConstraint(id);
+                return kNoConstraint;
+            }
+        }
+        else
+        {
+            row.SolveFor(subject);
+            Substitute(subject, row);
+            m_rows.insert_or_assign(subject, std::move(row));
+        }
+
+        m_constraints.emplace(id, info);
+        Optimize(m_objective);
+        return id;
+    }
+
+    bool ConstraintSolver::RemoveConstraint(ConstraintId id)
+    {
+        const auto found = m_constraints.find(id);
+        if (found == m_constraints.end())
+        {
+            return false;
+        }
+        const ConstraintInfo info = found->second;
+        m_constraints.erase(found);
+
+        RemoveConstraintEffects(info);
+
+        // A basic marker row is simply dropped; otherwise pivot the marker
+        // into the basis first.
+        if (m_rows.erase(info.tag.marker) == 0)
+        {
+            const auto it = MarkerLeavingRow(info.tag.marker);
+            if (it == m_rows.end())
+            {
+                return false;
+            }
+            const Symbol leaving = it->first;
+            Row row = std::move(it->second);
+            m_rows.erase(it);
+            row.SolveFor(leaving, info.tag.marker);
+            Substitute(info.tag.marker, row);
+        }
+
+        Optimize(m_objective);
+        return true;
+    }
+
+    bool ConstraintSolver::AddEditVariable(ConstraintVar var, double strength)
+    {
+        if (var >= m_values.size() || m_edits.count(var) != 0)
+        {
+            return false;
+        }
+
+        strength = (std::min)(strength, ConstraintStrength::Strong);
+        const ConstraintId id = AddConstraint(LinearExpr {}.Add(var), ConstraintOp::Equal, strength);
+        if (id == kNoConstraint)
+        {
+            return false;
+        }
+
+        EditInfo edit {};
+        edit.constraint = id;
+        edit.tag = m_constraints.at(id).tag;
+        m_edits.emplace(var, edit);
+        return true;
+    }
+
+    bool ConstraintSolver::RemoveEditVariable(ConstraintVar var)
+    {
+        const auto it = m_edits.find(var);
+        if (it == m_edits.end())
+        {
+            return false;
+        }
+        const ConstraintId id = it->second.constraint;
+        m_edits.erase(it);
+        return RemoveConstraint(id);
+    }
+
+    bool ConstraintSolver::SuggestValue(ConstraintVar var, double value)
+    {
+        const auto found = m_edits.find(var);
+        if (found == m_edits.end())
+        {
+            return false;
+        }
+
+        EditInfo& edit = found->second;
+        const double delta = value - edit.constant;
+        edit.constant = value;
+
+        // The edit row is "var - constant = errPlus - errMinus": shift the
+        // constant wherever the error symbols live, then restore feasibility
+        // with the dual simplex.
+        auto row = m_rows.find(edit.tag.marker);
+        if (row != m_rows.end())
+        {
+            if (row->second.Add(-delta) < 0.0)
+            {
+                m_infeasibleRows.push_back(row->first);
+            }
+            DualOptimize();
+            return true;
+        }
+
+        row = m_rows.find(edit.tag.other);
+        if (row != m_rows.end())
+        {
+            if (row->second.Add(delta) < 0.0)
+            {
+                m_infeasibleRows.push_back(row->first);
+            }
+            DualOptimize();
+            return true;
+        }
+
+        for (auto& [symbol, r] : m_rows)
+        {
+            const double coefficient = r.CoefficientFor(edit.tag.marker);
+            if (coefficient != 0.0 && r.Add(delta * coefficient) < 0.0 && TypeOf(symbol) != SymbolType::External)
+            {
+                m_infeasibleRows.push_back(symbol);
+            }
+        }
+        DualOptimize();
+        return true;
+    }
+
+    void ConstraintSolver::UpdateVariables()
+    {
+        for (std::size_t var = 0; var < m_values.size(); ++var)
+        {
+            const auto it = (m_varSymbols[var] != 0) ? m_rows.find(m_varSymbols[var]) : m_rows.end();
+            m_values[var] = (it != m_rows.end()) ? it->second.Constant() : 0.0;
+        }
+    }
+
+    ConstraintSolver::Row ConstraintSolver::CreateRow(const LinearExpr& expr, ConstraintOp op, double strength, Tag& tag)
+    {
+        Row row(expr.constant);
+        for (const LinearExpr::Term& term : expr.terms)
+        {
+            if (NearZero(term.coefficient))
+            {
+                continue;
+            }
+            const Symbol symbol = VarSymbol(term.var);
+            const auto basic = m_rows.find(symbol);
+            if (basic != m_rows.end())
+            {
+                row.Insert(basic->second, term.coefficient);
+            }
+            else
+            {
+                row.Insert(symbol, term.coefficient);
+            }
+        }
+
+        const bool required = strength >= ConstraintStrength::Required;
+        if (op == ConstraintOp::Equal)
+        {
+            if (required)
+            {
+                tag.marker = NewSymbol(SymbolType::Dummy);
+                row.Insert(tag.marker);
+            }
+            else
+            {
+                tag.marker = NewSymbol(SymbolType::Error);
+                tag.other = NewSymbol(SymbolType::Error);
+                row.Insert(tag.marker, -1.0);
+                row.Insert(tag.other, 1.0);
+                m_objective.Insert(tag.marker, strength);
+                m_objective.Insert(tag.other, strength);
+            }
+        }
+        else
+        {
+            // expr <= 0  ->  expr + slack = 0; expr >= 0  ->  expr - slack = 0.
+            const double coefficient = (op == ConstraintOp::LessEqual) ? 1.0 : -1.0;
+            tag.marker = NewSymbol(SymbolType::Slack);
+            row.Insert(tag.marker, coefficient);
+            if (!required)
+            {
+                tag.other = NewSymbol(SymbolType::Error);
+                row.Insert(tag.other, -coefficient);
+                m_objective.Insert(tag.other, strength);
+            }
+        }
+
+        if (row.Constant() < 0.0)
+        {
+            row.ReverseSign();
+        }
+        return row;
+    }
+
+    ConstraintSolver::Symbol ConstraintSolver::ChooseSubject(const Row& row, const Tag& tag) const
+    {
+        for (const Row::Cell& cell : row.Cells())
+        {
+            if (TypeOf(cell.symbol) == SymbolType::External)
+            {
+                return cell.symbol;
+            }
+        }
+        for (const Symbol symbol : { tag.marker, tag.other })
+        {
+            if (symbol != 0 &&
+                (TypeOf(symbol) == SymbolType::Slack || TypeOf(symbol) == SymbolType::Error) &&
+                row.CoefficientFor(symbol) < 0.0)
+            {
+                return symbol;
+            }
+        }
+        return 0;
+    }
+
+    bool ConstraintSolver::AllDummies(const Row& row) const
+    {
+        for (const Row::Cell& cell : row.Cells())
+        {
+            if (TypeOf(cell.symbol) != SymbolType::Dummy)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool ConstraintSolver::AddWithArtificialVariable(const Row& row)
+    {
+        // Minimize an artificial variable standing for the row; the row is
+        // satisfiable exactly when it can be driven to zero.
+        const Symbol art = NewSymbol(SymbolType::Slack);
+        m_rows.insert_or_assign(art, row);
+        m_artificial = row;
+        m_hasArtificial = true;
+        Optimize(m_artificial);
+        const bool success = NearZero(m_artificial.Constant());
+        m_hasArtificial = false;
+        m_artificial = Row {};
+
+        const auto it = m_rows.find(art);
+        if (it != m_rows.end())
+        {
+            Row basic = std::move(it->second);
+            m_rows.erase(it);
+            if (basic.Cells().empty())
+            {
+                return success;
+            }
+            const Symbol entering = AnyPivotableSymbol(basic);
+            if (entering == 0)
+            {
+                return false;
+            }
+            basic.SolveFor(art, entering);
+            Substitute(entering, basic);
+            m_rows.insert_or_assign(entering, std::move(basic));
+        }
+
+        for (auto& [symbol, r] : m_rows)
+        {
+            r.Remove(art);
+        }
+        m_objective.Remove(art);
+        return success;
+    }
+
+    void ConstraintSolver::Substitute(Symbol symbol, const Row& row)
+    {
+        for (auto& [basic, r] : m_rows)
+        {
+            r.Substitute(symbol, row);
+            if (TypeOf(basic) != SymbolType::External && r.Constant() < 0.0)
+            {
+                m_infeasibleRows.push_back(basic);
+            }
+        }
+        m_objective.Substitute(symbol, row);
+        if (m_hasArtificial)
+        {
+            m_artificial.Substitute(symbol, row);
+        }
+    }
+
+    void ConstraintSolver::Optimize(Row& objective)
+    {
+        for (;;)
+        {
+            const Symbol entering = EnteringSymbol(objective);
+            if (entering == 0)
+            {
+                return;
+            }
+            const auto it = LeavingRow(entering);
+            if (it == m_rows.end())
+            {
+                // Unbounded objective: cannot happen with non-negative
+                // error weights, but never loop on it.
+                return;
+            }
+            const Symbol leaving = it->first;
+            Row row = std::move(it->second);
+            m_rows.erase(it);
+            row.SolveFor(leaving, entering);
+            Substitute(entering, row);
+            m_rows.insert_or_assign(entering, std::move(row));
+        }
+    }
+
+    void ConstraintSolver::DualOptimize()
+    {
+        while (!m_infeasibleRows.empty())
+        {
+            const Symbol leaving = m_infeasibleRows.back();
+            m_infeasibleRows.pop_back();
+            const auto it = m_rows.find(leaving);
+            if (it == m_rows.end() || NearZero(it->second.Constant()) || it->second.Constant() >= 0.0)
+            {
+                continue;
+            }
+            const Symbol entering = DualEnteringSymbol(it->second);
+            if (entering == 0)
+            {
+                continue;
+            }
+            Row row = std::move(it->second);
+            m_rows.erase(it);
+            row.SolveFor(leaving, entering);
+            Substitute(entering, row);
+            m_rows.insert_or_assign(entering, std::move(row));
+        }
+    }
+
+    ConstraintSolver::Symbol ConstraintSolver::EnteringSymbol(const Row& objective) const
+    {
+        for (const Row::Cell& cell : objective.Cells())
+        {
+            if (TypeOf(cell.symbol) != SymbolType::Dummy && cell.coefficient < 0.0)
+            {
+                return cell.symbol;
+            }
+        }
+        return 0;
+    }
+
+    ConstraintSolver::Symbol ConstraintSolver::DualEnteringSymbol(const Row& row) const
+    {
+        Symbol entering = 0;
+        double ratio = std::numeric_limits<double>::max();
+        for (const Row::Cell& cell : row.Cells())
+        {
+            if (cell.coefficient > 0.0 && TypeOf(cell.symbol) != SymbolType::Dummy)
+            {
+                const double r = m_objective.CoefficientFor(cell.symbol) / cell.coefficient;
+                if (r < ratio)
+                {
+                    ratio = r;
+                    entering = cell.symbol;
+                }
+            }
+        }
+        return entering;
+    }
+
+    ConstraintSolver::Symbol ConstraintSolver::AnyPivotableSymbol(const Row& row) const
+    {
+        for (const Row::Cell& cell : row.Cells())
+        {
+            if (TypeOf(cell.symbol) == SymbolType::Slack || TypeOf(cell.symbol) == SymbolType::Error)
+            {
+                return cell.symbol;
+            }
+        }
+        return 0;
+    }
+
+    std::map<ConstraintSolver::Symbol, ConstraintSolver::Row>::iterator ConstraintSolver::LeavingRow(Symbol entering)
+    {
+        auto found = m_rows.end();
+        double ratio = std::numeric_limits<double>::max();
+        for (auto it = m_rows.begin(); it != m_rows.end(); ++it)
+        {
+            if (TypeOf(it->first) == SymbolType::External)
+            {
+                continue;
+            }
+            const double coefficient = it->second.CoefficientFor(entering);
+            if (coefficient < 0.0)
+            {
+                const double r = -it->second.Constant() / coefficient;
+                if (r < ratio)
+                {
+                    ratio = r;
+                    found = it;
+                }
+            }
+        }
+        return found;
+    }
+
+    std::map<ConstraintSolver::Symbol, ConstraintSolver::Row>::iterator ConstraintSolver::MarkerLeavingRow(Symbol marker)
+    {
+        // Prefer a restricted row with a negative coefficient (keeps the
+        // tableau feasible), then a restricted one with a positive
+        // coefficient, then an unrestricted (external) row.
+        const double dmax = std::numeric_limits<double>::max();
+        double r1 = dmax;
+        double r2 = dmax;
+        auto first = m_rows.end();
+        auto second = m_rows.end();
+        auto third = m_rows.end();
+        for (auto it = m_rows.begin(); it != m_rows.end(); ++it)
+        {
+            const double coefficient = it->second.CoefficientFor(marker);
+            if (coefficient == 0.0)
+            {
+                continue;
+            }
+            if (TypeOf(it->first) == SymbolType::External)
+            {
+                third = it;
+            }
+            else if (coefficient < 0.0)
+            {
+                const double r = -it->second.Constant() / coefficient;
+                if (r < r1)
+                {
+                    r1 = r;
+                    first = it;
+                }
+            }
+            else
+            {
+                const double r = it->second.Constant() / coefficient;
+                if (r < r2)
+                {
+                    r2 = r;
+                    second = it;
+                }
+            }
+        }
+        if (first != m_rows.end())
+        {
+            return first;
+        }
+        if (second != m_rows.end())
+        {
+            return second;
+        }
+        return third;
+    }
+
+    void ConstraintSolver::RemoveConstraintEffects(const ConstraintInfo& info)
+    {
+        if (info.tag.marker != 0 && TypeOf(info.tag.marker) == SymbolType::Error)
+        {
+            RemoveMarkerEffects(info.tag.marker, info.strength);
+        }
+        if (info.tag.other != 0 && TypeOf(info.tag.other) == SymbolType::Error)
+        {
+            RemoveMarkerEffects(info.tag.other, info.strength);
+        }
+    }
+
+    void ConstraintSolver::RemoveMarkerEffects(Symbol marker, double strength)
+    {
+        const auto it = m_rows.find(marker);
+        if (it != m_rows.end())
+        {
+            m_objective.Insert(it->second, -strength);
+        }
+        else
+        {
+            m_objective.Insert(marker, -strength);
+        }
+    }
+}
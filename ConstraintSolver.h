@@ -0,0 +1,195 @@
+#pragma once
+
+// ConstraintSolver.h - incremental linear constraint solver (Cassowary).
+//
+// Platform-neutral. Variables are plain ids; constraints are linear
+// expressions compared with zero ("expr <= 0", ">= 0", "== 0") at a
+// strength. Required constraints must hold; weaker ones are satisfied as far
+// as possible, stronger before weaker. The tableau is kept between calls:
+// adding or removing a constraint re-optimizes from the current solution, and
+// changing an edit variable's suggested value (SuggestValue) re-solves with
+// the dual simplex, which touches only the rows the change reaches. That is
+// what makes re-layout on a window resize cheap.
+//
+// Follows the algorithm of Badros, Borning and Stuckey, "The Cassowary
+// Linear Arithmetic Constraint Solving Algorithm" (2001), in the shape of
+// the kiwi implementation.
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace FD2D
+{
+    using ConstraintVar = std::uint32_t;
+    using ConstraintId = std::uint32_t;
+    inline constexpr ConstraintId kNoConstraint = 0;
+
+    namespace ConstraintStrength
+    {
+        inline constexpr double Required = 1001001000.0;
+        inline constexpr double Strong = 1000000.0;
+        inline constexpr double Medium = 1000.0;
+        inline constexpr double Weak = 1.0;
+    }
+
+    enum class ConstraintOp : std::uint8_t
+    {
+        LessEqual,
+        GreaterEqual,
+        Equal
+    };
+
+    // sum(coefficient * var) + constant.
+    struct LinearExpr
+    {
+        struct Term
+        {
+            ConstraintVar var { 0 };
+            double coefficient { 1.0 };
+        };
+
+        LinearExpr& Add(ConstraintVar var, double coefficient = 1.0)
+        {
+            terms.push_back({ var, coefficient });
+            return *this;
+        }
+        LinearExpr& Add(double value)
+        {
+            constant += value;
+            return *this;
+        }
+
+        std::vector<Term> terms {};
+        double constant { 0.0 };
+    };
+
+    class ConstraintSolver
+    {
+    public:
+        ConstraintVar AddVariable();
+        // Hands `var` back for reuse by AddVariable. Remove the constraints
+        // and edit variable that use it first; its value reads 0 after.
+        void RemoveVariable(ConstraintVar var);
+        double Value(ConstraintVar var) const { return (var < m_values.size()) ? m_values[var] : 0.0; }
+
+        // Adds "expr op 0". Returns kNoConstraint when a required constraint
+        // conflicts with the required ones already present (the solver is
+        // left as it was). Non-required constraints always succeed.
+        ConstraintId AddConstraint(const LinearExpr& expr, ConstraintOp op, double strength = ConstraintStrength::Required);
+        bool RemoveConstraint(ConstraintId id);
+        bool HasConstraint(ConstraintId id) const { return m_constraints.count(id) != 0; }
+
+        // Edit variables take suggested values (at most Strong strength;
+        // a required edit would make most suggestions unsatisfiable).
+        bool AddEditVariable(ConstraintVar var, double strength = ConstraintStrength::Strong);
+        bool RemoveEditVariable(ConstraintVar var);
+        bool HasEditVariable(ConstraintVar var) const { return m_edits.count(var) != 0; }
+        bool SuggestValue(ConstraintVar var, double value);
+
+        // Copies the current solution into Value().
+        void UpdateVariables();
+
+        std::size_t ConstraintCount() const { return m_constraints.size(); }
+
+    private:
+        enum class SymbolType : std::uint8_t
+        {
+            Invalid,
+            External,
+            Slack,
+            Error,
+            Dummy
+        };
+
+        // Symbol 0 is Invalid; the type of symbol s is m_symbolTypes[s].
+        using Symbol = std::uint32_t;
+
+        // Row of the tableau: constant + sum(coefficient * symbol), with the
+        // cells sorted by symbol so merges are linear and iteration order (and
+        // with it pivot choice) is deterministic.
+        class Row
+        {
+        public:
+            struct Cell
+            {
+                Symbol symbol;
+                double coefficient;
+            };
+
+            explicit Row(double constant = 0.0) : m_constant(constant) {}
+
+            double Constant() const { return m_constant; }
+            const std::vector<Cell>& Cells() const { return m_cells; }
+            double Add(double value) { return m_constant += value; }
+            double CoefficientFor(Symbol symbol) const;
+
+            void Insert(Symbol symbol, double coefficient = 1.0);
+            void Insert(const Row& other, double coefficient = 1.0);
+            void Remove(Symbol symbol);
+            void ReverseSign();
+            // Rewrites "0 = row" as "symbol = ...".
+            void SolveFor(Symbol symbol);
+            // Rewrites "lhs = row" (lhs not in the row) as "rhs = ...".
+            void SolveFor(Symbol lhs, Symbol rhs);
+            void Substitute(Symbol symbol, const Row& row);
+
+        private:
+            std::vector<Cell> m_cells {};
+            double m_constant { 0.0 };
+        };
+
+        struct Tag
+        {
+            Symbol marker { 0 };
+            Symbol other { 0 };
+        };
+
+        struct ConstraintInfo
+        {
+            Tag tag {};
+            double strength { 0.0 };
+        };
+
+        struct EditInfo
+        {
+            ConstraintId constraint { kNoConstraint };
+            Tag tag {};
+            double constant { 0.0 };
+        };
+
+        Symbol NewSymbol(SymbolType type);
+        SymbolType TypeOf(Symbol symbol) const { return m_symbolTypes[symbol]; }
+        Symbol VarSymbol(ConstraintVar var);
+
+        Row CreateRow(const LinearExpr& expr, ConstraintOp op, double strength, Tag& tag);
+        Symbol ChooseSubject(const Row& row, const Tag& tag) const;
+        bool AllDummies(const Row& row) const;
+        bool AddWithArtificialVariable(const Row& row);
+        void Substitute(Symbol symbol, const Row& row);
+        void Optimize(Row& objective);
+        void DualOptimize();
+        Symbol EnteringSymbol(const Row& objective) const;
+        Symbol DualEnteringSymbol(const Row& row) const;
+        Symbol AnyPivotableSymbol(const Row& row) const;
+        std::map<Symbol, Row>::iterator LeavingRow(Symbol entering);
+        std::map<Symbol, Row>::iterator MarkerLeavingRow(Symbol marker);
+        void RemoveConstraintEffects(const ConstraintInfo& info);
+        void RemoveMarkerEffects(Symbol marker, double strength);
+
+        std::vector<SymbolType> m_symbolTypes { SymbolType::Invalid };
+        std::vector<double> m_values {};
+        std::vector<Symbol> m_varSymbols {};
+        std::vector<ConstraintVar> m_freeVars {};
+        std::map<Symbol, Row> m_rows {};
+        std::unordered_map<ConstraintId, ConstraintInfo> m_constraints {};
+        std::unordered_map<ConstraintVar, EditInfo> m_edits {};
+        std::vector<Symbol> m_infeasibleRows {};
+        Row m_objective {};
+        Row m_artificial {};
+        bool m_hasArtificial { false };
+        ConstraintId m_nextConstraint { 1 };
+    };
+}
@@ -0,0 +1,69 @@
+#include "ContentSlots.h"
+
+namespace FD2D
+{
+    ContentSlots::Placement ContentSlots::Offer(ContentQuality quality, std::uint64_t nowMs)
+    {
+        if (quality == ContentQuality::None)
+        {
+            return Placement::Rejected;
+        }
+
+        // A preview that lands after the full image (cache hit, racing
+        // workers) must never replace it, and a repeat of what is already
+        // there (a request re-issued after culling) gains nothing from a fade.
+        const ContentQuality newest = (m_pending != ContentQuality::None) ? m_pending : m_primary;
+        if (quality <= newest)
+        {
+            return Placement::Rejected;
+        }
+
+        if (m_primary == ContentQuality::None || m_fadeMs == 0)
+        {
+            m_primary = quality;
+            m_pending = ContentQuality::None;
+            m_pendingOpacity = 0.0f;
+            return Placement::ReplacePrimary;
+        }
+
+        const bool wasFading = (m_pending != ContentQuality::None);
+        if (wasFading)
+        {
+            m_primary = m_pending;
+        }
+
+        m_pending = quality;
+        m_fadeStartMs = nowMs;
+        m_pendingOpacity = 0.0f;
+        return wasFading ? Placement::PromoteThenStartFade : Placement::StartFade;
+    }
+
+    bool ContentSlots::Advance(std::uint64_t nowMs)
+    {
+        if (m_pending == ContentQuality::None)
+        {
+            return false;
+        }
+
+        const std::uint64_t elapsed = (nowMs > m_fadeStartMs) ? (nowMs - m_fadeStartMs) : 0;
+        if (elapsed >= m_fadeMs)
+        {
+            m_primary = m_pending;
+            m_pending = ContentQuality::None;
+            m_pendingOpacity = 0.0f;
+            return true;
+        }
+
+        const float t = static_cast<float>(elapsed) / static_cast<float>(m_fadeMs);
+        m_pendingOpacity = t * t * (3.0f - 2.0f * t);
+        return false;
+    }
+
+    void ContentSlots::Reset()
+    {
+        m_primary = ContentQuality::None;
+        m_pending = ContentQuality::None;
+        m_fadeStartMs = 0;
+        m_pendingOpacity = 0.0f;
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+// ContentSlots.h - primary/pending content slot state machine for
+// progressive (preview-first) image display with a cross-fade.
+//
+// Platform-neutral and content-agnostic: it only decides where newly arrived
+// content goes and how far the fade has progressed. The owner (Image) keeps
+// the actual primary/pending bitmaps and applies the returned decisions, so
+// there is never a frame with neither slot populated.
+
+#include <cstdint>
+
+namespace FD2D
+{
+    enum class ContentQuality : std::uint8_t
+    {
+        None,
+        Preview,   // fast low-resolution stand-in (thumbnail, mip, scaled decode)
+        Full
+    };
+
+    class ContentSlots
+    {
+    public:
+        enum class Placement
+        {
+            Rejected,             // lower quality than what is shown or pending, or the same again
+            ReplacePrimary,       // show immediately (nothing shown yet, or fades disabled)
+            StartFade,            // put in the pending slot and fade it in
+            PromoteThenStartFade  // finish the running fade (pending -> primary) first
+        };
+
+        void SetFadeDurationMs(std::uint32_t durationMs) { m_fadeMs = durationMs; }
+        std::uint32_t FadeDurationMs() const { return m_fadeMs; }
+
+        // Decides where content of `quality` arriving at `nowMs` goes and
+        // updates the slot state accordingly. The slots hold one source at a
+        // time (the owner resets them when it changes), so content of the
+        // quality already shown or pending is a repeat and is not faded in.
+        Placement Offer(ContentQuality quality, std::uint64_t nowMs);
+
+        // Advances the fade. Returns true exactly once per fade, when the
+        // pending slot has become the primary (the owner swaps its content).
+        bool Advance(std::uint64_t nowMs);
+
+        // Opacity of the pending slot (0..1, smoothstep) as of the last Advance.
+        float PendingOpacity() const { return m_pendingOpacity; }
+        bool IsFading() const { return m_pending != ContentQuality::None; }
+        // When the running fade completes (valid while IsFading).
+        std::uint64_t FadeEndMs() const { return m_fadeStartMs + m_fadeMs; }
+        ContentQuality PrimaryQuality() const { return m_primary; }
+        ContentQuality PendingQuality() const { return m_pending; }
+
+        void Reset();
+
+    private:
+        ContentQuality m_primary { ContentQuality::None };
+        ContentQuality m_pending { ContentQuality::None };
+        std::uint64_t m_fadeStartMs { 0 };
+        std::uint32_t m_fadeMs { 150 };
+        float m_pendingOpacity { 0.0f };
+    };
+}
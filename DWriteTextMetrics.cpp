@@ -0,0 +1,151 @@
+#include "DWriteTextMetrics.h"
+
+#include <vector>
+
+namespace FD2D
+{
+    ComPtr<IDWriteTextFormat> DWriteTextMetrics::FormatFor(std::wstring_view family, float size)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto key = std::make_pair(std::wstring(family), size);
+        auto it = m_formats.find(key);
+        if (it != m_formats.end())
+        {
+            return it->second;
+        }
+
+        IDWriteFactory* factory = Core::DWriteFactory();
+        if (factory == nullptr)
+        {
+            return nullptr;
+        }
+
+        ComPtr<IDWriteTextFormat> format;
+        if (FAILED(factory->CreateTextFormat(
+                key.first.c_str(),
+                nullptr,
+                DWRITE_FONT_WEIGHT_NORMAL,
+                DWRITE_FONT_STYLE_NORMAL,
+                DWRITE_FONT_STRETCH_NORMAL,
+                size,
+                L"",
+                &format)))
+        {
+            return nullptr;
+        }
+        m_formats.emplace(std::move(key), format);
+        return format;
+    }
+
+    TextExtent DWriteTextMetrics::Measure(std::wstring_view family, float size, std::wstring_view text)
+    {
+        IDWriteFactory* factory = Core::DWriteFactory();
+        ComPtr<IDWriteTextFormat> format = FormatFor(family, size);
+        if (factory == nullptr || !format)
+        {
+            return {};
+        }
+
+        // Measure against an effectively unbounded box (no target/rendered
+        // layout required) so metrics.width/height reflect the text's true
+        // intrinsic size - real glyph advances and the font's actual
+        // ascent+descent+lineGap - rather than the old "charCount * size *
+        // 0.6" / "size * 1.2" guesses, which were consistently short enough
+        // to hard-clip descenders (e.g. the "g" in "Brightness") once a
+        // control sized its label rect directly off Measure()'s result.
+        constexpr float kUnbounded = 100000.0f;
+        ComPtr<IDWriteTextLayout> layout;
+        (void)factory->CreateTextLayout(
+            text.data(),
+            static_cast<UINT32>(text.size()),
+            format.Get(),
+            kUnbounded,
+            kUnbounded,
+            &layout);
+
+        DWRITE_TEXT_METRICS metrics {};
+        if (!layout || FAILED(layout->GetMetrics(&metrics)) || metrics.width <= 0.0f)
+        {
+            return {};
+        }
+
+        // +1px safety margin: GetMetrics() reports ideal (sub-pixel) glyph
+        // extents, while the rect a caller later hands to
+        // DrawText*(..., D2D1_DRAW_TEXT_OPTIONS_CLIP) goes through
+        // pixel snapping/rounding - without a little slack, that rounding
+        // can still shave a pixel off a descender on some sizes/DPIs.
+        return { metrics.width, metrics.height + 1.0f };
+    }
+
+    bool DWriteFontAdvances(std::wstring_view family, FontAdvances& out)
+    {
+        IDWriteFactory* factory = Core::DWriteFactory();
+        if (factory == nullptr)
+        {
+            return false;
+        }
+
+        ComPtr<IDWriteFontCollection> fonts;
+        if (FAILED(factory->GetSystemFontCollection(&fonts)))
+        {
+            return false;
+        }
+
+        const std::wstring name(family);
+        UINT32 index = 0;
+        BOOL exists = FALSE;
+        if (FAILED(fonts->FindFamilyName(name.c_str(), &index, &exists)) || !exists)
+        {
+            return false;
+        }
+
+        ComPtr<IDWriteFontFamily> fontFamily;
+        ComPtr<IDWriteFont> font;
+        ComPtr<IDWriteFontFace> face;
+        if (FAILED(fonts->GetFontFamily(index, &fontFamily)) ||
+            FAILED(fontFamily->GetFirstMatchingFont(DWRITE_FONT_WEIGHT_NORMAL, DWRITE_FONT_STRETCH_NORMAL, DWRITE_FONT_STYLE_NORMAL, &font)) ||
+            FAILED(font->CreateFontFace(&face)))
+        {
+            return false;
+        }
+
+        DWRITE_FONT_METRICS fontMetrics {};
+        face->GetMetrics(&fontMetrics);
+        if (fontMetrics.designUnitsPerEm == 0)
+        {
+            return false;
+        }
+        const float perEm = 1.0f / static_cast<float>(fontMetrics.designUnitsPerEm);
+
+        constexpr UINT32 kCount = static_cast<UINT32>(FontAdvances::kTableSize);
+        std::vector<UINT32> codePoints(kCount);
+        for (UINT32 c = 0; c < kCount; ++c)
+        {
+            codePoints[c] = c;
+        }
+        std::vector<UINT16> glyphs(kCount);
+        std::vector<DWRITE_GLYPH_METRICS> glyphMetrics(kCount);
+        if (FAILED(face->GetGlyphIndices(codePoints.data(), kCount, glyphs.data())) ||
+            FAILED(face->GetDesignGlyphMetrics(glyphs.data(), kCount, glyphMetrics.data(), FALSE)))
+        {
+            return false;
+        }
+
+        // Code points the font lacks (glyph 0) keep zero width, as do
+        // controls; past the table, the average printable ASCII advance
+        // stands in for whatever DirectWrite would fall back to.
+        float asciiTotal = 0.0f;
+        for (UINT32 c = 0; c < kCount; ++c)
+        {
+            const bool mapped = glyphs[c] != 0 && c >= 0x20;
+            out.advance[c] = mapped ? static_cast<float>(glyphMetrics[c].advanceWidth) * perEm : 0.0f;
+            if (c >= 0x20 && c < 0x7F)
+            {
+                asciiTotal += out.advance[c];
+            }
+        }
+        out.advance[FontAdvances::kTableSize] = asciiTotal / static_cast<float>(0x7F - 0x20);
+        out.lineHeight = static_cast<float>(fontMetrics.ascent + fontMetrics.descent + fontMetrics.lineGap) * perEm;
+        return true;
+    }
+}
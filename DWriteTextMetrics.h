@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Core.h"
+#include "TextMetrics.h"
+
+#include <map>
+#include <utility>
+
+namespace FD2D
+{
+    // Text's default metrics: a DirectWrite layout of the string against an
+    // unbounded box, so the size includes shaping, kerning and font
+    // fallback. Text formats are cached per family and size.
+    class DWriteTextMetrics final : public TextMetricsProvider
+    {
+    public:
+        TextExtent Measure(std::wstring_view family, float size, std::wstring_view text) override;
+
+    private:
+        ComPtr<IDWriteTextFormat> FormatFor(std::wstring_view family, float size);
+
+        std::mutex m_mutex {};
+        std::map<std::pair<std::wstring, float>, ComPtr<IDWriteTextFormat>> m_formats {};
+    };
+
+    // FontAdvanceSource over the system font collection (regular weight):
+    // design advances and line metrics of the installed font, for
+    // AdvanceTextMetrics to sum without building a layout per string.
+    bool DWriteFontAdvances(std::wstring_view family, FontAdvances& out);
+}
@@ -32,27 +32,11 @@ namespace FD2D
 
     Size DockPanel::Measure(Size available)
     {
-        // Measure children with remaining space; conservative return = available.
-        Size remaining = available;
-        for (auto& child : m_order)
-        {
-            if (!child)
-            {
-                continue;
-            }
-
-            Dock dock = Dock::Fill;
-            auto it = m_docks.find(child.get());
-            if (it != m_docks.end())
-            {
-                dock = it->second;
-            }
-
-            Size childAvail = remaining;
-            child->Measure(childAvail);
-
-            // For Auto measure we'd shrink remaining, but we just measure and keep available as-is.
-        }
+        // Every child is measured against the full available size (the
+        // remaining space is only carved up in Arrange), so the children are
+        // independent; conservative return = available.
+        std::pmr::vector<Size> measured(m_order.size(), Size {}, ScratchMemory());
+        MeasureChildren(m_order.data(), m_order.size(), available, measured.data());
 
         m_desired = available;
         return m_desired;
@@ -1,6 +1,8 @@
 #include "DynamicPanel.h"
+#include "LayoutEngine.h"
 
 #include <algorithm>
+#include <memory_resource>
 
 namespace FD2D
 {
@@ -25,6 +27,7 @@ namespace FD2D
     {
         m_hgap = horizontal;
         m_vgap = vertical;
+        m_rowsValid = false;
         Invalidate();
     }
 
@@ -35,52 +38,170 @@ namespace FD2D
             return;
         }
         m_forceSingle = force;
+        m_rowsValid = false;
         Invalidate();
     }
 
-    float DynamicPanel::LayoutRows(float contentWidth, std::vector<Placed>* out,
-                                   float* outUsedWidth) const
+    void DynamicPanel::SetChildFlex(const std::shared_ptr<Wnd>& child, float grow, float shrink)
     {
-        float x = 0.0f, y = 0.0f, rowH = 0.0f, usedW = 0.0f;
-        bool rowEmpty = true;
-        for (const auto& child : ChildrenInOrder())
+        if (!child)
         {
-            if (!child)
+            return;
+        }
+        m_flex[child.get()] = { child, (std::max)(0.0f, grow), (std::max)(0.0f, shrink) };
+        m_itemsDirty = true;
+        Invalidate();
+    }
+
+    void DynamicPanel::SetJustifyContent(FlexJustify justify)
+    {
+        m_justify = justify;
+        Invalidate();
+    }
+
+    void DynamicPanel::SetAlignContent(FlexJustify align)
+    {
+        m_alignContent = align;
+        Invalidate();
+    }
+
+    void DynamicPanel::SetAlignItems(FlexAlign align)
+    {
+        m_alignItems = align;
+        Invalidate();
+    }
+
+    bool DynamicPanel::ItemsMatchChildren() const
+    {
+        const auto& children = ChildrenInOrder();
+        if (m_itemsDirty || m_items.size() != children.size())
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < children.size(); ++i)
+        {
+            if (m_items[i].wnd != children[i].get())
             {
-                continue;
+                return false;
             }
-            // Hand the child the available width so a nested DynamicPanel can
-            // reflow itself to fit.
-            const Size s = child->Measure({ contentWidth, kInfWidth });
-            // Start a new row when this child won't fit (unless the row is
-            // empty - an over-wide child still gets its own row rather than
-            // vanishing), or unconditionally in single-column (compact) mode.
-            if (!rowEmpty && (m_forceSingle || (x + m_hgap + s.w) > contentWidth))
+        }
+        return true;
+    }
+
+    bool DynamicPanel::ItemsStillMeasure(float contentWidth) const
+    {
+        const auto& children = ChildrenInOrder();
+        for (std::size_t i = 0; i < children.size(); ++i)
+        {
+            const Item& item = m_items[i];
+            if (children[i] && !children[i]->MeasureUnchanged({ item.w, item.h }, { contentWidth, kInfWidth }))
             {
-                usedW = (std::max)(usedW, x); // widest row so far
-                x = 0.0f;
-                y += rowH + m_vgap;
-                rowH = 0.0f;
-                rowEmpty = true;
+                return false;
             }
-            if (!rowEmpty)
+        }
+        return true;
+    }
+
+    void DynamicPanel::MeasureItems(float contentWidth)
+    {
+        const auto& children = ChildrenInOrder();
+        if (!ItemsMatchChildren())
+        {
+            // Factors of destroyed children would otherwise pile up, or pass
+            // to a new child at the same address.
+            std::erase_if(m_flex, [](const auto& entry) { return entry.second.wnd.expired(); });
+
+            m_items.assign(children.size(), Item {});
+            for (std::size_t i = 0; i < children.size(); ++i)
             {
-                x += m_hgap;
+                Item& item = m_items[i];
+                item.wnd = children[i].get();
+                const auto it = m_flex.find(item.wnd);
+                if (it != m_flex.end())
+                {
+                    item.grow = it->second.grow;
+                    item.shrink = it->second.shrink;
+                }
             }
-            if (out != nullptr)
+            m_itemsDirty = false;
+            m_rowsValid = false;
+        }
+        else if (m_measuredWidth >= 0.0f && ItemsStillMeasure(contentWidth))
+        {
+            // A resize the children do not react to: keep their sizes and let
+            // EnsureRows decide whether the breaks still hold.
+            m_measuredWidth = contentWidth;
+            return;
+        }
+
+        // Hand the children the available width so a nested DynamicPanel can
+        // reflow itself to fit.
+        std::pmr::vector<Size> measured(children.size(), Size {}, ScratchMemory());
+        MeasureChildren(children.data(), children.size(), { contentWidth, kInfWidth }, measured.data());
+        for (std::size_t i = 0; i < children.size(); ++i)
+        {
+            Item& item = m_items[i];
+            if (item.w != measured[i].w || item.h != measured[i].h)
+            {
+                item.w = measured[i].w;
+                item.h = measured[i].h;
+                m_rowsValid = false;
+            }
+        }
+        m_measuredWidth = contentWidth;
+    }
+
+    void DynamicPanel::EnsureRows(float contentWidth)
+    {
+        if (m_rowsValid && contentWidth >= m_rowsMinWidth && contentWidth < m_rowsMaxWidth)
+        {
+            return;
+        }
+
+        // Null children take no space and no gap: break over the live ones.
+        std::pmr::memory_resource* scratch = ScratchMemory();
+        std::pmr::vector<float> widths(scratch);
+        std::pmr::vector<std::uint32_t> live(scratch);
+        widths.reserve(m_items.size());
+        live.reserve(m_items.size());
+        for (std::size_t i = 0; i < m_items.size(); ++i)
+        {
+            if (m_items[i].wnd != nullptr)
             {
-                out->push_back({ child.get(), x, y, s.w, s.h });
+                widths.push_back(m_items[i].w);
+                live.push_back(static_cast<std::uint32_t>(i));
             }
-            x += s.w;
-            rowH = (std::max)(rowH, s.h);
-            rowEmpty = false;
         }
-        usedW = (std::max)(usedW, x); // last row
-        if (outUsedWidth != nullptr)
+
+        // Rows break when the next child won't fit (an over-wide child still
+        // gets its own row rather than vanishing), or after every child in
+        // single-column (compact) mode; see LayoutKernels::BreakRows.
+        std::pmr::vector<std::uint32_t> ends(widths.size(), 0u, scratch);
+        const std::size_t rows = LayoutKernels::BreakRows(widths.data(), widths.size(), contentWidth, m_hgap,
+            m_forceSingle, ends.data(), &m_rowsMinWidth, &m_rowsMaxWidth);
+
+        // Row ends index m_items (null children fall inside rows, at 0x0).
+        m_rowEnds.resize(rows);
+        m_rowHeights.assign(rows, 0.0f);
+        m_usedWidth = 0.0f;
+        m_contentHeight = 0.0f;
+        std::size_t begin = 0;
+        for (std::size_t r = 0; r < rows; ++r)
         {
-            *outUsedWidth = usedW;
+            const std::size_t end = ends[r];
+            float rowW = 0.0f;
+            for (std::size_t k = begin; k < end; ++k)
+            {
+                const Item& item = m_items[live[k]];
+                rowW += item.w + ((k > begin) ? m_hgap : 0.0f);
+                m_rowHeights[r] = (std::max)(m_rowHeights[r], item.h);
+            }
+            m_rowEnds[r] = (end < live.size()) ? live[end] : static_cast<std::uint32_t>(m_items.size());
+            m_usedWidth = (std::max)(m_usedWidth, rowW);
+            m_contentHeight += m_rowHeights[r] + ((r > 0) ? m_vgap : 0.0f);
+            begin = end;
         }
-        return y + rowH;
+        m_rowsValid = true;
     }
 
     Size DynamicPanel::Measure(Size available)
@@ -90,16 +211,16 @@ namespace FD2D
         const float innerW = unconstrained ? kInfWidth
                                            : (std::max)(0.0f, available.w - chrome);
 
-        float usedW = 0.0f;
-        const float totalH = LayoutRows(innerW, nullptr, &usedW);
+        MeasureItems(innerW);
+        EnsureRows(innerW);
 
         // Report the width the content actually USES, not the width we were
         // offered - otherwise a nested panel would greedily claim its whole row
         // and push its siblings onto new rows. Capped at the offered width when
         // constrained.
-        const float desiredW = unconstrained ? usedW : (std::min)(usedW, innerW);
+        const float desiredW = unconstrained ? m_usedWidth : (std::min)(m_usedWidth, innerW);
 
-        m_desired = { desiredW + chrome, totalH + chrome };
+        m_desired = { desiredW + chrome, m_contentHeight + chrome };
         return m_desired;
     }
 
@@ -108,15 +229,75 @@ namespace FD2D
         const Rect inset = Inset(finalRect, m_margin);
         const Rect childArea = Inset(inset, m_padding);
 
-        std::vector<Placed> placed;
-        LayoutRows(childArea.w, &placed);
-        for (const Placed& p : placed)
+        // Measure's child sizes hold as long as the width hint is the same.
+        if (!ItemsMatchChildren() || childArea.w != m_measuredWidth)
         {
-            if (p.wnd == nullptr)
+            MeasureItems(childArea.w);
+        }
+        EnsureRows(childArea.w);
+
+        const auto& children = ChildrenInOrder();
+        const std::size_t rows = m_rowEnds.size();
+        float y = 0.0f;
+        float between = 0.0f;
+        LayoutKernels::Justify(m_alignContent, childArea.h - m_contentHeight, rows, &y, &between);
+
+        std::pmr::memory_resource* scratch = ScratchMemory();
+        std::pmr::vector<std::uint32_t> index(scratch);
+        std::pmr::vector<float> basis(scratch);
+        std::pmr::vector<float> grow(scratch);
+        std::pmr::vector<float> shrink(scratch);
+        std::pmr::vector<float> xs(scratch);
+        std::pmr::vector<float> ws(scratch);
+        std::size_t begin = 0;
+        for (std::size_t r = 0; r < rows; ++r)
+        {
+            index.clear();
+            basis.clear();
+            grow.clear();
+            shrink.clear();
+            for (std::size_t i = begin; i < m_rowEnds[r]; ++i)
+            {
+                const Item& item = m_items[i];
+                if (item.wnd == nullptr)
+                {
+                    continue;
+                }
+                index.push_back(static_cast<std::uint32_t>(i));
+                basis.push_back(item.w);
+                grow.push_back(item.grow);
+                shrink.push_back(item.shrink);
+            }
+            begin = m_rowEnds[r];
+
+            xs.resize(index.size());
+            ws.resize(index.size());
+            LayoutKernels::FlexRow(basis.data(), grow.data(), shrink.data(), index.size(),
+                childArea.w, m_hgap, m_justify, xs.data(), ws.data());
+
+            const float rowH = m_rowHeights[r];
+            for (std::size_t k = 0; k < index.size(); ++k)
             {
-                continue;
+                const Item& item = m_items[index[k]];
+                float h = item.h;
+                float dy = 0.0f;
+                switch (m_alignItems)
+                {
+                case FlexAlign::Start:
+                    break;
+                case FlexAlign::End:
+                    dy = rowH - h;
+                    break;
+                case FlexAlign::Center:
+                    dy = (rowH - h) * 0.5f;
+                    break;
+                case FlexAlign::Stretch:
+                    h = rowH;
+                    break;
+                }
+                children[index[k]]->Arrange({ childArea.x + xs[k], childArea.y + y + dy, ws[k], h });
             }
-            p.wnd->Arrange({ childArea.x + p.x, childArea.y + p.y, p.w, p.h });
+            y += rowH + m_vgap + between;
         }
 
         m_bounds = finalRect;
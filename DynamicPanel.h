@@ -2,7 +2,11 @@
 
 #include "Panel.h"
 #include "Layout.h"
+#include "LayoutEngine.h"
 
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace FD2D
@@ -22,6 +26,17 @@ namespace FD2D
     //   more would fit - a "compact mode" switch the application can drive from
     //   a top-level breakpoint (window width), keeping Measure and Arrange
     //   consistent instead of each nested panel guessing from its local width.
+    // - Flex: children can grow into a row's free space or shrink when they
+    //   overflow it (SetChildFlex); leftover space is placed by
+    //   SetJustifyContent along each row and SetAlignContent between rows,
+    //   and SetAlignItems places children across their row.
+    // - The measured child sizes and the row breaks are kept between passes.
+    //   Children are re-measured only when the width hint changes and a child
+    //   cannot vouch for its cached size (Wnd::MeasureUnchanged); breaks are
+    //   recomputed only when a child's size changes or the width leaves the
+    //   interval over which they stay valid. Resizing a large panel of text
+    //   therefore mostly re-places children without measuring or re-wrapping
+    //   them, and Arrange reuses Measure's child sizes.
     class DynamicPanel : public Panel
     {
     public:
@@ -37,26 +52,71 @@ namespace FD2D
         void SetForceSingleColumn(bool force);
         bool ForceSingleColumn() const { return m_forceSingle; }
 
+        // Flex factors of one child (CSS flex-grow / flex-shrink). Children
+        // without them keep their measured width (grow 0, shrink 0). Factors
+        // of a child that is destroyed are dropped.
+        void SetChildFlex(const std::shared_ptr<Wnd>& child, float grow, float shrink = 1.0f);
+
+        // Free space along a row (default Start) and between rows when the
+        // panel is arranged taller than its rows (default Start).
+        void SetJustifyContent(FlexJustify justify);
+        FlexJustify JustifyContent() const { return m_justify; }
+        void SetAlignContent(FlexJustify align);
+        FlexJustify AlignContent() const { return m_alignContent; }
+
+        // Position of a child across its row (default Start).
+        void SetAlignItems(FlexAlign align);
+        FlexAlign AlignItems() const { return m_alignItems; }
+
         Size Measure(Size available) override;
         void Arrange(Rect finalRect) override;
 
     protected:
-        // One child's placement relative to the padded content-area origin.
-        struct Placed
+        // One per child, in child order: flex factors and the size from the
+        // last measure.
+        struct Item
+        {
+            const Wnd* wnd = nullptr;
+            float w = 0.0f, h = 0.0f;
+            float grow = 0.0f, shrink = 0.0f;
+        };
+
+        struct Flex
         {
-            Wnd* wnd = nullptr;
-            float x = 0.0f, y = 0.0f, w = 0.0f, h = 0.0f;
+            std::weak_ptr<Wnd> wnd {};
+            float grow = 0.0f, shrink = 0.0f;
         };
 
-        // Wrap children for the given content width; fills `out` (when non-null)
-        // and returns the total content height. `outUsedWidth` (when non-null)
-        // receives the widest row's width. `contentWidth` may be effectively
-        // infinite for an unconstrained probe, which never wraps.
-        float LayoutRows(float contentWidth, std::vector<Placed>* out,
-                         float* outUsedWidth = nullptr) const;
+        bool ItemsMatchChildren() const;
+        // Whether every cached item size holds for `contentWidth` as well.
+        bool ItemsStillMeasure(float contentWidth) const;
+        // Measures the children against `contentWidth` (the width hint they
+        // reflow to); drops the row breaks if any size changed.
+        void MeasureItems(float contentWidth);
+        // Row breaks, row heights and used width for `contentWidth`, kept
+        // while the width stays inside the breaks' valid interval.
+        void EnsureRows(float contentWidth);
 
         float m_hgap { 12.0f };
         float m_vgap { 8.0f };
         bool m_forceSingle { false };
+        FlexJustify m_justify { FlexJustify::Start };
+        FlexJustify m_alignContent { FlexJustify::Start };
+        FlexAlign m_alignItems { FlexAlign::Start };
+        // Keyed by address; the weak reference tells a live child from a new
+        // one allocated where a destroyed child used to be.
+        std::unordered_map<const Wnd*, Flex> m_flex {};
+
+        std::vector<Item> m_items {};
+        bool m_itemsDirty { true };
+        float m_measuredWidth { -1.0f };
+
+        std::vector<std::uint32_t> m_rowEnds {};
+        std::vector<float> m_rowHeights {};
+        bool m_rowsValid { false };
+        float m_rowsMinWidth { 0.0f };
+        float m_rowsMaxWidth { 0.0f };
+        float m_usedWidth { 0.0f };
+        float m_contentHeight { 0.0f };
     };
 }
@@ -0,0 +1,367 @@
+#include "Executor.h"
+#include <iterator>
+
+namespace FD2D
+{
+    namespace
+    {
+        struct CurrentWorker
+        {
+            const Executor* owner { nullptr };
+            std::size_t index { 0 };
+        };
+
+        thread_local CurrentWorker t_currentWorker {};
+
+        std::size_t DefaultWorkerCount()
+        {
+            const unsigned int hardware = std::thread::hardware_concurrency();
+            return (hardware > 1) ? static_cast<std::size_t>(hardware - 1) : 1;
+        }
+    }
+
+    Executor::Executor()
+        : Executor(Options {})
+    {
+    }
+
+    Executor::Executor(const Options& options)
+        : m_options(options)
+    {
+        const std::size_t count = (options.workerCount != 0) ? options.workerCount : DefaultWorkerCount();
+        m_workers.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            m_workers.push_back(std::make_unique<Worker>());
+        }
+        // Every deque exists before any worker can try to steal from it.
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            m_workers[i]->thread = std::thread([this, i]() { WorkerMain(i); });
+        }
+    }
+
+    Executor::~Executor()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            m_stop.store(true, std::memory_order_release);
+        }
+        m_wake.notify_all();
+
+        for (auto& worker : m_workers)
+        {
+            if (worker->thread.joinable())
+            {
+                worker->thread.join();
+            }
+        }
+    }
+
+    bool Executor::OnWorkerThread() const
+    {
+        return t_currentWorker.owner == this;
+    }
+
+    bool Executor::Submit(Task task, WorkLane lane, CancellationToken token)
+    {
+        if (!task)
+        {
+            return false;
+        }
+        return Enqueue(Job { std::move(task), std::move(token), nullptr }, lane);
+    }
+
+    bool Executor::Enqueue(Job job, WorkLane lane)
+    {
+        if (m_stop.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        const std::size_t laneIndex = static_cast<std::size_t>(lane);
+        if (OnWorkerThread())
+        {
+            Worker& self = *m_workers[t_currentWorker.index];
+            std::lock_guard<std::mutex> lock(self.mutex);
+            self.lanes[laneIndex].push_back(std::move(job));
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(m_sharedMutex);
+            m_shared[laneIndex].push_back(std::move(job));
+        }
+        m_queued[laneIndex].fetch_add(1, std::memory_order_acq_rel);
+        WakeOne();
+        return true;
+    }
+
+    void Executor::WakeOne()
+    {
+        // Taking the lock orders this with a worker that is between checking
+        // HasRunnable() and going to sleep, so the wakeup cannot be lost.
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+        m_wake.notify_one();
+    }
+
+    void Executor::BeginFrame()
+    {
+        m_framesInProgress.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    void Executor::EndFrame()
+    {
+        if (m_framesInProgress.fetch_sub(1, std::memory_order_acq_rel) == 1 &&
+            m_queued[static_cast<std::size_t>(WorkLane::Background)].load(std::memory_order_acquire) > 0)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_sleepMutex);
+            }
+            m_wake.notify_all();
+        }
+    }
+
+    bool Executor::HasRunnable() const
+    {
+        if (m_queued[static_cast<std::size_t>(WorkLane::Interactive)].load(std::memory_order_acquire) > 0)
+        {
+            return true;
+        }
+        return !FrameInProgress() &&
+            m_queued[static_cast<std::size_t>(WorkLane::Background)].load(std::memory_order_acquire) > 0;
+    }
+
+    bool Executor::TakeFromLane(std::size_t self, std::size_t lane, Job& out)
+    {
+        if (m_queued[lane].load(std::memory_order_acquire) <= 0)
+        {
+            return false;
+        }
+
+        // Own deque, newest first.
+        if (self != kNoWorker)
+        {
+            Worker& worker = *m_workers[self];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            if (!worker.lanes[lane].empty())
+            {
+                out = std::move(worker.lanes[lane].back());
+                worker.lanes[lane].pop_back();
+                return true;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_sharedMutex);
+            if (!m_shared[lane].empty())
+            {
+                out = std::move(m_shared[lane].front());
+                m_shared[lane].pop_front();
+                return true;
+            }
+        }
+
+        // Steal the oldest job of another worker, starting after our own
+        // index so thieves spread out.
+        const std::size_t count = m_workers.size();
+        const std::size_t start = (self != kNoWorker) ? self + 1 : 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const std::size_t victim = (start + i) % count;
+            if (victim == self)
+            {
+                continue;
+            }
+
+            Worker& worker = *m_workers[victim];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            if (!worker.lanes[lane].empty())
+            {
+                out = std::move(worker.lanes[lane].front());
+                worker.lanes[lane].pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool Executor::TakeJob(std::size_t self, bool allowBackground, Job& out)
+    {
+        for (std::size_t lane = 0; lane < kLanes; ++lane)
+        {
+            if (lane == static_cast<std::size_t>(WorkLane::Background) && !allowBackground)
+            {
+                break;
+            }
+            if (TakeFromLane(self, lane, out))
+            {
+                m_queued[lane].fetch_sub(1, std::memory_order_acq_rel);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Executor::Run(Job& job)
+    {
+        if (!job.token.IsCancelled())
+        {
+            job.task();
+        }
+        job = {};
+    }
+
+    bool Executor::TryRunOne()
+    {
+        const std::size_t self = OnWorkerThread() ? t_currentWorker.index : kNoWorker;
+        Job job {};
+        if (!TakeJob(self, !FrameInProgress(), job))
+        {
+            return false;
+        }
+        Run(job);
+        return true;
+    }
+
+    bool Executor::TryRunGroupJob(const void* group, WorkLane lane)
+    {
+        const std::size_t laneIndex = static_cast<std::size_t>(lane);
+        if (m_queued[laneIndex].load(std::memory_order_acquire) <= 0)
+        {
+            return false;
+        }
+
+        const auto take = [&](std::deque<Job>& jobs, Job& out)
+        {
+            // Newest first: in a worker's deque that is the most recent fork.
+            for (auto it = jobs.rbegin(); it != jobs.rend(); ++it)
+            {
+                if (it->group == group)
+                {
+                    out = std::move(*it);
+                    jobs.erase(std::next(it).base());
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        Job job {};
+        bool found = false;
+        if (OnWorkerThread())
+        {
+            Worker& self = *m_workers[t_currentWorker.index];
+            std::lock_guard<std::mutex> lock(self.mutex);
+            found = take(self.lanes[laneIndex], job);
+        }
+        if (!found)
+        {
+            std::lock_guard<std::mutex> lock(m_sharedMutex);
+            found = take(m_shared[laneIndex], job);
+        }
+        for (std::size_t i = 0; !found && i < m_workers.size(); ++i)
+        {
+            Worker& worker = *m_workers[i];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            found = take(worker.lanes[laneIndex], job);
+        }
+        if (!found)
+        {
+            return false;
+        }
+
+        m_queued[laneIndex].fetch_sub(1, std::memory_order_acq_rel);
+        Run(job);
+        return true;
+    }
+
+    void Executor::WorkerMain(std::size_t index)
+    {
+        t_currentWorker = { this, index };
+        if (m_options.onThreadStart)
+        {
+            m_options.onThreadStart();
+        }
+
+        for (;;)
+        {
+            Job job {};
+            if (TakeJob(index, !FrameInProgress(), job))
+            {
+                Run(job);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_wake.wait(lock, [this]()
+            {
+                return m_stop.load(std::memory_order_acquire) || HasRunnable();
+            });
+            if (m_stop.load(std::memory_order_acquire))
+            {
+                break;
+            }
+        }
+
+        if (m_options.onThreadStop)
+        {
+            m_options.onThreadStop();
+        }
+        t_currentWorker = {};
+    }
+
+    TaskGroup::TaskGroup(Executor& executor, WorkLane lane, CancellationToken token)
+        : m_executor(executor)
+        , m_lane(lane)
+        , m_token(std::move(token))
+    {
+    }
+
+    TaskGroup::~TaskGroup()
+    {
+        Wait();
+    }
+
+    void TaskGroup::Run(Executor::Task task)
+    {
+        if (!task)
+        {
+            return;
+        }
+
+        m_pending->fetch_add(1, std::memory_order_acq_rel);
+        // The group checks its own token so a skipped task is still counted
+        // off; the executor never drops it once queued.
+        Executor::Job job {
+            [pending = m_pending, token = m_token, task = std::move(task)]()
+            {
+                if (!token.IsCancelled())
+                {
+                    task();
+                }
+                pending->fetch_sub(1, std::memory_order_acq_rel);
+            },
+            {},
+            this };
+        if (!m_executor.Enqueue(std::move(job), m_lane))
+        {
+            // Shutting down: the task will never run, so do not wait for it.
+            m_pending->fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    void TaskGroup::Wait()
+    {
+        while (m_pending->load(std::memory_order_acquire) != 0)
+        {
+            // Run our own queued tasks rather than block; when none is left
+            // in the queues the rest are running on workers.
+            if (!m_executor.TryRunGroupJob(this, m_lane))
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+}
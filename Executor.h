@@ -0,0 +1,178 @@
+#pragma once
+
+// Executor.h - FD2D's background thread pool.
+//
+// Platform-neutral. Each worker owns a deque per lane: work submitted from a
+// worker goes to its own deque (newest first, for fork/join locality) and
+// idle workers steal the oldest entries of other workers' deques. Work from
+// outside the pool goes to a shared FIFO per lane. Interactive work always
+// runs before background work, and while a frame is being rendered
+// (BeginFrame/EndFrame, driven by every Backplate the executor is attached
+// to) workers start no new background tasks, so bulk work does not compete
+// with the UI thread for cores during a frame.
+//
+// Cancellation is cooperative: a task whose token is cancelled before it
+// starts is dropped, and long tasks should poll the token themselves.
+// Wnd::LifetimeToken() is cancelled when the control is detached.
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace FD2D
+{
+    enum class WorkLane : std::uint8_t
+    {
+        Interactive, // the user is waiting for it (visible thumbnails, text shaping)
+        Background   // prefetch, caches; yields to interactive work and frames
+    };
+
+    // Read side of a cancellation flag. A default token is never cancelled.
+    class CancellationToken
+    {
+    public:
+        CancellationToken() = default;
+
+        bool IsCancelled() const { return m_state && m_state->load(std::memory_order_acquire); }
+        bool CanBeCancelled() const { return m_state != nullptr; }
+
+    private:
+        friend class CancellationSource;
+        explicit CancellationToken(std::shared_ptr<const std::atomic<bool>> state) : m_state(std::move(state)) {}
+
+        std::shared_ptr<const std::atomic<bool>> m_state {};
+    };
+
+    class CancellationSource
+    {
+    public:
+        CancellationSource() : m_state(std::make_shared<std::atomic<bool>>(false)) {}
+
+        CancellationToken Token() const { return CancellationToken(m_state); }
+        void Cancel() { m_state->store(true, std::memory_order_release); }
+        bool IsCancelled() const { return m_state->load(std::memory_order_acquire); }
+
+    private:
+        std::shared_ptr<std::atomic<bool>> m_state {};
+    };
+
+    class Executor
+    {
+    public:
+        using Task = std::function<void()>;
+
+        struct Options
+        {
+            // 0 = one per hardware thread, minus one for the UI thread (at least 1).
+            std::size_t workerCount { 0 };
+            // Per-worker-thread setup/teardown (e.g. COM apartment init).
+            std::function<void()> onThreadStart {};
+            std::function<void()> onThreadStop {};
+        };
+
+        Executor();
+        explicit Executor(const Options& options);
+        // Drops queued tasks and joins the workers (running tasks finish).
+        ~Executor();
+
+        Executor(const Executor&) = delete;
+        Executor& operator=(const Executor&) = delete;
+
+        // Returns false when the task was not queued (empty task, or the
+        // executor is shutting down); it will never run.
+        bool Submit(Task task, WorkLane lane = WorkLane::Background, CancellationToken token = {});
+
+        // Runs one queued task on the calling thread, interactive first;
+        // returns false when nothing was runnable. Background tasks are only
+        // taken while no frame is in progress, as for the workers.
+        bool TryRunOne();
+
+        // Frame-in-progress signal. Nests, so several windows can share one
+        // executor; background tasks start again once every frame has ended.
+        void BeginFrame();
+        void EndFrame();
+        bool FrameInProgress() const { return m_framesInProgress.load(std::memory_order_acquire) > 0; }
+
+        std::size_t WorkerCount() const { return m_workers.size(); }
+        // True on one of this executor's worker threads.
+        bool OnWorkerThread() const;
+
+    private:
+        static constexpr std::size_t kLanes = 2;
+
+        friend class TaskGroup;
+
+        struct Job
+        {
+            Task task {};
+            CancellationToken token {};
+            // TaskGroup that submitted the job, so its Wait can run exactly
+            // its own tasks.
+            const void* group { nullptr };
+        };
+
+        struct Worker
+        {
+            std::mutex mutex {};
+            std::deque<Job> lanes[kLanes] {}; // owner pops back, thieves take front
+            std::thread thread {};
+        };
+
+        bool Enqueue(Job job, WorkLane lane);
+        // Runs one queued job of `group` on the calling thread, whatever the
+        // lane and frame state (the caller is waiting for it anyway).
+        bool TryRunGroupJob(const void* group, WorkLane lane);
+        void WorkerMain(std::size_t index);
+        // Finds the next job for worker `self` (kNoWorker for a foreign thread).
+        bool TakeJob(std::size_t self, bool allowBackground, Job& out);
+        bool TakeFromLane(std::size_t self, std::size_t lane, Job& out);
+        bool HasRunnable() const;
+        void WakeOne();
+        void Run(Job& job);
+
+        static constexpr std::size_t kNoWorker = ~static_cast<std::size_t>(0);
+
+        Options m_options {};
+        std::vector<std::unique_ptr<Worker>> m_workers {};
+        std::mutex m_sharedMutex {};
+        std::deque<Job> m_shared[kLanes] {};
+        // Queued (not yet taken) jobs per lane; briefly negative while a
+        // submission is being counted.
+        std::atomic<std::int64_t> m_queued[kLanes] {};
+        std::atomic<int> m_framesInProgress { 0 };
+        std::atomic<bool> m_stop { false };
+        std::mutex m_sleepMutex {};
+        std::condition_variable m_wake {};
+    };
+
+    // Fork/join helper: Run() submits work counted by the group; Wait() runs
+    // the group's still-queued tasks on the calling thread and otherwise
+    // waits for the ones already running. It never picks up unrelated pool
+    // work, so waiting inside a frame (parallel measure) cannot end up
+    // running someone's decode or prefetch.
+    class TaskGroup
+    {
+    public:
+        explicit TaskGroup(Executor& executor, WorkLane lane = WorkLane::Interactive, CancellationToken token = {});
+        ~TaskGroup();
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        void Run(Executor::Task task);
+        void Wait();
+
+    private:
+        Executor& m_executor;
+        WorkLane m_lane { WorkLane::Interactive };
+        CancellationToken m_token {};
+        std::shared_ptr<std::atomic<std::size_t>> m_pending { std::make_shared<std::atomic<std::size_t>>(0) };
+    };
+}
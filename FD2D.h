@@ -6,16 +6,20 @@
 #include "Wnd.h"
 #include "Application.h"
 #include "Text.h"
+#include "DWriteTextMetrics.h"
 #include "Button.h"
 #include "CheckBox.h"
 #include "ComboBox.h"
 #include "Slider.h"
 #include "Image.h"
+#include "ImagePipeline.h"
+#include "WicImageDecoder.h"
 #include "Panel.h"
 #include "StackPanel.h"
 #include "DockPanel.h"
 #include "OverlayPanel.h"
 #include "GridPanel.h"
+#include "ConstraintPanel.h"
 #include "Splitter.h"
 #include "SplitPanel.h"
 #include "ScrollView.h"
@@ -0,0 +1,99 @@
+#include "FrameArena.h"
+#include <algorithm>
+#include <new>
+
+namespace FD2D
+{
+    FrameArena::FrameArena(std::size_t initialBlockBytes)
+        : m_initialBlockBytes((std::max)(initialBlockBytes, std::size_t { 1024 }))
+    {
+    }
+
+    FrameArena::~FrameArena()
+    {
+        FreeBlocks();
+    }
+
+    void FrameArena::AddBlock(std::size_t size)
+    {
+        Block block {};
+        block.data = static_cast<std::byte*>(::operator new(size));
+        block.size = size;
+        m_blocks.push_back(block);
+        ++m_blockAllocations;
+    }
+
+    void FrameArena::FreeBlocks()
+    {
+        for (Block& block : m_blocks)
+        {
+            ::operator delete(block.data);
+        }
+        m_blocks.clear();
+    }
+
+    void* FrameArena::do_allocate(std::size_t bytes, std::size_t alignment)
+    {
+        for (;;)
+        {
+            if (m_current < m_blocks.size())
+            {
+                Block& block = m_blocks[m_current];
+                const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block.data);
+                const std::uintptr_t aligned = (base + m_offset + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+                const std::size_t start = static_cast<std::size_t>(aligned - base);
+                if (start <= block.size && bytes <= block.size - start)
+                {
+                    m_offset = start + bytes;
+                    return block.data + start;
+                }
+
+                // Move on to the next block (kept from an earlier frame, or new).
+                m_usedBefore += m_offset;
+                m_offset = 0;
+                ++m_current;
+                if (m_current < m_blocks.size())
+                {
+                    continue;
+                }
+            }
+
+            // Grow geometrically; always room for this request.
+            const std::size_t last = m_blocks.empty() ? m_initialBlockBytes : m_blocks.back().size;
+            AddBlock((std::max)(last * 2, bytes + alignment));
+            m_current = m_blocks.size() - 1;
+        }
+    }
+
+    void FrameArena::Reset()
+    {
+        if (m_blocks.size() > 1)
+        {
+            std::size_t total = 0;
+            for (const Block& block : m_blocks)
+            {
+                total += block.size;
+            }
+            FreeBlocks();
+            AddBlock(total);
+        }
+        m_current = 0;
+        m_offset = 0;
+        m_usedBefore = 0;
+    }
+
+    std::size_t FrameArena::BytesUsed() const
+    {
+        return m_usedBefore + m_offset;
+    }
+
+    std::size_t FrameArena::Capacity() const
+    {
+        std::size_t total = 0;
+        for (const Block& block : m_blocks)
+        {
+            total += block.size;
+        }
+        return total;
+    }
+}
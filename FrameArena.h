@@ -0,0 +1,63 @@
+#pragma once
+
+// FrameArena.h - bump allocator for per-frame scratch memory.
+//
+// Platform-neutral. A std::pmr::memory_resource, so scratch containers are
+// plain std::pmr::vector etc. Allocation bumps a pointer through large
+// blocks; deallocation is a no-op and Reset() releases everything at once.
+// When a frame needed more than one block, Reset() replaces them with a
+// single block of their combined size, so once frames reach their usual
+// shape the arena stops touching the heap altogether.
+//
+// Backplate owns one (Backplate::ScratchArena) and resets it at the start
+// of every rendered frame; layout code reaches it through
+// Wnd::ScratchMemory(). Single-threaded: scratch must not outlive the call
+// that allocated it, and must not be shared with other threads.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace FD2D
+{
+    class FrameArena : public std::pmr::memory_resource
+    {
+    public:
+        static constexpr std::size_t kDefaultBlockBytes = 64 * 1024;
+
+        explicit FrameArena(std::size_t initialBlockBytes = kDefaultBlockBytes);
+        ~FrameArena() override;
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        void Reset();
+
+        std::size_t BytesUsed() const;
+        std::size_t Capacity() const;
+        // Heap blocks the arena has allocated so far; flat in steady state.
+        std::uint64_t BlockAllocations() const { return m_blockAllocations; }
+
+    private:
+        struct Block
+        {
+            std::byte* data { nullptr };
+            std::size_t size { 0 };
+        };
+
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void*, std::size_t, std::size_t) override {}
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+        void AddBlock(std::size_t size);
+        void FreeBlocks();
+
+        std::vector<Block> m_blocks {};
+        std::size_t m_current { 0 };   // block being bumped
+        std::size_t m_offset { 0 };    // bytes used in m_blocks[m_current]
+        std::size_t m_usedBefore { 0 }; // bytes used in blocks before m_current
+        std::size_t m_initialBlockBytes { kDefaultBlockBytes };
+        std::uint64_t m_blockAllocations { 0 };
+    };
+}
@@ -0,0 +1,90 @@
+#include "FramePacer.h"
+#include <algorithm>
+
+namespace FD2D
+{
+    namespace
+    {
+        // Headroom on top of the predicted cost: timer wakeups land up to
+        // ~1ms late, and composition wants the frame a little before vblank.
+        constexpr std::uint64_t kDeadlineMarginUs = 1500;
+    }
+
+    void FramePacer::OnFrameRendered(std::uint64_t renderUs)
+    {
+        m_costs[m_costNext] = renderUs;
+        m_costNext = (m_costNext + 1) % kCostWindow;
+        m_costCount = (std::min)(m_costCount + 1, kCostWindow);
+    }
+
+    std::uint64_t FramePacer::PredictedFrameCostUs() const
+    {
+        std::uint64_t slowest = 0;
+        for (std::size_t i = 0; i < m_costCount; ++i)
+        {
+            slowest = (std::max)(slowest, m_costs[i]);
+        }
+        return slowest + kDeadlineMarginUs;
+    }
+
+    std::uint64_t FramePacer::NextFrameStartUs(std::uint64_t lastStartUs, std::uint64_t intervalUs) const
+    {
+        if (lastStartUs == 0)
+        {
+            return 0;
+        }
+
+        const std::uint64_t cost = PredictedFrameCostUs();
+        if (!HasPhase() || cost >= m_refreshUs)
+        {
+            return lastStartUs + intervalUs;
+        }
+
+        // Half a refresh of slack: the previous frame started just before
+        // some vblank V, so the earliest allowed start picks V + interval.
+        const std::uint64_t earliest = lastStartUs + intervalUs - (std::min)(intervalUs, m_refreshUs / 2);
+
+        // First vblank V = phase + k * refresh with V - cost >= earliest.
+        const std::uint64_t target = earliest + cost;
+        std::uint64_t vblank = m_lastVblankUs;
+        if (target > vblank)
+        {
+            const std::uint64_t periods = (target - vblank + m_refreshUs - 1) / m_refreshUs;
+            vblank += periods * m_refreshUs;
+        }
+        else
+        {
+            // Phase anchor is newer than the target: step back to the earliest
+            // vblank that still satisfies it.
+            vblank -= ((vblank - target) / m_refreshUs) * m_refreshUs;
+        }
+        return vblank - cost;
+    }
+
+    void FramePacer::NoteInput(std::uint64_t atUs)
+    {
+        if (m_pendingInputUs == 0 || atUs < m_pendingInputUs)
+        {
+            m_pendingInputUs = atUs;
+        }
+    }
+
+    void FramePacer::NotePresented(std::uint64_t atUs)
+    {
+        // Input newer than the present was not in that frame; a present
+        // reported late (render thread) must not close its sample.
+        if (m_pendingInputUs == 0 || atUs < m_pendingInputUs)
+        {
+            return;
+        }
+
+        const std::uint64_t latency = atUs - m_pendingInputUs;
+        m_pendingInputUs = 0;
+
+        m_latency.minUs = (m_latency.samples == 0) ? latency : (std::min)(m_latency.minUs, latency);
+        m_latency.maxUs = (std::max)(m_latency.maxUs, latency);
+        m_latency.lastUs = latency;
+        m_latency.totalUs += latency;
+        ++m_latency.samples;
+    }
+}
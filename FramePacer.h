@@ -0,0 +1,75 @@
+#pragma once
+
+// FramePacer.h - vsync phase tracking, render deadlines and input latency.
+//
+// Platform-neutral: every call takes the current time (microseconds on the
+// Util::NowUs clock), so the policy can be driven by a fake clock. Backplate
+// feeds it vblank timestamps (swap chain frame statistics, or the frame
+// latency waitable waking), the cost of each rendered frame and the arrival
+// time of input, and asks it when a paced frame should start.
+//
+// Deadline pacing ("render just before vsync"): rather than starting a frame
+// right after the previous one was presented and then idling until vblank
+// with stale input, the frame starts as late as the recent render cost
+// allows, so the input it samples is as fresh as possible.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace FD2D
+{
+    class FramePacer
+    {
+    public:
+        // Nominal display refresh (0 = unknown). Used as the vblank period.
+        void SetRefreshIntervalUs(std::uint64_t refreshUs) { m_refreshUs = refreshUs; }
+        std::uint64_t RefreshIntervalUs() const { return m_refreshUs; }
+
+        // A vblank happened at `atUs`; anchors the vsync phase.
+        void OnVblank(std::uint64_t atUs) { m_lastVblankUs = atUs; }
+        bool HasPhase() const { return m_lastVblankUs != 0 && m_refreshUs != 0; }
+
+        // Wall time one frame took from start to present.
+        void OnFrameRendered(std::uint64_t renderUs);
+        // Conservative cost estimate: the slowest of the recent frames plus a
+        // safety margin for scheduler wakeup jitter.
+        std::uint64_t PredictedFrameCostUs() const;
+
+        // When the next paced frame should start. `lastStartUs` is when the
+        // previous paced frame started (0 = none) and `intervalUs` the target
+        // cadence (a whole number of refreshes). Returns the latest start that
+        // still finishes before the first vblank the cadence allows; a result
+        // in the past means "now". Without a vsync phase, or when frames cost
+        // a whole refresh anyway, this is plain interval pacing.
+        std::uint64_t NextFrameStartUs(std::uint64_t lastStartUs, std::uint64_t intervalUs) const;
+
+        // Input-to-present latency. NoteInput keeps the oldest input not yet
+        // shown; NotePresented closes the sample with the present time. A
+        // present older than the pending input leaves the sample open, so
+        // the render thread can report its present time after the fact.
+        struct LatencyStats
+        {
+            std::uint64_t samples { 0 };
+            std::uint64_t lastUs { 0 };
+            std::uint64_t minUs { 0 };
+            std::uint64_t maxUs { 0 };
+            std::uint64_t totalUs { 0 };
+        };
+
+        void NoteInput(std::uint64_t atUs);
+        void NotePresented(std::uint64_t atUs);
+        const LatencyStats& Latency() const { return m_latency; }
+        void ResetLatency() { m_latency = {}; }
+
+    private:
+        static constexpr std::size_t kCostWindow = 8;
+
+        std::uint64_t m_refreshUs { 0 };
+        std::uint64_t m_lastVblankUs { 0 };
+        std::uint64_t m_costs[kCostWindow] {};
+        std::size_t m_costCount { 0 };
+        std::size_t m_costNext { 0 };
+        std::uint64_t m_pendingInputUs { 0 };
+        LatencyStats m_latency {};
+    };
+}
@@ -0,0 +1,61 @@
+#include "FrameScheduler.h"
+#include <algorithm>
+
+namespace FD2D
+{
+    FrameScheduler::FrameScheduler(Clock clock)
+        : m_clock(std::move(clock))
+    {
+    }
+
+    void FrameScheduler::Begin()
+    {
+        Begin(m_clock ? m_clock() : m_nowUs);
+    }
+
+    void FrameScheduler::Begin(std::uint64_t nowUs)
+    {
+        m_nowUs = nowUs;
+        m_nextWakeUs = kNoDeadline;
+    }
+
+    void FrameScheduler::AddDeadline(std::uint64_t atUs)
+    {
+        m_nextWakeUs = (std::min)(m_nextWakeUs, (std::max)(atUs, m_nowUs));
+    }
+
+    void FrameScheduler::AddFrame(std::uint64_t lastFrameUs, std::uint64_t intervalUs)
+    {
+        if (lastFrameUs == 0 || lastFrameUs > m_nowUs)
+        {
+            AddDeadline(m_nowUs);
+            return;
+        }
+        AddDeadline(lastFrameUs + intervalUs);
+    }
+
+    std::uint64_t FrameScheduler::WaitUs(std::uint64_t maxWaitUs) const
+    {
+        if (m_nextWakeUs == kNoDeadline)
+        {
+            return maxWaitUs;
+        }
+        if (m_nextWakeUs <= m_nowUs)
+        {
+            return 0;
+        }
+        return (std::min)(m_nextWakeUs - m_nowUs, maxWaitUs);
+    }
+
+    std::uint64_t FrameScheduler::AlignToRefresh(std::uint64_t targetUs, std::uint64_t refreshUs)
+    {
+        if (refreshUs == 0)
+        {
+            return targetUs;
+        }
+
+        // Nearest whole number of refreshes, at least one.
+        const std::uint64_t refreshes = (std::max)(std::uint64_t { 1 }, (targetUs + refreshUs / 2) / refreshUs);
+        return refreshes * refreshUs;
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+// FrameScheduler.h - computes how long the message loop may sleep.
+//
+// Platform-neutral: time is microseconds on any monotonic clock, read from
+// the injected clock by Begin() or passed to Begin(nowUs), so the policy can
+// be driven by a fake clock. Each loop iteration calls Begin(), lets every
+// window report its next animation frame and timed events (tooltip dwell,
+// toast expiry, ...), then sleeps WaitUs().
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+namespace FD2D
+{
+    class FrameScheduler
+    {
+    public:
+        using Clock = std::function<std::uint64_t()>;
+
+        static constexpr std::uint64_t kNoDeadline = ~0ull;
+
+        explicit FrameScheduler(Clock clock = {});
+
+        void SetClock(Clock clock) { m_clock = std::move(clock); }
+
+        // Starts a new collection round at the clock's time (without a clock,
+        // at the previous round's time).
+        void Begin();
+        // Starts a new collection round at `nowUs`.
+        void Begin(std::uint64_t nowUs);
+        // Time of the current round.
+        std::uint64_t NowUs() const { return m_nowUs; }
+
+        // Timed event at absolute `atUs` (already due when <= now).
+        void AddDeadline(std::uint64_t atUs);
+
+        // Animation frame paced at `intervalUs` after `lastFrameUs`. A frame
+        // that is already late is due immediately rather than being pushed to a
+        // later refresh boundary. lastFrameUs == 0 means no frame yet (due now).
+        void AddFrame(std::uint64_t lastFrameUs, std::uint64_t intervalUs);
+
+        // Earliest collected deadline, or kNoDeadline.
+        std::uint64_t NextWakeUs() const { return m_nextWakeUs; }
+
+        // Sleep length until the earliest deadline, clamped to maxWaitUs (the
+        // safety heartbeat). 0 = something is due now.
+        std::uint64_t WaitUs(std::uint64_t maxWaitUs) const;
+
+        // Frame interval for a target cadence snapped to a whole number of
+        // display refreshes (60 Hz @ 16 ms -> 16.67 ms, 144 Hz @ 16 ms ->
+        // 13.9 ms), so frames land on vsync instead of beating against it.
+        // refreshUs == 0 (unknown) returns targetUs.
+        static std::uint64_t AlignToRefresh(std::uint64_t targetUs, std::uint64_t refreshUs);
+
+    private:
+        Clock m_clock {};
+        std::uint64_t m_nowUs { 0 };
+        std::uint64_t m_nextWakeUs { kNoDeadline };
+    };
+}
@@ -1,7 +1,15 @@
 #include "GridPanel.h"
+#include <algorithm>
 
 namespace FD2D
 {
+    namespace
+    {
+        // Anything at or beyond this is an unconstrained probe (matches
+        // DynamicPanel and LayoutEngine).
+        constexpr float kUnboundedExtent = 1.0e9f;
+    }
+
     GridPanel::GridPanel()
         : Panel()
     {
@@ -17,6 +25,7 @@ namespace FD2D
         if (!columns.empty())
         {
             m_columns = columns;
+            m_slotsDirty = true;
         }
     }
 
@@ -25,6 +34,7 @@ namespace FD2D
         if (!rows.empty())
         {
             m_rows = rows;
+            m_slotsDirty = true;
         }
     }
 
@@ -41,193 +51,204 @@ namespace FD2D
         cell.colSpan = (std::max)(1, colSpan);
         cell.rowSpan = (std::max)(1, rowSpan);
         m_cells[child.get()] = cell;
+        m_slotsDirty = true;
     }
 
-    static float SumStar(const std::vector<GridLength>& defs)
+    bool GridPanel::SlotsMatchChildren() const
     {
-        float total = 0.0f;
-        for (auto& d : defs)
+        const auto& children = ChildrenInOrder();
+        if (m_slotsDirty || m_slots.size() != children.size())
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < children.size(); ++i)
         {
-            if (d.type == GridLength::Type::Star)
+            if (m_slots[i].wnd != children[i].get())
             {
-                total += d.value;
+                return false;
             }
         }
-        return total;
+        return true;
     }
 
-    static float SumFixedAuto(const std::vector<GridLength>& defs, const std::vector<float>& autoSizes)
+    void GridPanel::RebuildSlots()
     {
-        float total = 0.0f;
-        for (size_t i = 0; i < defs.size(); ++i)
+        const auto& children = ChildrenInOrder();
+        const int colCount = static_cast<int>(m_columns.size());
+        const int rowCount = static_cast<int>(m_rows.size());
+
+        m_slots.assign(children.size(), Slot {});
+        for (std::size_t i = 0; i < children.size(); ++i)
         {
-            if (defs[i].type == GridLength::Type::Fixed)
-            {
-                total += defs[i].value;
-            }
-            else if (defs[i].type == GridLength::Type::Auto)
-            {
-                total += autoSizes[i];
-            }
+            Slot& slot = m_slots[i];
+            slot.wnd = children[i].get();
+            const auto it = m_cells.find(slot.wnd);
+            const GridCell cell = (it != m_cells.end()) ? it->second : GridCell {};
+            slot.cell.col = (std::min)(cell.col, colCount - 1);
+            slot.cell.row = (std::min)(cell.row, rowCount - 1);
+            slot.cell.colSpan = (std::min)(cell.colSpan, colCount - slot.cell.col);
+            slot.cell.rowSpan = (std::min)(cell.rowSpan, rowCount - slot.cell.row);
         }
-        return total;
+        m_slotsDirty = false;
     }
 
     Size GridPanel::Measure(Size available)
     {
-        std::vector<float> colAuto(m_columns.size(), 0.0f);
-        std::vector<float> rowAuto(m_rows.size(), 0.0f);
-
-        // Measure each child and collect auto sizes.
-        for (auto& child : ChildrenInOrder())
+        if (!SlotsMatchChildren())
         {
-            if (!child)
-            {
-                continue;
-            }
-
-            const GridCell cell = m_cells.count(child.get()) ? m_cells[child.get()] : GridCell {};
-
-            Size childAvail { available.w, available.h };
-            Size desired = child->Measure(childAvail);
-
-            // Only handle span == 1 for auto sizing.
-            if (cell.col < static_cast<int>(colAuto.size()) && cell.colSpan == 1 && m_columns[cell.col].type == GridLength::Type::Auto)
-            {
-                colAuto[cell.col] = (std::max)(colAuto[cell.col], desired.w);
-            }
-            if (cell.row < static_cast<int>(rowAuto.size()) && cell.rowSpan == 1 && m_rows[cell.row].type == GridLength::Type::Auto)
-            {
-                rowAuto[cell.row] = (std::max)(rowAuto[cell.row], desired.h);
-            }
+            RebuildSlots();
         }
 
-        float totalStarW = SumStar(m_columns);
-        float totalStarH = SumStar(m_rows);
-
-        float fixedAutoW = SumFixedAuto(m_columns, colAuto);
-        float fixedAutoH = SumFixedAuto(m_rows, rowAuto);
-
-        float remainW = (std::max)(0.0f, available.w - fixedAutoW);
-        float remainH = (std::max)(0.0f, available.h - fixedAutoH);
-
-        float width = fixedAutoW + (totalStarW > 0.0f ? remainW : 0.0f);
-        float height = fixedAutoH + (totalStarH > 0.0f ? remainH : 0.0f);
-
-        m_desired = { width, height };
+        std::pmr::memory_resource* scratch = ScratchMemory();
+        GridTrackAxis cols(m_columns, !(available.w < kUnboundedExtent), scratch);
+        GridTrackAxis rows(m_rows, !(available.h < kUnboundedExtent), scratch);
+        const auto& children = ChildrenInOrder();
+
+        // Measures the children inside (or outside) Star columns, each against
+        // its cell as far as the tracks are known.
+        std::pmr::vector<std::shared_ptr<Wnd>> batch(scratch);
+        std::pmr::vector<Size> batchAvailable(scratch);
+        std::pmr::vector<Size> batchDesired(scratch);
+        std::pmr::vector<std::size_t> batchSlot(scratch);
+        const auto measureBatch = [&](bool inStarColumns)
+        {
+            batch.clear();
+            batchAvailable.clear();
+            batchSlot.clear();
+            for (std::size_t i = 0; i < m_slots.size(); ++i)
+            {
+                const GridCell& cell = m_slots[i].cell;
+                if (m_slots[i].wnd == nullptr || cols.SpansStar(cell.col, cell.colSpan) != inStarColumns)
+                {
+                    continue;
+                }
+                const float w = inStarColumns ? cols.SpanSize(cell.col, cell.colSpan)
+                                              : cols.SpanAvailable(cell.col, cell.colSpan, available.w);
+                batch.push_back(children[i]);
+                batchAvailable.push_back({ w, rows.SpanAvailable(cell.row, cell.rowSpan, available.h) });
+                batchSlot.push_back(i);
+            }
+            batchDesired.assign(batch.size(), Size {});
+            MeasureChildren(batch.data(), batch.size(), batchAvailable.data(), batchDesired.data());
+            for (std::size_t k = 0; k < batch.size(); ++k)
+            {
+                m_slots[batchSlot[k]].desired = batchDesired[k];
+            }
+        };
+
+        // Sizes the Auto tracks of one axis from the children's extents.
+        // Children crossing a Star track do not count (the Star share is their
+        // space); single-track children go first, then spanning ones by span
+        // length, as in CSS Grid.
+        std::pmr::vector<std::size_t> spanning(scratch);
+        const auto fitAuto = [&](GridTrackAxis& axis, bool columns)
+        {
+            spanning.clear();
+            for (std::size_t i = 0; i < m_slots.size(); ++i)
+            {
+                const Slot& slot = m_slots[i];
+                const int start = columns ? slot.cell.col : slot.cell.row;
+                const int span = columns ? slot.cell.colSpan : slot.cell.rowSpan;
+                if (slot.wnd == nullptr || axis.SpansStar(start, span))
+                {
+                    continue;
+                }
+                if (span == 1)
+                {
+                    axis.FitSingle(start, columns ? slot.desired.w : slot.desired.h);
+                }
+                else
+                {
+                    spanning.push_back(i);
+                }
+            }
+            std::stable_sort(spanning.begin(), spanning.end(), [&](std::size_t a, std::size_t b)
+            {
+                return columns ? (m_slots[a].cell.colSpan < m_slots[b].cell.colSpan)
+                               : (m_slots[a].cell.rowSpan < m_slots[b].cell.rowSpan);
+            });
+            for (const std::size_t i : spanning)
+            {
+                const Slot& slot = m_slots[i];
+                if (columns)
+                {
+                    axis.FitSpan(slot.cell.col, slot.cell.colSpan, slot.desired.w);
+                }
+                else
+                {
+                    axis.FitSpan(slot.cell.row, slot.cell.rowSpan, slot.desired.h);
+                }
+            }
+        };
+
+        // Children outside Star columns size the Auto columns, which fixes
+        // the width the Star columns share; the rest are then measured at
+        // their resolved width, and every child's height sizes the rows.
+        // Each child is measured exactly once.
+        measureBatch(false);
+        fitAuto(cols, true);
+        cols.ShareStar(available.w);
+        measureBatch(true);
+        fitAuto(rows, false);
+        rows.ShareStar(available.h);
+
+        m_colSizes.assign(cols.sizes.begin(), cols.sizes.end());
+        m_rowSizes.assign(rows.sizes.begin(), rows.sizes.end());
+
+        m_desired = { cols.Total(), rows.Total() };
         return m_desired;
     }
 
     void GridPanel::Arrange(Rect finalRect)
     {
-        size_t colCount = m_columns.empty() ? 1 : m_columns.size();
-        size_t rowCount = m_rows.empty() ? 1 : m_rows.size();
-
-        std::vector<float> colAuto(colCount, 0.0f);
-        std::vector<float> rowAuto(rowCount, 0.0f);
-
-        // Use desired sizes for auto columns/rows
-        for (auto& child : ChildrenInOrder())
-        {
-            if (!child)
-            {
-                continue;
-            }
-
-            const GridCell cell = m_cells.count(child.get()) ? m_cells[child.get()] : GridCell {};
-            Size desired = child->Measure({ finalRect.w, finalRect.h });
-
-            if (cell.col < static_cast<int>(colCount) && cell.colSpan == 1 && m_columns[cell.col].type == GridLength::Type::Auto)
-            {
-                colAuto[cell.col] = (std::max)(colAuto[cell.col], desired.w);
-            }
-            if (cell.row < static_cast<int>(rowCount) && cell.rowSpan == 1 && m_rows[cell.row].type == GridLength::Type::Auto)
-            {
-                rowAuto[cell.row] = (std::max)(rowAuto[cell.row], desired.h);
-            }
-        }
-
-        float totalStarW = SumStar(m_columns);
-        float totalStarH = SumStar(m_rows);
-
-        float fixedAutoW = SumFixedAuto(m_columns, colAuto);
-        float fixedAutoH = SumFixedAuto(m_rows, rowAuto);
-
-        float remainW = (std::max)(0.0f, finalRect.w - fixedAutoW);
-        float remainH = (std::max)(0.0f, finalRect.h - fixedAutoH);
-
-        std::vector<float> colWidths(colCount, 0.0f);
-        std::vector<float> rowHeights(rowCount, 0.0f);
-
-        for (size_t i = 0; i < colCount; ++i)
+        if (!SlotsMatchChildren() || m_colSizes.size() != m_columns.size() || m_rowSizes.size() != m_rows.size())
         {
-            if (m_columns[i].type == GridLength::Type::Fixed)
-            {
-                colWidths[i] = m_columns[i].value;
-            }
-            else if (m_columns[i].type == GridLength::Type::Auto)
-            {
-                colWidths[i] = colAuto[i];
-            }
-            else
-            {
-                colWidths[i] = totalStarW > 0.0f ? remainW * (m_columns[i].value / totalStarW) : 0.0f;
-            }
+            (void)Measure({ finalRect.w, finalRect.h });
         }
 
-        for (size_t i = 0; i < rowCount; ++i)
-        {
-            if (m_rows[i].type == GridLength::Type::Fixed)
-            {
-                rowHeights[i] = m_rows[i].value;
-            }
-            else if (m_rows[i].type == GridLength::Type::Auto)
-            {
-                rowHeights[i] = rowAuto[i];
-            }
-            else
-            {
-                rowHeights[i] = totalStarH > 0.0f ? remainH * (m_rows[i].value / totalStarH) : 0.0f;
-            }
-        }
+        // Fixed and Auto tracks keep their measured sizes; Star tracks share
+        // the final size.
+        std::pmr::memory_resource* scratch = ScratchMemory();
+        GridTrackAxis cols(m_columns, false, scratch);
+        GridTrackAxis rows(m_rows, false, scratch);
+        std::copy(m_colSizes.begin(), m_colSizes.end(), cols.sizes.begin());
+        std::copy(m_rowSizes.begin(), m_rowSizes.end(), rows.sizes.begin());
+        cols.ShareStar(finalRect.w);
+        rows.ShareStar(finalRect.h);
 
         // Prefix sums
-        std::vector<float> colOffsets(colCount + 1, 0.0f);
-        for (size_t i = 0; i < colCount; ++i)
+        const std::size_t colCount = cols.sizes.size();
+        const std::size_t rowCount = rows.sizes.size();
+        std::pmr::vector<float> colOffsets(colCount + 1, 0.0f, scratch);
+        for (std::size_t i = 0; i < colCount; ++i)
         {
-            colOffsets[i + 1] = colOffsets[i] + colWidths[i];
+            colOffsets[i + 1] = colOffsets[i] + cols.sizes[i];
         }
 
-        std::vector<float> rowOffsets(rowCount + 1, 0.0f);
-        for (size_t i = 0; i < rowCount; ++i)
+        std::pmr::vector<float> rowOffsets(rowCount + 1, 0.0f, scratch);
+        for (std::size_t i = 0; i < rowCount; ++i)
         {
-            rowOffsets[i + 1] = rowOffsets[i] + rowHeights[i];
+            rowOffsets[i + 1] = rowOffsets[i] + rows.sizes[i];
         }
 
-        for (auto& child : ChildrenInOrder())
+        const auto& children = ChildrenInOrder();
+        for (std::size_t i = 0; i < m_slots.size(); ++i)
         {
-            if (!child)
+            if (!children[i])
             {
                 continue;
             }
 
-            const GridCell cell = m_cells.count(child.get()) ? m_cells[child.get()] : GridCell {};
+            const GridCell& cell = m_slots[i].cell;
+            const float x = finalRect.x + colOffsets[cell.col];
+            const float y = finalRect.y + rowOffsets[cell.row];
+            const float w = colOffsets[cell.col + cell.colSpan] - colOffsets[cell.col];
+            const float h = rowOffsets[cell.row + cell.rowSpan] - rowOffsets[cell.row];
 
-            size_t c = (std::min)(static_cast<size_t>(cell.col), colCount - 1);
-            size_t r = (std::min)(static_cast<size_t>(cell.row), rowCount - 1);
-            size_t cs = (std::min)(static_cast<size_t>(cell.colSpan), colCount - c);
-            size_t rs = (std::min)(static_cast<size_t>(cell.rowSpan), rowCount - r);
-
-            float x = finalRect.x + colOffsets[c];
-            float y = finalRect.y + rowOffsets[r];
-            float w = colOffsets[c + cs] - colOffsets[c];
-            float h = rowOffsets[r + rs] - rowOffsets[r];
-
-            child->Arrange({ x, y, w, h });
+            children[i]->Arrange({ x, y, w, h });
         }
 
         m_bounds = finalRect;
         m_layoutRect = ToD2D(finalRect);
     }
 }
-
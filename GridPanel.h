@@ -1,24 +1,12 @@
 #pragma once
 
+#include "GridTracks.h"
 #include "Panel.h"
 #include <vector>
 #include <unordered_map>
 
 namespace FD2D
 {
-    struct GridLength
-    {
-        enum class Type
-        {
-            Auto,
-            Fixed,
-            Star
-        };
-
-        Type type { Type::Star };
-        float value { 1.0f };
-    };
-
     struct GridCell
     {
         int col { 0 };
@@ -37,13 +25,32 @@ namespace FD2D
         void SetRows(const std::vector<GridLength>& rows);
         void SetChildCell(const std::shared_ptr<Wnd>& child, int col, int row, int colSpan = 1, int rowSpan = 1);
 
+        // Measures every child once, against its cell; Arrange reuses those
+        // sizes and only re-shares the Star tracks for the final size.
         Size Measure(Size available) override;
         void Arrange(Rect finalRect) override;
 
     private:
+        // One per child, in child order: the cell clamped to the track
+        // counts and the child's size from the last Measure.
+        struct Slot
+        {
+            const Wnd* wnd { nullptr };
+            GridCell cell {};
+            Size desired {};
+        };
+
+        bool SlotsMatchChildren() const;
+        void RebuildSlots();
+
         std::vector<GridLength> m_columns { GridLength { GridLength::Type::Star, 1.0f } };
         std::vector<GridLength> m_rows { GridLength { GridLength::Type::Star, 1.0f } };
         std::unordered_map<const Wnd*, GridCell> m_cells {};
+        std::vector<Slot> m_slots {};
+        bool m_slotsDirty { true };
+        // Track sizes from the last Measure (Star tracks re-shared in Arrange).
+        std::vector<float> m_colSizes {};
+        std::vector<float> m_rowSizes {};
     };
 }
 
@@ -0,0 +1,105 @@
+#include "GridTracks.h"
+#include "LayoutEngine.h"
+#include <algorithm>
+
+namespace FD2D
+{
+    GridTrackAxis::GridTrackAxis(const std::vector<GridLength>& defs, bool starAsAuto, std::pmr::memory_resource* scratch)
+        : sizes(defs.size(), 0.0f, scratch)
+        , minSizes(defs.size(), 0.0f, scratch)
+        , maxSizes(defs.size(), 0.0f, scratch)
+        , weights(defs.size(), 0.0f, scratch)
+        , growable(defs.size(), 0, scratch)
+    {
+        for (std::size_t i = 0; i < defs.size(); ++i)
+        {
+            const GridLength& d = defs[i];
+            minSizes[i] = (std::max)(0.0f, d.minSize);
+            maxSizes[i] = (std::max)(minSizes[i], d.maxSize);
+            sizes[i] = minSizes[i];
+            if (d.type == GridLength::Type::Fixed)
+            {
+                sizes[i] = (std::min)((std::max)(d.value, minSizes[i]), maxSizes[i]);
+            }
+            else if (d.type == GridLength::Type::Auto || starAsAuto)
+            {
+                growable[i] = 1;
+            }
+            else if (d.value > 0.0f)
+            {
+                weights[i] = d.value;
+            }
+        }
+    }
+
+    bool GridTrackAxis::SpansStar(int start, int span) const
+    {
+        for (int t = start; t < start + span; ++t)
+        {
+            if (weights[t] > 0.0f)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    float GridTrackAxis::SpanSize(int start, int span) const
+    {
+        float total = 0.0f;
+        for (int t = start; t < start + span; ++t)
+        {
+            total += sizes[t];
+        }
+        return total;
+    }
+
+    float GridTrackAxis::SpanAvailable(int start, int span, float available) const
+    {
+        for (int t = start; t < start + span; ++t)
+        {
+            if (growable[t] != 0 || weights[t] > 0.0f)
+            {
+                return available;
+            }
+        }
+        return SpanSize(start, span);
+    }
+
+    void GridTrackAxis::FitSingle(int track, float extent)
+    {
+        if (growable[track] != 0)
+        {
+            sizes[track] = (std::max)(sizes[track], (std::min)(extent, maxSizes[track]));
+        }
+    }
+
+    void GridTrackAxis::FitSpan(int start, int span, float extent)
+    {
+        const float extra = extent - SpanSize(start, span);
+        if (extra > 0.0f)
+        {
+            (void)LayoutKernels::GrowTracks(sizes.data() + start, maxSizes.data() + start,
+                growable.data() + start, static_cast<std::size_t>(span), extra);
+        }
+    }
+
+    void GridTrackAxis::ShareStar(float available)
+    {
+        float fixed = 0.0f;
+        for (std::size_t i = 0; i < sizes.size(); ++i)
+        {
+            if (weights[i] <= 0.0f)
+            {
+                fixed += sizes[i];
+            }
+        }
+        LayoutKernels::ShareStar(weights.data(), minSizes.data(), maxSizes.data(), sizes.size(),
+            (std::max)(0.0f, available - fixed), sizes.data());
+    }
+
+    float GridTrackAxis::Total() const
+    {
+        return SpanSize(0, static_cast<int>(sizes.size()));
+    }
+}
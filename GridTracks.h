@@ -0,0 +1,72 @@
+#pragma once
+
+// GridTracks.h - GridPanel's track definitions and track sizing.
+//
+// Platform-neutral: the per-axis arithmetic of a grid layout pass, without
+// Wnd, so it can be tested and benchmarked on its own. GridPanel builds one
+// GridTrackAxis per axis and pass, fits the Auto tracks to its children's
+// extents and lets the Star tracks share what is left (LayoutKernels
+// GrowTracks / ShareStar).
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <vector>
+
+namespace FD2D
+{
+    // Track sizing follows CSS Grid: Fixed tracks take `value`, Auto tracks
+    // fit the content of the children in them (children spanning several
+    // tracks grow the span's Auto tracks evenly), and Star tracks share the
+    // space left in proportion to `value`. Every track is clamped to
+    // [minSize, maxSize]. With unbounded available space (scrolling content)
+    // Star tracks size to content like Auto ones.
+    struct GridLength
+    {
+        enum class Type
+        {
+            Auto,
+            Fixed,
+            Star
+        };
+
+        Type type { Type::Star };
+        float value { 1.0f };
+        float minSize { 0.0f };
+        float maxSize { std::numeric_limits<float>::infinity() };
+    };
+
+    // One axis (columns or rows) of a layout pass, in scratch memory.
+    // Star tracks have weight > 0; Auto tracks (and Star ones while the
+    // axis is unbounded) are growable. Spans are [start, start + span) and
+    // must lie inside the axis.
+    struct GridTrackAxis
+    {
+        GridTrackAxis(const std::vector<GridLength>& defs, bool starAsAuto,
+            std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+
+        bool SpansStar(int start, int span) const;
+        float SpanSize(int start, int span) const;
+
+        // Measure constraint for a child in this span: exact when every
+        // track is already fixed, otherwise the whole available extent.
+        float SpanAvailable(int start, int span, float available) const;
+
+        // A child of `extent` in one track / across a span grows the
+        // growable tracks it covers (a span evenly, within maxSize).
+        void FitSingle(int track, float extent);
+        void FitSpan(int start, int span, float extent);
+
+        // Star tracks share `available` less the other tracks' sizes.
+        void ShareStar(float available);
+
+        float Total() const;
+
+        std::pmr::vector<float> sizes;
+        std::pmr::vector<float> minSizes;
+        std::pmr::vector<float> maxSizes;
+        std::pmr::vector<float> weights;
+        std::pmr::vector<std::uint8_t> growable;
+    };
+}
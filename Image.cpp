@@ -8,6 +8,7 @@
 #include <cstring>
 #include <d3dcompiler.h>
 #include <vector>
+#include <wincodec.h>
 
 namespace FD2D
 {
@@ -413,6 +414,180 @@ namespace FD2D
         {
             return ((q % 4) + 4) % 4;
         }
+
+        // Bytes per 4x4 block for BC formats, 0 for everything else.
+        static UINT BlockCompressedBytes(DXGI_FORMAT format)
+        {
+            switch (format)
+            {
+            case DXGI_FORMAT_BC1_TYPELESS:
+            case DXGI_FORMAT_BC1_UNORM:
+            case DXGI_FORMAT_BC1_UNORM_SRGB:
+            case DXGI_FORMAT_BC4_TYPELESS:
+            case DXGI_FORMAT_BC4_UNORM:
+            case DXGI_FORMAT_BC4_SNORM:
+                return 8;
+            case DXGI_FORMAT_BC2_TYPELESS:
+            case DXGI_FORMAT_BC2_UNORM:
+            case DXGI_FORMAT_BC2_UNORM_SRGB:
+            case DXGI_FORMAT_BC3_TYPELESS:
+            case DXGI_FORMAT_BC3_UNORM:
+            case DXGI_FORMAT_BC3_UNORM_SRGB:
+            case DXGI_FORMAT_BC5_TYPELESS:
+            case DXGI_FORMAT_BC5_UNORM:
+            case DXGI_FORMAT_BC5_SNORM:
+            case DXGI_FORMAT_BC6H_TYPELESS:
+            case DXGI_FORMAT_BC6H_UF16:
+            case DXGI_FORMAT_BC6H_SF16:
+            case DXGI_FORMAT_BC7_TYPELESS:
+            case DXGI_FORMAT_BC7_UNORM:
+            case DXGI_FORMAT_BC7_UNORM_SRGB:
+                return 16;
+            default:
+                return 0;
+            }
+        }
+
+        // Uncompressed bytes per texel for the formats images actually use;
+        // anything unlisted is accounted as 4 (BGRA8/RGBA8-class).
+        static UINT BytesPerTexel(DXGI_FORMAT format)
+        {
+            switch (format)
+            {
+            case DXGI_FORMAT_R32G32B32A32_FLOAT:
+            case DXGI_FORMAT_R32G32B32A32_UINT:
+                return 16;
+            case DXGI_FORMAT_R32G32B32_FLOAT:
+                return 12;
+            case DXGI_FORMAT_R16G16B16A16_FLOAT:
+            case DXGI_FORMAT_R16G16B16A16_UNORM:
+            case DXGI_FORMAT_R32G32_FLOAT:
+                return 8;
+            case DXGI_FORMAT_R16_FLOAT:
+            case DXGI_FORMAT_R16_UNORM:
+            case DXGI_FORMAT_R8G8_UNORM:
+                return 2;
+            case DXGI_FORMAT_R8_UNORM:
+            case DXGI_FORMAT_A8_UNORM:
+                return 1;
+            default:
+                return 4;
+            }
+        }
+
+        static std::uint64_t EstimateSurfaceBytes(DXGI_FORMAT format, UINT width, UINT height)
+        {
+            const UINT blockBytes = BlockCompressedBytes(format);
+            if (blockBytes != 0)
+            {
+                const std::uint64_t blocksX = (static_cast<std::uint64_t>(width) + 3) / 4;
+                const std::uint64_t blocksY = (static_cast<std::uint64_t>(height) + 3) / 4;
+                return blocksX * blocksY * blockBytes;
+            }
+            return static_cast<std::uint64_t>(width) * height * BytesPerTexel(format);
+        }
+
+        // Whole-resource footprint behind an SRV (all mips and array slices),
+        // since that is what stays resident while the view is referenced.
+        static std::uint64_t EstimateShaderResourceBytes(ID3D11ShaderResourceView* srv)
+        {
+            if (!srv)
+            {
+                return 0;
+            }
+
+            Microsoft::WRL::ComPtr<ID3D11Resource> res;
+            srv->GetResource(&res);
+            Microsoft::WRL::ComPtr<ID3D11Texture2D> tex;
+            if (!res || FAILED(res.As(&tex)) || !tex)
+            {
+                return 0;
+            }
+
+            D3D11_TEXTURE2D_DESC td {};
+            tex->GetDesc(&td);
+
+            std::uint64_t bytes = 0;
+            for (UINT mip = 0; mip < (std::max)(1u, td.MipLevels); ++mip)
+            {
+                bytes += EstimateSurfaceBytes(
+                    td.Format,
+                    (std::max)(1u, td.Width >> mip),
+                    (std::max)(1u, td.Height >> mip));
+            }
+            return bytes * (std::max)(1u, td.ArraySize);
+        }
+
+        static std::uint64_t EstimateBitmapBytes(ID2D1Bitmap* bitmap)
+        {
+            if (!bitmap)
+            {
+                return 0;
+            }
+
+            const D2D1_SIZE_U px = bitmap->GetPixelSize();
+            return EstimateSurfaceBytes(bitmap->GetPixelFormat().format, px.width, px.height);
+        }
+
+        // High-quality cubic downscale of premultiplied BGRA pixels with WIC,
+        // for the prescaled cache (runs on an executor worker).
+        static bool ScaleHighQualityCubic(
+            const DecodedImage& source,
+            UINT width,
+            UINT height,
+            const CancellationToken& token,
+            DecodedImage& out)
+        {
+            // Executor workers need not have joined COM; CoInitializeEx is
+            // reference counted, so balance it here.
+            const HRESULT hrCom = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+            bool ok = false;
+            {
+                Microsoft::WRL::ComPtr<IWICImagingFactory> factory;
+                Microsoft::WRL::ComPtr<IWICBitmap> bitmap;
+                Microsoft::WRL::ComPtr<IWICBitmapScaler> scaler;
+                HRESULT hr = CoCreateInstance(
+                    CLSID_WICImagingFactory,
+                    nullptr,
+                    CLSCTX_INPROC_SERVER,
+                    IID_PPV_ARGS(&factory));
+                if (SUCCEEDED(hr))
+                {
+                    hr = factory->CreateBitmapFromMemory(
+                        source.width,
+                        source.height,
+                        GUID_WICPixelFormat32bppPBGRA,
+                        source.stride,
+                        static_cast<UINT>(source.pixels.size()),
+                        const_cast<BYTE*>(source.pixels.data()),
+                        &bitmap);
+                }
+                if (SUCCEEDED(hr))
+                {
+                    hr = factory->CreateBitmapScaler(&scaler);
+                }
+                if (SUCCEEDED(hr))
+                {
+                    hr = scaler->Initialize(bitmap.Get(), width, height, WICBitmapInterpolationModeHighQualityCubic);
+                }
+                if (SUCCEEDED(hr) && !token.IsCancelled())
+                {
+                    out.width = width;
+                    out.height = height;
+                    out.stride = width * 4u;
+                    out.sourceWidth = source.sourceWidth;
+                    out.sourceHeight = source.sourceHeight;
+                    out.pixels.resize(static_cast<std::size_t>(out.stride) * height);
+                    hr = scaler->CopyPixels(nullptr, out.stride, static_cast<UINT>(out.pixels.size()), out.pixels.data());
+                    ok = SUCCEEDED(hr);
+                }
+            }
+            if (SUCCEEDED(hrCom))
+            {
+                CoUninitialize();
+            }
+            return ok;
+        }
     }
 
     bool TryGetShaderResourceTexelSize(
@@ -529,6 +704,24 @@ namespace FD2D
             context->RSGetScissorRects(&prevScissorCount, prevScissors.data());
         }
 
+        // The caller may already be scissoring (damage-only frames): stay inside.
+        if (prevRs && prevScissorCount > 0)
+        {
+            D3D11_RASTERIZER_DESC prevRsDesc {};
+            prevRs->GetDesc(&prevRsDesc);
+            if (prevRsDesc.ScissorEnable)
+            {
+                scissor.left = (std::max)(scissor.left, prevScissors[0].left);
+                scissor.top = (std::max)(scissor.top, prevScissors[0].top);
+                scissor.right = (std::min)(scissor.right, prevScissors[0].right);
+                scissor.bottom = (std::min)(scissor.bottom, prevScissors[0].bottom);
+                if (scissor.left >= scissor.right || scissor.top >= scissor.bottom)
+                {
+                    return S_FALSE;
+                }
+            }
+        }
+
         Microsoft::WRL::ComPtr<ID3D11InputLayout> prevInputLayout;
         context->IAGetInputLayout(&prevInputLayout);
         Microsoft::WRL::ComPtr<ID3D11Buffer> prevVertexBuffer;
@@ -813,6 +1006,352 @@ namespace FD2D
     {
     }
 
+    Image::~Image()
+    {
+        CancelSourceRequest();
+        ReleaseResidency();
+    }
+
+    void Image::OnAttached(Backplate& backplate)
+    {
+        Wnd::OnAttached(backplate);
+        UpdateResidency();
+        if (!m_bitmap && !m_srv && !m_pendingUpload)
+        {
+            RequestSource(ImageLoadPriority::Prefetch);
+        }
+    }
+
+    void Image::OnDetached()
+    {
+        CancelSourceRequest();
+        ++m_cullWatchGeneration;
+        m_cullWatch = false;
+        if (m_backplate)
+        {
+            m_backplate->UnregisterAnimation(this);
+        }
+        ResetScaledCache();
+        ReleaseResidency();
+        Wnd::OnDetached();
+    }
+
+    void Image::SetContentRestorer(ContentRestorer restorer)
+    {
+        const bool couldRecreate = CanRecreateContent();
+        m_restorer = std::move(restorer);
+        if (couldRecreate != CanRecreateContent() && m_residencyHandle != ResidencyManager::kInvalidHandle)
+        {
+            // Evictable now, or no longer.
+            UpdateResidency();
+        }
+    }
+
+    void Image::UpdateResidency()
+    {
+        ReleaseResidency();
+        if (!m_backplate)
+        {
+            return;
+        }
+
+        m_contentBytes = m_bitmap
+            ? EstimateBitmapBytes(m_bitmap.Get())
+            : EstimateShaderResourceBytes(m_srv.Get());
+        if (!CanRecreateContent())
+        {
+            // Evicting it would leave the image empty for good: count it only.
+            m_residencyHandle = m_backplate->Residency().Register(
+                ResidentBytes(),
+                m_backplate->FrameIndex(),
+                nullptr);
+            return;
+        }
+
+        m_residencyHandle = m_backplate->Residency().Register(
+            ResidentBytes(),
+            m_backplate->FrameIndex(),
+            [this]()
+            {
+                // Runs after the frame was presented, only for content that was
+                // not drawn in it, so no repaint is needed here.
+                m_residencyHandle = ResidencyManager::kInvalidHandle;
+                m_bitmap.Reset();
+                m_bitmapPixels.reset();
+                ResetScaledCache();
+                ResetContentSlots();
+                m_srv.Reset();
+                m_evicted = true;
+                m_restoreRequested = false;
+            });
+    }
+
+    std::uint64_t Image::ResidentBytes() const
+    {
+        return m_contentBytes +
+            static_cast<std::uint64_t>(m_scaledCacheSize.width) * m_scaledCacheSize.height * 4 +
+            EstimateBitmapBytes(m_pendingBitmap.Get());
+    }
+
+    void Image::UpdateResidentBytes()
+    {
+        if (m_residencyHandle != ResidencyManager::kInvalidHandle && m_backplate)
+        {
+            m_backplate->Residency().UpdateSize(m_residencyHandle, ResidentBytes());
+        }
+    }
+
+    void Image::ReleaseResidency()
+    {
+        if (m_residencyHandle != ResidencyManager::kInvalidHandle && m_backplate)
+        {
+            m_backplate->Residency().Unregister(m_residencyHandle);
+        }
+        m_residencyHandle = ResidencyManager::kInvalidHandle;
+    }
+
+    void Image::ResetScaledCache()
+    {
+        const bool hadCache = (m_scaledCache != nullptr);
+        m_scaledCache.Reset();
+        m_scaledCacheSize = { 0, 0 };
+        if (m_scaledBuildSize.width != 0)
+        {
+            m_scaledBuild.Cancel();
+            m_scaledBuild = CancellationSource();
+        }
+        m_scaledBuildSize = { 0, 0 };
+        m_scaledUpload.reset();
+        if (hadCache)
+        {
+            UpdateResidentBytes();
+        }
+    }
+
+    ID2D1Bitmap* Image::AcquireScaledBitmap(
+        ID2D1RenderTarget* target,
+        const D2D1_RECT_F& destRect,
+        bool& interacting)
+    {
+        interacting = false;
+        if (!target || !m_bitmap)
+        {
+            return nullptr;
+        }
+
+        // Device-pixel size of the (pre-rotation) destination rect under the
+        // current transform (logical-to-render scale, scroll transforms) and DPI.
+        D2D1_MATRIX_3X2_F transform {};
+        target->GetTransform(&transform);
+        float dpiX = 96.0f;
+        float dpiY = 96.0f;
+        target->GetDpi(&dpiX, &dpiY);
+        const float scaleX = std::sqrt(transform._11 * transform._11 + transform._12 * transform._12) * (dpiX / 96.0f);
+        const float scaleY = std::sqrt(transform._21 * transform._21 + transform._22 * transform._22) * (dpiY / 96.0f);
+        const UINT pixelW = static_cast<UINT>((std::max)(0.0f, std::round((destRect.right - destRect.left) * scaleX)));
+        const UINT pixelH = static_cast<UINT>((std::max)(0.0f, std::round((destRect.bottom - destRect.top) * scaleY)));
+
+        const D2D1_SIZE_U drawSize { pixelW, pixelH };
+        interacting =
+            (m_lastDrawSource == m_bitmap.Get()) &&
+            (m_lastDrawPixelSize.width != drawSize.width || m_lastDrawPixelSize.height != drawSize.height);
+        m_lastDrawSource = m_bitmap.Get();
+        m_lastDrawPixelSize = drawSize;
+
+        // Only downscales benefit: the cubic filter is what is expensive, and an
+        // upscaled cache would be larger than the source it replaces.
+        const D2D1_SIZE_U sourceSize = m_bitmap->GetPixelSize();
+        constexpr UINT kMaxCacheExtent = 8192;
+        if (pixelW == 0 || pixelH == 0 ||
+            pixelW >= sourceSize.width || pixelH >= sourceSize.height ||
+            pixelW > kMaxCacheExtent || pixelH > kMaxCacheExtent)
+        {
+            ResetScaledCache();
+            return nullptr;
+        }
+
+        if (m_scaledCache &&
+            m_scaledCacheSize.width == pixelW &&
+            m_scaledCacheSize.height == pixelH)
+        {
+            return m_scaledCache.Get();
+        }
+
+        if (interacting)
+        {
+            // Zoom is changing: let the caller draw bilinear from the source and
+            // make sure a follow-up frame arrives to rebuild once it settles.
+            if (m_backplate)
+            {
+                m_backplate->RequestAnimationFrame();
+            }
+            return nullptr;
+        }
+
+        // Decoded content: upload a finished off-thread build, or start one
+        // and keep drawing the previous copy (or bilinear) until it lands.
+        const bool failedHere = (m_scaledFailedSize.width == pixelW && m_scaledFailedSize.height == pixelH);
+        if (m_bitmapPixels && !failedHere && m_backplate && m_backplate->GetExecutor())
+        {
+            if (m_scaledUpload && m_scaledUpload->width == pixelW && m_scaledUpload->height == pixelH)
+            {
+                const std::shared_ptr<const DecodedImage> upload = std::move(m_scaledUpload);
+                Microsoft::WRL::ComPtr<ID2D1Bitmap> bitmap;
+                const HRESULT hr = target->CreateBitmap(
+                    D2D1::SizeU(pixelW, pixelH),
+                    upload->pixels.data(),
+                    upload->stride,
+                    D2D1::BitmapProperties(
+                        D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED),
+                        dpiX,
+                        dpiY),
+                    &bitmap);
+                if (SUCCEEDED(hr) && bitmap)
+                {
+                    m_scaledCache = std::move(bitmap);
+                    m_scaledCacheSize = D2D1::SizeU(pixelW, pixelH);
+                    UpdateResidentBytes();
+                    return m_scaledCache.Get();
+                }
+                m_scaledFailedSize = D2D1::SizeU(pixelW, pixelH);
+            }
+            else
+            {
+                m_scaledUpload.reset();
+                RequestScaledCache(pixelW, pixelH);
+                interacting = true;
+                return m_scaledCache.Get();
+            }
+        }
+
+        ResetScaledCache();
+
+        Microsoft::WRL::ComPtr<ID2D1BitmapRenderTarget> scaledTarget;
+        const D2D1_SIZE_F desiredSize = D2D1::SizeF(
+            static_cast<float>(pixelW) * 96.0f / dpiX,
+            static_cast<float>(pixelH) * 96.0f / dpiY);
+        const D2D1_SIZE_U desiredPixelSize = D2D1::SizeU(pixelW, pixelH);
+        const D2D1_PIXEL_FORMAT format = D2D1::PixelFormat(
+            DXGI_FORMAT_B8G8R8A8_UNORM,
+            D2D1_ALPHA_MODE_PREMULTIPLIED);
+        HRESULT hr = target->CreateCompatibleRenderTarget(
+            &desiredSize,
+            &desiredPixelSize,
+            &format,
+            D2D1_COMPATIBLE_RENDER_TARGET_OPTIONS_NONE,
+            &scaledTarget);
+        if (FAILED(hr) || !scaledTarget)
+        {
+            return nullptr;
+        }
+
+        Microsoft::WRL::ComPtr<ID2D1DeviceContext> scaledDc;
+        if (FAILED(scaledTarget.As(&scaledDc)) || !scaledDc)
+        {
+            return nullptr;
+        }
+
+        const D2D1_SIZE_F contentSize = m_bitmap->GetSize();
+        scaledDc->BeginDraw();
+        scaledDc->SetTransform(D2D1::Matrix3x2F::Identity());
+        scaledDc->Clear(D2D1::ColorF(0.0f, 0.0f, 0.0f, 0.0f));
+        scaledDc->DrawBitmap(
+            m_bitmap.Get(),
+            D2D1::RectF(0.0f, 0.0f, desiredSize.width, desiredSize.height),
+            1.0f,
+            D2D1_INTERPOLATION_MODE_HIGH_QUALITY_CUBIC,
+            D2D1::RectF(0.0f, 0.0f, contentSize.width, contentSize.height));
+        hr = scaledDc->EndDraw();
+        if (FAILED(hr))
+        {
+            return nullptr;
+        }
+
+        if (FAILED(scaledTarget->GetBitmap(&m_scaledCache)) || !m_scaledCache)
+        {
+            m_scaledCache.Reset();
+            return nullptr;
+        }
+
+        m_scaledCacheSize = desiredPixelSize;
+        UpdateResidentBytes();
+        return m_scaledCache.Get();
+    }
+
+    void Image::RequestScaledCache(UINT pixelW, UINT pixelH)
+    {
+        if (m_scaledBuildSize.width == pixelW && m_scaledBuildSize.height == pixelH)
+        {
+            return;
+        }
+
+        // A build for another size is superseded; its result is dropped.
+        m_scaledBuild.Cancel();
+        m_scaledBuild = CancellationSource();
+        m_scaledBuildSize = D2D1::SizeU(pixelW, pixelH);
+
+        const CancellationToken token = m_scaledBuild.Token();
+        std::weak_ptr<Wnd> weakSelf = weak_from_this();
+        std::shared_ptr<UiDispatcher> dispatcher = m_backplate->GetDispatcher();
+        const bool submitted = m_backplate->GetExecutor()->Submit(
+            [pixels = m_bitmapPixels, pixelW, pixelH, token, weakSelf, dispatcher]()
+            {
+                auto scaled = std::make_shared<DecodedImage>();
+                if (!ScaleHighQualityCubic(*pixels, pixelW, pixelH, token, *scaled))
+                {
+                    scaled.reset();
+                }
+                (void)dispatcher->Post([weakSelf, token, pixelW, pixelH, scaled = std::move(scaled)]() mutable
+                {
+                    auto self = weakSelf.lock();
+                    if (self && !token.IsCancelled())
+                    {
+                        static_cast<Image*>(self.get())->OnScaledCacheBuilt(D2D1::SizeU(pixelW, pixelH), std::move(scaled));
+                    }
+                });
+            },
+            WorkLane::Interactive,
+            token);
+        if (!submitted)
+        {
+            m_scaledBuildSize = { 0, 0 };
+            m_scaledFailedSize = D2D1::SizeU(pixelW, pixelH);
+        }
+    }
+
+    void Image::OnScaledCacheBuilt(D2D1_SIZE_U size, std::shared_ptr<const DecodedImage> scaled)
+    {
+        m_scaledBuildSize = { 0, 0 };
+        if (!scaled)
+        {
+            m_scaledFailedSize = size;
+        }
+        m_scaledUpload = std::move(scaled);
+        Invalidate();
+    }
+
+    void Image::MarkContentDrawn()
+    {
+        if (m_residencyHandle != ResidencyManager::kInvalidHandle && m_backplate)
+        {
+            m_backplate->Residency().MarkDrawn(m_residencyHandle, m_backplate->FrameIndex());
+        }
+    }
+
+    void Image::RestoreEvictedContent()
+    {
+        // Ask once per eviction; the restorer may re-supply content now
+        // (SetBitmap/SetShaderResource, which triggers a follow-up frame) or
+        // later from an async load.
+        if (!m_evicted || m_restoreRequested || !m_restorer)
+        {
+            return;
+        }
+
+        m_restoreRequested = true;
+        m_restorer(*this);
+    }
+
     void Image::ResetCheckerBrushes()
     {
         m_checkerLightBrush.Reset();
@@ -820,23 +1359,46 @@ namespace FD2D
     }
 
     void Image::SetBitmap(Microsoft::WRL::ComPtr<ID2D1Bitmap> bitmap)
+    {
+        DetachSource();
+        ApplyBitmap(std::move(bitmap), true);
+    }
+
+    void Image::ApplyBitmap(
+        Microsoft::WRL::ComPtr<ID2D1Bitmap> bitmap,
+        bool invalidate,
+        std::shared_ptr<const DecodedImage> pixels)
     {
         const bool changed =
             (m_bitmap.Get() != bitmap.Get()) ||
             (m_srv != nullptr);
 
         m_bitmap = std::move(bitmap);
+        m_bitmapPixels = m_bitmap ? std::move(pixels) : nullptr;
+        m_scaledFailedSize = { 0, 0 };
+        ResetScaledCache();
         m_srv.Reset();
         m_srvWidth = 0;
         m_srvHeight = 0;
+        m_evicted = false;
 
         if (changed)
         {
-            Invalidate();
+            UpdateResidency();
+            if (invalidate)
+            {
+                Invalidate();
+            }
         }
     }
 
     void Image::SetShaderResource(Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srv)
+    {
+        DetachSource();
+        ApplyShaderResource(std::move(srv), true);
+    }
+
+    void Image::ApplyShaderResource(Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srv, bool invalidate)
     {
         UINT w = 0;
         UINT h = 0;
@@ -858,26 +1420,336 @@ namespace FD2D
         m_srvWidth = w;
         m_srvHeight = h;
         m_bitmap.Reset();
+        m_bitmapPixels.reset();
+        ResetScaledCache();
+        m_evicted = false;
 
         if (changed)
         {
-            Invalidate();
+            UpdateResidency();
+            if (invalidate)
+            {
+                Invalidate();
+            }
         }
     }
 
     void Image::Clear()
     {
+        DetachSource();
+
         const bool hadContent = (m_bitmap != nullptr) || (m_srv != nullptr);
+        ReleaseResidency();
         m_bitmap.Reset();
+        m_bitmapPixels.reset();
+        ResetScaledCache();
         m_srv.Reset();
         m_srvWidth = 0;
         m_srvHeight = 0;
+        m_evicted = false;
         if (hadContent)
         {
             Invalidate();
         }
     }
 
+    void Image::SetSource(const std::wstring& source)
+    {
+        if (source == m_source)
+        {
+            return;
+        }
+
+        DetachSource();
+        m_source = source;
+        if (m_source.empty())
+        {
+            return;
+        }
+
+        // Drop the previous content rather than showing a stale image until
+        // the new one decodes.
+        ApplyBitmap(nullptr, true);
+        if (m_backplate)
+        {
+            RequestSource(ImageLoadPriority::Prefetch);
+        }
+    }
+
+    void Image::DetachSource()
+    {
+        CancelSourceRequest();
+        m_source.clear();
+        m_pendingUpload.reset();
+        m_sourceFailed = false;
+        m_sourcePixelSize = { 0, 0 };
+        ResetContentSlots();
+    }
+
+    void Image::ResetContentSlots()
+    {
+        const bool hadPending = (m_pendingBitmap != nullptr);
+        if (m_slots.IsFading() && m_backplate)
+        {
+            m_backplate->UnregisterAnimation(this);
+        }
+        m_pendingBitmap.Reset();
+        m_pendingPixels.reset();
+        m_slots.Reset();
+        if (hadPending)
+        {
+            UpdateResidentBytes();
+        }
+    }
+
+    void Image::RequestSource(ImageLoadPriority priority)
+    {
+        if (m_source.empty() || !m_backplate || m_sourceRequest != ImagePipeline::kInvalidRequest)
+        {
+            return;
+        }
+
+        const std::shared_ptr<ImagePipeline>& pipeline = m_backplate->GetImagePipeline();
+        if (!pipeline)
+        {
+            return;
+        }
+
+        // Completions run on the UI thread from DeliverCompleted; the weak
+        // reference covers images destroyed before their decode lands.
+        std::weak_ptr<Wnd> weakSelf = weak_from_this();
+        m_sourceRequestPriority = priority;
+        m_sourceRequest = pipeline->Request(
+            m_source,
+            priority,
+            [weakSelf, source = m_source](std::shared_ptr<const DecodedImage> image)
+            {
+                if (auto self = weakSelf.lock())
+                {
+                    static_cast<Image*>(self.get())->OnSourceDecoded(source, std::move(image));
+                }
+            },
+            m_progressive,
+            m_backplate);
+        if (m_sourceRequest != ImagePipeline::kInvalidRequest)
+        {
+            WatchForCulling();
+        }
+    }
+
+    void Image::WatchForCulling()
+    {
+        if (m_cullWatch)
+        {
+            return;
+        }
+
+        m_cullWatch = true;
+        std::weak_ptr<Wnd> weakSelf = weak_from_this();
+        m_backplate->AddFrameObserver([weakSelf, generation = m_cullWatchGeneration]()
+        {
+            auto self = weakSelf.lock();
+            if (!self)
+            {
+                return false;
+            }
+
+            Image& image = static_cast<Image&>(*self);
+            if (image.m_cullWatchGeneration != generation)
+            {
+                return false;
+            }
+            if (image.m_sourceRequest != ImagePipeline::kInvalidRequest &&
+                image.m_backplate &&
+                image.m_renderedFrame == image.m_backplate->FrameIndex())
+            {
+                return true;
+            }
+
+            // Not painted in the frame just finished: stop the decode like
+            // UpdateSourceVisibility does for an off-screen image. The next
+            // OnRender requests it again.
+            image.CancelSourceRequest();
+            image.m_cullWatch = false;
+            return false;
+        });
+    }
+
+    void Image::CancelSourceRequest()
+    {
+        if (m_sourceRequest == ImagePipeline::kInvalidRequest)
+        {
+            return;
+        }
+
+        if (m_backplate && m_backplate->GetImagePipeline())
+        {
+            m_backplate->GetImagePipeline()->Cancel(m_sourceRequest);
+        }
+        m_sourceRequest = ImagePipeline::kInvalidRequest;
+    }
+
+    void Image::OnSourceDecoded(const std::wstring& source, std::shared_ptr<const DecodedImage> image)
+    {
+        if (source != m_source)
+        {
+            return;
+        }
+
+        // A preview leaves the request running for the full image.
+        const bool preview = image && image->preview;
+        if (!preview)
+        {
+            m_sourceRequest = ImagePipeline::kInvalidRequest;
+        }
+        if (!image || image->width == 0 || image->height == 0)
+        {
+            m_sourceFailed = !preview;
+            return;
+        }
+        if (preview && m_pendingUpload && !m_pendingUpload->preview)
+        {
+            return;
+        }
+
+        m_sourceFailed = false;
+        m_pendingUpload = std::move(image);
+        Invalidate();
+    }
+
+    void Image::UpdateSourceVisibility(ID2D1RenderTarget* target)
+    {
+        // Only a preview (or nothing) on hand: the full decode is still wanted.
+        const bool hasFull =
+            (m_pendingUpload && !m_pendingUpload->preview) ||
+            (m_slots.PrimaryQuality() == ContentQuality::Full) ||
+            (m_slots.PendingQuality() == ContentQuality::Full);
+        if (m_source.empty() || hasFull || m_sourceFailed || !target)
+        {
+            return;
+        }
+
+        // On screen = the layout rect, under the current transform (scroll
+        // offsets, logical-to-render scale), intersects the target surface.
+        D2D1_MATRIX_3X2_F m {};
+        target->GetTransform(&m);
+        const D2D1_RECT_F r = LayoutRect();
+        const D2D1_RECT_F bounds = Util::TransformRectBounds(r, m);
+        const D2D1_SIZE_F targetSize = target->GetSize();
+        const bool visible =
+            bounds.right > 0.0f && bounds.bottom > 0.0f &&
+            bounds.left < targetSize.width && bounds.top < targetSize.height &&
+            r.right > r.left && r.bottom > r.top;
+
+        if (!visible)
+        {
+            // Off screen: stop spending decode time on it; it is requested
+            // again (usually from the decoded-pixel cache) once it scrolls back.
+            CancelSourceRequest();
+            return;
+        }
+
+        if (m_sourceRequest == ImagePipeline::kInvalidRequest)
+        {
+            RequestSource(ImageLoadPriority::Visible);
+        }
+        else if (m_sourceRequestPriority != ImageLoadPriority::Visible)
+        {
+            m_sourceRequestPriority = ImageLoadPriority::Visible;
+            m_backplate->GetImagePipeline()->SetPriority(m_sourceRequest, ImageLoadPriority::Visible);
+        }
+    }
+
+    void Image::UploadDecodedSource(ID2D1RenderTarget* target)
+    {
+        if (!m_pendingUpload || !target)
+        {
+            return;
+        }
+
+        std::shared_ptr<const DecodedImage> image = std::move(m_pendingUpload);
+        Microsoft::WRL::ComPtr<ID2D1Bitmap> bitmap;
+        const HRESULT hr = target->CreateBitmap(
+            D2D1::SizeU(image->width, image->height),
+            image->pixels.data(),
+            image->stride,
+            D2D1::BitmapProperties(D2D1::PixelFormat(
+                DXGI_FORMAT_B8G8R8A8_UNORM,
+                D2D1_ALPHA_MODE_PREMULTIPLIED)),
+            &bitmap);
+        if (FAILED(hr))
+        {
+            // A failed preview upload is harmless; the full image follows.
+            m_sourceFailed = !image->preview;
+            return;
+        }
+
+        // Already inside Render(): no Invalidate needed for this frame.
+        const ContentQuality quality = image->preview ? ContentQuality::Preview : ContentQuality::Full;
+        switch (m_slots.Offer(quality, Util::NowMs()))
+        {
+        case ContentSlots::Placement::Rejected:
+            return;
+
+        case ContentSlots::Placement::ReplacePrimary:
+            m_pendingBitmap.Reset();
+            m_pendingPixels.reset();
+            ApplyBitmap(std::move(bitmap), false, image);
+            break;
+
+        case ContentSlots::Placement::PromoteThenStartFade:
+            ApplyBitmap(std::move(m_pendingBitmap), false, std::move(m_pendingPixels));
+            m_pendingBitmap = std::move(bitmap);
+            m_pendingPixels = image;
+            break;
+
+        case ContentSlots::Placement::StartFade:
+            m_pendingBitmap = std::move(bitmap);
+            m_pendingPixels = image;
+            break;
+        }
+        // Both slots are resident while the fade runs.
+        UpdateResidentBytes();
+        m_sourcePixelSize = D2D1::SizeU(image->sourceWidth, image->sourceHeight);
+    }
+
+    void Image::AdvanceCrossFade(ID2D1RenderTarget* target)
+    {
+        if (!m_slots.IsFading())
+        {
+            return;
+        }
+
+        if (!m_pendingBitmap || !m_bitmap)
+        {
+            // Lost a slot (device/target change): show whatever is left.
+            ResetContentSlots();
+            return;
+        }
+
+        if (m_slots.Advance(Util::NowMs()))
+        {
+            // The primary is replaced in the same frame the fade completes, so
+            // there is no frame with neither slot drawn.
+            ApplyBitmap(std::move(m_pendingBitmap), false, std::move(m_pendingPixels));
+            if (m_backplate)
+            {
+                m_backplate->UnregisterAnimation(this);
+            }
+            return;
+        }
+
+        // Lease this image's bounds (target pixels) until the fade ends, so
+        // ticks driven only by the fade repaint just the image.
+        if (m_backplate)
+        {
+            D2D1_MATRIX_3X2_F transform {};
+            target->GetTransform(&transform);
+            m_backplate->RegisterAnimation(
+                this, Util::TransformRectBounds(LayoutRect(), transform), m_slots.FadeEndMs());
+        }
+    }
+
     void Image::SetDrawState(const DrawState& state)
     {
         DrawState next = state;
@@ -910,6 +1782,10 @@ namespace FD2D
     {
         if (m_bitmap)
         {
+            if (m_sourcePixelSize.width > 0 && m_sourcePixelSize.height > 0)
+            {
+                return m_sourcePixelSize;
+            }
             return m_bitmap->GetPixelSize();
         }
         if (m_srv && m_srvWidth > 0 && m_srvHeight > 0)
@@ -924,6 +1800,16 @@ namespace FD2D
         if (m_bitmap)
         {
             outSize = m_bitmap->GetSize();
+
+            // Pipeline content is laid out at the full image size even while
+            // the bitmap is a reduced preview, keeping the DIP/pixel ratio.
+            const D2D1_SIZE_U pixels = m_bitmap->GetPixelSize();
+            if (m_sourcePixelSize.width > 0 && m_sourcePixelSize.height > 0 &&
+                pixels.width > 0 && pixels.height > 0)
+            {
+                outSize.width *= static_cast<float>(m_sourcePixelSize.width) / static_cast<float>(pixels.width);
+                outSize.height *= static_cast<float>(m_sourcePixelSize.height) / static_cast<float>(pixels.height);
+            }
             return outSize.width > 0.0f && outSize.height > 0.0f;
         }
         if (m_srv && m_srvWidth > 0 && m_srvHeight > 0)
@@ -940,14 +1826,26 @@ namespace FD2D
         {
         case GraphicsInvalidationReason::TargetRecreated:
             // D2D bitmaps/brushes are target-bound; SRVs on the same D3D device remain valid.
+            if (m_bitmap)
+            {
+                ReleaseResidency();
+            }
             m_bitmap.Reset();
+            m_bitmapPixels.reset();
+            ResetScaledCache();
+            ResetContentSlots();
             ResetCheckerBrushes();
             Invalidate();
             break;
 
         case GraphicsInvalidationReason::DeviceLost:
         case GraphicsInvalidationReason::RendererFallback:
+            ReleaseResidency();
+            m_evicted = false;
             m_bitmap.Reset();
+            m_bitmapPixels.reset();
+            ResetScaledCache();
+            ResetContentSlots();
             m_srv.Reset();
             m_srvWidth = 0;
             m_srvHeight = 0;
@@ -958,7 +1856,12 @@ namespace FD2D
 
         case GraphicsInvalidationReason::Shutdown:
             // Teardown only - do not Invalidate/Render; the HWND may already be gone.
+            ReleaseResidency();
+            m_evicted = false;
             m_bitmap.Reset();
+            m_bitmapPixels.reset();
+            ResetScaledCache();
+            ResetContentSlots();
             m_srv.Reset();
             m_srvWidth = 0;
             m_srvHeight = 0;
@@ -984,8 +1887,19 @@ namespace FD2D
         const D2D1_RECT_F clipRect = LayoutRect();
         target->PushAxisAlignedClip(clipRect, D2D1_ANTIALIAS_MODE_PER_PRIMITIVE);
 
+        if (m_backplate)
+        {
+            m_renderedFrame = m_backplate->FrameIndex();
+        }
+        RestoreEvictedContent();
+        UploadDecodedSource(target);
+        AdvanceCrossFade(target);
+        UpdateSourceVisibility(target);
+
         if (m_bitmap)
         {
+            MarkContentDrawn();
+
             D2D1_SIZE_F contentSize {};
             if (TryGetContentSize(contentSize))
             {
@@ -1000,6 +1914,20 @@ namespace FD2D
                     m_drawState.panX,
                     m_drawState.panY);
 
+                // Resolve the pre-scaled cache before the rotation transform below
+                // replaces the current one, whose scale defines the pixel size.
+                const FD2D::D2DVersion d2dVersion = FD2D::Core::GetSupportedD2DVersion();
+                bool scaledInteracting = false;
+                ID2D1Bitmap* scaled = nullptr;
+                if (m_drawState.highQualitySampling && d2dVersion >= FD2D::D2DVersion::D2D1_1)
+                {
+                    scaled = AcquireScaledBitmap(target, destRect, scaledInteracting);
+                }
+                else
+                {
+                    ResetScaledCache();
+                }
+
                 if (m_drawState.rotationQuarters != 0)
                 {
                     const float cx = (layoutRect.left + layoutRect.right) * 0.5f;
@@ -1040,11 +1968,13 @@ namespace FD2D
                     }
                 }
 
-                const D2D1_RECT_F sourceRect = D2D1::RectF(0.0f, 0.0f, contentSize.width, contentSize.height);
+                // The bitmap's own extent: contentSize is the full image size,
+                // which differs while a preview is the primary.
+                const D2D1_SIZE_F bitmapSize = m_bitmap->GetSize();
+                const D2D1_RECT_F sourceRect = D2D1::RectF(0.0f, 0.0f, bitmapSize.width, bitmapSize.height);
                 D2D1_BITMAP_INTERPOLATION_MODE interpMode = D2D1_BITMAP_INTERPOLATION_MODE_LINEAR;
                 bool drawn = false;
 
-                const FD2D::D2DVersion d2dVersion = FD2D::Core::GetSupportedD2DVersion();
                 if (m_drawState.highQualitySampling)
                 {
                     if (d2dVersion >= FD2D::D2DVersion::D2D1_1)
@@ -1052,13 +1982,30 @@ namespace FD2D
                         Microsoft::WRL::ComPtr<ID2D1DeviceContext> dc;
                         if (SUCCEEDED(target->QueryInterface(IID_PPV_ARGS(&dc))) && dc)
                         {
-                            dc->DrawBitmap(
-                                m_bitmap.Get(),
-                                destRect,
-                                1.0f,
-                                D2D1_INTERPOLATION_MODE_HIGH_QUALITY_CUBIC,
-                                sourceRect);
-                            drawn = true;
+                            // Downscaled views reuse a cubic-filtered copy built at the
+                            // current size, so a steady image costs a 1:1 blit per frame
+                            // instead of a full-resolution cubic resample. While zoom is
+                            // changing, fall through to bilinear from the source.
+                            if (scaled)
+                            {
+                                dc->DrawBitmap(
+                                    scaled,
+                                    destRect,
+                                    1.0f,
+                                    D2D1_INTERPOLATION_MODE_LINEAR,
+                                    nullptr);
+                                drawn = true;
+                            }
+                            else if (!scaledInteracting)
+                            {
+                                dc->DrawBitmap(
+                                    m_bitmap.Get(),
+                                    destRect,
+                                    1.0f,
+                                    D2D1_INTERPOLATION_MODE_HIGH_QUALITY_CUBIC,
+                                    sourceRect);
+                                drawn = true;
+                            }
                         }
                     }
                 }
@@ -1077,6 +2024,19 @@ namespace FD2D
                         sourceRect);
                 }
 
+                // Cross-fade: the incoming content over the primary, which stays
+                // fully opaque so the background never shows through mid-fade.
+                if (m_pendingBitmap && m_slots.IsFading())
+                {
+                    const D2D1_SIZE_F pendingSize = m_pendingBitmap->GetSize();
+                    target->DrawBitmap(
+                        m_pendingBitmap.Get(),
+                        destRect,
+                        m_slots.PendingOpacity(),
+                        D2D1_BITMAP_INTERPOLATION_MODE_LINEAR,
+                        D2D1::RectF(0.0f, 0.0f, pendingSize.width, pendingSize.height));
+                }
+
                 if (m_drawState.rotationQuarters != 0)
                 {
                     target->SetTransform(D2D1::Matrix3x2F::Identity());
@@ -1092,6 +2052,8 @@ namespace FD2D
     {
         if (context && m_backplate && m_srv && m_srvWidth > 0 && m_srvHeight > 0)
         {
+            MarkContentDrawn();
+
             ShaderResourceDraw draw;
             draw.layout = LayoutRect();
             draw.contentWidth = m_srvWidth;
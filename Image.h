@@ -1,17 +1,22 @@
 #pragma once
 
+#include "ContentSlots.h"
+#include "ImagePipeline.h"
+#include "ResidencyManager.h"
 #include "Wnd.h"
 #include <wrl/client.h>
 #include <d2d1.h>
 #include <d2d1_1.h>
 #include <d3d11_1.h>
+#include <functional>
 #include <string>
 
 namespace FD2D
 {
     // Handle-only image control: owns a D2D bitmap XOR a D3D Texture2D SRV and
     // renders aspect-fit + zoom/pan/rotation with optional alpha checkerboard.
-    // Does not load files or manage async pipelines (those belong to the app).
+    // Files are only loaded when the app opts into an ImagePipeline (SetSource).
+    // Content is registered with the Backplate's ResidencyManager while attached.
     class Image : public Wnd
     {
     public:
@@ -39,8 +44,18 @@ namespace FD2D
             int sourceAlphaUsage { 0 };
         };
 
+        // Called when the Backplate's residency manager evicted this image's
+        // content (budget exceeded while the image was off screen) and the
+        // image is being drawn again. The app re-supplies content via
+        // SetBitmap/SetShaderResource, immediately or from an async load.
+        // Only content that can come back is evictable: SetSource content
+        // (decoded again) or content with a restorer. Other content is still
+        // counted against the budget but never evicted.
+        using ContentRestorer = std::function<void(Image& image)>;
+
         Image();
         explicit Image(const std::wstring& name);
+        ~Image() override;
 
         void SetBitmap(Microsoft::WRL::ComPtr<ID2D1Bitmap> bitmap);
         // Texture2D SRV only; discover size via GetResource/GetDesc/SRV mip. Clears bitmap when set.
@@ -50,6 +65,32 @@ namespace FD2D
         DrawState GetDrawState() const;
         D2D1_SIZE_U ContentPixelSize() const; // texel size; 0,0 if empty
 
+        // Pipeline-backed content: decodes `source` through the Backplate's
+        // ImagePipeline (Backplate::SetImagePipeline). The request is queued
+        // when attached, promoted to Visible priority while the image is on
+        // screen and cancelled while it is scrolled off screen; the decoded
+        // pixels are uploaded as the image's bitmap on the next render (and
+        // re-requested after device loss or residency eviction). An empty
+        // source, SetBitmap, SetShaderResource or Clear detach the source.
+        //
+        // With progressive loading (default on) large files first show the
+        // decoder's low-resolution preview, laid out at the full image size,
+        // and the full image cross-fades over it when it arrives.
+        void SetSource(const std::wstring& source);
+        const std::wstring& Source() const { return m_source; }
+        // True when the last decode of Source() failed.
+        bool SourceFailed() const { return m_sourceFailed; }
+        // Applies to requests made after the call.
+        void SetProgressiveLoading(bool enabled) { m_progressive = enabled; }
+        // Preview -> full cross-fade length; 0 swaps without a fade.
+        void SetCrossFadeDuration(std::uint32_t durationMs) { m_slots.SetFadeDurationMs(durationMs); }
+
+        void SetContentRestorer(ContentRestorer restorer);
+        // True after residency eviction until new content is set.
+        bool IsContentEvicted() const { return m_evicted; }
+
+        void OnAttached(Backplate& backplate) override;
+        void OnDetached() override;
         void OnRender(ID2D1RenderTarget* target) override;
         void OnRenderD3D(ID3D11DeviceContext* context) override;
         void OnGraphicsInvalidated(GraphicsInvalidationReason reason, const GraphicsGeneration& generation) override;
@@ -57,6 +98,45 @@ namespace FD2D
     private:
         bool TryGetContentSize(D2D1_SIZE_F& outSize) const;
         void ResetCheckerBrushes();
+        void UpdateResidency();
+        void ReleaseResidency();
+        // Content + prescaled cache + cross-fade slot, as reported to residency.
+        std::uint64_t ResidentBytes() const;
+        void UpdateResidentBytes();
+        bool CanRecreateContent() const { return !m_source.empty() || m_restorer != nullptr; }
+        void MarkContentDrawn();
+        void ResetScaledCache();
+        // `pixels`: the decoded pixels `bitmap` was uploaded from, if any.
+        void ApplyBitmap(
+            Microsoft::WRL::ComPtr<ID2D1Bitmap> bitmap,
+            bool invalidate,
+            std::shared_ptr<const DecodedImage> pixels = nullptr);
+        void ApplyShaderResource(Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srv, bool invalidate);
+        void DetachSource();
+        void RequestSource(ImageLoadPriority priority);
+        void CancelSourceRequest();
+        // Cancels the source request after a full frame this image was not
+        // painted in (hidden or culled: OnRender never ran).
+        void WatchForCulling();
+        void OnSourceDecoded(const std::wstring& source, std::shared_ptr<const DecodedImage> image);
+        void UpdateSourceVisibility(ID2D1RenderTarget* target);
+        void UploadDecodedSource(ID2D1RenderTarget* target);
+        void AdvanceCrossFade(ID2D1RenderTarget* target);
+        void ResetContentSlots();
+        // Returns the cubic-prescaled copy of m_bitmap for destRect, building it
+        // when the draw size has been stable for a frame; nullptr when no cache
+        // applies (not downscaling). `interacting` is set while the size is
+        // changing or the copy is still being built: the result is then the
+        // previous copy or nullptr, and the caller draws bilinear.
+        ID2D1Bitmap* AcquireScaledBitmap(
+            ID2D1RenderTarget* target,
+            const D2D1_RECT_F& destRect,
+            bool& interacting);
+        // Scales m_bitmapPixels to pixelW x pixelH on the executor; the result
+        // lands in m_scaledUpload.
+        void RequestScaledCache(UINT pixelW, UINT pixelH);
+        void OnScaledCacheBuilt(D2D1_SIZE_U size, std::shared_ptr<const DecodedImage> scaled);
+        void RestoreEvictedContent();
 
         // Strong refs to current content; D2D and D3D mutually exclusive.
         Microsoft::WRL::ComPtr<ID2D1Bitmap> m_bitmap {};
@@ -65,6 +145,51 @@ namespace FD2D
         UINT m_srvHeight { 0 };
         DrawState m_drawState {};
 
+        // HIGH_QUALITY_CUBIC result at the current draw size (D2D path only).
+        // m_lastDraw* detect an active zoom (size changed since last frame);
+        // m_lastDrawSource is compared by identity and never dereferenced.
+        Microsoft::WRL::ComPtr<ID2D1Bitmap> m_scaledCache {};
+        D2D1_SIZE_U m_scaledCacheSize { 0, 0 };
+        // Pipeline content keeps its decoded pixels (shared with the
+        // pipeline's cache), so the cubic copy is built off the UI thread with
+        // WIC: the size in flight, its cancellation, the result waiting for
+        // upload, and a size WIC failed at (built on the GPU instead).
+        std::shared_ptr<const DecodedImage> m_bitmapPixels {};
+        CancellationSource m_scaledBuild {};
+        D2D1_SIZE_U m_scaledBuildSize { 0, 0 };
+        std::shared_ptr<const DecodedImage> m_scaledUpload {};
+        D2D1_SIZE_U m_scaledFailedSize { 0, 0 };
+        D2D1_SIZE_U m_lastDrawPixelSize { 0, 0 };
+        const ID2D1Bitmap* m_lastDrawSource { nullptr };
+        std::uint64_t m_contentBytes { 0 };
+
+        // Pipeline source state (see SetSource).
+        std::wstring m_source {};
+        ImagePipeline::RequestId m_sourceRequest { ImagePipeline::kInvalidRequest };
+        ImageLoadPriority m_sourceRequestPriority { ImageLoadPriority::Prefetch };
+        std::uint64_t m_renderedFrame { 0 };
+        // Bumped on detach so a watch left in the previous window's frame
+        // observers retires itself.
+        std::uint32_t m_cullWatchGeneration { 0 };
+        bool m_cullWatch { false };
+        std::shared_ptr<const DecodedImage> m_pendingUpload {};
+        bool m_sourceFailed { false };
+        bool m_progressive { true };
+
+        // Progressive display: m_bitmap is the primary slot, m_pendingBitmap
+        // the content fading in over it; m_slots tracks their quality and the
+        // fade. m_sourcePixelSize is the full-resolution size of pipeline
+        // content, so a preview primary lays out exactly like the final image.
+        ContentSlots m_slots {};
+        Microsoft::WRL::ComPtr<ID2D1Bitmap> m_pendingBitmap {};
+        std::shared_ptr<const DecodedImage> m_pendingPixels {};
+        D2D1_SIZE_U m_sourcePixelSize { 0, 0 };
+
+        ResidencyManager::Handle m_residencyHandle { ResidencyManager::kInvalidHandle };
+        ContentRestorer m_restorer {};
+        bool m_evicted { false };
+        bool m_restoreRequested { false };
+
         Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> m_checkerLightBrush {};
         Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> m_checkerDarkBrush {};
     };
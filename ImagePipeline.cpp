@@ -0,0 +1,600 @@
+#include "ImagePipeline.h"
+#include <algorithm>
+#include <utility>
+
+namespace FD2D
+{
+    void DecodedImageCache::SetBudget(std::uint64_t bytes)
+    {
+        m_budgetBytes = bytes;
+        Trim();
+    }
+
+    std::shared_ptr<const DecodedImage> DecodedImageCache::Find(const std::wstring& key)
+    {
+        auto it = m_index.find(key);
+        if (it == m_index.end())
+        {
+            return nullptr;
+        }
+
+        if (it->second != m_lru.begin())
+        {
+            m_lru.splice(m_lru.begin(), m_lru, it->second);
+        }
+        return it->second->image;
+    }
+
+    void DecodedImageCache::Insert(const std::wstring& key, std::shared_ptr<const DecodedImage> image)
+    {
+        if (!image)
+        {
+            return;
+        }
+
+        Erase(key);
+
+        // An image larger than the whole budget would only flush everything
+        // else and then be evicted itself; hand it out uncached instead.
+        if (m_budgetBytes != 0 && image->ByteSize() > m_budgetBytes)
+        {
+            return;
+        }
+
+        m_bytes += image->ByteSize();
+        m_lru.push_front(Entry { key, std::move(image) });
+        m_index.emplace(key, m_lru.begin());
+        Trim();
+    }
+
+    void DecodedImageCache::Erase(const std::wstring& key)
+    {
+        auto it = m_index.find(key);
+        if (it == m_index.end())
+        {
+            return;
+        }
+
+        m_bytes -= it->second->image->ByteSize();
+        m_lru.erase(it->second);
+        m_index.erase(it);
+    }
+
+    void DecodedImageCache::Clear()
+    {
+        m_lru.clear();
+        m_index.clear();
+        m_bytes = 0;
+    }
+
+    void DecodedImageCache::Trim()
+    {
+        if (m_budgetBytes == 0)
+        {
+            return;
+        }
+
+        while (m_bytes > m_budgetBytes && !m_lru.empty())
+        {
+            Entry& victim = m_lru.back();
+            m_bytes -= victim.image->ByteSize();
+            m_index.erase(victim.key);
+            m_lru.pop_back();
+        }
+    }
+
+    ImagePipeline::ImagePipeline(std::shared_ptr<ImageDecoder> decoder, const Options& options)
+        : m_decoder(std::move(decoder))
+    {
+        m_cache.SetBudget(options.cacheBudgetBytes);
+
+        const std::size_t workerCount = (std::max)(std::size_t { 1 }, options.workerCount);
+        m_workers.reserve(workerCount);
+        for (std::size_t i = 0; i < workerCount; ++i)
+        {
+            m_workers.emplace_back([this]() { WorkerMain(); });
+        }
+    }
+
+    ImagePipeline::~ImagePipeline()
+    {
+        Shutdown();
+    }
+
+    void ImagePipeline::SetWakeCallback(Owner owner, std::function<void()> wake)
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        auto it = std::find_if(
+            m_wakes.begin(),
+            m_wakes.end(),
+            [owner](const WakeEntry& entry) { return entry.owner == owner; });
+        if (!wake)
+        {
+            if (it != m_wakes.end())
+            {
+                m_wakes.erase(it);
+            }
+            return;
+        }
+
+        if (it != m_wakes.end())
+        {
+            it->wake = std::move(wake);
+        }
+        else
+        {
+            m_wakes.push_back(WakeEntry { owner, std::move(wake) });
+        }
+    }
+
+    void ImagePipeline::Wake(const std::vector<Owner>& owners)
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        for (const WakeEntry& entry : m_wakes)
+        {
+            const bool interested =
+                entry.owner == nullptr ||
+                std::any_of(
+                    owners.begin(),
+                    owners.end(),
+                    [&entry](Owner owner) { return owner == nullptr || owner == entry.owner; });
+            if (interested)
+            {
+                entry.wake();
+            }
+        }
+    }
+
+    ImagePipeline::RequestId ImagePipeline::Request(
+        const std::wstring& source,
+        ImageLoadPriority priority,
+        Completion completion,
+        bool wantPreview,
+        Owner owner)
+    {
+        bool cacheHit = false;
+        RequestId request = kInvalidRequest;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stopping)
+            {
+                return kInvalidRequest;
+            }
+
+            request = m_nextRequest++;
+
+            if (auto cached = m_cache.Find(source))
+            {
+                ++m_cacheHits;
+                m_deliveries.push_back(Delivery { request, std::move(completion), std::move(cached), owner });
+                cacheHit = true;
+            }
+            else
+            {
+                JobId jobId = 0;
+                auto existing = m_jobBySource.find(source);
+                if (existing != m_jobBySource.end())
+                {
+                    jobId = existing->second;
+                }
+                else
+                {
+                    jobId = m_nextJob++;
+                    Job job {};
+                    job.id = jobId;
+                    job.source = source;
+                    job.priority = static_cast<int>(priority);
+                    job.sequence = m_nextSequence++;
+                    job.cancelled = std::make_shared<std::atomic<bool>>(false);
+                    m_jobs.emplace(jobId, std::move(job));
+                    m_jobBySource.emplace(source, jobId);
+                    m_queue.insert(QueueKey { static_cast<int>(priority), m_jobs[jobId].sequence, jobId });
+                    m_workAvailable.notify_one();
+                }
+
+                Job& job = m_jobs[jobId];
+                job.waiters.push_back(request);
+                m_waiters.emplace(request, Waiter { jobId, priority, std::move(completion), wantPreview, owner });
+                Requeue(job, EffectivePriority(job));
+            }
+        }
+
+        if (cacheHit)
+        {
+            Wake({ owner });
+        }
+        return request;
+    }
+
+    int ImagePipeline::EffectivePriority(const Job& job) const
+    {
+        int best = static_cast<int>(ImageLoadPriority::Prefetch);
+        for (RequestId waiter : job.waiters)
+        {
+            auto it = m_waiters.find(waiter);
+            if (it != m_waiters.end())
+            {
+                best = (std::min)(best, static_cast<int>(it->second.priority));
+            }
+        }
+        return best;
+    }
+
+    void ImagePipeline::Requeue(Job& job, int priority)
+    {
+        if (job.running || job.priority == priority)
+        {
+            return;
+        }
+
+        // Keep the original sequence so FIFO order within a band is stable.
+        m_queue.erase(QueueKey { job.priority, job.sequence, job.id });
+        job.priority = priority;
+        m_queue.insert(QueueKey { job.priority, job.sequence, job.id });
+    }
+
+    void ImagePipeline::SetPriority(RequestId request, ImageLoadPriority priority)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_waiters.find(request);
+        if (it == m_waiters.end())
+        {
+            return;
+        }
+
+        it->second.priority = priority;
+        auto jobIt = m_jobs.find(it->second.job);
+        if (jobIt != m_jobs.end())
+        {
+            Requeue(jobIt->second, EffectivePriority(jobIt->second));
+        }
+    }
+
+    void ImagePipeline::Cancel(RequestId request)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // Already finished (or a cache hit, or a preview) but not delivered
+        // yet: drop the deliveries. A request that only had its preview
+        // delivered is still waiting on the full decode below.
+        m_deliveries.erase(
+            std::remove_if(
+                m_deliveries.begin(),
+                m_deliveries.end(),
+                [request](const Delivery& delivery) { return delivery.request == request; }),
+            m_deliveries.end());
+
+        auto waiterIt = m_waiters.find(request);
+        if (waiterIt == m_waiters.end())
+        {
+            return;
+        }
+
+        const JobId jobId = waiterIt->second.job;
+        m_waiters.erase(waiterIt);
+
+        auto jobIt = m_jobs.find(jobId);
+        if (jobIt == m_jobs.end())
+        {
+            return;
+        }
+
+        Job& job = jobIt->second;
+        job.waiters.erase(
+            std::remove(job.waiters.begin(), job.waiters.end(), request),
+            job.waiters.end());
+        if (!job.waiters.empty())
+        {
+            Requeue(job, EffectivePriority(job));
+            return;
+        }
+
+        ++m_cancelledJobs;
+        if (job.running)
+        {
+            // The worker owns the job until Decode returns. Unmap the source
+            // now so a new request for it starts a fresh job instead of
+            // joining one that is being abandoned.
+            job.cancelled->store(true);
+            m_jobBySource.erase(job.source);
+            return;
+        }
+
+        m_queue.erase(QueueKey { job.priority, job.sequence, job.id });
+        m_jobBySource.erase(job.source);
+        m_jobs.erase(jobIt);
+    }
+
+    bool ImagePipeline::DeliverCompleted(std::size_t maxItems, std::uint64_t maxBytes, Owner owner)
+    {
+        std::size_t delivered = 0;
+        std::uint64_t deliveredBytes = 0;
+        for (;;)
+        {
+            Delivery delivery {};
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto next = std::find_if(
+                    m_deliveries.begin(),
+                    m_deliveries.end(),
+                    [owner](const Delivery& candidate) { return DeliversTo(candidate, owner); });
+                if (next == m_deliveries.end())
+                {
+                    return false;
+                }
+                if ((maxItems != 0 && delivered >= maxItems) ||
+                    (maxBytes != 0 && deliveredBytes >= maxBytes))
+                {
+                    return true;
+                }
+
+                delivery = std::move(*next);
+                m_deliveries.erase(next);
+            }
+
+            // Completions run unlocked: they typically upload and may issue
+            // new requests or cancel others.
+            ++delivered;
+            if (delivery.image)
+            {
+                deliveredBytes += delivery.image->ByteSize();
+            }
+            if (delivery.completion)
+            {
+                delivery.completion(std::move(delivery.image));
+            }
+        }
+    }
+
+    bool ImagePipeline::HasPendingDeliveries(Owner owner) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return std::any_of(
+            m_deliveries.begin(),
+            m_deliveries.end(),
+            [owner](const Delivery& delivery) { return DeliversTo(delivery, owner); });
+    }
+
+    std::shared_ptr<const DecodedImage> ImagePipeline::FindCached(const std::wstring& source)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_cache.Find(source);
+    }
+
+    void ImagePipeline::SetCacheBudget(std::uint64_t bytes)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_cache.SetBudget(bytes);
+    }
+
+    ImagePipeline::Stats ImagePipeline::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Stats stats {};
+        stats.queuedJobs = m_queue.size();
+        stats.runningJobs = m_runningJobs;
+        stats.pendingDeliveries = m_deliveries.size();
+        stats.cacheBytes = m_cache.Bytes();
+        stats.cacheEntries = m_cache.Count();
+        stats.cacheHits = m_cacheHits;
+        stats.decodes = m_decodes;
+        stats.previews = m_previews;
+        stats.decodeFailures = m_decodeFailures;
+        stats.cancelledJobs = m_cancelledJobs;
+        return stats;
+    }
+
+    void ImagePipeline::Shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stopping && m_workers.empty())
+            {
+                return;
+            }
+
+            m_stopping = true;
+            for (auto& entry : m_jobs)
+            {
+                entry.second.cancelled->store(true);
+            }
+        }
+        m_workAvailable.notify_all();
+
+        for (auto& worker : m_workers)
+        {
+            if (worker.joinable())
+            {
+                worker.join();
+            }
+        }
+        m_workers.clear();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.clear();
+        m_jobs.clear();
+        m_jobBySource.clear();
+        m_waiters.clear();
+        m_deliveries.clear();
+    }
+
+    void ImagePipeline::DeliverPreview(
+        JobId jobId,
+        const std::shared_ptr<std::atomic<bool>>& cancelled,
+        const std::wstring& source)
+    {
+        auto wantsPreview = [this](const Job& job)
+        {
+            for (RequestId waiter : job.waiters)
+            {
+                auto it = m_waiters.find(waiter);
+                if (it != m_waiters.end() && it->second.wantPreview)
+                {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto jobIt = m_jobs.find(jobId);
+            if (jobIt == m_jobs.end() || !wantsPreview(jobIt->second))
+            {
+                return;
+            }
+        }
+
+        auto preview = std::make_shared<DecodedImage>();
+        if (!m_decoder->DecodePreview(source, *cancelled, *preview) || cancelled->load())
+        {
+            return;
+        }
+
+        preview->preview = true;
+        if (preview->sourceWidth == 0 || preview->sourceHeight == 0)
+        {
+            preview->sourceWidth = preview->width;
+            preview->sourceHeight = preview->height;
+        }
+
+        std::vector<Owner> wake;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto jobIt = m_jobs.find(jobId);
+            if (jobIt == m_jobs.end() || cancelled->load())
+            {
+                return;
+            }
+
+            ++m_previews;
+            std::shared_ptr<const DecodedImage> shared = std::move(preview);
+            for (RequestId waiter : jobIt->second.waiters)
+            {
+                auto waiterIt = m_waiters.find(waiter);
+                if (waiterIt == m_waiters.end() || !waiterIt->second.wantPreview)
+                {
+                    continue;
+                }
+                // Copy the completion: the same waiter receives the full image later.
+                m_deliveries.push_back(Delivery { waiter, waiterIt->second.completion, shared, waiterIt->second.owner });
+                wake.push_back(waiterIt->second.owner);
+            }
+        }
+
+        if (!wake.empty())
+        {
+            Wake(wake);
+        }
+    }
+
+    void ImagePipeline::WorkerMain()
+    {
+        if (m_decoder)
+        {
+            m_decoder->OnWorkerThreadStart();
+        }
+
+        for (;;)
+        {
+            JobId jobId = 0;
+            std::wstring source;
+            std::shared_ptr<std::atomic<bool>> cancelled;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_workAvailable.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+                if (m_stopping)
+                {
+                    break;
+                }
+
+                const QueueKey next = *m_queue.begin();
+                m_queue.erase(m_queue.begin());
+                Job& job = m_jobs[next.job];
+                job.running = true;
+                ++m_runningJobs;
+                jobId = job.id;
+                source = job.source;
+                cancelled = job.cancelled;
+            }
+
+            if (m_decoder)
+            {
+                DeliverPreview(jobId, cancelled, source);
+            }
+
+            auto image = std::make_shared<DecodedImage>();
+            const bool ok = m_decoder && m_decoder->Decode(source, *cancelled, *image);
+            if (ok)
+            {
+                image->preview = false;
+                if (image->sourceWidth == 0 || image->sourceHeight == 0)
+                {
+                    image->sourceWidth = image->width;
+                    image->sourceHeight = image->height;
+                }
+            }
+
+            std::vector<Owner> wake;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                --m_runningJobs;
+                auto jobIt = m_jobs.find(jobId);
+                if (jobIt == m_jobs.end())
+                {
+                    // Shutdown cleared the tables while we were decoding.
+                    continue;
+                }
+
+                Job job = std::move(jobIt->second);
+                m_jobs.erase(jobIt);
+                auto sourceIt = m_jobBySource.find(job.source);
+                if (sourceIt != m_jobBySource.end() && sourceIt->second == jobId)
+                {
+                    m_jobBySource.erase(sourceIt);
+                }
+
+                // A decode that completed despite a late cancel is still worth
+                // caching; one that bailed out reports failure and is dropped.
+                std::shared_ptr<const DecodedImage> result;
+                if (ok)
+                {
+                    ++m_decodes;
+                    result = std::move(image);
+                    m_cache.Insert(job.source, result);
+                }
+                else if (!cancelled->load())
+                {
+                    ++m_decodeFailures;
+                }
+
+                if (cancelled->load() || job.waiters.empty())
+                {
+                    continue;
+                }
+
+                for (RequestId waiter : job.waiters)
+                {
+                    auto waiterIt = m_waiters.find(waiter);
+                    if (waiterIt == m_waiters.end())
+                    {
+                        continue;
+                    }
+                    m_deliveries.push_back(Delivery { waiter, std::move(waiterIt->second.completion), result, waiterIt->second.owner });
+                    wake.push_back(waiterIt->second.owner);
+                    m_waiters.erase(waiterIt);
+                }
+            }
+
+            if (!wake.empty())
+            {
+                Wake(wake);
+            }
+        }
+
+        if (m_decoder)
+        {
+            m_decoder->OnWorkerThreadStop();
+        }
+    }
+}
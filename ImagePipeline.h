@@ -0,0 +1,292 @@
+#pragma once
+
+// ImagePipeline.h - optional asynchronous image decode pipeline.
+//
+// Platform-neutral core (no Windows/WIC/D2D types): a prioritized decode queue
+// served by a small worker pool, a decoded-pixel LRU cache under a byte budget,
+// per-request cancellation, and UI-thread delivery in bounded batches. The
+// actual decoding is delegated to an ImageDecoder (WicImageDecoder on Windows).
+//
+// Threading: Request/SetPriority/Cancel/DeliverCompleted may be called from
+// any thread, but completions only ever run inside DeliverCompleted (normally
+// the UI thread, driven by Backplate). Wake callbacks run on worker threads
+// and must only signal (e.g. AsyncRedrawToken::RequestAsyncRedraw).
+//
+// A pipeline may be shared by several windows: requests carry an owner (the
+// Backplate whose control made them), each owner registers its own wake
+// callback, and DeliverCompleted(owner) runs only that owner's completions,
+// so every window is woken for and uploads its own images.
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace FD2D
+{
+    // Decoded pixels: BGRA8, premultiplied alpha, rows `stride` bytes apart.
+    // A preview is a reduced-resolution stand-in; sourceWidth/sourceHeight
+    // always carry the full-resolution size so layout does not jump when the
+    // full image replaces it.
+    struct DecodedImage
+    {
+        std::uint32_t width { 0 };
+        std::uint32_t height { 0 };
+        std::uint32_t stride { 0 };
+        std::uint32_t sourceWidth { 0 };
+        std::uint32_t sourceHeight { 0 };
+        bool preview { false };
+        std::vector<std::uint8_t> pixels {};
+
+        std::uint64_t ByteSize() const { return pixels.size(); }
+    };
+
+    class ImageDecoder
+    {
+    public:
+        virtual ~ImageDecoder() = default;
+
+        // Per-worker-thread setup/teardown (e.g. COM apartment init).
+        virtual void OnWorkerThreadStart() {}
+        virtual void OnWorkerThreadStop() {}
+
+        // Decodes `source` (a path or app-defined key) into `out`. Long decodes
+        // should poll `cancelled` and bail out early. Returns false on failure.
+        virtual bool Decode(
+            const std::wstring& source,
+            const std::atomic<bool>& cancelled,
+            DecodedImage& out) = 0;
+
+        // Optional fast low-resolution stand-in (embedded thumbnail, small mip,
+        // scaled decode), decoded before the full image for requests that ask
+        // for it. Return false when none is available or it would not be
+        // meaningfully faster than Decode.
+        virtual bool DecodePreview(
+            const std::wstring& source,
+            const std::atomic<bool>& cancelled,
+            DecodedImage& out)
+        {
+            (void)source;
+            (void)cancelled;
+            (void)out;
+            return false;
+        }
+    };
+
+    // LRU cache of decoded pixels keyed by source, bounded by total bytes.
+    // Entries handed out stay alive while referenced, even after eviction.
+    // Not synchronized (ImagePipeline guards it with its own mutex).
+    class DecodedImageCache
+    {
+    public:
+        void SetBudget(std::uint64_t bytes);
+        std::uint64_t Budget() const { return m_budgetBytes; }
+        std::uint64_t Bytes() const { return m_bytes; }
+        std::size_t Count() const { return m_index.size(); }
+
+        std::shared_ptr<const DecodedImage> Find(const std::wstring& key);
+        void Insert(const std::wstring& key, std::shared_ptr<const DecodedImage> image);
+        void Erase(const std::wstring& key);
+        void Clear();
+
+    private:
+        struct Entry
+        {
+            std::wstring key {};
+            std::shared_ptr<const DecodedImage> image {};
+        };
+
+        void Trim();
+
+        // Front = most recently used.
+        std::list<Entry> m_lru {};
+        std::unordered_map<std::wstring, std::list<Entry>::iterator> m_index {};
+        std::uint64_t m_budgetBytes { 256ull * 1024ull * 1024ull };
+        std::uint64_t m_bytes { 0 };
+    };
+
+    enum class ImageLoadPriority : int
+    {
+        Visible = 0,   // on screen now: decoded first
+        Prefetch = 1   // likely needed soon (neighbours, off-screen lists)
+    };
+
+    class ImagePipeline
+    {
+    public:
+        using RequestId = std::uint64_t;
+        static constexpr RequestId kInvalidRequest = 0;
+        // Opaque owner key (nullptr = none). Ownerless deliveries go to any
+        // owner; an ownerless wake callback hears about every delivery.
+        using Owner = const void*;
+
+        // Receives the decoded image, or nullptr when decoding failed.
+        // Not called for cancelled requests. Requests made with wantPreview
+        // may first receive a preview (image->preview), then the full image.
+        using Completion = std::function<void(std::shared_ptr<const DecodedImage> image)>;
+
+        struct Options
+        {
+            std::size_t workerCount { 2 };
+            std::uint64_t cacheBudgetBytes { 256ull * 1024ull * 1024ull };
+        };
+
+        struct Stats
+        {
+            std::size_t queuedJobs { 0 };
+            std::size_t runningJobs { 0 };
+            std::size_t pendingDeliveries { 0 };
+            std::uint64_t cacheBytes { 0 };
+            std::size_t cacheEntries { 0 };
+            std::uint64_t cacheHits { 0 };
+            std::uint64_t decodes { 0 };
+            std::uint64_t previews { 0 };
+            std::uint64_t decodeFailures { 0 };
+            std::uint64_t cancelledJobs { 0 };
+        };
+
+        ImagePipeline(std::shared_ptr<ImageDecoder> decoder, const Options& options);
+        ~ImagePipeline();
+
+        ImagePipeline(const ImagePipeline&) = delete;
+        ImagePipeline& operator=(const ImagePipeline&) = delete;
+
+        // Invoked (from a worker thread) whenever completions for `owner`
+        // are ready. One callback per owner; an empty one removes it (an
+        // owner must remove its callback before it goes away).
+        void SetWakeCallback(Owner owner, std::function<void()> wake);
+        void SetWakeCallback(std::function<void()> wake) { SetWakeCallback(nullptr, std::move(wake)); }
+
+        // Requests `source`. Cache hits complete on the next DeliverCompleted.
+        // Concurrent requests for the same source share one decode.
+        // `wantPreview` asks for a preview delivery ahead of the full image
+        // when the decoder can produce one (never for cache hits).
+        RequestId Request(
+            const std::wstring& source,
+            ImageLoadPriority priority,
+            Completion completion,
+            bool wantPreview = false,
+            Owner owner = nullptr);
+        void SetPriority(RequestId request, ImageLoadPriority priority);
+        // Drops the request's completion. A queued decode with no remaining
+        // requests is removed; a running one is flagged so the decoder can stop.
+        void Cancel(RequestId request);
+
+        // Runs ready completions on the calling thread until `maxItems`
+        // completions or `maxBytes` of delivered pixels (whichever first; 0 =
+        // unlimited) so uploads are spread over frames. With an owner, only
+        // its own and ownerless completions run; nullptr runs them all.
+        // Returns true when more of those completions remain.
+        bool DeliverCompleted(std::size_t maxItems, std::uint64_t maxBytes, Owner owner = nullptr);
+        bool HasPendingDeliveries(Owner owner = nullptr) const;
+
+        std::shared_ptr<const DecodedImage> FindCached(const std::wstring& source);
+        void SetCacheBudget(std::uint64_t bytes);
+        Stats GetStats() const;
+
+        // Stops workers (cancelling running decodes) and drops all queued work
+        // and undelivered completions. Called by the destructor.
+        void Shutdown();
+
+    private:
+        using JobId = std::uint64_t;
+
+        struct Job
+        {
+            JobId id { 0 };
+            std::wstring source {};
+            int priority { 0 };
+            std::uint64_t sequence { 0 };
+            bool running { false };
+            std::shared_ptr<std::atomic<bool>> cancelled {};
+            std::vector<RequestId> waiters {};
+        };
+
+        struct QueueKey
+        {
+            int priority { 0 };
+            std::uint64_t sequence { 0 };
+            JobId job { 0 };
+
+            bool operator<(const QueueKey& other) const
+            {
+                if (priority != other.priority)
+                {
+                    return priority < other.priority;
+                }
+                return sequence < other.sequence;
+            }
+        };
+
+        struct Waiter
+        {
+            JobId job { 0 };
+            ImageLoadPriority priority { ImageLoadPriority::Prefetch };
+            Completion completion {};
+            bool wantPreview { false };
+            Owner owner { nullptr };
+        };
+
+        struct Delivery
+        {
+            RequestId request { kInvalidRequest };
+            Completion completion {};
+            std::shared_ptr<const DecodedImage> image {};
+            Owner owner { nullptr };
+        };
+
+        struct WakeEntry
+        {
+            Owner owner { nullptr };
+            std::function<void()> wake {};
+        };
+
+        void WorkerMain();
+        void DeliverPreview(JobId jobId, const std::shared_ptr<std::atomic<bool>>& cancelled, const std::wstring& source);
+        void Requeue(Job& job, int priority);
+        int EffectivePriority(const Job& job) const;
+        // Calls the wake callbacks interested in deliveries for `owners`.
+        void Wake(const std::vector<Owner>& owners);
+        static bool DeliversTo(const Delivery& delivery, Owner owner)
+        {
+            return owner == nullptr || delivery.owner == nullptr || delivery.owner == owner;
+        }
+
+        std::shared_ptr<ImageDecoder> m_decoder {};
+        std::vector<std::thread> m_workers {};
+
+        mutable std::mutex m_mutex {};
+        std::condition_variable m_workAvailable {};
+        bool m_stopping { false };
+
+        std::unordered_map<JobId, Job> m_jobs {};
+        std::unordered_map<std::wstring, JobId> m_jobBySource {};
+        std::set<QueueKey> m_queue {};
+        std::unordered_map<RequestId, Waiter> m_waiters {};
+        std::deque<Delivery> m_deliveries {};
+        DecodedImageCache m_cache {};
+
+        JobId m_nextJob { 1 };
+        RequestId m_nextRequest { 1 };
+        std::uint64_t m_nextSequence { 0 };
+        std::size_t m_runningJobs { 0 };
+        std::uint64_t m_cacheHits { 0 };
+        std::uint64_t m_decodes { 0 };
+        std::uint64_t m_previews { 0 };
+        std::uint64_t m_decodeFailures { 0 };
+        std::uint64_t m_cancelledJobs { 0 };
+
+        std::mutex m_wakeMutex {};
+        std::vector<WakeEntry> m_wakes {};
+    };
+}
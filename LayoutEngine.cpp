@@ -0,0 +1,589 @@
+#include "LayoutEngine.h"
+#include <algorithm>
+#include <limits>
+
+namespace FD2D
+{
+    namespace
+    {
+        // Anything at or beyond this is an unconstrained probe (matches
+        // DynamicPanel; avoids FLT_MAX arithmetic overflow).
+        constexpr float kInfExtent = 1.0e9f;
+    }
+
+    float LayoutKernels::Stack(const float* mainSizes, std::size_t count, float start, float spacing, float* outOffsets)
+    {
+        float offset = start;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (outOffsets != nullptr)
+            {
+                outOffsets[i] = offset;
+            }
+            offset += mainSizes[i] + spacing;
+        }
+        return (count > 0) ? (offset - spacing - start) : 0.0f;
+    }
+
+    float LayoutKernels::Wrap(const float* widths, const float* heights, std::size_t count,
+        float contentWidth, float hgap, float vgap, bool singleColumn,
+        float* outX, float* outY, float* outUsedWidth)
+    {
+        float x = 0.0f, y = 0.0f, rowH = 0.0f, usedW = 0.0f;
+        bool rowEmpty = true;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (!rowEmpty && (singleColumn || (x + hgap + widths[i]) > contentWidth))
+            {
+                usedW = (std::max)(usedW, x); // widest row so far
+                x = 0.0f;
+                y += rowH + vgap;
+                rowH = 0.0f;
+                rowEmpty = true;
+            }
+            if (!rowEmpty)
+            {
+                x += hgap;
+            }
+            if (outX != nullptr)
+            {
+                outX[i] = x;
+                outY[i] = y;
+            }
+            x += widths[i];
+            rowH = (std::max)(rowH, heights[i]);
+            rowEmpty = false;
+        }
+        usedW = (std::max)(usedW, x); // last row
+        if (outUsedWidth != nullptr)
+        {
+            *outUsedWidth = usedW;
+        }
+        return y + rowH;
+    }
+
+    std::size_t LayoutKernels::BreakRows(const float* widths, std::size_t count, float contentWidth, float hgap,
+        bool singleColumn, std::uint32_t* outRowEnds, float* outMinWidth, float* outMaxWidth)
+    {
+        // Same arithmetic as Wrap, so both agree on every break. A row of
+        // several children needs the width it uses; each break needs the
+        // next child to still overflow.
+        float minWidth = 0.0f;
+        float maxWidth = std::numeric_limits<float>::infinity();
+        std::size_t rows = 0;
+        float x = 0.0f;
+        bool rowEmpty = true;
+        bool rowShared = false;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (!rowEmpty && (singleColumn || (x + hgap + widths[i]) > contentWidth))
+            {
+                if (rowShared)
+                {
+                    minWidth = (std::max)(minWidth, x);
+                }
+                if (!singleColumn)
+                {
+                    maxWidth = (std::min)(maxWidth, x + hgap + widths[i]);
+                }
+                outRowEnds[rows++] = static_cast<std::uint32_t>(i);
+                x = 0.0f;
+                rowEmpty = true;
+                rowShared = false;
+            }
+            if (!rowEmpty)
+            {
+                x += hgap;
+                rowShared = true;
+            }
+            x += widths[i];
+            rowEmpty = false;
+        }
+        if (!rowEmpty)
+        {
+            if (rowShared)
+            {
+                minWidth = (std::max)(minWidth, x);
+            }
+            outRowEnds[rows++] = static_cast<std::uint32_t>(count);
+        }
+        if (singleColumn)
+        {
+            minWidth = 0.0f;
+        }
+        *outMinWidth = minWidth;
+        *outMaxWidth = maxWidth;
+        return rows;
+    }
+
+    void LayoutKernels::Justify(FlexJustify justify, float freeSpace, std::size_t count, float* outLead, float* outBetween)
+    {
+        *outLead = 0.0f;
+        *outBetween = 0.0f;
+        if (freeSpace <= 0.0f || count == 0)
+        {
+            return;
+        }
+
+        const float n = static_cast<float>(count);
+        switch (justify)
+        {
+        case FlexJustify::Start:
+            break;
+        case FlexJustify::End:
+            *outLead = freeSpace;
+            break;
+        case FlexJustify::Center:
+            *outLead = freeSpace * 0.5f;
+            break;
+        case FlexJustify::SpaceBetween:
+            if (count > 1)
+            {
+                *outBetween = freeSpace / (n - 1.0f);
+            }
+            break;
+        case FlexJustify::SpaceAround:
+            *outBetween = freeSpace / n;
+            *outLead = *outBetween * 0.5f;
+            break;
+        case FlexJustify::SpaceEvenly:
+            *outBetween = freeSpace / (n + 1.0f);
+            *outLead = *outBetween;
+            break;
+        }
+    }
+
+    void LayoutKernels::FlexRow(const float* basis, const float* grow, const float* shrink, std::size_t count,
+        float contentWidth, float gap, FlexJustify justify, float* outX, float* outW)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        const float gaps = gap * static_cast<float>(count - 1);
+        float used = gaps;
+        float growTotal = 0.0f;
+        float shrinkTotal = 0.0f;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            outW[i] = basis[i];
+            used += basis[i];
+            growTotal += grow[i];
+            shrinkTotal += shrink[i] * basis[i];
+        }
+
+        float freeSpace = contentWidth - used;
+        if (freeSpace > 0.0f && growTotal > 0.0f)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                outW[i] += freeSpace * (grow[i] / growTotal);
+            }
+            freeSpace = 0.0f;
+        }
+        else if (freeSpace < 0.0f && shrinkTotal > 0.0f)
+        {
+            used = gaps;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                outW[i] = (std::max)(0.0f, basis[i] + freeSpace * (shrink[i] * basis[i] / shrinkTotal));
+                used += outW[i];
+            }
+            freeSpace = contentWidth - used;
+        }
+
+        float lead = 0.0f;
+        float between = 0.0f;
+        Justify(justify, freeSpace, count, &lead, &between);
+        float x = lead;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            outX[i] = x;
+            x += outW[i] + gap + between;
+        }
+    }
+
+    float LayoutKernels::GrowTracks(float* sizes, const float* maxSizes, const std::uint8_t* growable,
+        std::size_t count, float extra)
+    {
+        // Each round hands every still-growable track an equal share; a round
+        // either places everything or caps at least one more track.
+        while (extra > 0.0f)
+        {
+            std::size_t open = 0;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (growable[i] != 0 && sizes[i] < maxSizes[i])
+                {
+                    ++open;
+                }
+            }
+            if (open == 0)
+            {
+                break;
+            }
+
+            const float share = extra / static_cast<float>(open);
+            bool capped = false;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (growable[i] != 0 && sizes[i] < maxSizes[i])
+                {
+                    const float room = maxSizes[i] - sizes[i];
+                    const float grow = (std::min)(share, room);
+                    capped = capped || room <= share;
+                    sizes[i] += grow;
+                    extra -= grow;
+                }
+            }
+            if (!capped)
+            {
+                return 0.0f;
+            }
+        }
+        return (std::max)(0.0f, extra);
+    }
+
+    void LayoutKernels::ShareStar(const float* weights, const float* minSizes, const float* maxSizes,
+        std::size_t count, float space, float* outSizes)
+    {
+        // Unresolved star tracks hold -1; a track is resolved once frozen at a
+        // bound or when a round needs no clamping.
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (weights[i] > 0.0f)
+            {
+                outSizes[i] = -1.0f;
+            }
+        }
+
+        for (;;)
+        {
+            float weight = 0.0f;
+            float free = space;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (weights[i] <= 0.0f)
+                {
+                    continue;
+                }
+                if (outSizes[i] < 0.0f)
+                {
+                    weight += weights[i];
+                }
+                else
+                {
+                    free -= outSizes[i];
+                }
+            }
+            if (weight <= 0.0f)
+            {
+                return;
+            }
+
+            const float share = (std::max)(0.0f, free) / weight;
+            float violation = 0.0f;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (weights[i] > 0.0f && outSizes[i] < 0.0f)
+                {
+                    const float size = weights[i] * share;
+                    const float clamped = (std::max)(minSizes[i], (std::min)(size, maxSizes[i]));
+                    violation += clamped - size;
+                }
+            }
+
+            // Freeze only the tracks clamped in the direction of the net
+            // violation (CSS flexible-length resolution); the others re-share.
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (weights[i] > 0.0f && outSizes[i] < 0.0f)
+                {
+                    const float size = weights[i] * share;
+                    const float clamped = (std::max)(minSizes[i], (std::min)(size, maxSizes[i]));
+                    if (violation == 0.0f || (violation > 0.0f && clamped > size) || (violation < 0.0f && clamped < size))
+                    {
+                        outSizes[i] = clamped;
+                    }
+                }
+            }
+        }
+    }
+
+    LayoutNodeId LayoutEngine::CreateNode(LayoutKind kind, LayoutNodeId parent)
+    {
+        const LayoutNodeId id = static_cast<LayoutNodeId>(m_kind.size());
+        m_orderRoot = kNoLayoutNode;
+        m_kind.push_back(kind);
+        m_parent.push_back(parent);
+        m_firstChild.push_back(kNoLayoutNode);
+        m_lastChild.push_back(kNoLayoutNode);
+        m_nextSibling.push_back(kNoLayoutNode);
+        m_leafW.push_back(0.0f);
+        m_leafH.push_back(0.0f);
+        m_margin.push_back(0.0f);
+        m_padding.push_back(0.0f);
+        m_spacing.push_back(0.0f);
+        m_rowSpacing.push_back(0.0f);
+        m_singleColumn.push_back(0);
+        m_availW.push_back(0.0f);
+        m_availH.push_back(0.0f);
+        m_desiredW.push_back(0.0f);
+        m_desiredH.push_back(0.0f);
+        m_x.push_back(0.0f);
+        m_y.push_back(0.0f);
+        m_w.push_back(0.0f);
+        m_h.push_back(0.0f);
+
+        if (parent != kNoLayoutNode)
+        {
+            if (m_lastChild[parent] == kNoLayoutNode)
+            {
+                m_firstChild[parent] = id;
+            }
+            else
+            {
+                m_nextSibling[m_lastChild[parent]] = id;
+            }
+            m_lastChild[parent] = id;
+        }
+        return id;
+    }
+
+    void LayoutEngine::Clear()
+    {
+        for (auto* v : { &m_parent, &m_firstChild, &m_lastChild, &m_nextSibling })
+        {
+            v->clear();
+        }
+        for (auto* v : { &m_leafW, &m_leafH, &m_margin, &m_padding, &m_spacing, &m_rowSpacing,
+                         &m_availW, &m_availH, &m_desiredW, &m_desiredH, &m_x, &m_y, &m_w, &m_h })
+        {
+            v->clear();
+        }
+        m_kind.clear();
+        m_singleColumn.clear();
+        m_orderRoot = kNoLayoutNode;
+    }
+
+    void LayoutEngine::Reserve(std::size_t nodes)
+    {
+        for (auto* v : { &m_parent, &m_firstChild, &m_lastChild, &m_nextSibling })
+        {
+            v->reserve(nodes);
+        }
+        for (auto* v : { &m_leafW, &m_leafH, &m_margin, &m_padding, &m_spacing, &m_rowSpacing,
+                         &m_availW, &m_availH, &m_desiredW, &m_desiredH, &m_x, &m_y, &m_w, &m_h })
+        {
+            v->reserve(nodes);
+        }
+        m_kind.reserve(nodes);
+        m_singleColumn.reserve(nodes);
+    }
+
+    void LayoutEngine::CollectPreorder(LayoutNodeId root)
+    {
+        // The links only change in CreateNode/Clear, which drop the cache, so
+        // repeated passes over one root (Measure then Arrange, every resize)
+        // reuse the walk.
+        if (m_orderRoot == root)
+        {
+            return;
+        }
+        m_orderRoot = root;
+        m_order.clear();
+        m_stack.clear();
+        m_stack.push_back(root);
+        while (!m_stack.empty())
+        {
+            const LayoutNodeId id = m_stack.back();
+            m_stack.pop_back();
+            m_order.push_back(id);
+
+            // Push children so the first child is visited first. Siblings
+            // are singly linked, so push them in order and reverse in place.
+            const std::size_t firstPushed = m_stack.size();
+            for (LayoutNodeId c = m_firstChild[id]; c != kNoLayoutNode; c = m_nextSibling[c])
+            {
+                m_stack.push_back(c);
+            }
+            std::reverse(m_stack.begin() + static_cast<std::ptrdiff_t>(firstPushed), m_stack.end());
+        }
+    }
+
+    std::size_t LayoutEngine::GatherChildSizes(LayoutNodeId id)
+    {
+        m_scratchW.clear();
+        m_scratchH.clear();
+        for (LayoutNodeId c = m_firstChild[id]; c != kNoLayoutNode; c = m_nextSibling[c])
+        {
+            m_scratchW.push_back(m_desiredW[c]);
+            m_scratchH.push_back(m_desiredH[c]);
+        }
+        return m_scratchW.size();
+    }
+
+    void LayoutEngine::Measure(LayoutNodeId root, float availableW, float availableH)
+    {
+        if (root >= m_kind.size())
+        {
+            return;
+        }
+        CollectPreorder(root);
+
+        // Top-down: what each node offers its children.
+        m_availW[root] = availableW;
+        m_availH[root] = availableH;
+        for (const LayoutNodeId id : m_order)
+        {
+            const float chrome = Chrome(id);
+            const bool unconstrainedW = !(m_availW[id] < kInfExtent);
+            const float innerW = unconstrainedW ? kInfExtent : (std::max)(0.0f, m_availW[id] - chrome);
+            const float innerH = !(m_availH[id] < kInfExtent) ? kInfExtent : (std::max)(0.0f, m_availH[id] - chrome);
+            // Wrap children get the row width and unbounded height.
+            const float childH = (m_kind[id] == LayoutKind::Wrap) ? kInfExtent : innerH;
+            for (LayoutNodeId c = m_firstChild[id]; c != kNoLayoutNode; c = m_nextSibling[c])
+            {
+                m_availW[c] = innerW;
+                m_availH[c] = childH;
+            }
+        }
+
+        // Bottom-up: children are measured before their parent.
+        for (auto it = m_order.rbegin(); it != m_order.rend(); ++it)
+        {
+            const LayoutNodeId id = *it;
+            const float chrome = Chrome(id);
+            float w = 0.0f;
+            float h = 0.0f;
+            switch (m_kind[id])
+            {
+            case LayoutKind::Leaf:
+                w = m_leafW[id];
+                h = m_leafH[id];
+                break;
+
+            case LayoutKind::Overlay:
+                for (LayoutNodeId c = m_firstChild[id]; c != kNoLayoutNode; c = m_nextSibling[c])
+                {
+                    w = (std::max)(w, m_desiredW[c]);
+                    h = (std::max)(h, m_desiredH[c]);
+                }
+                break;
+
+            case LayoutKind::StackV:
+            case LayoutKind::StackH:
+            {
+                const bool vertical = (m_kind[id] == LayoutKind::StackV);
+                const std::size_t count = GatherChildSizes(id);
+                const float* mainSizes = vertical ? m_scratchH.data() : m_scratchW.data();
+                const float* crossSizes = vertical ? m_scratchW.data() : m_scratchH.data();
+                const float main = LayoutKernels::Stack(mainSizes, count, 0.0f, m_spacing[id], nullptr);
+                float cross = 0.0f;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    cross = (std::max)(cross, crossSizes[i]);
+                }
+                w = vertical ? cross : main;
+                h = vertical ? main : cross;
+                break;
+            }
+
+            case LayoutKind::Wrap:
+            {
+                const std::size_t count = GatherChildSizes(id);
+                const bool unconstrained = !(m_availW[id] < kInfExtent);
+                const float innerW = unconstrained ? kInfExtent : (std::max)(0.0f, m_availW[id] - chrome);
+                float usedW = 0.0f;
+                h = LayoutKernels::Wrap(m_scratchW.data(), m_scratchH.data(), count, innerW,
+                    m_spacing[id], m_rowSpacing[id], m_singleColumn[id] != 0, nullptr, nullptr, &usedW);
+                // The width the rows use, never greedily the width offered.
+                w = unconstrained ? usedW : (std::min)(usedW, innerW);
+                break;
+            }
+            }
+            m_desiredW[id] = w + chrome;
+            m_desiredH[id] = h + chrome;
+        }
+    }
+
+    void LayoutEngine::Arrange(LayoutNodeId root, const Box& box)
+    {
+        if (root >= m_kind.size())
+        {
+            return;
+        }
+        CollectPreorder(root);
+
+        m_x[root] = box.x;
+        m_y[root] = box.y;
+        m_w[root] = box.w;
+        m_h[root] = box.h;
+        for (const LayoutNodeId id : m_order)
+        {
+            if (m_firstChild[id] == kNoLayoutNode)
+            {
+                continue;
+            }
+
+            const float inset = m_margin[id] + m_padding[id];
+            const float cx = m_x[id] + inset;
+            const float cy = m_y[id] + inset;
+            const float cw = (std::max)(0.0f, m_w[id] - 2.0f * inset);
+            const float ch = (std::max)(0.0f, m_h[id] - 2.0f * inset);
+
+            switch (m_kind[id])
+            {
+            case LayoutKind::Leaf:
+            case LayoutKind::Overlay:
+                for (LayoutNodeId c = m_firstChild[id]; c != kNoLayoutNode; c = m_nextSibling[c])
+                {
+                    m_x[c] = cx;
+                    m_y[c] = cy;
+                    m_w[c] = cw;
+                    m_h[c] = ch;
+                }
+                break;
+
+            case LayoutKind::StackV:
+            case LayoutKind::StackH:
+            {
+                const bool vertical = (m_kind[id] == LayoutKind::StackV);
+                const std::size_t count = GatherChildSizes(id);
+                m_scratchX.resize(count);
+                (void)LayoutKernels::Stack(vertical ? m_scratchH.data() : m_scratchW.data(), count,
+                    vertical ? cy : cx, m_spacing[id], m_scratchX.data());
+                std::size_t i = 0;
+                for (LayoutNodeId c = m_firstChild[id]; c != kNoLayoutNode; c = m_nextSibling[c], ++i)
+                {
+                    m_x[c] = vertical ? cx : m_scratchX[i];
+                    m_y[c] = vertical ? m_scratchX[i] : cy;
+                    m_w[c] = vertical ? cw : m_scratchW[i];
+                    m_h[c] = vertical ? m_scratchH[i] : ch;
+                }
+                break;
+            }
+
+            case LayoutKind::Wrap:
+            {
+                const std::size_t count = GatherChildSizes(id);
+                m_scratchX.resize(count);
+                m_scratchY.resize(count);
+                (void)LayoutKernels::Wrap(m_scratchW.data(), m_scratchH.data(), count, cw,
+                    m_spacing[id], m_rowSpacing[id], m_singleColumn[id] != 0,
+                    m_scratchX.data(), m_scratchY.data(), nullptr);
+                std::size_t i = 0;
+                for (LayoutNodeId c = m_firstChild[id]; c != kNoLayoutNode; c = m_nextSibling[c], ++i)
+                {
+                    m_x[c] = cx + m_scratchX[i];
+                    m_y[c] = cy + m_scratchY[i];
+                    m_w[c] = m_scratchW[i];
+                    m_h[c] = m_scratchH[i];
+                }
+                break;
+            }
+            }
+        }
+    }
+}
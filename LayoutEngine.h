@@ -0,0 +1,193 @@
+#pragma once
+
+// LayoutEngine.h - data-oriented layout over structure-of-arrays node storage.
+//
+// Platform-neutral. Two layers:
+//
+// - LayoutKernels: the panel algorithms (stack, wrap, grid tracks) as plain
+//   loops over arrays of child sizes. StackPanel, DynamicPanel and GridPanel
+//   gather their children's measured sizes into scratch arrays and run
+//   these, so the Wnd panels and the engine share one implementation.
+//
+// - LayoutEngine: a whole tree laid out without Wnd objects. Geometry and
+//   constraints live in parallel arrays indexed by LayoutNodeId; Measure and
+//   Arrange are iterative passes over a preorder list (no recursion, no
+//   virtual calls, no pointer chasing beyond the sibling links), so trees of
+//   100k+ nodes (virtualized lists, generated dashboards) lay out in a few
+//   linear sweeps. Leaves carry an intrinsic size set by the caller.
+//
+// Box model (every kind): a node's box is the rect its parent gave it; its
+// children are laid out in the box inset by margin and then padding, and its
+// desired size includes both on each side.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace FD2D
+{
+    // Flex placement (DynamicPanel): how leftover space along a line is
+    // distributed (justify-content / align-content) and how items sit across
+    // their row (align-items).
+    enum class FlexJustify : std::uint8_t
+    {
+        Start,
+        End,
+        Center,
+        SpaceBetween,
+        SpaceAround,
+        SpaceEvenly
+    };
+
+    enum class FlexAlign : std::uint8_t
+    {
+        Start,
+        End,
+        Center,
+        Stretch
+    };
+
+    namespace LayoutKernels
+    {
+        // Main-axis positions of `count` stacked children of extent
+        // `mainSizes[i]`, starting at `start`, `spacing` apart. Returns the
+        // total extent (no trailing spacing).
+        float Stack(const float* mainSizes, std::size_t count, float start, float spacing, float* outOffsets);
+
+        // Flex-wrap rows (DynamicPanel): children flow left to right and wrap
+        // when the next one would overflow `contentWidth` (an over-wide child
+        // still gets its own row), or one per row when `singleColumn`.
+        // Positions are relative to the content origin. Returns the content
+        // height; `outUsedWidth` (when non-null) receives the widest row.
+        float Wrap(const float* widths, const float* heights, std::size_t count,
+            float contentWidth, float hgap, float vgap, bool singleColumn,
+            float* outX, float* outY, float* outUsedWidth);
+
+        // The row breaks of Wrap: outRowEnds[r] is one past the last child of
+        // row r (room for `count` entries); returns the row count. The same
+        // breaks hold for every content width in [*outMinWidth,
+        // *outMaxWidth), so a caller can keep them across resizes inside that
+        // interval instead of searching for the next breakpoint.
+        std::size_t BreakRows(const float* widths, std::size_t count, float contentWidth, float hgap,
+            bool singleColumn, std::uint32_t* outRowEnds, float* outMinWidth, float* outMaxWidth);
+
+        // Leading offset and extra gap that place `count` items (or rows)
+        // with `freeSpace` left over. No free space means packed at the start.
+        void Justify(FlexJustify justify, float freeSpace, std::size_t count, float* outLead, float* outBetween);
+
+        // One flex row along the main axis. Items start at basis[i]; free
+        // space grows them by grow[i] (shared by weight), overflow shrinks
+        // them in proportion to shrink[i] * basis[i] (as CSS flex-shrink),
+        // and what is still left is placed by `justify`. Writes positions
+        // relative to the row start and the final widths.
+        void FlexRow(const float* basis, const float* grow, const float* shrink, std::size_t count,
+            float contentWidth, float gap, FlexJustify justify, float* outX, float* outW);
+
+        // Grid tracks (GridPanel). Grows the `count` tracks of one span whose
+        // growable[i] is set, evenly, by `extra`, never past maxSizes[i];
+        // what a capped track cannot take goes to the others. Returns the
+        // part no track could take.
+        float GrowTracks(float* sizes, const float* maxSizes, const std::uint8_t* growable,
+            std::size_t count, float extra);
+
+        // Star tracks (weights[i] > 0) share `space` in proportion to their
+        // weight, clamped to [minSizes[i], maxSizes[i]]; tracks that hit a
+        // bound are frozen there and the rest re-share what is left, as CSS
+        // Grid resolves fr tracks. Only star tracks' sizes are written.
+        void ShareStar(const float* weights, const float* minSizes, const float* maxSizes,
+            std::size_t count, float space, float* outSizes);
+    }
+
+    using LayoutNodeId = std::uint32_t;
+    inline constexpr LayoutNodeId kNoLayoutNode = ~static_cast<LayoutNodeId>(0);
+
+    enum class LayoutKind : std::uint8_t
+    {
+        Leaf,       // intrinsic size (SetLeafSize)
+        Overlay,    // children share the content area; desired = largest child
+        StackV,     // StackPanel, vertical
+        StackH,     // StackPanel, horizontal
+        Wrap        // DynamicPanel
+    };
+
+    class LayoutEngine
+    {
+    public:
+        struct Box
+        {
+            float x { 0.0f };
+            float y { 0.0f };
+            float w { 0.0f };
+            float h { 0.0f };
+        };
+
+        // Appends a node as the last child of `parent` (kNoLayoutNode for a
+        // root). Ids are dense and stable until Clear().
+        LayoutNodeId CreateNode(LayoutKind kind, LayoutNodeId parent = kNoLayoutNode);
+        void Clear();
+        void Reserve(std::size_t nodes);
+        std::size_t NodeCount() const { return m_kind.size(); }
+
+        void SetKind(LayoutNodeId id, LayoutKind kind) { m_kind[id] = kind; }
+        void SetLeafSize(LayoutNodeId id, float w, float h) { m_leafW[id] = w; m_leafH[id] = h; }
+        void SetMargin(LayoutNodeId id, float margin) { m_margin[id] = margin; }
+        void SetPadding(LayoutNodeId id, float padding) { m_padding[id] = padding; }
+        // Stack: gap between children. Wrap: gap within a row.
+        void SetSpacing(LayoutNodeId id, float spacing) { m_spacing[id] = spacing; }
+        // Wrap: gap between rows.
+        void SetRowSpacing(LayoutNodeId id, float spacing) { m_rowSpacing[id] = spacing; }
+        void SetSingleColumn(LayoutNodeId id, bool single) { m_singleColumn[id] = single ? 1 : 0; }
+
+        LayoutNodeId Parent(LayoutNodeId id) const { return m_parent[id]; }
+        LayoutNodeId FirstChild(LayoutNodeId id) const { return m_firstChild[id]; }
+        LayoutNodeId NextSibling(LayoutNodeId id) const { return m_nextSibling[id]; }
+
+        // Desired sizes of `root`'s subtree for the given available size.
+        void Measure(LayoutNodeId root, float availableW, float availableH);
+        // Boxes of `root`'s subtree; uses the sizes from the last Measure.
+        void Arrange(LayoutNodeId root, const Box& box);
+
+        float DesiredW(LayoutNodeId id) const { return m_desiredW[id]; }
+        float DesiredH(LayoutNodeId id) const { return m_desiredH[id]; }
+        Box GetBox(LayoutNodeId id) const { return { m_x[id], m_y[id], m_w[id], m_h[id] }; }
+
+    private:
+        void CollectPreorder(LayoutNodeId root);
+        float Chrome(LayoutNodeId id) const { return 2.0f * (m_margin[id] + m_padding[id]); }
+        // Gathers `id`'s children's desired sizes into m_scratchW/H.
+        std::size_t GatherChildSizes(LayoutNodeId id);
+
+        // Tree links
+        std::vector<LayoutKind> m_kind {};
+        std::vector<LayoutNodeId> m_parent {};
+        std::vector<LayoutNodeId> m_firstChild {};
+        std::vector<LayoutNodeId> m_lastChild {};
+        std::vector<LayoutNodeId> m_nextSibling {};
+        // Constraints
+        std::vector<float> m_leafW {};
+        std::vector<float> m_leafH {};
+        std::vector<float> m_margin {};
+        std::vector<float> m_padding {};
+        std::vector<float> m_spacing {};
+        std::vector<float> m_rowSpacing {};
+        std::vector<std::uint8_t> m_singleColumn {};
+        // Results
+        std::vector<float> m_availW {};
+        std::vector<float> m_availH {};
+        std::vector<float> m_desiredW {};
+        std::vector<float> m_desiredH {};
+        std::vector<float> m_x {};
+        std::vector<float> m_y {};
+        std::vector<float> m_w {};
+        std::vector<float> m_h {};
+        // Pass scratch (kept to avoid reallocating every pass); m_order is
+        // the preorder of m_orderRoot's subtree.
+        LayoutNodeId m_orderRoot { kNoLayoutNode };
+        std::vector<LayoutNodeId> m_order {};
+        std::vector<LayoutNodeId> m_stack {};
+        std::vector<float> m_scratchW {};
+        std::vector<float> m_scratchH {};
+        std::vector<float> m_scratchX {};
+        std::vector<float> m_scratchY {};
+    };
+}
@@ -0,0 +1,69 @@
+#include "NameInterner.h"
+#include <mutex>
+
+namespace FD2D
+{
+    NameInterner& NameInterner::Global()
+    {
+        static NameInterner s_interner;
+        return s_interner;
+    }
+
+    NameInterner::NameInterner()
+    {
+        m_names.emplace_back(); // kNoName
+    }
+
+    NameId NameInterner::Intern(std::wstring_view name)
+    {
+        if (name.empty())
+        {
+            return kNoName;
+        }
+
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+            const auto it = m_ids.find(name);
+            if (it != m_ids.end())
+            {
+                return it->second;
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        const auto it = m_ids.find(name); // another thread may have added it
+        if (it != m_ids.end())
+        {
+            return it->second;
+        }
+
+        const NameId id = static_cast<NameId>(m_names.size());
+        const std::wstring& stored = m_names.emplace_back(name);
+        m_ids.emplace(std::wstring_view(stored), id);
+        return id;
+    }
+
+    NameId NameInterner::Find(std::wstring_view name) const
+    {
+        if (name.empty())
+        {
+            return kNoName;
+        }
+
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        const auto it = m_ids.find(name);
+        return (it != m_ids.end()) ? it->second : kNoName;
+    }
+
+    const std::wstring& NameInterner::NameOf(NameId id) const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        return (id < m_names.size()) ? m_names[id] : m_names[kNoName];
+    }
+
+    std::size_t NameInterner::Size() const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        return m_names.size();
+    }
+}
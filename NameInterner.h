@@ -0,0 +1,49 @@
+#pragma once
+
+// NameInterner.h - process-wide table of interned control names.
+//
+// Platform-neutral. Intern() maps a string to a stable 32-bit id (equal
+// strings, equal ids), so Wnd lookups, duplicate checks and reordering compare
+// integers instead of hashing and comparing wstrings. Interned strings live
+// until the process exits and references returned by NameOf() stay valid;
+// the table only grows, so it is meant for identifiers, not arbitrary text.
+// Thread-safe (lookups take a shared lock).
+
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace FD2D
+{
+    using NameId = std::uint32_t;
+    // The empty name; never returned for a non-empty string.
+    inline constexpr NameId kNoName = 0;
+
+    class NameInterner
+    {
+    public:
+        static NameInterner& Global();
+
+        NameInterner();
+        NameInterner(const NameInterner&) = delete;
+        NameInterner& operator=(const NameInterner&) = delete;
+
+        // Id of `name`, adding it on first use.
+        NameId Intern(std::wstring_view name);
+        // Id of `name` if it was ever interned, else kNoName (nothing is added;
+        // a name nobody interned cannot belong to any control).
+        NameId Find(std::wstring_view name) const;
+        // The string behind `id` (empty for kNoName or an unknown id).
+        const std::wstring& NameOf(NameId id) const;
+
+        std::size_t Size() const;
+
+    private:
+        mutable std::shared_mutex m_mutex {};
+        std::deque<std::wstring> m_names {};                  // index = id; deque keeps elements in place
+        std::unordered_map<std::wstring_view, NameId> m_ids {}; // views into m_names
+    };
+}
@@ -15,15 +15,14 @@ namespace FD2D
     Size OverlayPanel::Measure(Size available)
     {
         // OverlayPanel uses the maximum size of its children, but does not exceed the available size
+        const auto& children = ChildrenInOrder();
+        std::pmr::vector<Size> measured(children.size(), Size {}, ScratchMemory());
+        MeasureChildren(children.data(), children.size(), available, measured.data());
         Size maxSize {};
-        for (auto& child : ChildrenInOrder())
+        for (const Size& s : measured)
         {
-            if (child)
-            {
-                Size s = child->Measure(available);
-                maxSize.w = (std::max)(maxSize.w, s.w);
-                maxSize.h = (std::max)(maxSize.h, s.h);
-            }
+            maxSize.w = (std::max)(maxSize.w, s.w);
+            maxSize.h = (std::max)(maxSize.h, s.h);
         }
 
         // Clamp to not exceed the available size
@@ -25,15 +25,14 @@ namespace FD2D
     Size Panel::Measure(Size available)
     {
         // Base Panel defers to children Measure pass; default desired is max of children.
+        const auto& children = ChildrenInOrder();
+        std::pmr::vector<Size> measured(children.size(), Size {}, ScratchMemory());
+        MeasureChildren(children.data(), children.size(), available, measured.data());
         Size maxSize {};
-        for (auto& child : ChildrenInOrder())
+        for (const Size& s : measured)
         {
-            if (child)
-            {
-                Size s = child->Measure(available);
-                maxSize.w = (std::max)(maxSize.w, s.w);
-                maxSize.h = (std::max)(maxSize.h, s.h);
-            }
+            maxSize.w = (std::max)(maxSize.w, s.w);
+            maxSize.h = (std::max)(maxSize.h, s.h);
         }
 
         m_desired = maxSize;
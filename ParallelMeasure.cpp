@@ -0,0 +1,72 @@
+#include "ParallelMeasure.h"
+#include <optional>
+
+namespace FD2D
+{
+    namespace
+    {
+        // Non-zero while this thread runs a forked measure (a Wait can run
+        // the group's tasks on the thread that forked them, so it nests).
+        thread_local int t_forkedDepth = 0;
+
+        struct ForkedScope
+        {
+            ForkedScope() { ++t_forkedDepth; }
+            ~ForkedScope() { --t_forkedDepth; }
+        };
+    }
+
+    bool ParallelMeasure::InForkedMeasure()
+    {
+        return t_forkedDepth != 0;
+    }
+
+    void ParallelMeasure::Run(Executor* executor, std::size_t count,
+        const std::function<bool(std::size_t)>& fork,
+        const std::function<void(std::size_t)>& measure)
+    {
+        if (executor == nullptr || count < 2)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                measure(i);
+            }
+            return;
+        }
+
+        // An item is only submitted once a later one worth forking turns up,
+        // so the last such item is left for this thread.
+        std::optional<TaskGroup> group;
+        std::size_t held = count;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (!fork(i))
+            {
+                measure(i);
+                continue;
+            }
+            if (held != count)
+            {
+                if (!group)
+                {
+                    group.emplace(*executor, WorkLane::Interactive);
+                }
+                group->Run([&measure, held]()
+                {
+                    ForkedScope scope;
+                    measure(held);
+                });
+            }
+            held = i;
+        }
+
+        if (held != count)
+        {
+            measure(held);
+        }
+        if (group)
+        {
+            group->Wait();
+        }
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+// ParallelMeasure.h - fork/join over independent sibling measures.
+//
+// Platform-neutral: the scheduling behind Wnd::MeasureChildren, written
+// against an Executor and two callbacks so it can be tested (including
+// under ThreadSanitizer) and benchmarked without controls. The caller
+// decides which items are worth a task and how an item is measured.
+
+#include <cstddef>
+#include <functional>
+
+#include "Executor.h"
+
+namespace FD2D
+{
+    namespace ParallelMeasure
+    {
+        // Runs measure(i) once for every i in [0, count) and returns when all
+        // of them have finished. Without an executor, or with fewer than two
+        // items, they run in order on the calling thread. Otherwise the items
+        // for which fork(i) holds go to a TaskGroup on the Interactive lane,
+        // except the last of them, which the calling thread measures itself
+        // instead of idling in Wait; the rest run inline, in order. measure(i)
+        // must only write state owned by item i, so the results do not depend
+        // on scheduling.
+        void Run(Executor* executor, std::size_t count,
+            const std::function<bool(std::size_t)>& fork,
+            const std::function<void(std::size_t)>& measure);
+
+        // True while this thread runs a forked measure(i). UI-thread-only
+        // resources (the Backplate's frame arena) are off limits there.
+        bool InForkedMeasure();
+    }
+}
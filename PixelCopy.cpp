@@ -0,0 +1,137 @@
+#include "PixelCopy.h"
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FD2D_PIXELS_SSE2 1
+#elif defined(_M_ARM64) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define FD2D_PIXELS_NEON 1
+#endif
+
+namespace FD2D::Pixels
+{
+    namespace
+    {
+        inline std::uint32_t LoadPixel(const std::uint8_t* p)
+        {
+            std::uint32_t v = 0;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        inline void StorePixel(std::uint8_t* p, std::uint32_t v)
+        {
+            std::memcpy(p, &v, sizeof(v));
+        }
+
+        // Little-endian BGRA8 read as a uint32 is 0xAARRGGBB; swapping R/B is a
+        // pair of masked 16-bit shifts, which maps directly onto SSE2/NEON.
+        inline std::uint32_t SwapRedBlueScalar(std::uint32_t v)
+        {
+            return (v & 0xFF00FF00u) | ((v & 0x00FF0000u) >> 16) | ((v & 0x000000FFu) << 16);
+        }
+
+        void SwapRedBlueRow(std::uint8_t* dst, const std::uint8_t* src, std::size_t pixelCount)
+        {
+            std::size_t i = 0;
+#if defined(FD2D_PIXELS_SSE2)
+            const __m128i keepMask = _mm_set1_epi32(static_cast<int>(0xFF00FF00u));
+            const __m128i lowMask = _mm_set1_epi32(0x000000FF);
+            for (; i + 4 <= pixelCount; i += 4)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+                const __m128i kept = _mm_and_si128(v, keepMask);
+                const __m128i red = _mm_and_si128(_mm_srli_epi32(v, 16), lowMask);
+                const __m128i blue = _mm_slli_epi32(_mm_and_si128(v, lowMask), 16);
+                _mm_storeu_si128(
+                    reinterpret_cast<__m128i*>(dst + i * 4),
+                    _mm_or_si128(kept, _mm_or_si128(red, blue)));
+            }
+#elif defined(FD2D_PIXELS_NEON)
+            for (; i + 16 <= pixelCount; i += 16)
+            {
+                uint8x16x4_t v = vld4q_u8(src + i * 4);
+                const uint8x16_t b = v.val[0];
+                v.val[0] = v.val[2];
+                v.val[2] = b;
+                vst4q_u8(dst + i * 4, v);
+            }
+#endif
+            for (; i < pixelCount; ++i)
+            {
+                StorePixel(dst + i * 4, SwapRedBlueScalar(LoadPixel(src + i * 4)));
+            }
+        }
+
+        void ForceOpaqueRow(std::uint8_t* dst, const std::uint8_t* src, std::size_t pixelCount)
+        {
+            std::size_t i = 0;
+#if defined(FD2D_PIXELS_SSE2)
+            const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+            for (; i + 4 <= pixelCount; i += 4)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_or_si128(v, alpha));
+            }
+#elif defined(FD2D_PIXELS_NEON)
+            const uint32x4_t alpha = vdupq_n_u32(0xFF000000u);
+            for (; i + 4 <= pixelCount; i += 4)
+            {
+                const uint32x4_t v = vreinterpretq_u32_u8(vld1q_u8(src + i * 4));
+                vst1q_u8(dst + i * 4, vreinterpretq_u8_u32(vorrq_u32(v, alpha)));
+            }
+#endif
+            for (; i < pixelCount; ++i)
+            {
+                StorePixel(dst + i * 4, LoadPixel(src + i * 4) | 0xFF000000u);
+            }
+        }
+    }
+
+    void CopyRows(
+        std::uint8_t* dst,
+        std::size_t dstStride,
+        const std::uint8_t* src,
+        std::size_t srcStride,
+        std::size_t rowBytes,
+        std::size_t rows,
+        RowConversion conversion)
+    {
+        if (!dst || !src || rowBytes == 0 || rows == 0)
+        {
+            return;
+        }
+
+        if (conversion == RowConversion::Copy)
+        {
+            // Tightly packed on both sides: one bulk copy instead of per-row calls.
+            if (srcStride == rowBytes && dstStride == rowBytes)
+            {
+                std::memcpy(dst, src, rowBytes * rows);
+                return;
+            }
+
+            for (std::size_t row = 0; row < rows; ++row)
+            {
+                std::memcpy(dst + row * dstStride, src + row * srcStride, rowBytes);
+            }
+            return;
+        }
+
+        const std::size_t pixelCount = rowBytes / 4;
+        for (std::size_t row = 0; row < rows; ++row)
+        {
+            std::uint8_t* d = dst + row * dstStride;
+            const std::uint8_t* s = src + row * srcStride;
+            if (conversion == RowConversion::SwapRedBlue)
+            {
+                SwapRedBlueRow(d, s, pixelCount);
+            }
+            else
+            {
+                ForceOpaqueRow(d, s, pixelCount);
+            }
+        }
+    }
+}
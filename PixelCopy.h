@@ -0,0 +1,38 @@
+#pragma once
+
+// PixelCopy.h - row-wise pixel copy / stride conversion helpers.
+//
+// Platform-neutral (no Windows/D3D headers) so the conversion kernels can be
+// built and checked on any toolchain. Used by Backplate's composed-frame
+// readback to repack mapped staging rows (RowPitch) into tightly packed
+// output rows.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace FD2D::Pixels
+{
+    enum class RowConversion
+    {
+        // Plain copy (BGRA8 stays BGRA8).
+        Copy,
+        // 32bpp BGRA8 -> RGBA8 (swaps the R and B channels in place).
+        SwapRedBlue,
+        // 32bpp copy that forces alpha to 0xFF (for opaque captures of
+        // targets that were rendered with DXGI_ALPHA_MODE_IGNORE).
+        ForceOpaque
+    };
+
+    // Copies `rows` rows of `rowBytes` bytes from src (pitch srcStride) to dst
+    // (pitch dstStride), applying `conversion`. Conversions other than Copy
+    // require rowBytes to be a multiple of 4. Source and destination must not
+    // overlap. Uses SSE2 / NEON when available, scalar otherwise.
+    void CopyRows(
+        std::uint8_t* dst,
+        std::size_t dstStride,
+        const std::uint8_t* src,
+        std::size_t srcStride,
+        std::size_t rowBytes,
+        std::size_t rows,
+        RowConversion conversion = RowConversion::Copy);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+// RedrawSignal.h - coalescing cross-thread wake flag.
+//
+// Platform-neutral core of AsyncRedrawToken: one atomic state word holding a
+// "pending" bit and a "closed" bit. Signal() is a single fetch_or, so it is
+// wait-free for any number of threads: only the call that turns "idle" into
+// "pending" invokes the wake function, every later one coalesces into it
+// until the consumer calls Consume(). After Close() signals are no-ops.
+//
+// The wake function is fixed at construction and must stay callable for the
+// object's whole lifetime (AsyncRedrawToken keeps the event it sets alive in
+// the same control block), so a signal racing with Close() is harmless.
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+namespace FD2D
+{
+    class RedrawSignal
+    {
+    public:
+        explicit RedrawSignal(std::function<void()> wake)
+            : m_wake(std::move(wake))
+        {
+        }
+
+        RedrawSignal(const RedrawSignal&) = delete;
+        RedrawSignal& operator=(const RedrawSignal&) = delete;
+
+        // Any thread. Returns true when this call issued the wake.
+        bool Signal()
+        {
+            const std::uint32_t prev = m_state.fetch_or(kPending, std::memory_order_acq_rel);
+            if ((prev & (kPending | kClosed)) != 0)
+            {
+                return false;
+            }
+            if (m_wake)
+            {
+                m_wake();
+            }
+            return true;
+        }
+
+        // Consumer thread: clears the pending bit and reports whether it was
+        // set. Reset the wake object (e.g. the event) before calling this, so
+        // a signal landing in between is either consumed here or wakes again.
+        bool Consume()
+        {
+            return (m_state.fetch_and(~kPending, std::memory_order_acq_rel) & kPending) != 0;
+        }
+
+        bool Pending() const { return (m_state.load(std::memory_order_acquire) & kPending) != 0; }
+
+        void Close() { m_state.fetch_or(kClosed, std::memory_order_acq_rel); }
+        bool Closed() const { return (m_state.load(std::memory_order_acquire) & kClosed) != 0; }
+
+    private:
+        static constexpr std::uint32_t kPending = 1u << 0;
+        static constexpr std::uint32_t kClosed = 1u << 1;
+
+        std::function<void()> m_wake {};
+        std::atomic<std::uint32_t> m_state { 0 };
+    };
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+// RenderThread.h - hands finished frames from the UI thread to a presenter.
+//
+// Platform-neutral. FrameMailbox is a lock-free triple buffer: the producer
+// owns one slot (Back) and fills it in place, Publish swaps it with the
+// shared middle slot, and the consumer swaps the middle into its own slot
+// (Front) when a newer frame is there. Neither side ever waits for the
+// other, a published slot is never written again until the consumer has
+// moved on, and when the producer outruns the consumer the older unpresented
+// frame is dropped (latest frame wins).
+//
+// RenderThread runs a consumer thread that calls `present` for every frame
+// it takes and sleeps (atomic wait) while there is none. Backplate uses it to
+// copy finished frames to the swap chain and block in Present on vsync off
+// the UI thread.
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <utility>
+
+namespace FD2D
+{
+    template <typename T>
+    class FrameMailbox
+    {
+    public:
+        FrameMailbox() = default;
+        FrameMailbox(const FrameMailbox&) = delete;
+        FrameMailbox& operator=(const FrameMailbox&) = delete;
+
+        // Producer side.
+        T& Back() { return m_slots[m_back]; }
+        // Hands Back() over and starts a new Back(). Returns false when it
+        // replaced a frame the consumer never took (that frame is dropped).
+        bool Publish()
+        {
+            const std::uint32_t prev = m_state.exchange(m_back | kFresh, std::memory_order_acq_rel);
+            m_back = prev & kIndexMask;
+            m_state.notify_one();
+            return (prev & kFresh) == 0;
+        }
+
+        // Consumer side. Takes the newest published frame, or nullptr when
+        // nothing new arrived since the last take.
+        T* TakeLatest()
+        {
+            if ((m_state.load(std::memory_order_acquire) & kFresh) == 0)
+            {
+                return nullptr;
+            }
+            const std::uint32_t prev = m_state.exchange(m_front, std::memory_order_acq_rel);
+            m_front = prev & kIndexMask;
+            return &m_slots[m_front];
+        }
+
+        // Blocks until a new frame arrives (returned) or Close() (nullptr).
+        T* WaitForFrame()
+        {
+            for (;;)
+            {
+                if (m_closed.load(std::memory_order_acquire))
+                {
+                    return nullptr;
+                }
+                const std::uint32_t state = m_state.load(std::memory_order_acquire);
+                if ((state & kFresh) != 0)
+                {
+                    return TakeLatest();
+                }
+                m_state.wait(state, std::memory_order_acquire);
+            }
+        }
+
+        // Wakes and releases a consumer blocked in WaitForFrame.
+        void Close()
+        {
+            m_closed.store(true, std::memory_order_release);
+            m_state.fetch_xor(kPoke, std::memory_order_acq_rel); // change the word so waiters wake
+            m_state.notify_all();
+        }
+
+    private:
+        static constexpr std::uint32_t kIndexMask = 0x3u;
+        static constexpr std::uint32_t kFresh = 0x4u;
+        static constexpr std::uint32_t kPoke = 0x8u;
+
+        T m_slots[3] {};
+        std::uint32_t m_back { 0 };            // producer-owned
+        std::uint32_t m_front { 1 };           // consumer-owned
+        std::atomic<std::uint32_t> m_state { 2 }; // middle index | kFresh | kPoke
+        std::atomic<bool> m_closed { false };
+    };
+
+    template <typename T>
+    class RenderThread
+    {
+    public:
+        using PresentFn = std::function<void(T& frame)>;
+
+        // `present` runs on the render thread only.
+        explicit RenderThread(PresentFn present)
+            : m_present(std::move(present))
+        {
+            m_thread = std::thread([this]() { Main(); });
+        }
+
+        // Finishes the frame being presented (if any) and joins; frames still
+        // in the mailbox are not presented.
+        ~RenderThread()
+        {
+            m_mailbox.Close();
+            if (m_thread.joinable())
+            {
+                m_thread.join();
+            }
+        }
+
+        RenderThread(const RenderThread&) = delete;
+        RenderThread& operator=(const RenderThread&) = delete;
+
+        // Producer (UI thread): fill Back(), then Publish() it.
+        T& Back() { return m_mailbox.Back(); }
+        void Publish()
+        {
+            if (!m_mailbox.Publish())
+            {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        std::uint64_t PresentedFrames() const { return m_presented.load(std::memory_order_relaxed); }
+        std::uint64_t DroppedFrames() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    private:
+        void Main()
+        {
+            while (T* frame = m_mailbox.WaitForFrame())
+            {
+                m_present(*frame);
+                m_presented.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        PresentFn m_present {};
+        FrameMailbox<T> m_mailbox {};
+        std::atomic<std::uint64_t> m_presented { 0 };
+        std::atomic<std::uint64_t> m_dropped { 0 };
+        std::thread m_thread {};
+    };
+}
@@ -0,0 +1,142 @@
+#include "ResidencyManager.h"
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace FD2D
+{
+    void ResidencyManager::SetBudget(std::uint64_t bytes)
+    {
+        m_budgetBytes = bytes;
+    }
+
+    ResidencyManager::Handle ResidencyManager::Register(
+        std::uint64_t bytes,
+        std::uint64_t frame,
+        EvictCallback onEvict)
+    {
+        if (bytes == 0)
+        {
+            return kInvalidHandle;
+        }
+
+        const Handle handle = m_nextHandle++;
+        Entry entry {};
+        entry.handle = handle;
+        entry.bytes = bytes;
+        entry.lastDrawnFrame = frame;
+        entry.onEvict = std::move(onEvict);
+
+        m_lru.push_back(std::move(entry));
+        m_index.emplace(handle, std::prev(m_lru.end()));
+
+        m_residentBytes += bytes;
+        if (m_residentBytes > m_peakResidentBytes)
+        {
+            m_peakResidentBytes = m_residentBytes;
+        }
+        return handle;
+    }
+
+    void ResidencyManager::Unregister(Handle handle)
+    {
+        auto it = m_index.find(handle);
+        if (it == m_index.end())
+        {
+            return;
+        }
+
+        m_residentBytes -= it->second->bytes;
+        m_lru.erase(it->second);
+        m_index.erase(it);
+    }
+
+    void ResidencyManager::UpdateSize(Handle handle, std::uint64_t bytes)
+    {
+        auto it = m_index.find(handle);
+        if (it == m_index.end())
+        {
+            return;
+        }
+
+        m_residentBytes = m_residentBytes - it->second->bytes + bytes;
+        it->second->bytes = bytes;
+        if (m_residentBytes > m_peakResidentBytes)
+        {
+            m_peakResidentBytes = m_residentBytes;
+        }
+    }
+
+    void ResidencyManager::MarkDrawn(Handle handle, std::uint64_t frame)
+    {
+        auto it = m_index.find(handle);
+        if (it == m_index.end())
+        {
+            return;
+        }
+
+        it->second->lastDrawnFrame = frame;
+        if (std::next(it->second) != m_lru.end())
+        {
+            m_lru.splice(m_lru.end(), m_lru, it->second);
+        }
+    }
+
+    bool ResidencyManager::IsRegistered(Handle handle) const
+    {
+        return m_index.find(handle) != m_index.end();
+    }
+
+    std::size_t ResidencyManager::EnforceBudget(std::uint64_t currentFrame)
+    {
+        if (m_budgetBytes == 0 || m_residentBytes <= m_budgetBytes)
+        {
+            return 0;
+        }
+
+        // Unlink victims first and run their callbacks afterwards: a callback
+        // may register/unregister other content and must not observe (or
+        // invalidate) the list while it is being walked.
+        std::vector<EvictCallback> callbacks;
+        for (auto it = m_lru.begin(); m_residentBytes > m_budgetBytes && it != m_lru.end();)
+        {
+            Entry& victim = *it;
+            if (victim.lastDrawnFrame >= currentFrame)
+            {
+                // Everything from here on is visible this frame.
+                break;
+            }
+            if (!victim.onEvict)
+            {
+                // Pinned: counted, but its owner could not bring it back.
+                ++it;
+                continue;
+            }
+
+            m_residentBytes -= victim.bytes;
+            ++m_evictionCount;
+            m_evictedBytes += victim.bytes;
+            callbacks.push_back(std::move(victim.onEvict));
+            m_index.erase(victim.handle);
+            it = m_lru.erase(it);
+        }
+
+        for (auto& callback : callbacks)
+        {
+            callback();
+        }
+        return callbacks.size();
+    }
+
+    ResidencyManager::Stats ResidencyManager::GetStats() const
+    {
+        Stats stats {};
+        stats.budgetBytes = m_budgetBytes;
+        stats.residentBytes = m_residentBytes;
+        stats.peakResidentBytes = m_peakResidentBytes;
+        stats.residentCount = m_index.size();
+        stats.evictionCount = m_evictionCount;
+        stats.evictedBytes = m_evictedBytes;
+        return stats;
+    }
+}
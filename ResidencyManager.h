@@ -0,0 +1,82 @@
+#pragma once
+
+// ResidencyManager.h - GPU content residency accounting under a byte budget.
+//
+// Platform-neutral policy core (no D3D/D2D types): callers register each piece
+// of GPU content with its byte size and an eviction callback, report which
+// frame last drew it, and ask the manager to enforce the budget once per
+// frame. Eviction is least-recently-drawn first and never touches content
+// drawn in the frame being enforced (it is on screen).
+//
+// UI-thread only; not synchronized.
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <unordered_map>
+
+namespace FD2D
+{
+    class ResidencyManager
+    {
+    public:
+        using Handle = std::uint64_t;
+        static constexpr Handle kInvalidHandle = 0;
+
+        // Invoked after the entry has been removed from the manager, so the
+        // callback may freely (re)register content.
+        using EvictCallback = std::function<void()>;
+
+        struct Stats
+        {
+            std::uint64_t budgetBytes { 0 };      // 0 = unlimited
+            std::uint64_t residentBytes { 0 };
+            std::uint64_t peakResidentBytes { 0 };
+            std::size_t residentCount { 0 };
+            std::uint64_t evictionCount { 0 };    // lifetime totals
+            std::uint64_t evictedBytes { 0 };
+        };
+
+        // 0 disables eviction (accounting only).
+        void SetBudget(std::uint64_t bytes);
+        std::uint64_t Budget() const { return m_budgetBytes; }
+
+        // Registers content as drawn in `frame` (so it survives the current
+        // frame's enforcement). Returns kInvalidHandle when bytes == 0.
+        // Content registered without a callback cannot be re-created by its
+        // owner: it is counted (residentBytes) but never evicted.
+        Handle Register(std::uint64_t bytes, std::uint64_t frame, EvictCallback onEvict);
+        void Unregister(Handle handle);
+        void UpdateSize(Handle handle, std::uint64_t bytes);
+        void MarkDrawn(Handle handle, std::uint64_t frame);
+        bool IsRegistered(Handle handle) const;
+
+        // Evicts least-recently-drawn entries not drawn in `currentFrame` or
+        // later until the resident total fits the budget. Pass the oldest
+        // frame whose content is still on screen (e.g. the last full frame
+        // while partial frames reuse it). Returns the number evicted.
+        std::size_t EnforceBudget(std::uint64_t currentFrame);
+
+        Stats GetStats() const;
+
+    private:
+        struct Entry
+        {
+            Handle handle { kInvalidHandle };
+            std::uint64_t bytes { 0 };
+            std::uint64_t lastDrawnFrame { 0 };
+            EvictCallback onEvict {};
+        };
+
+        // Front = least recently drawn. MarkDrawn splices to the back in O(1).
+        std::list<Entry> m_lru {};
+        std::unordered_map<Handle, std::list<Entry>::iterator> m_index {};
+        Handle m_nextHandle { 1 };
+        std::uint64_t m_budgetBytes { 0 };
+        std::uint64_t m_residentBytes { 0 };
+        std::uint64_t m_peakResidentBytes { 0 };
+        std::uint64_t m_evictionCount { 0 };
+        std::uint64_t m_evictedBytes { 0 };
+    };
+}
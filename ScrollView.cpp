@@ -25,6 +25,7 @@ namespace FD2D
     void ScrollView::SetHorizontalScrollEnabled(bool enabled)
     {
         m_enableHScroll = enabled;
+        StopSmoothScroll(&m_scrollX);
         if (!m_enableHScroll)
         {
             m_scrollX = 0.0f;
@@ -36,6 +37,7 @@ namespace FD2D
     void ScrollView::SetVerticalScrollEnabled(bool enabled)
     {
         m_enableVScroll = enabled;
+        StopSmoothScroll(&m_scrollY);
         if (!m_enableVScroll)
         {
             m_scrollY = 0.0f;
@@ -55,6 +57,7 @@ namespace FD2D
         constexpr float kBarThick = 9.0f;   // scrollbar thickness
         constexpr float kBarPad = 2.0f;     // inset from the viewport edges
         constexpr float kBarMinThumb = 28.0f;
+        constexpr float kSmoothScrollEpsilon = 0.25f; // px; snaps to the target below this
     }
 
     bool ScrollView::HScrollBarRects(D2D1_RECT_F& track, D2D1_RECT_F& thumb) const
@@ -102,9 +105,9 @@ namespace FD2D
     void ScrollView::SetContent(const std::shared_ptr<Wnd>& content)
     {
         m_content = content;
-        if (m_content && !m_content->Name().empty())
+        if (m_content && m_content->Id() != kNoName)
         {
-            if (Children().find(m_content->Name()) == Children().end())
+            if (!HasChild(m_content->Id()))
             {
                 AddChild(m_content);
             }
@@ -114,6 +117,7 @@ namespace FD2D
 
     void ScrollView::SetScrollY(float y)
     {
+        StopSmoothScroll(&m_scrollY);
         if (!m_enableVScroll)
         {
             m_scrollY = 0.0f;
@@ -129,6 +133,7 @@ namespace FD2D
 
     void ScrollView::SetScrollX(float x)
     {
+        StopSmoothScroll(&m_scrollX);
         if (!m_enableHScroll)
         {
             m_scrollX = 0.0f;
@@ -293,6 +298,13 @@ namespace FD2D
 
         ClampScroll();
         ClampTargetScroll();
+
+        // Keep a running smooth scroll inside the (possibly smaller) new range.
+        if (BackplateRef() != nullptr &&
+            (BackplateRef()->Animations().IsAnimating(&m_scrollX) || BackplateRef()->Animations().IsAnimating(&m_scrollY)))
+        {
+            AnimateScrollToTarget();
+        }
     }
 
     void ScrollView::ClampScroll()
@@ -340,10 +352,7 @@ namespace FD2D
         }
         m_targetScrollX = (std::max)(0.0f, x);
         ClampTargetScroll();
-        if (BackplateRef() != nullptr)
-        {
-            BackplateRef()->RequestAnimationFrame();
-        }
+        AnimateScrollToTarget();
         Invalidate();
     }
 
@@ -356,43 +365,32 @@ namespace FD2D
         }
         m_targetScrollY = (std::max)(0.0f, y);
         ClampTargetScroll();
-        if (BackplateRef() != nullptr)
-        {
-            BackplateRef()->RequestAnimationFrame();
-        }
+        AnimateScrollToTarget();
         Invalidate();
     }
 
-    void ScrollView::AdvanceSmoothScroll(unsigned long long nowMs)
+    void ScrollView::AnimateScrollToTarget()
     {
-        const float dx = m_targetScrollX - m_scrollX;
-        const float dy = m_targetScrollY - m_scrollY;
-        const float eps = 0.25f;
-        if (std::fabs(dx) < eps && std::fabs(dy) < eps)
+        // Exponential approach (time constant m_smoothTimeMs); a new target
+        // mid-scroll (wheel repeat) continues from the current offset.
+        if (BackplateRef() == nullptr)
         {
             m_scrollX = m_targetScrollX;
             m_scrollY = m_targetScrollY;
-            m_lastSmoothAnimMs = nowMs;
             return;
         }
 
-        if (m_lastSmoothAnimMs == 0)
-        {
-            m_lastSmoothAnimMs = nowMs;
-        }
-        const unsigned long long dt = nowMs - m_lastSmoothAnimMs;
-        m_lastSmoothAnimMs = nowMs;
-
-        const float tauMs = (m_smoothTimeMs > 0) ? static_cast<float>(m_smoothTimeMs) : 90.0f;
-        const float a = 1.0f - std::exp(-static_cast<float>(dt) / tauMs);
-
-        m_scrollX += dx * a;
-        m_scrollY += dy * a;
-        ClampScroll();
+        const Follow follow { (std::max)(1U, m_smoothTimeMs), kSmoothScrollEpsilon };
+        AnimationEngine& animations = BackplateRef()->Animations();
+        animations.Animate(this, &m_scrollX, m_targetScrollX, follow);
+        animations.Animate(this, &m_scrollY, m_targetScrollY, follow);
+    }
 
+    void ScrollView::StopSmoothScroll(float* offset)
+    {
         if (BackplateRef() != nullptr)
         {
-            BackplateRef()->RequestAnimationFrame();
+            (void)BackplateRef()->Animations().Stop(offset);
         }
     }
 
@@ -403,8 +401,6 @@ namespace FD2D
             return;
         }
 
-        AdvanceSmoothScroll(Util::NowMs());
-
         // Clip to viewport + apply translation
         const D2D1_RECT_F clip = LayoutRect();
         
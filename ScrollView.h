@@ -70,7 +70,11 @@ namespace FD2D
         void ClampTargetScroll();
         void SetTargetScrollX(float x);
         void SetTargetScrollY(float y);
-        void AdvanceSmoothScroll(unsigned long long nowMs);
+        // Smooth scroll: the window's AnimationEngine moves m_scrollX/Y
+        // toward the targets; an immediate scroll stops its axis (m_scrollX or
+        // m_scrollY) first.
+        void AnimateScrollToTarget();
+        void StopSmoothScroll(float* offset);
 
         std::shared_ptr<Wnd> m_content {};
         float m_scrollX { 0.0f };
@@ -88,7 +92,6 @@ namespace FD2D
         float m_barDragMouse { 0.0f };  // cursor pos on the drag axis at grab
         float m_barDragScroll { 0.0f }; // scroll offset at grab
         bool m_barHover { false };
-        unsigned long long m_lastSmoothAnimMs { 0 };
         unsigned int m_smoothTimeMs { 110 }; // smaller = snappier
 
         // cached after Arrange
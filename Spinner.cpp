@@ -7,6 +7,13 @@
 
 namespace FD2D
 {
+    namespace
+    {
+        // Each painted frame renews the registration for this long, so a
+        // spinner that stops being painted (hidden/culled) stops ticking.
+        constexpr unsigned long long kAnimationLeaseMs = 250ULL;
+    }
+
     Spinner::Spinner()
         : Wnd()
     {
@@ -37,14 +44,35 @@ namespace FD2D
         }
 
         m_active = active;
-        m_lastAnimMs = 0;
         Invalidate();
 
-        // Ensure the application loop treats animations as active immediately, even before the first paint.
-        if (m_active && BackplateRef() != nullptr)
+        // Smooth fade in/out to avoid abrupt dim-overlay flashes. Constant
+        // rate: reversing mid-fade only takes the distance already covered.
+        const float targetOpacity = m_active ? 1.0f : 0.0f;
+        if (BackplateRef() == nullptr)
+        {
+            m_opacity = targetOpacity;
+            return;
+        }
+        const unsigned int fadeMs = (m_style.fadeMs > 0) ? m_style.fadeMs : 100U;
+        const auto durationMs = static_cast<std::uint32_t>(static_cast<float>(fadeMs) * std::fabs(targetOpacity - m_opacity));
+        BackplateRef()->Animations().Animate(this, &m_opacity, targetOpacity, Tween { durationMs, Easing::Linear });
+
+        // Ensure the application loop treats animations as active immediately, even before the first paint
+        // (which replaces these bounds with the ones actually drawn).
+        if (m_active)
+        {
+            BackplateRef()->RegisterAnimation(this, LayoutRect(), Util::NowMs() + kAnimationLeaseMs);
+        }
+    }
+
+    void Spinner::OnDetached()
+    {
+        if (BackplateRef() != nullptr)
         {
-            BackplateRef()->RequestAnimationFrame();
+            BackplateRef()->UnregisterAnimation(this);
         }
+        Wnd::OnDetached();
     }
 
     void Spinner::SetStyle(const Style& style)
@@ -64,46 +92,25 @@ namespace FD2D
             return;
         }
 
-        // Smooth fade in/out to avoid abrupt dim-overlay flashes.
-        const unsigned long long now = Util::NowMs();
-        if (m_lastAnimMs == 0)
-        {
-            m_lastAnimMs = now;
-        }
-        const unsigned long long dtMs = now - m_lastAnimMs;
-        m_lastAnimMs = now;
-
-        const unsigned int fadeMs = (m_style.fadeMs > 0) ? m_style.fadeMs : 100U;
-        const float step = static_cast<float>(dtMs) / static_cast<float>(fadeMs);
-        if (m_active)
-        {
-            m_opacity = (std::min)(1.0f, m_opacity + step);
-        }
-        else
-        {
-            m_opacity = (std::max)(0.0f, m_opacity - step);
-        }
-
-        if (m_opacity <= 0.0f)
-        {
-            return;
-        }
+        // Rotation reads the frame's timestamp (m_opacity is already advanced).
+        const unsigned long long frameMs = BackplateRef() ? BackplateRef()->FrameTimeMs() : 0ULL;
+        const unsigned long long now = frameMs != 0 ? frameMs : Util::NowMs();
 
         if (!m_brush)
         {
             (void)target->CreateSolidColorBrush(m_style.color, &m_brush);
         }
 
-        if (!m_brush)
-        {
-            return;
-        }
-
         const D2D1_RECT_F r = LayoutRect();
         const float w = r.right - r.left;
         const float h = r.bottom - r.top;
-        if (!(w > 0.0f && h > 0.0f))
+        if (m_opacity <= 0.0f || !m_brush || !(w > 0.0f && h > 0.0f))
         {
+            // Nothing to draw: stop ticking (the registry repaints the last bounds once).
+            if (BackplateRef() != nullptr)
+            {
+                BackplateRef()->UnregisterAnimation(this);
+            }
             return;
         }
 
@@ -132,8 +139,7 @@ namespace FD2D
         const float outerRadius = baseRadius;
 
         const unsigned int period = (m_style.periodMs > 0) ? m_style.periodMs : 900U;
-        const unsigned long long t = Util::NowMs();
-        const float phase = static_cast<float>(t % static_cast<unsigned long long>(period)) / static_cast<float>(period);
+        const float phase = static_cast<float>(now % static_cast<unsigned long long>(period)) / static_cast<float>(period);
         const float baseAngle = phase * 6.28318530718f;
 
         const int ticks = (m_style.ticks >= 3) ? m_style.ticks : 12;
@@ -157,10 +163,19 @@ namespace FD2D
             target->DrawLine(p0, p1, m_brush.Get(), m_style.thickness);
         }
 
-        // Keep animating: request a 60fps tick from the application loop.
+        // Keep animating. Spinning only changes the tick ring; while fading, a
+        // dim overlay changes the whole rect. Bounds are in target pixels.
         if (BackplateRef() != nullptr)
         {
-            BackplateRef()->RequestAnimationFrame();
+            const bool fading = !m_active || m_opacity < 1.0f;
+            const float reach = outerRadius + m_style.thickness;
+            const D2D1_RECT_F changed = (m_style.dimBackground && fading)
+                ? r
+                : D2D1::RectF(cx - reach, cy - reach, cx + reach, cy + reach);
+            D2D1_MATRIX_3X2_F transform {};
+            target->GetTransform(&transform);
+            BackplateRef()->RegisterAnimation(
+                this, Util::TransformRectBounds(changed, transform), now + kAnimationLeaseMs);
         }
     }
 }
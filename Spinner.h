@@ -38,6 +38,7 @@ namespace FD2D
         Size Measure(Size available) override;
         Size MinSize() const override;
         void OnRender(ID2D1RenderTarget* target) override;
+        void OnDetached() override;
 
         void SetActive(bool active);
         bool Active() const { return m_active; }
@@ -47,8 +48,7 @@ namespace FD2D
 
     private:
         bool m_active { false };
-        float m_opacity { 0.0f };
-        unsigned long long m_lastAnimMs { 0 };
+        float m_opacity { 0.0f }; // faded by the window's AnimationEngine
         Style m_style {};
 
         Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> m_brush {};
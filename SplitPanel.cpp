@@ -41,10 +41,10 @@ namespace FD2D
     void SplitPanel::SetFirstChild(const std::shared_ptr<Wnd>& child)
     {
         m_firstChild = child;
-        if (m_firstChild && !m_firstChild->Name().empty())
+        if (m_firstChild && m_firstChild->Id() != kNoName)
         {
             // Add if not already added
-            if (Children().find(m_firstChild->Name()) == Children().end())
+            if (!HasChild(m_firstChild->Id()))
             {
                 AddChild(m_firstChild);
             }
@@ -54,10 +54,10 @@ namespace FD2D
     void SplitPanel::SetSecondChild(const std::shared_ptr<Wnd>& child)
     {
         m_secondChild = child;
-        if (m_secondChild && !m_secondChild->Name().empty())
+        if (m_secondChild && m_secondChild->Id() != kNoName)
         {
             // Add if not already added
-            if (Children().find(m_secondChild->Name()) == Children().end())
+            if (!HasChild(m_secondChild->Id()))
             {
                 AddChild(m_secondChild);
             }
@@ -289,23 +289,14 @@ namespace FD2D
 
     Size SplitPanel::Measure(Size available)
     {
-        // Calculate desired size of children
-        Size firstSize {};
-        Size secondSize {};
-        Size splitterSize {};
-
-        if (m_firstChild)
-        {
-            firstSize = m_firstChild->Measure(available);
-        }
-        if (m_secondChild)
-        {
-            secondSize = m_secondChild->Measure(available);
-        }
-        if (m_splitter)
-        {
-            splitterSize = m_splitter->Measure(available);
-        }
+        // Calculate desired size of children (the two panes are independent
+        // and may be measured concurrently; see MeasureChildren).
+        const std::shared_ptr<Wnd> parts[] = { m_firstChild, m_secondChild, m_splitter };
+        Size measured[3] {};
+        MeasureChildren(parts, 3, available, measured);
+        const Size firstSize = measured[0];
+        const Size secondSize = measured[1];
+        const Size splitterSize = measured[2];
 
         if (m_orientation == SplitterOrientation::Horizontal)
         {
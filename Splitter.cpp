@@ -113,6 +113,7 @@ namespace FD2D
         m_dragStart = pt;
         m_dragStartRatio = m_currentRatio;
         // m_dragStartParentBounds is set via SetParentBounds
+        AnimateHover();
         Invalidate();
     }
 
@@ -170,10 +171,25 @@ namespace FD2D
         if (m_dragging)
         {
             m_dragging = false;
+            AnimateHover();
             Invalidate();
         }
     }
 
+    void Splitter::AnimateHover()
+    {
+        // Constant-rate fade: reversing mid-fade only takes the distance back.
+        const float targetT = (m_hovered || m_dragging) ? 1.0f : 0.0f;
+        if (BackplateRef() == nullptr)
+        {
+            m_hoverT = targetT;
+            return;
+        }
+        const unsigned int fadeMs = (m_hoverFadeMs > 0) ? m_hoverFadeMs : 120U;
+        const auto durationMs = static_cast<std::uint32_t>(static_cast<float>(fadeMs) * std::fabs(targetT - m_hoverT));
+        BackplateRef()->Animations().Animate(this, &m_hoverT, targetT, Tween { durationMs, Easing::Linear });
+    }
+
     void Splitter::HandleDoubleClick()
     {
         // Reset to equal split on double-click
@@ -206,7 +222,7 @@ namespace FD2D
 
             if (m_hovered != wasHovered)
             {
-                m_lastHoverAnimMs = 0;
+                AnimateHover();
                 Invalidate();
 
                 // Track mouse leave so we can fade out when cursor exits the splitter.
@@ -243,7 +259,7 @@ namespace FD2D
             if (m_hovered)
             {
                 m_hovered = false;
-                m_lastHoverAnimMs = 0;
+                AnimateHover();
                 Invalidate();
             }
             return false;
@@ -360,28 +376,6 @@ namespace FD2D
             target->CreateSolidColorBrush(D2D1::ColorF(1.0f, 1.0f, 1.0f, 0.65f), &m_brushGrip);
         }
 
-        // Hover fade animation (time-based).
-        const unsigned long long now = Util::NowMs();
-        if (m_lastHoverAnimMs == 0)
-        {
-            m_lastHoverAnimMs = now;
-        }
-        const unsigned long long dtMs = now - m_lastHoverAnimMs;
-        m_lastHoverAnimMs = now;
-
-        const float targetT = (m_hovered || m_dragging) ? 1.0f : 0.0f;
-        const unsigned int fadeMs = (m_hoverFadeMs > 0) ? m_hoverFadeMs : 120U;
-        const float step = static_cast<float>(dtMs) / static_cast<float>(fadeMs);
-        if (m_hoverT < targetT)
-        {
-            m_hoverT = (std::min)(targetT, m_hoverT + step);
-        }
-        else if (m_hoverT > targetT)
-        {
-            m_hoverT = (std::max)(targetT, m_hoverT - step);
-        }
-        m_hoverT = Util::Clamp01(m_hoverT);
-
         // Splitter visuals:
         // - Wide hit-area (rect) for usability
         // - Thin center line for aesthetics
@@ -478,16 +472,6 @@ namespace FD2D
             }
         }
 
-        // Keep animating while fade is in progress.
-        if (!m_dragging && BackplateRef() != nullptr)
-        {
-            const float t = (m_hovered ? (1.0f - m_hoverT) : m_hoverT);
-            if (t > 0.001f)
-            {
-                BackplateRef()->RequestAnimationFrame();
-            }
-        }
-
         Wnd::OnRender(target);
     }
 }
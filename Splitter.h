@@ -50,6 +50,7 @@ namespace FD2D
         void UpdateDrag(const POINT& pt);
         void EndDrag();
         void HandleDoubleClick();
+        void AnimateHover();
         float CalculateRatio(float position) const;
         Rect GetParentBounds() const;
 
@@ -66,9 +67,8 @@ namespace FD2D
         float m_currentRatio { 0.5f };
         Rect m_dragStartParentBounds {};  // Parent bounds at the start of the drag
 
-        // Hover fade animation (0 = normal, 1 = hover).
+        // Hover fade animation (0 = normal, 1 = hover), driven by the window's AnimationEngine.
         float m_hoverT { 0.0f };
-        unsigned long long m_lastHoverAnimMs { 0 };
         unsigned int m_hoverFadeMs { 140 };
 
         std::function<void(float)> m_splitChanged;
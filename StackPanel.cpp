@@ -1,4 +1,5 @@
 #include "StackPanel.h"
+#include "LayoutEngine.h"
 
 namespace FD2D
 {
@@ -20,37 +21,26 @@ namespace FD2D
 
     Size StackPanel::Measure(Size available)
     {
-        float main = 0.0f;
-        float cross = 0.0f;
+        const bool vertical = (m_orientation == Orientation::Vertical);
+        const auto& children = ChildrenInOrder();
+        std::pmr::vector<Size> measured(children.size(), Size {}, ScratchMemory());
+        MeasureChildren(children.data(), children.size(), available, measured.data());
 
-        for (auto& child : ChildrenInOrder())
+        std::pmr::vector<float> mainSizes(ScratchMemory());
+        mainSizes.reserve(children.size());
+        float cross = 0.0f;
+        for (std::size_t i = 0; i < children.size(); ++i)
         {
-            if (child)
+            if (children[i])
             {
-                Size s = child->Measure(available);
-                if (m_orientation == Orientation::Vertical)
-                {
-                    main += s.h;
-                    cross = (std::max)(cross, s.w);
-                }
-                else
-                {
-                    main += s.w;
-                    cross = (std::max)(cross, s.h);
-                }
-
-                main += m_spacing;
+                const Size s = measured[i];
+                mainSizes.push_back(vertical ? s.h : s.w);
+                cross = (std::max)(cross, vertical ? s.w : s.h);
             }
         }
 
-        if (m_orientation == Orientation::Vertical)
-        {
-            m_desired = { cross, main > 0.0f ? main - m_spacing : 0.0f };
-        }
-        else
-        {
-            m_desired = { main > 0.0f ? main - m_spacing : 0.0f, cross };
-        }
+        const float main = LayoutKernels::Stack(mainSizes.data(), mainSizes.size(), 0.0f, m_spacing, nullptr);
+        m_desired = vertical ? Size { cross, main } : Size { main, cross };
 
         // Include this panel's padding and margin so scroll containers compute correct content extents.
         m_desired.w += 2.0f * m_padding + 2.0f * m_margin;
@@ -63,8 +53,13 @@ namespace FD2D
     {
         Rect inset = Inset(r, m_margin);
         Rect childArea = Inset(inset, m_padding);
-        float offset = (m_orientation == Orientation::Vertical) ? childArea.y : childArea.x;
+        const bool vertical = (m_orientation == Orientation::Vertical);
 
+        // Measure every child first, then place them with the shared kernel.
+        std::pmr::vector<Wnd*> children(ScratchMemory());
+        std::pmr::vector<float> mainSizes(ScratchMemory());
+        children.reserve(ChildrenInOrder().size());
+        mainSizes.reserve(ChildrenInOrder().size());
         for (auto& child : ChildrenInOrder())
         {
             if (!child)
@@ -73,19 +68,19 @@ namespace FD2D
             }
 
             Size desired = child->Measure({ childArea.w, childArea.h });
+            children.push_back(child.get());
+            mainSizes.push_back(vertical ? desired.h : desired.w);
+        }
 
-            if (m_orientation == Orientation::Vertical)
-            {
-                Rect childRect { childArea.x, offset, childArea.w, desired.h };
-                child->Arrange(childRect);
-                offset += desired.h + m_spacing;
-            }
-            else
-            {
-                Rect childRect { offset, childArea.y, desired.w, childArea.h };
-                child->Arrange(childRect);
-                offset += desired.w + m_spacing;
-            }
+        std::pmr::vector<float> offsets(children.size(), 0.0f, ScratchMemory());
+        (void)LayoutKernels::Stack(mainSizes.data(), mainSizes.size(),
+            vertical ? childArea.y : childArea.x, m_spacing, offsets.data());
+        for (std::size_t i = 0; i < children.size(); ++i)
+        {
+            const Rect childRect = vertical
+                ? Rect { childArea.x, offsets[i], childArea.w, mainSizes[i] }
+                : Rect { offsets[i], childArea.y, mainSizes[i], childArea.h };
+            children[i]->Arrange(childRect);
         }
 
         m_bounds = r;
@@ -1,8 +1,29 @@
 #include "Text.h"
+#include "DWriteTextMetrics.h"
+#include <atomic>
 #include <cmath>
+#include <mutex>
 
 namespace FD2D
 {
+    namespace
+    {
+        // SetMetricsProvider keeps the owner; Measure reads the raw pointer.
+        std::mutex g_metricsMutex;
+        std::shared_ptr<TextMetricsProvider> g_metricsOwner;
+        std::atomic<TextMetricsProvider*> g_metrics { nullptr };
+
+        TextMetricsProvider& ActiveMetrics()
+        {
+            if (TextMetricsProvider* provider = g_metrics.load(std::memory_order_acquire))
+            {
+                return *provider;
+            }
+            static DWriteTextMetrics s_directWrite;
+            return s_directWrite;
+        }
+    }
+
     Text::Text()
         : Wnd()
     {
@@ -13,6 +34,19 @@ namespace FD2D
     {
     }
 
+    void Text::SetMetricsProvider(std::shared_ptr<TextMetricsProvider> provider)
+    {
+        std::lock_guard<std::mutex> lock(g_metricsMutex);
+        g_metrics.store(provider.get(), std::memory_order_release);
+        g_metricsOwner = std::move(provider);
+    }
+
+    std::shared_ptr<TextMetricsProvider> Text::MetricsProvider()
+    {
+        std::lock_guard<std::mutex> lock(g_metricsMutex);
+        return g_metricsOwner;
+    }
+
     void Text::SetText(const std::wstring& text)
     {
         if (m_text == text)
@@ -213,49 +247,21 @@ namespace FD2D
             return;
         }
 
-        EnsureFormat();
-
-        if (!m_format || m_text.empty())
+        if (m_text.empty())
         {
             m_naturalSize = { 0.0f, m_size * 1.2f };
             m_naturalSizeDirty = false;
             return;
         }
 
-        // Measure against an effectively unbounded box (no target/rendered
-        // layout required) so metrics.width/height reflect the text's true
-        // intrinsic size - real glyph advances and the font's actual
-        // ascent+descent+lineGap - rather than the old "charCount * size *
-        // 0.6" / "size * 1.2" guesses, which were consistently short enough
-        // to hard-clip descenders (e.g. the "g" in "Brightness") once a
-        // control sized its label rect directly off Measure()'s result.
-        constexpr float kUnbounded = 100000.0f;
-        Microsoft::WRL::ComPtr<IDWriteTextLayout> naturalLayout;
-        IDWriteFactory* factory = Core::DWriteFactory();
-        if (factory != nullptr)
-        {
-            (void)factory->CreateTextLayout(
-                m_text.c_str(),
-                static_cast<UINT32>(m_text.length()),
-                m_format.Get(),
-                kUnbounded,
-                kUnbounded,
-                &naturalLayout);
-        }
-
-        DWRITE_TEXT_METRICS metrics {};
-        if (naturalLayout && SUCCEEDED(naturalLayout->GetMetrics(&metrics)) && metrics.width > 0.0f)
+        const TextExtent extent = ActiveMetrics().Measure(m_family, m_size, m_text);
+        if (extent.width > 0.0f)
         {
-            // +1px safety margin: GetMetrics() reports ideal (sub-pixel) glyph
-            // extents, while the rect a caller later hands to
-            // DrawText*(..., D2D1_DRAW_TEXT_OPTIONS_CLIP) goes through
-            // pixel snapping/rounding - without a little slack, that rounding
-            // can still shave a pixel off a descender on some sizes/DPIs.
-            m_naturalSize = { metrics.width, metrics.height + 1.0f };
+            m_naturalSize = { extent.width, extent.height };
         }
         else
         {
-            // DWrite unavailable/failed - fall back to the old heuristic
+            // Provider unavailable/failed - fall back to the old heuristic
             // rather than reporting a bogus zero size.
             m_naturalSize = {
                 static_cast<float>(m_text.length()) * m_size * 0.6f,
@@ -288,6 +294,31 @@ namespace FD2D
         return m_desired;
     }
 
+    bool Text::MeasureUnchanged(const Size& last, Size available) const
+    {
+        // Measure only clamps the natural width to the offered one; with the
+        // natural size current that is cheap to replay.
+        if (!m_text.empty() && m_naturalSizeDirty)
+        {
+            return false;
+        }
+
+        Size size {};
+        if (m_text.empty())
+        {
+            size = { (m_fixedWidth > 0.0f) ? m_fixedWidth : 0.0f, m_size * 1.2f };
+        }
+        else
+        {
+            size = { (m_fixedWidth > 0.0f) ? m_fixedWidth : m_naturalSize.w, m_naturalSize.h };
+            if (available.w > 0.0f)
+            {
+                size.w = (std::min)(size.w, available.w);
+            }
+        }
+        return size.w == last.w && size.h == last.h;
+    }
+
     void Text::OnRender(ID2D1RenderTarget* target)
     {
         EnsureResources(target);
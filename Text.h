@@ -2,6 +2,7 @@
 
 #include "Wnd.h"
 #include "Core.h"
+#include "TextMetrics.h"
 #include <functional>
 
 namespace FD2D
@@ -15,6 +16,7 @@ namespace FD2D
         explicit Text(const std::wstring& name);
 
         Size Measure(Size available) override;
+        bool MeasureUnchanged(const Size& last, Size available) const override;
         void SetText(const std::wstring& text);
         void SetColor(const D2D1_COLOR_F& color);
         void SetRect(const D2D1_RECT_F& rect);
@@ -25,6 +27,16 @@ namespace FD2D
         void SetEllipsisTrimmingEnabled(bool enabled);
         void SetOnClick(ClickHandler handler);
 
+        // Process-wide source of the intrinsic text size Measure reports
+        // (TextMetrics.h); nullptr restores DirectWrite (DWriteTextMetrics).
+        // AdvanceTextMetrics sizes large label sets far faster, and without
+        // a source needs no DirectWrite at all (benchmarks, headless runs).
+        // Swap it while no layout is running; sizes already cached by a
+        // control are kept until its text or font changes. Rendering always
+        // uses DirectWrite.
+        static void SetMetricsProvider(std::shared_ptr<TextMetricsProvider> provider);
+        static std::shared_ptr<TextMetricsProvider> MetricsProvider();
+
         // When enabled, this control asks Backplate to show a hover tooltip
         // with the full text whenever the text does not fit its rect (i.e. it
         // is clipped / shown with an ellipsis). Pairs naturally with
@@ -80,9 +92,10 @@ namespace FD2D
         bool m_textLayoutDirty { true };
 
         // Cached result of measuring m_text/m_family/m_size at effectively
-        // unbounded width, i.e. its true intrinsic size (see EnsureNaturalSize
-        // in Text.cpp for why Measure() needs this instead of the old
-        // "fontSize * 1.2" / "charCount * fontSize * 0.6" heuristics).
+        // unbounded width, i.e. its true intrinsic size, from the metrics
+        // provider (see DWriteTextMetrics::Measure for why Measure() needs
+        // this instead of the old "fontSize * 1.2" / "charCount * fontSize *
+        // 0.6" heuristics).
         Size m_naturalSize { 0.0f, 0.0f };
         bool m_naturalSizeDirty { true };
     };
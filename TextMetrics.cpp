@@ -0,0 +1,131 @@
+#include "TextMetrics.h"
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FD2D_TEXT_SSE2 1
+#elif defined(_M_ARM64) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define FD2D_TEXT_NEON 1
+#endif
+
+namespace FD2D
+{
+    namespace
+    {
+        // Printable ASCII (0x20..0x7E) of a UI sans-serif, in em.
+        constexpr float kAsciiAdvances[] = {
+            0.27f, 0.27f, 0.40f, 0.60f, 0.55f, 0.80f, 0.77f, 0.23f, // space ! " # $ % & '
+            0.30f, 0.30f, 0.42f, 0.69f, 0.22f, 0.39f, 0.25f, 0.38f, // ( ) * + , - . /
+            0.55f, 0.55f, 0.55f, 0.55f, 0.55f, 0.55f, 0.55f, 0.55f, // 0-7
+            0.55f, 0.55f, 0.25f, 0.25f, 0.69f, 0.69f, 0.69f, 0.45f, // 8 9 : ; < = > ?
+            0.95f, 0.66f, 0.60f, 0.63f, 0.73f, 0.52f, 0.50f, 0.71f, // @ A-G
+            0.75f, 0.28f, 0.37f, 0.60f, 0.49f, 0.93f, 0.77f, 0.78f, // H-O
+            0.58f, 0.78f, 0.61f, 0.55f, 0.55f, 0.73f, 0.64f, 0.97f, // P-W
+            0.62f, 0.58f, 0.60f, 0.30f, 0.38f, 0.30f, 0.69f, 0.42f, // X Y Z [ \ ] ^ _
+            0.27f, 0.51f, 0.59f, 0.47f, 0.59f, 0.53f, 0.32f, 0.59f, // ` a-g
+            0.57f, 0.24f, 0.24f, 0.50f, 0.24f, 0.87f, 0.57f, 0.59f, // h-o
+            0.59f, 0.59f, 0.35f, 0.43f, 0.34f, 0.57f, 0.48f, 0.74f, // p-w
+            0.47f, 0.48f, 0.45f, 0.30f, 0.24f, 0.30f, 0.69f        // x y z { | } ~
+        };
+
+        // Four-lane reduction shared by every path, so SIMD and scalar agree.
+        inline float CombineLanes(const float lanes[4])
+        {
+            return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        }
+    }
+
+    void DefaultFontAdvances(FontAdvances& out)
+    {
+        out.advance.fill(0.0f);
+        std::copy(std::begin(kAsciiAdvances), std::end(kAsciiAdvances), out.advance.begin() + 0x20);
+        for (std::size_t c = 0xA0; c < 0xC0; ++c)
+        {
+            out.advance[c] = 0.50f; // Latin-1 punctuation and symbols
+        }
+        for (std::size_t c = 0xC0; c < 0x100; ++c)
+        {
+            out.advance[c] = (c < 0xDF) ? 0.66f : 0.53f; // accented capitals, then lowercase
+        }
+        for (std::size_t c = 0x100; c < FontAdvances::kTableSize; ++c)
+        {
+            out.advance[c] = 0.58f; // Latin Extended-A/B, capitals and lowercase interleaved
+        }
+        // Everything else: the old per-character estimate of Text.
+        out.advance[FontAdvances::kTableSize] = 0.6f;
+        out.lineHeight = 1.2f;
+    }
+
+    float SumAdvances(const float* table, std::size_t count, const wchar_t* text, std::size_t length)
+    {
+        const auto at = [&](std::size_t i)
+        {
+            const std::size_t unit = static_cast<std::size_t>(static_cast<std::make_unsigned_t<wchar_t>>(text[i]));
+            return table[(std::min)(unit, count)];
+        };
+
+        float lanes[4] {};
+        std::size_t i = 0;
+#if defined(FD2D_TEXT_SSE2)
+        __m128 sum = _mm_setzero_ps();
+        for (; i + 4 <= length; i += 4)
+        {
+            sum = _mm_add_ps(sum, _mm_set_ps(at(i + 3), at(i + 2), at(i + 1), at(i)));
+        }
+        _mm_storeu_ps(lanes, sum);
+#elif defined(FD2D_TEXT_NEON)
+        float32x4_t sum = vdupq_n_f32(0.0f);
+        for (; i + 4 <= length; i += 4)
+        {
+            const float values[4] { at(i), at(i + 1), at(i + 2), at(i + 3) };
+            sum = vaddq_f32(sum, vld1q_f32(values));
+        }
+        vst1q_f32(lanes, sum);
+#else
+        for (; i + 4 <= length; i += 4)
+        {
+            lanes[0] += at(i);
+            lanes[1] += at(i + 1);
+            lanes[2] += at(i + 2);
+            lanes[3] += at(i + 3);
+        }
+#endif
+        float total = CombineLanes(lanes);
+        for (; i < length; ++i)
+        {
+            total += at(i);
+        }
+        return total;
+    }
+
+    AdvanceTextMetrics::AdvanceTextMetrics(FontAdvanceSource source)
+        : m_source(std::move(source))
+    {
+    }
+
+    const FontAdvances& AdvanceTextMetrics::AdvancesFor(std::wstring_view family)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_fonts.find(family);
+        if (it == m_fonts.end())
+        {
+            auto advances = std::make_unique<FontAdvances>();
+            if (!m_source || !m_source(family, *advances))
+            {
+                DefaultFontAdvances(*advances);
+            }
+            it = m_fonts.emplace(std::wstring(family), std::move(advances)).first;
+        }
+        return *it->second;
+    }
+
+    TextExtent AdvanceTextMetrics::Measure(std::wstring_view family, float size, std::wstring_view text)
+    {
+        const FontAdvances& font = AdvancesFor(family);
+        const float em = SumAdvances(font.advance.data(), FontAdvances::kTableSize, text.data(), text.size());
+        return { em * size, font.lineHeight * size };
+    }
+}
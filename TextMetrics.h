@@ -0,0 +1,94 @@
+#pragma once
+
+// TextMetrics.h - where Text gets the intrinsic size of its string.
+//
+// Platform-neutral (DWriteTextMetrics.h has the DirectWrite provider). Text
+// asks the process-wide provider (Text::SetMetricsProvider) for the size of
+// its string as one unbounded line; DirectWrite is the default. The
+// advance-table provider here trades shaping for speed and determinism: each
+// font's per-character advances are looked up once, and a string's width is
+// their sum, so sizing thousands of labels costs a table walk per label
+// instead of a text layout, and gives the same numbers on every machine.
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace FD2D
+{
+    struct TextExtent
+    {
+        float width { 0.0f };
+        float height { 0.0f };
+    };
+
+    // Measure may be called from several threads at once (see the Measure
+    // contract in Wnd.h), so implementations must be thread-safe.
+    class TextMetricsProvider
+    {
+    public:
+        virtual ~TextMetricsProvider() = default;
+
+        // Size of `text` set on one line in `family` at `size` DIPs. A zero
+        // width means the provider could not measure it.
+        virtual TextExtent Measure(std::wstring_view family, float size, std::wstring_view text) = 0;
+    };
+
+    // Advances of one font, in em.
+    struct FontAdvances
+    {
+        // Code units below this have their own entry (Latin-1 and Latin
+        // Extended-A/B); the rest share `advance[kTableSize]`.
+        static constexpr std::size_t kTableSize = 0x250;
+
+        std::array<float, kTableSize + 1> advance {};
+        // Ascent + descent + line gap.
+        float lineHeight { 1.2f };
+    };
+
+    // Fills `out` for `family`; false when the family is unknown.
+    using FontAdvanceSource = std::function<bool(std::wstring_view family, FontAdvances& out)>;
+
+    // Built-in advances of a generic proportional sans-serif; what
+    // AdvanceTextMetrics uses without a source or for families the source
+    // does not know.
+    void DefaultFontAdvances(FontAdvances& out);
+
+    // Sum of table[min(text[i], count)]: `table` has count + 1 entries, the
+    // last one shared by every code unit past the table. The sum runs in
+    // four lanes (SSE2 / NEON when available) in a fixed order, so the result
+    // is the same bit for bit with or without SIMD.
+    float SumAdvances(const float* table, std::size_t count, const wchar_t* text, std::size_t length);
+
+    // Cached advance-width metrics. Each family's table is built once, from
+    // `source` when given (DWriteFontAdvances reads the installed font) or
+    // from DefaultFontAdvances. There is no shaping: kerning, ligatures and
+    // complex scripts are not applied, so widths track DirectWrite's closely
+    // for Latin UI text but not for scripts that need shaping.
+    class AdvanceTextMetrics final : public TextMetricsProvider
+    {
+    public:
+        explicit AdvanceTextMetrics(FontAdvanceSource source = {});
+
+        TextExtent Measure(std::wstring_view family, float size, std::wstring_view text) override;
+
+    private:
+        struct FamilyHash
+        {
+            using is_transparent = void;
+            std::size_t operator()(std::wstring_view family) const { return std::hash<std::wstring_view> {}(family); }
+        };
+
+        const FontAdvances& AdvancesFor(std::wstring_view family);
+
+        FontAdvanceSource m_source {};
+        std::mutex m_mutex {};
+        // Tables are never dropped, so references handed out stay valid.
+        std::unordered_map<std::wstring, std::unique_ptr<FontAdvances>, FamilyHash, std::equal_to<>> m_fonts {};
+    };
+}
@@ -0,0 +1,424 @@
+#include "TimerWheel.h"
+#include <algorithm>
+#include <bit>
+
+namespace FD2D
+{
+    TimerWheel::TimerWheel(std::uint64_t nowMs)
+        : m_current(nowMs)
+    {
+        m_heads.fill(kNil);
+        m_occupied.fill(0);
+    }
+
+    TimerWheel::TimerId TimerWheel::MakeId(std::uint32_t index, std::uint32_t generation)
+    {
+        return (static_cast<TimerId>(generation) << 32) | (static_cast<TimerId>(index) + 1);
+    }
+
+    bool TimerWheel::Resolve(TimerId id, std::uint32_t& index) const
+    {
+        const std::uint64_t low = id & 0xFFFFFFFFull;
+        if (low == 0 || low > m_nodes.size())
+        {
+            return false;
+        }
+
+        index = static_cast<std::uint32_t>(low - 1);
+        const Node& node = m_nodes[index];
+        return node.active && node.generation == static_cast<std::uint32_t>(id >> 32);
+    }
+
+    std::uint32_t TimerWheel::Allocate()
+    {
+        if (!m_free.empty())
+        {
+            const std::uint32_t index = m_free.back();
+            m_free.pop_back();
+            return index;
+        }
+
+        m_nodes.emplace_back();
+        return static_cast<std::uint32_t>(m_nodes.size() - 1);
+    }
+
+    void TimerWheel::Release(std::uint32_t index)
+    {
+        Node& node = m_nodes[index];
+        node.active = false;
+        ++node.generation;
+        node.callback = nullptr;
+        node.prev = kNil;
+        node.next = kNil;
+        node.list = kNoList;
+        m_free.push_back(index);
+        --m_count;
+    }
+
+    void TimerWheel::Link(std::uint32_t index)
+    {
+        Node& node = m_nodes[index];
+        std::uint64_t due = (std::max)(node.due, m_current);
+        const std::uint64_t delta = due - m_current;
+
+        unsigned level = 0;
+        while (level < kLevels && delta >= (1ull << (kSlotBits * (level + 1))))
+        {
+            ++level;
+        }
+        if (level == kLevels)
+        {
+            // Beyond the wheel's span: park at the far end of the top level;
+            // it is re-placed (using the real due time) when that slot cascades.
+            level = kLevels - 1;
+            due = m_current + (1ull << (kSlotBits * kLevels)) - 1;
+        }
+
+        const std::uint32_t slot = static_cast<std::uint32_t>((due >> (kSlotBits * level)) & (kSlots - 1));
+        const std::uint32_t list = level * kSlots + slot;
+
+        node.list = list;
+        node.prev = kNil;
+        node.next = m_heads[list];
+        if (node.next != kNil)
+        {
+            m_nodes[node.next].prev = index;
+        }
+        m_heads[list] = index;
+        m_occupied[level] |= (1ull << slot);
+    }
+
+    void TimerWheel::Unlink(std::uint32_t index)
+    {
+        Node& node = m_nodes[index];
+        if (node.list == kNoList)
+        {
+            return;
+        }
+
+        if (node.prev != kNil)
+        {
+            m_nodes[node.prev].next = node.next;
+        }
+        else
+        {
+            m_heads[node.list] = node.next;
+        }
+        if (node.next != kNil)
+        {
+            m_nodes[node.next].prev = node.prev;
+        }
+
+        if (m_heads[node.list] == kNil)
+        {
+            m_occupied[node.list / kSlots] &= ~(1ull << (node.list % kSlots));
+        }
+
+        node.prev = kNil;
+        node.next = kNil;
+        node.list = kNoList;
+    }
+
+    TimerWheel::TimerId TimerWheel::Schedule(std::uint64_t dueMs, std::uint64_t periodMs, Callback callback)
+    {
+        const std::uint32_t index = Allocate();
+        Node& node = m_nodes[index];
+        node.due = dueMs;
+        node.period = periodMs;
+        node.callback = std::move(callback);
+        node.active = true;
+        ++m_count;
+        Link(index);
+        return MakeId(index, node.generation);
+    }
+
+    bool TimerWheel::Cancel(TimerId id)
+    {
+        std::uint32_t index = 0;
+        if (!Resolve(id, index))
+        {
+            return false;
+        }
+
+        Unlink(index);
+        Release(index);
+        return true;
+    }
+
+    bool TimerWheel::IsPending(TimerId id) const
+    {
+        std::uint32_t index = 0;
+        return Resolve(id, index);
+    }
+
+    void TimerWheel::TakeSlot(std::uint32_t list)
+    {
+        m_scratch.clear();
+        std::uint32_t index = m_heads[list];
+        while (index != kNil)
+        {
+            Node& node = m_nodes[index];
+            const std::uint32_t next = node.next;
+            m_scratch.emplace_back(index, node.generation);
+            node.prev = kNil;
+            node.next = kNil;
+            node.list = kNoList;
+            index = next;
+        }
+
+        m_heads[list] = kNil;
+        m_occupied[list / kSlots] &= ~(1ull << (list % kSlots));
+    }
+
+    void TimerWheel::Cascade(unsigned level, std::uint64_t tick)
+    {
+        const std::uint32_t slot = static_cast<std::uint32_t>((tick >> (kSlotBits * level)) & (kSlots - 1));
+        TakeSlot(level * kSlots + slot);
+        for (const auto& entry : m_scratch)
+        {
+            Link(entry.first);
+        }
+    }
+
+    bool TimerWheel::Fire(std::uint32_t index, std::uint32_t generation, std::uint64_t tick)
+    {
+        {
+            const Node& node = m_nodes[index];
+            if (!node.active || node.generation != generation || node.list != kNoList)
+            {
+                // Cancelled (or cancelled and reused) by an earlier callback.
+                return false;
+            }
+        }
+
+        Callback callback = std::move(m_nodes[index].callback);
+        const bool periodic = m_nodes[index].period != 0;
+        if (periodic)
+        {
+            // Re-arm before running so the callback can cancel itself.
+            Node& node = m_nodes[index];
+            std::uint64_t next = node.due + node.period;
+            if (next <= tick)
+            {
+                next = tick + node.period; // skip periods missed while stalled
+            }
+            node.due = next;
+            Link(index);
+        }
+        else
+        {
+            Release(index);
+        }
+
+        if (callback)
+        {
+            callback();
+        }
+
+        // m_nodes may have grown during the callback: index again.
+        if (periodic && m_nodes[index].active && m_nodes[index].generation == generation)
+        {
+            m_nodes[index].callback = std::move(callback);
+        }
+        return true;
+    }
+
+    std::size_t TimerWheel::Advance(std::uint64_t nowMs)
+    {
+        if (nowMs < m_current)
+        {
+            return (nowMs + 1 == m_current) ? FireLate(nowMs) : 0;
+        }
+        if (m_count == 0)
+        {
+            m_current = nowMs + 1;
+            return 0;
+        }
+        if (nowMs - m_current >= kRebaseGapMs)
+        {
+            return Rebase(nowMs);
+        }
+
+        std::size_t fired = 0;
+        while (m_current <= nowMs)
+        {
+            const std::uint64_t tick = m_current;
+
+            // Block boundary: pull the next block of each higher level down,
+            // top-down, so timers cascading through several levels land in
+            // their final slot before level 0 is drained.
+            if ((tick & (kSlots - 1)) == 0)
+            {
+                unsigned top = 1;
+                while (top + 1 < kLevels && ((tick >> (kSlotBits * top)) & (kSlots - 1)) == 0)
+                {
+                    ++top;
+                }
+                for (unsigned level = top; level >= 1; --level)
+                {
+                    Cascade(level, tick);
+                }
+            }
+
+            // Advance first: timers scheduled by callbacks below then land in
+            // a future slot instead of the one being drained.
+            m_current = tick + 1;
+            const std::uint32_t list = static_cast<std::uint32_t>(tick & (kSlots - 1));
+            if (m_heads[list] != kNil)
+            {
+                TakeSlot(list);
+                for (std::size_t i = 0; i < m_scratch.size(); ++i)
+                {
+                    if (Fire(m_scratch[i].first, m_scratch[i].second, tick))
+                    {
+                        ++fired;
+                    }
+                }
+            }
+
+            if (m_count == 0)
+            {
+                m_current = nowMs + 1;
+                break;
+            }
+
+            // Nothing left in level 0: skip ahead to the next block boundary.
+            if (m_occupied[0] == 0)
+            {
+                const std::uint64_t nextBlock = ((tick >> kSlotBits) + 1) << kSlotBits;
+                m_current = (std::min)(nextBlock, nowMs + 1);
+            }
+        }
+        return fired;
+    }
+
+    std::size_t TimerWheel::FireLate(std::uint64_t nowMs)
+    {
+        // Timers scheduled for a processed tick were linked into the slot of
+        // m_current (see Link); it also holds the ones due at m_current, which
+        // go back untouched.
+        const std::uint32_t list = static_cast<std::uint32_t>(m_current & (kSlots - 1));
+        if (m_heads[list] == kNil)
+        {
+            return 0;
+        }
+
+        TakeSlot(list);
+        for (const auto& entry : m_scratch)
+        {
+            if (m_nodes[entry.first].due > nowMs)
+            {
+                Link(entry.first);
+            }
+        }
+
+        std::size_t fired = 0;
+        for (std::size_t i = 0; i < m_scratch.size(); ++i)
+        {
+            if (Fire(m_scratch[i].first, m_scratch[i].second, nowMs))
+            {
+                ++fired;
+            }
+        }
+        return fired;
+    }
+
+    std::size_t TimerWheel::Rebase(std::uint64_t nowMs)
+    {
+        // Long gap: re-place everything relative to the new time and fire the
+        // overdue timers in deadline order, instead of stepping every ms.
+        std::vector<std::pair<std::uint64_t, std::pair<std::uint32_t, std::uint32_t>>> overdue;
+        for (std::uint32_t index = 0; index < m_nodes.size(); ++index)
+        {
+            Node& node = m_nodes[index];
+            if (!node.active)
+            {
+                continue;
+            }
+            Unlink(index);
+            if (node.due <= nowMs)
+            {
+                overdue.push_back({ node.due, { index, node.generation } });
+            }
+        }
+
+        m_current = nowMs + 1;
+        for (std::uint32_t index = 0; index < m_nodes.size(); ++index)
+        {
+            if (m_nodes[index].active && m_nodes[index].due > nowMs)
+            {
+                Link(index);
+            }
+        }
+
+        std::sort(overdue.begin(), overdue.end());
+        std::size_t fired = 0;
+        for (const auto& entry : overdue)
+        {
+            if (Fire(entry.second.first, entry.second.second, nowMs))
+            {
+                ++fired;
+            }
+        }
+        return fired;
+    }
+
+    std::uint64_t TimerWheel::NextDeadline() const
+    {
+        if (m_count == 0)
+        {
+            return kNoDeadline;
+        }
+
+        std::uint64_t best = kNoDeadline;
+
+        // Level 0 holds exactly the timers due in [m_current, m_current + 63]
+        // (earlier due times are linked at m_current).
+        if (m_occupied[0] != 0)
+        {
+            const int rotate = static_cast<int>(m_current & (kSlots - 1));
+            const int offset = std::countr_zero(std::rotr(m_occupied[0], rotate));
+            best = m_current + static_cast<std::uint64_t>(offset);
+
+            // The m_current slot may also hold timers scheduled for a tick
+            // already processed: they are due as of the last Advance.
+            if (offset == 0)
+            {
+                for (std::uint32_t index = m_heads[rotate]; index != kNil; index = m_nodes[index].next)
+                {
+                    if (m_nodes[index].due < m_current)
+                    {
+                        best = m_current - 1;
+                        break;
+                    }
+                }
+            }
+        }
+
+        // Higher levels: blocks are disjoint and ordered, so the earliest
+        // occupied slot of a level holds that level's earliest timer. The
+        // current block's slot only still counts when its boundary tick is
+        // unprocessed (otherwise it holds timers one full turn ahead).
+        for (unsigned level = 1; level < kLevels; ++level)
+        {
+            if (m_occupied[level] == 0)
+            {
+                continue;
+            }
+
+            const unsigned shift = kSlotBits * level;
+            const std::uint64_t blockMask = (1ull << shift) - 1;
+            const std::uint64_t block = m_current >> shift;
+            const std::uint64_t first = ((m_current & blockMask) == 0) ? block : block + 1;
+            const int rotate = static_cast<int>(first & (kSlots - 1));
+            const int offset = std::countr_zero(std::rotr(m_occupied[level], rotate));
+            const std::uint32_t slot = static_cast<std::uint32_t>((first + static_cast<std::uint64_t>(offset)) & (kSlots - 1));
+
+            for (std::uint32_t index = m_heads[level * kSlots + slot]; index != kNil; index = m_nodes[index].next)
+            {
+                best = (std::min)(best, (std::max)(m_nodes[index].due, m_current));
+            }
+        }
+        return best;
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+// TimerWheel.h - hierarchical timing wheel for UI-thread timers.
+//
+// Platform-neutral: time is whatever millisecond clock the owner feeds to
+// Advance (Backplate uses Util::NowMs). Four levels of 64 slots cover ~4.6h
+// at 1ms resolution; later deadlines park in the top level and are re-placed
+// as it turns. Schedule and Cancel are O(1); Advance costs O(elapsed ms)
+// plus the timers it cascades or fires, and rebases instead of stepping
+// through long gaps (system sleep).
+//
+// Not thread-safe. Callbacks run inside Advance and may schedule or cancel
+// timers (including their own), but must not call Advance.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace FD2D
+{
+    class TimerWheel
+    {
+    public:
+        using TimerId = std::uint64_t;
+        using Callback = std::function<void()>;
+
+        static constexpr TimerId kInvalidTimer = 0;
+        static constexpr std::uint64_t kNoDeadline = ~0ull;
+
+        explicit TimerWheel(std::uint64_t nowMs = 0);
+
+        // Fires once at (or after) `dueMs`, then every `periodMs` when non-zero.
+        // A due time that has already passed fires on the next Advance, even
+        // one for the tick already advanced to: Schedule(now) right after
+        // Advance(now) fires on a repeated Advance(now).
+        TimerId Schedule(std::uint64_t dueMs, std::uint64_t periodMs, Callback callback);
+        // Returns false when the timer already fired (one-shot) or was cancelled.
+        bool Cancel(TimerId id);
+        bool IsPending(TimerId id) const;
+
+        // Fires every timer due at or before `nowMs`; returns how many fired.
+        // A clock that went backwards fires nothing.
+        std::size_t Advance(std::uint64_t nowMs);
+
+        // Earliest pending deadline (kNoDeadline if empty), including timers
+        // parked beyond the wheel's span. A timer due at or before the last
+        // advanced tick reports that tick. O(levels) plus the timers sharing
+        // the earliest slot of each level.
+        std::uint64_t NextDeadline() const;
+
+        std::size_t Count() const { return m_count; }
+
+    private:
+        static constexpr unsigned kSlotBits = 6;
+        static constexpr unsigned kSlots = 1u << kSlotBits;
+        static constexpr unsigned kLevels = 4;
+        static constexpr std::uint32_t kNil = ~0u;
+        static constexpr std::uint32_t kNoList = ~0u;
+        // Gaps longer than this are handled by Rebase instead of ms stepping.
+        static constexpr std::uint64_t kRebaseGapMs = 1ull << (2 * kSlotBits);
+
+        struct Node
+        {
+            std::uint64_t due { 0 };
+            std::uint64_t period { 0 };
+            Callback callback {};
+            std::uint32_t prev { kNil };
+            std::uint32_t next { kNil };
+            std::uint32_t list { kNoList };
+            std::uint32_t generation { 1 };
+            bool active { false };
+        };
+
+        static TimerId MakeId(std::uint32_t index, std::uint32_t generation);
+        bool Resolve(TimerId id, std::uint32_t& index) const;
+
+        std::uint32_t Allocate();
+        void Release(std::uint32_t index);
+        void Link(std::uint32_t index);
+        void Unlink(std::uint32_t index);
+        // Moves a slot's timers out (into m_scratch) and empties the slot.
+        void TakeSlot(std::uint32_t list);
+        void Cascade(unsigned level, std::uint64_t tick);
+        bool Fire(std::uint32_t index, std::uint32_t generation, std::uint64_t tick);
+        // Advance(nowMs) again after the tick was processed.
+        std::size_t FireLate(std::uint64_t nowMs);
+        std::size_t Rebase(std::uint64_t nowMs);
+
+        std::vector<Node> m_nodes {};
+        std::vector<std::uint32_t> m_free {};
+        std::array<std::uint32_t, kLevels * kSlots> m_heads {};
+        std::array<std::uint64_t, kLevels> m_occupied {};
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> m_scratch {};
+
+        // Next tick to process: every timer due before it has fired.
+        std::uint64_t m_current { 0 };
+        std::size_t m_count { 0 };
+    };
+}
@@ -0,0 +1,152 @@
+#include "UiDispatcher.h"
+#include <algorithm>
+#include <chrono>
+
+namespace FD2D
+{
+    UiDispatcher::UiDispatcher(Clock clock)
+        : m_clock(std::move(clock))
+    {
+    }
+
+    UiDispatcher::~UiDispatcher()
+    {
+        // Nothing posts any more; free whatever is left (including posts that
+        // raced with Close).
+        for (Lane& lane : m_lanes)
+        {
+            while (Node* node = Pop(lane))
+            {
+                delete node;
+            }
+        }
+    }
+
+    std::uint64_t UiDispatcher::Now() const
+    {
+        if (m_clock)
+        {
+            return m_clock();
+        }
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    void UiDispatcher::Push(Lane& lane, Node* node)
+    {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        Node* prev = lane.head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    UiDispatcher::Node* UiDispatcher::Pop(Lane& lane)
+    {
+        Node* tail = lane.tail;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (tail == &lane.stub)
+        {
+            if (next == nullptr)
+            {
+                return nullptr;
+            }
+            lane.tail = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+
+        if (next != nullptr)
+        {
+            lane.tail = next;
+            return tail;
+        }
+
+        if (tail != lane.head.load(std::memory_order_acquire))
+        {
+            return nullptr; // a producer swapped in but has not linked yet
+        }
+
+        // `tail` is the last node: re-insert the stub behind it so it can be
+        // handed out without leaving the list empty.
+        Push(lane, &lane.stub);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next != nullptr)
+        {
+            lane.tail = next;
+            return tail;
+        }
+        return nullptr;
+    }
+
+    void UiDispatcher::Enqueue(Node* node, TaskPriority priority)
+    {
+        // Counted before it is visible so Pending() never misses it.
+        m_pending.fetch_add(1, std::memory_order_acq_rel);
+        const std::size_t lane = (std::min)(static_cast<std::size_t>(priority), kLanes - 1);
+        Push(m_lanes[lane], node);
+
+        // One wakeup per drain: the consumer clears the flag before it drains,
+        // so a post that finds it set is seen by that drain (or a later one).
+        if (!m_wakePending.exchange(true, std::memory_order_acq_rel) && m_wake)
+        {
+            m_wake();
+        }
+    }
+
+    bool UiDispatcher::Drain(std::uint64_t budgetUs, std::size_t maxTasks)
+    {
+        m_wakePending.store(false, std::memory_order_seq_cst);
+        if (m_closed.load(std::memory_order_acquire) || maxTasks == 0)
+        {
+            return Pending();
+        }
+
+        const std::uint64_t start = Now();
+        bool served[kLanes] {};
+        std::size_t ran = 0;
+        for (;;)
+        {
+            // One task from each lane not yet served this slice, then strictly
+            // by priority.
+            Node* node = nullptr;
+            for (std::size_t i = 0; i < kLanes && node == nullptr; ++i)
+            {
+                if (!served[i])
+                {
+                    served[i] = true;
+                    node = Pop(m_lanes[i]);
+                }
+            }
+            for (std::size_t i = 0; i < kLanes && node == nullptr; ++i)
+            {
+                node = Pop(m_lanes[i]);
+            }
+            if (node == nullptr)
+            {
+                break;
+            }
+
+            node->Run();
+            delete node;
+            m_pending.fetch_sub(1, std::memory_order_acq_rel);
+
+            if (++ran >= maxTasks || m_closed.load(std::memory_order_acquire) || Now() - start >= budgetUs)
+            {
+                break;
+            }
+        }
+        return Pending();
+    }
+
+    void UiDispatcher::Close()
+    {
+        m_closed.store(true, std::memory_order_release);
+        for (Lane& lane : m_lanes)
+        {
+            while (Node* node = Pop(lane))
+            {
+                delete node;
+                m_pending.fetch_sub(1, std::memory_order_acq_rel);
+            }
+        }
+    }
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+// UiDispatcher.h - hands work from any thread to the UI thread.
+//
+// Platform-neutral: one lock-free multi-producer / single-consumer queue per
+// priority lane. Post() never blocks or takes a lock (one allocation per
+// task), so workers can hand over their payload (a decoded bitmap, a query
+// result, ...) together with the code that applies it. The owner (Backplate)
+// drains the queues on the UI thread in bounded slices; leftovers wait for
+// the next slice so a flood of posts cannot hold up input or frames.
+//
+// Each slice first runs one task from every non-empty lane (High, Normal,
+// Low), then keeps serving the highest non-empty lane until its task or time
+// budget is spent, so lower lanes always make progress.
+//
+// Threading: Post/Pending may be called from any thread; Drain/Close only
+// from the consumer thread. The wake callback runs on the posting thread and
+// must only signal (e.g. AsyncRedrawToken::RequestAsyncRedraw); set it before
+// anything posts. Tasks run on the consumer thread and may post again.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace FD2D
+{
+    enum class TaskPriority : std::uint8_t
+    {
+        High,   // input-adjacent work that should land in the next frame
+        Normal,
+        Low     // bulk results; runs after higher lanes, never starves
+    };
+
+    class UiDispatcher
+    {
+    public:
+        using Clock = std::function<std::uint64_t()>; // microseconds
+        using WakeCallback = std::function<void()>;
+
+        static constexpr std::size_t kUnlimitedTasks = (std::numeric_limits<std::size_t>::max)();
+
+        // `clock` measures slice budgets (steady_clock when empty).
+        explicit UiDispatcher(Clock clock = {});
+        ~UiDispatcher();
+
+        UiDispatcher(const UiDispatcher&) = delete;
+        UiDispatcher& operator=(const UiDispatcher&) = delete;
+
+        // Called (coalesced) when a post finds no wakeup outstanding.
+        void SetWakeCallback(WakeCallback callback) { m_wake = std::move(callback); }
+
+        // Queues `task` (any callable, move-only ones included). Returns false
+        // and drops the task once the dispatcher is closed.
+        template <typename F>
+        bool Post(F&& task, TaskPriority priority = TaskPriority::Normal)
+        {
+            using Fn = std::decay_t<F>;
+            static_assert(std::is_invocable_v<Fn&>, "UiDispatcher::Post needs a callable taking no arguments");
+            if (m_closed.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+            Enqueue(new TaskNode<Fn>(std::forward<F>(task)), priority);
+            return true;
+        }
+
+        // Runs queued tasks until `budgetUs` has elapsed (checked after each
+        // task, so at least one runs) or `maxTasks` ran. Returns true when
+        // tasks are still queued.
+        bool Drain(std::uint64_t budgetUs, std::size_t maxTasks = kUnlimitedTasks);
+
+        // True while any task is queued (or being posted).
+        bool Pending() const { return m_pending.load(std::memory_order_acquire) > 0; }
+
+        // Rejects further posts and destroys queued tasks without running them.
+        void Close();
+        bool Closed() const { return m_closed.load(std::memory_order_acquire); }
+
+    private:
+        static constexpr std::size_t kLanes = 3;
+
+        struct Node
+        {
+            virtual ~Node() = default;
+            virtual void Run() {}
+
+            std::atomic<Node*> next { nullptr };
+        };
+
+        template <typename Fn>
+        struct TaskNode final : Node
+        {
+            template <typename F>
+            explicit TaskNode(F&& fn) : task(std::forward<F>(fn)) {}
+            void Run() override { task(); }
+
+            Fn task;
+        };
+
+        // Intrusive MPSC queue: producers swap themselves in at `head`; the
+        // consumer walks from `tail`. `stub` keeps the list non-empty.
+        struct Lane
+        {
+            Lane() : head(&stub), tail(&stub) {}
+
+            Node stub {};
+            std::atomic<Node*> head;
+            Node* tail;
+        };
+
+        void Enqueue(Node* node, TaskPriority priority);
+        static void Push(Lane& lane, Node* node);
+        // Returns nullptr when the lane is empty or a post is half-linked.
+        static Node* Pop(Lane& lane);
+        std::uint64_t Now() const;
+
+        Clock m_clock {};
+        WakeCallback m_wake {};
+        Lane m_lanes[kLanes] {};
+        std::atomic<std::int64_t> m_pending { 0 };
+        std::atomic<bool> m_wakePending { false };
+        std::atomic<bool> m_closed { false };
+    };
+}
@@ -1,12 +1,36 @@
 #include "Util.h"
 #include "Wnd.h"
+#include <algorithm>
 #include <cmath>
 
 namespace FD2D::Util
 {
     unsigned long long NowMs()
     {
-        return static_cast<unsigned long long>(GetTickCount64());
+        return NowUs() / 1000ULL;
+    }
+
+    unsigned long long NowUs()
+    {
+        LARGE_INTEGER counter {};
+        QueryPerformanceCounter(&counter);
+        return QpcToUs(counter.QuadPart);
+    }
+
+    unsigned long long QpcToUs(long long counter)
+    {
+        static const long long s_frequency = []()
+        {
+            LARGE_INTEGER f {};
+            QueryPerformanceFrequency(&f);
+            return f.QuadPart;
+        }();
+
+        // Split to avoid overflowing counter * 1'000'000 on long uptimes.
+        const long long seconds = counter / s_frequency;
+        const long long remainder = counter % s_frequency;
+        return static_cast<unsigned long long>(seconds) * 1000000ULL +
+            static_cast<unsigned long long>(remainder * 1000000LL / s_frequency);
     }
 
     float Clamp01(float v)
@@ -136,5 +160,35 @@ namespace FD2D::Util
         }
         return rect;
     }
+
+    D2D1_RECT_F TransformRectBounds(
+        const D2D1_RECT_F& rect,
+        const D2D1_MATRIX_3X2_F& transform)
+    {
+        const D2D1_POINT_2F corners[4] =
+        {
+            D2D1::Point2F(rect.left, rect.top),
+            D2D1::Point2F(rect.right, rect.top),
+            D2D1::Point2F(rect.left, rect.bottom),
+            D2D1::Point2F(rect.right, rect.bottom),
+        };
+
+        D2D1_RECT_F bounds {};
+        for (int i = 0; i < 4; ++i)
+        {
+            const float x = corners[i].x * transform._11 + corners[i].y * transform._21 + transform._31;
+            const float y = corners[i].x * transform._12 + corners[i].y * transform._22 + transform._32;
+            if (i == 0)
+            {
+                bounds = D2D1::RectF(x, y, x, y);
+                continue;
+            }
+            bounds.left = (std::min)(bounds.left, x);
+            bounds.top = (std::min)(bounds.top, y);
+            bounds.right = (std::max)(bounds.right, x);
+            bounds.bottom = (std::max)(bounds.bottom, y);
+        }
+        return bounds;
+    }
 }
 
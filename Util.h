@@ -11,7 +11,13 @@ namespace FD2D
 
 namespace FD2D::Util
 {
+    // Monotonic time from the performance counter (sub-millisecond resolution;
+    // GetTickCount64 only advances every ~15.6 ms, too coarse to pace frames).
     unsigned long long NowMs();
+    unsigned long long NowUs();
+    // A raw QueryPerformanceCounter value (e.g. DXGI_FRAME_STATISTICS::SyncQPCTime)
+    // on the NowUs() clock.
+    unsigned long long QpcToUs(long long counter);
     float Clamp01(float v);
 
     bool RectContainsPoint(const D2D1_RECT_F& r, const POINT& pt);
@@ -36,5 +42,11 @@ namespace FD2D::Util
         float zoomScale,
         float panX,
         float panY);
+
+    // Axis-aligned bounds of `rect` mapped through `transform` (e.g. a control's
+    // LayoutRect through the render target's current transform).
+    D2D1_RECT_F TransformRectBounds(
+        const D2D1_RECT_F& rect,
+        const D2D1_MATRIX_3X2_F& transform);
 }
 
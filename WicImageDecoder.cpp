@@ -0,0 +1,275 @@
+#include "WicImageDecoder.h"
+#include "FD2DLog.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace FD2D
+{
+    namespace
+    {
+        thread_local bool t_comInitialized = false;
+
+        // Images below this long edge get no preview; previews aim for about
+        // this long edge (DDS mip selection).
+        constexpr UINT kPreviewMinEdge = 2048;
+        constexpr UINT kPreviewTargetEdge = 512;
+    }
+
+    void WicImageDecoder::OnWorkerThreadStart()
+    {
+        const HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+        t_comInitialized = SUCCEEDED(hr);
+    }
+
+    void WicImageDecoder::OnWorkerThreadStop()
+    {
+        if (t_comInitialized)
+        {
+            CoUninitialize();
+            t_comInitialized = false;
+        }
+    }
+
+    IWICImagingFactory* WicImageDecoder::Factory()
+    {
+        // The WIC factory is free-threaded, so one instance serves all workers.
+        std::call_once(m_factoryOnce, [this]()
+        {
+            const HRESULT hr = CoCreateInstance(
+                CLSID_WICImagingFactory,
+                nullptr,
+                CLSCTX_INPROC_SERVER,
+                IID_PPV_ARGS(&m_factory));
+            if (FAILED(hr))
+            {
+                FD2D_LOG_WARN("[ImagePipeline] WIC factory creation failed hr=0x{:08X}", static_cast<unsigned>(hr));
+            }
+        });
+        return m_factory.Get();
+    }
+
+    Microsoft::WRL::ComPtr<IWICBitmapFrameDecode> WicImageDecoder::OpenFrame(
+        const std::wstring& source,
+        Microsoft::WRL::ComPtr<IWICBitmapDecoder>& decoder)
+    {
+        IWICImagingFactory* factory = Factory();
+        if (!factory)
+        {
+            return nullptr;
+        }
+
+        HRESULT hr = factory->CreateDecoderFromFilename(
+            source.c_str(),
+            nullptr,
+            GENERIC_READ,
+            WICDecodeMetadataCacheOnDemand,
+            &decoder);
+        if (FAILED(hr))
+        {
+            return nullptr;
+        }
+
+        Microsoft::WRL::ComPtr<IWICBitmapFrameDecode> frame;
+        hr = decoder->GetFrame(0, &frame);
+        if (FAILED(hr))
+        {
+            return nullptr;
+        }
+        return frame;
+    }
+
+    bool WicImageDecoder::CopyConverted(
+        IWICBitmapSource* source,
+        const std::atomic<bool>& cancelled,
+        DecodedImage& out)
+    {
+        IWICImagingFactory* factory = Factory();
+        if (!factory || !source)
+        {
+            return false;
+        }
+
+        Microsoft::WRL::ComPtr<IWICFormatConverter> converter;
+        HRESULT hr = factory->CreateFormatConverter(&converter);
+        if (SUCCEEDED(hr))
+        {
+            hr = converter->Initialize(
+                source,
+                GUID_WICPixelFormat32bppPBGRA,
+                WICBitmapDitherTypeNone,
+                nullptr,
+                0.0,
+                WICBitmapPaletteTypeMedianCut);
+        }
+        if (FAILED(hr))
+        {
+            return false;
+        }
+
+        UINT width = 0;
+        UINT height = 0;
+        hr = converter->GetSize(&width, &height);
+        if (FAILED(hr) || width == 0 || height == 0 ||
+            width > (std::numeric_limits<std::uint32_t>::max)() / 4)
+        {
+            return false;
+        }
+
+        const std::uint32_t stride = width * 4;
+        out.width = width;
+        out.height = height;
+        out.stride = stride;
+        out.pixels.resize(static_cast<std::size_t>(stride) * height);
+
+        // Convert in bands so a cancel (image scrolled away) stops a large
+        // decode early instead of finishing it for nothing.
+        constexpr UINT kBandRows = 256;
+        for (UINT y = 0; y < height; y += kBandRows)
+        {
+            if (cancelled.load())
+            {
+                out = DecodedImage {};
+                return false;
+            }
+
+            const UINT rows = (std::min)(kBandRows, height - y);
+            const WICRect band { 0, static_cast<INT>(y), static_cast<INT>(width), static_cast<INT>(rows) };
+            hr = converter->CopyPixels(
+                &band,
+                stride,
+                stride * rows,
+                out.pixels.data() + static_cast<std::size_t>(y) * stride);
+            if (FAILED(hr))
+            {
+                out = DecodedImage {};
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool WicImageDecoder::Decode(
+        const std::wstring& source,
+        const std::atomic<bool>& cancelled,
+        DecodedImage& out)
+    {
+        if (cancelled.load())
+        {
+            return false;
+        }
+
+        Microsoft::WRL::ComPtr<IWICBitmapDecoder> decoder;
+        auto frame = OpenFrame(source, decoder);
+        if (!frame || cancelled.load())
+        {
+            return false;
+        }
+        return CopyConverted(frame.Get(), cancelled, out);
+    }
+
+    bool WicImageDecoder::DecodePreview(
+        const std::wstring& source,
+        const std::atomic<bool>& cancelled,
+        DecodedImage& out)
+    {
+        if (cancelled.load())
+        {
+            return false;
+        }
+
+        Microsoft::WRL::ComPtr<IWICBitmapDecoder> decoder;
+        auto frame = OpenFrame(source, decoder);
+        if (!frame)
+        {
+            return false;
+        }
+
+        UINT width = 0;
+        UINT height = 0;
+        if (FAILED(frame->GetSize(&width, &height)) || (std::max)(width, height) < kPreviewMinEdge)
+        {
+            // Small images decode fast enough that a preview only adds work.
+            return false;
+        }
+
+        Microsoft::WRL::ComPtr<IWICBitmapSource> preview;
+
+        // DDS: pick the first mip level whose long edge fits the preview size.
+        Microsoft::WRL::ComPtr<IWICDdsDecoder> dds;
+        if (SUCCEEDED(decoder.As(&dds)))
+        {
+            WICDdsParameters parameters {};
+            if (SUCCEEDED(dds->GetParameters(&parameters)) && parameters.MipLevels > 1)
+            {
+                UINT level = 0;
+                UINT edge = (std::max)(width, height);
+                while (level + 1 < parameters.MipLevels && edge > kPreviewTargetEdge)
+                {
+                    edge = (std::max)(1u, edge / 2);
+                    ++level;
+                }
+
+                Microsoft::WRL::ComPtr<IWICBitmapFrameDecode> mip;
+                if (level > 0 && SUCCEEDED(dds->GetFrame(0, level, 0, &mip)))
+                {
+                    preview = mip;
+                }
+            }
+        }
+
+        // Embedded thumbnail (EXIF and friends): essentially free to decode.
+        if (!preview)
+        {
+            Microsoft::WRL::ComPtr<IWICBitmapSource> thumbnail;
+            UINT thumbWidth = 0;
+            UINT thumbHeight = 0;
+            if (SUCCEEDED(frame->GetThumbnail(&thumbnail)) &&
+                SUCCEEDED(thumbnail->GetSize(&thumbWidth, &thumbHeight)) &&
+                thumbWidth > 0 && thumbHeight > 0)
+            {
+                // Reject letterboxed thumbnails whose aspect does not match.
+                const double sourceAspect = static_cast<double>(width) / static_cast<double>(height);
+                const double thumbAspect = static_cast<double>(thumbWidth) / static_cast<double>(thumbHeight);
+                if (std::abs(sourceAspect - thumbAspect) <= sourceAspect * 0.02)
+                {
+                    preview = thumbnail;
+                }
+            }
+        }
+
+        // Codecs with native scaling (JPEG IDCT scaling): a scaler on top of
+        // the frame lets WIC decode straight at the reduced size.
+        if (!preview && !cancelled.load())
+        {
+            Microsoft::WRL::ComPtr<IWICBitmapSourceTransform> transform;
+            UINT scaledWidth = (std::max)(1u, width / 8);
+            UINT scaledHeight = (std::max)(1u, height / 8);
+            if (SUCCEEDED(frame.As(&transform)) &&
+                SUCCEEDED(transform->GetClosestSize(&scaledWidth, &scaledHeight)) &&
+                scaledWidth < width && scaledHeight < height)
+            {
+                Microsoft::WRL::ComPtr<IWICBitmapScaler> scaler;
+                if (SUCCEEDED(Factory()->CreateBitmapScaler(&scaler)) &&
+                    SUCCEEDED(scaler->Initialize(
+                        frame.Get(),
+                        scaledWidth,
+                        scaledHeight,
+                        WICBitmapInterpolationModeNearestNeighbor)))
+                {
+                    preview = scaler;
+                }
+            }
+        }
+
+        if (!preview || cancelled.load() || !CopyConverted(preview.Get(), cancelled, out))
+        {
+            return false;
+        }
+
+        out.sourceWidth = width;
+        out.sourceHeight = height;
+        out.preview = true;
+        return true;
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "ImagePipeline.h"
+#include <windows.h>
+#include <wincodec.h>
+#include <wrl/client.h>
+#include <mutex>
+
+namespace FD2D
+{
+    // ImageDecoder backed by WIC: decodes frame 0 of any WIC-supported file
+    // into 32bpp premultiplied BGRA. Worker threads join the MTA.
+    //
+    // Previews (large images only) come from, in order of preference: a small
+    // DDS mip level, the embedded (EXIF) thumbnail, or a reduced-size decode
+    // for codecs that scale natively (JPEG 1/2..1/8 IDCT scaling).
+    class WicImageDecoder : public ImageDecoder
+    {
+    public:
+        void OnWorkerThreadStart() override;
+        void OnWorkerThreadStop() override;
+
+        bool Decode(
+            const std::wstring& source,
+            const std::atomic<bool>& cancelled,
+            DecodedImage& out) override;
+
+        bool DecodePreview(
+            const std::wstring& source,
+            const std::atomic<bool>& cancelled,
+            DecodedImage& out) override;
+
+    private:
+        IWICImagingFactory* Factory();
+        Microsoft::WRL::ComPtr<IWICBitmapFrameDecode> OpenFrame(
+            const std::wstring& source,
+            Microsoft::WRL::ComPtr<IWICBitmapDecoder>& decoder);
+        bool CopyConverted(
+            IWICBitmapSource* source,
+            const std::atomic<bool>& cancelled,
+            DecodedImage& out);
+
+        std::once_flag m_factoryOnce {};
+        Microsoft::WRL::ComPtr<IWICImagingFactory> m_factory {};
+    };
+}
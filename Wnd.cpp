@@ -1,23 +1,126 @@
 #include "Wnd.h"
 #include "Backplate.h"
+#include "ParallelMeasure.h"
 #include "Util.h"
 #include <algorithm>
 
 namespace FD2D
 {
+    namespace
+    {
+        // Subtrees smaller than this are measured inline: a task costs more
+        // than measuring a few dozen controls.
+        constexpr std::size_t kParallelMeasureMinNodes = 64;
+
+        bool WorthForking(const Wnd& node)
+        {
+            return node.SubtreeNodeCount() >= kParallelMeasureMinNodes;
+        }
+    }
+
     // Note: LayoutRect() returns coordinates in client coordinate system (Backplate client area)
     // Since all LayoutRects are in the same client coordinate system, no conversion is needed
     // Parent Wnd and Child Wnd both receive coordinates in client/Layout coordinate system
 
+    std::size_t ChildNameIndex::Find(const std::vector<std::shared_ptr<Wnd>>& children, NameId id) const
+    {
+        if (id == kNoName)
+        {
+            return npos;
+        }
+
+        if (children.size() < kMinIndexedChildren)
+        {
+            for (std::size_t i = 0; i < children.size(); ++i)
+            {
+                if (children[i] && children[i]->Id() == id)
+                {
+                    return i;
+                }
+            }
+            return npos;
+        }
+
+        if (!m_map)
+        {
+            m_map = std::make_unique<std::unordered_map<NameId, std::size_t>>();
+            m_map->reserve(children.size());
+            for (std::size_t i = 0; i < children.size(); ++i)
+            {
+                if (children[i])
+                {
+                    m_map->emplace(children[i]->Id(), i);
+                }
+            }
+        }
+
+        const auto it = m_map->find(id);
+        return (it != m_map->end()) ? it->second : npos;
+    }
+
+    const ChildNameIndex::NameMap& ChildNameIndex::ByName(const std::vector<std::shared_ptr<Wnd>>& children) const
+    {
+        if (!m_byName)
+        {
+            m_byName = std::make_unique<NameMap>();
+            m_byName->reserve(children.size());
+            for (const auto& child : children)
+            {
+                if (child)
+                {
+                    m_byName->emplace(child->Name(), child);
+                }
+            }
+        }
+        return *m_byName;
+    }
+
+    void ChildNameIndex::NoteAppended(const std::vector<std::shared_ptr<Wnd>>& children)
+    {
+        if (children.empty() || !children.back())
+        {
+            return;
+        }
+        if (m_map)
+        {
+            m_map->emplace(children.back()->Id(), children.size() - 1);
+        }
+        if (m_byName)
+        {
+            m_byName->emplace(children.back()->Name(), children.back());
+        }
+    }
+
+    std::pmr::memory_resource* WndPool()
+    {
+        // Deliberately leaked: controls may still be released during static
+        // destruction.
+        static std::pmr::synchronized_pool_resource* s_pool = new std::pmr::synchronized_pool_resource();
+        return s_pool;
+    }
+
     Wnd::Wnd()
     {
     }
 
     Wnd::Wnd(const std::wstring& name)
-        : m_name(name)
+        : m_nameId(NameInterner::Global().Intern(name))
     {
     }
 
+    Wnd::~Wnd()
+    {
+        m_lifetime.Cancel();
+        // Children that outlive this control must not point back at it.
+        for (auto& child : m_childrenOrdered)
+        {
+            if (child && child->m_parent == this)
+            {
+                child->m_parent = nullptr;
+            }
+        }
+    }
+
     void Wnd::SetLayoutRect(const D2D1_RECT_F& rect)
     {
         m_layoutDesired = rect;
@@ -48,21 +151,26 @@ namespace FD2D
         }
 
         // If there are children, use the maximum size among them
+        std::pmr::vector<Size> sizes(m_childrenOrdered.size(), Size {}, ScratchMemory());
+        MeasureChildren(m_childrenOrdered.data(), m_childrenOrdered.size(), available, sizes.data());
         Size maxSize {};
-        for (auto& child : m_childrenOrdered)
+        for (const Size& childSize : sizes)
         {
-            if (child)
-            {
-                Size childSize = child->Measure(available);
-                maxSize.w = (std::max)(maxSize.w, childSize.w);
-                maxSize.h = (std::max)(maxSize.h, childSize.h);
-            }
+            maxSize.w = (std::max)(maxSize.w, childSize.w);
+            maxSize.h = (std::max)(maxSize.h, childSize.h);
         }
 
         m_desired = { maxSize.w + 2 * m_margin, maxSize.h + 2 * m_margin };
         return m_desired;
     }
 
+    bool Wnd::MeasureUnchanged(const Size& last, Size available) const
+    {
+        UNREFERENCED_PARAMETER(last);
+        UNREFERENCED_PARAMETER(available);
+        return false;
+    }
+
     Size Wnd::MinSize() const
     {
         // Default: if no children, no intrinsic minimum.
@@ -166,12 +274,12 @@ namespace FD2D
 
     void Wnd::SetName(const std::wstring& name)
     {
-        m_name = name;
+        m_nameId = NameInterner::Global().Intern(name);
     }
 
     const std::wstring& Wnd::Name() const
     {
-        return m_name;
+        return NameInterner::Global().NameOf(m_nameId);
     }
 
     bool Wnd::AddChild(const std::shared_ptr<Wnd>& child)
@@ -181,20 +289,37 @@ namespace FD2D
             return false;
         }
 
-        const std::wstring& childName = child->Name();
+        // One parent at a time (the subtree counts depend on it): move a
+        // child by removing it from its old parent first. Adding an ancestor
+        // would make a cycle.
+        if (child->m_parent != nullptr)
+        {
+            return false;
+        }
+        for (const Wnd* ancestor = this; ancestor != nullptr; ancestor = ancestor->m_parent)
+        {
+            if (ancestor == child.get())
+            {
+                return false;
+            }
+        }
+
+        const NameId childId = child->Id();
 
-        if (childName.empty())
+        if (childId == kNoName)
         {
             return false;
         }
 
-        if (m_children.find(childName) != m_children.end())
+        if (m_childIndex.Find(m_childrenOrdered, childId) != ChildNameIndex::npos)
         {
             return false;
         }
 
-        m_children.emplace(childName, child);
         m_childrenOrdered.push_back(child);
+        m_childIndex.NoteAppended(m_childrenOrdered);
+        child->m_parent = this;
+        AdjustSubtreeNodes(static_cast<std::ptrdiff_t>(child->m_subtreeNodes));
 
         if (m_backplate != nullptr)
         {
@@ -206,35 +331,42 @@ namespace FD2D
 
     bool Wnd::RemoveChild(const std::wstring& childName)
     {
-        if (childName.empty())
-        {
-            return false;
-        }
+        return RemoveChild(NameInterner::Global().Find(childName));
+    }
 
-        auto it = m_children.find(childName);
-        if (it == m_children.end())
+    bool Wnd::RemoveChild(NameId childId)
+    {
+        const std::size_t index = m_childIndex.Find(m_childrenOrdered, childId);
+        if (index == ChildNameIndex::npos)
         {
             return false;
         }
 
-        std::shared_ptr<Wnd> child = it->second;
+        std::shared_ptr<Wnd> child = m_childrenOrdered[index];
 
         if (child && m_backplate != nullptr)
         {
             child->OnDetached();
         }
 
-        m_children.erase(it);
-
-        for (auto vit = m_childrenOrdered.begin(); vit != m_childrenOrdered.end(); ++vit)
+        // OnDetached may have changed the list (removed or moved the child,
+        // or added another under the same name): erase this child wherever
+        // it is now, and report whether it was still here.
+        auto it = (index < m_childrenOrdered.size() && m_childrenOrdered[index] == child)
+            ? m_childrenOrdered.begin() + static_cast<std::ptrdiff_t>(index)
+            : std::find(m_childrenOrdered.begin(), m_childrenOrdered.end(), child);
+        m_childIndex.Invalidate();
+        if (it == m_childrenOrdered.end())
         {
-            if (*vit && (*vit)->Name() == childName)
-            {
-                m_childrenOrdered.erase(vit);
-                break;
-            }
+            return false;
         }
 
+        m_childrenOrdered.erase(it);
+        if (child)
+        {
+            child->m_parent = nullptr;
+            AdjustSubtreeNodes(-static_cast<std::ptrdiff_t>(child->m_subtreeNodes));
+        }
         return true;
     }
 
@@ -251,47 +383,102 @@ namespace FD2D
             }
         }
 
-        m_children.clear();
+        std::size_t removed = 0;
+        for (auto& child : m_childrenOrdered)
+        {
+            if (child)
+            {
+                child->m_parent = nullptr;
+                removed += child->m_subtreeNodes;
+            }
+        }
         m_childrenOrdered.clear();
+        m_childIndex.Invalidate();
+        AdjustSubtreeNodes(-static_cast<std::ptrdiff_t>(removed));
+    }
+
+    void Wnd::AdjustSubtreeNodes(std::ptrdiff_t delta)
+    {
+        for (Wnd* node = this; node != nullptr; node = node->m_parent)
+        {
+            node->m_subtreeNodes = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(node->m_subtreeNodes) + delta);
+        }
     }
 
     bool Wnd::ReorderChildren(const std::vector<std::wstring>& childNamesInOrder)
     {
-        std::unordered_map<std::wstring, bool> seen;
-        seen.reserve(childNamesInOrder.size());
+        std::vector<NameId> ids;
+        ids.reserve(childNamesInOrder.size());
+        for (const auto& childName : childNamesInOrder)
+        {
+            ids.push_back(NameInterner::Global().Find(childName));
+        }
+        return ReorderChildren(ids);
+    }
 
+    bool Wnd::ReorderChildren(const std::vector<NameId>& childIdsInOrder)
+    {
+        // More ids than children means a duplicate or an unknown one.
+        if (childIdsInOrder.size() > m_childrenOrdered.size())
+        {
+            return false;
+        }
+
+        // Each current position may be taken once.
+        std::vector<bool> taken(m_childrenOrdered.size(), false);
         std::vector<std::shared_ptr<Wnd>> newOrder;
-        newOrder.reserve(childNamesInOrder.size());
+        newOrder.reserve(m_childrenOrdered.size());
 
-        for (const auto& childName : childNamesInOrder)
+        for (const NameId childId : childIdsInOrder)
         {
-            if (childName.empty())
+            const std::size_t index = m_childIndex.Find(m_childrenOrdered, childId);
+            if (index == ChildNameIndex::npos || taken[index])
             {
                 return false;
             }
+            taken[index] = true;
+            newOrder.push_back(m_childrenOrdered[index]);
+        }
 
-            if (seen.find(childName) != seen.end())
-            {
-                return false;
-            }
-            seen.emplace(childName, true);
-
-            auto it = m_children.find(childName);
-            if (it == m_children.end())
+        // The ordered list is the only storage: children left out stay, in
+        // their current relative order, behind the listed ones.
+        for (std::size_t i = 0; i < m_childrenOrdered.size(); ++i)
+        {
+            if (!taken[i])
             {
-                return false;
+                newOrder.push_back(m_childrenOrdered[i]);
             }
-
-            newOrder.push_back(it->second);
         }
 
         m_childrenOrdered = std::move(newOrder);
+        m_childIndex.Invalidate();
         return true;
     }
 
-    const std::unordered_map<std::wstring, std::shared_ptr<Wnd>>& Wnd::Children() const
+    std::shared_ptr<Wnd> Wnd::FindChild(const std::wstring& childName) const
+    {
+        return FindChild(NameInterner::Global().Find(childName));
+    }
+
+    std::shared_ptr<Wnd> Wnd::FindChild(NameId childId) const
+    {
+        const std::size_t index = m_childIndex.Find(m_childrenOrdered, childId);
+        return (index != ChildNameIndex::npos) ? m_childrenOrdered[index] : nullptr;
+    }
+
+    bool Wnd::HasChild(const std::wstring& childName) const
+    {
+        return HasChild(NameInterner::Global().Find(childName));
+    }
+
+    bool Wnd::HasChild(NameId childId) const
     {
-        return m_children;
+        return m_childIndex.Find(m_childrenOrdered, childId) != ChildNameIndex::npos;
+    }
+
+    const ChildNameIndex::NameMap& Wnd::Children() const
+    {
+        return m_childIndex.ByName(m_childrenOrdered);
     }
 
     const std::vector<std::shared_ptr<Wnd>>& Wnd::ChildrenInOrder() const
@@ -316,6 +503,7 @@ namespace FD2D
         if (m_backplate != nullptr)
         {
             m_backplate->ClearFocusIf(this);
+            m_backplate->Animations().StopAll(this);
         }
 
         for (auto& child : m_childrenOrdered)
@@ -327,6 +515,8 @@ namespace FD2D
         }
 
         m_backplate = nullptr;
+        m_lifetime.Cancel();
+        m_lifetime = CancellationSource {};
     }
 
     void Wnd::OnGraphicsInvalidated(GraphicsInvalidationReason reason, const GraphicsGeneration& generation)
@@ -344,9 +534,16 @@ namespace FD2D
     {
         UNREFERENCED_PARAMETER(target);
 
+        // On damage-only frames, skip children (and their subtrees) that the
+        // current transform puts outside the damage.
+        D2D1_MATRIX_3X2_F toRender = D2D1::Matrix3x2F::Identity();
+        if (target)
+        {
+            target->GetTransform(&toRender);
+        }
         for (auto& child : m_childrenOrdered)
         {
-            if (child)
+            if (child && !(m_backplate && target && m_backplate->OutsideRenderDamage(child->LayoutRect(), &toRender)))
             {
                 child->OnRender(target);
             }
@@ -382,7 +579,7 @@ namespace FD2D
 
         for (auto& child : m_childrenOrdered)
         {
-            if (child)
+            if (child && !(m_backplate && m_backplate->OutsideRenderDamage(child->LayoutRect())))
             {
                 child->OnRenderD3D(context);
             }
@@ -623,6 +820,50 @@ namespace FD2D
         return m_backplate;
     }
 
+    std::pmr::memory_resource* Wnd::ScratchMemory() const
+    {
+        // The Backplate's scratch arena is UI-thread only.
+        if (m_backplate == nullptr || ParallelMeasure::InForkedMeasure())
+        {
+            return std::pmr::get_default_resource();
+        }
+        return &m_backplate->ScratchArena();
+    }
+
+    Executor* Wnd::ParallelMeasureExecutor() const
+    {
+        if (m_backplate != nullptr && m_backplate->ParallelLayout())
+        {
+            return m_backplate->GetExecutor().get();
+        }
+        return nullptr;
+    }
+
+    void Wnd::MeasureChildren(const std::shared_ptr<Wnd>* children, std::size_t count, Size available, Size* out) const
+    {
+        MeasureIndependent(ParallelMeasureExecutor(), children, count, &available, 0, out);
+    }
+
+    void Wnd::MeasureChildren(const std::shared_ptr<Wnd>* children, std::size_t count, const Size* available, Size* out) const
+    {
+        MeasureIndependent(ParallelMeasureExecutor(), children, count, available, 1, out);
+    }
+
+    void Wnd::MeasureIndependent(Executor* executor, const std::shared_ptr<Wnd>* children,
+                                 std::size_t count, const Size* available, std::size_t availableStride,
+                                 Size* out)
+    {
+        // Each child writes only its own subtree and its own out slot.
+        ParallelMeasure::Run(
+            executor,
+            count,
+            [children](std::size_t i) { return children[i] && WorthForking(*children[i]); },
+            [children, available, availableStride, out](std::size_t i)
+            {
+                out[i] = children[i] ? children[i]->Measure(available[i * availableStride]) : Size {};
+            });
+    }
+
     void Wnd::Invalidate() const
     {
         if (m_backplate == nullptr)
@@ -4,15 +4,20 @@
 #define NOMINMAX
 #endif
 #include "Layout.h"
+#include "Executor.h"
+#include "NameInterner.h"
 #include <windows.h>
 #include <d2d1.h>
 #include <dwrite.h>
 #include <d3d11_1.h>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <memory_resource>
 #include <unordered_map>
 #include <vector>
 #include <string>
+#include <utility>
 
 namespace FD2D
 {
@@ -114,22 +119,70 @@ namespace FD2D
         LPARAM lParam { 0 };
     };
 
+    class Wnd;
+
+    // Name lookup over a child list stored once, in order, in a vector.
+    // Small lists are scanned; from kMinIndexedChildren on, a name -> position
+    // map is built on the first lookup, kept up to date by appends and dropped
+    // by any other mutation, so nodes nobody searches by name pay nothing.
+    // Keys are interned names (Wnd::Id), so neither path touches strings.
+    // The string-keyed map behind Wnd::Children() is built the same way, only
+    // for callers that ask for it.
+    class ChildNameIndex
+    {
+    public:
+        using NameMap = std::unordered_map<std::wstring, std::shared_ptr<Wnd>>;
+
+        static constexpr std::size_t npos = ~static_cast<std::size_t>(0);
+        static constexpr std::size_t kMinIndexedChildren = 16;
+
+        std::size_t Find(const std::vector<std::shared_ptr<Wnd>>& children, NameId id) const;
+        const NameMap& ByName(const std::vector<std::shared_ptr<Wnd>>& children) const;
+        // `children` just had one entry appended.
+        void NoteAppended(const std::vector<std::shared_ptr<Wnd>>& children);
+        void Invalidate()
+        {
+            m_map.reset();
+            m_byName.reset();
+        }
+
+    private:
+        mutable std::unique_ptr<std::unordered_map<NameId, std::size_t>> m_map {};
+        mutable std::unique_ptr<NameMap> m_byName {};
+    };
+
     class Wnd : public std::enable_shared_from_this<Wnd>
     {
     public:
         Wnd();
         explicit Wnd(const std::wstring& name);
-        virtual ~Wnd() = default;
+        virtual ~Wnd();
 
+        // Names are interned (NameInterner): the control stores the id, and
+        // child lookup and reordering compare ids. Name() is for diagnostics
+        // and for callers that only have the string.
         void SetName(const std::wstring& name);
         const std::wstring& Name() const;
+        NameId Id() const { return m_nameId; }
 
         void Invalidate() const;
 
         void SetLayoutRect(const D2D1_RECT_F& rect);
         void SetAnchors(bool anchorLeft, bool anchorTop, bool anchorRight, bool anchorBottom);
         const D2D1_RECT_F& LayoutRect() const;
+        // Measure contract. With Backplate::SetParallelLayout on, a container
+        // may measure sibling subtrees concurrently on the window's executor,
+        // so Measure must only write state of this control's own subtree
+        // (m_desired, caches of its own content), may read shared thread-safe
+        // services (the shared DWrite factory), and must not call Invalidate,
+        // RequestLayout or anything else on the Backplate. Measure must not
+        // depend on which thread runs it or on sibling measure order.
         virtual Size Measure(Size available);
+        // True when Measure(available) would return `last` again, so a
+        // container may keep the size it cached for this control instead of
+        // measuring it. Controls override it only where the answer is cheap
+        // and exact; the default (false) always re-measures.
+        virtual bool MeasureUnchanged(const Size& last, Size available) const;
         // Upward constraint: intrinsic minimum size requested by this control.
         // Default implementation aggregates children; containers can override.
         virtual Size MinSize() const;
@@ -152,19 +205,45 @@ namespace FD2D
         AlignH ContentAlignH() const { return m_contentAlignH; }
         AlignV ContentAlignV() const { return m_contentAlignV; }
 
+        // Returns false for a null or unnamed child, a name already in use,
+        // a child that still has a parent, or this control's own ancestor.
         bool AddChild(const std::shared_ptr<Wnd>& child);
+        // True when the child was removed. False when there is no such child,
+        // or when its OnDetached already took it out of this control.
         bool RemoveChild(const std::wstring& childName);
+        bool RemoveChild(NameId childId);
         void ClearChildren();
         // Reorders the visual child iteration order without detaching/attaching children.
-        // Returns false if any name is missing or duplicated; on failure, order is unchanged.
+        // The listed children come first, in the given order; children left
+        // out keep their relative order behind them. Returns false if any
+        // name is empty, unknown or listed twice; on failure, order is unchanged.
         bool ReorderChildren(const std::vector<std::wstring>& childNamesInOrder);
-        const std::unordered_map<std::wstring, std::shared_ptr<Wnd>>& Children() const;
+        bool ReorderChildren(const std::vector<NameId>& childIdsInOrder);
+        // Direct child with this name, or nullptr.
+        std::shared_ptr<Wnd> FindChild(const std::wstring& childName) const;
+        std::shared_ptr<Wnd> FindChild(NameId childId) const;
+        bool HasChild(const std::wstring& childName) const;
+        bool HasChild(NameId childId) const;
+        // Children by name, for code written against the old map storage.
+        // The map is built on first use and dropped by any change to the
+        // child list, so prefer FindChild and ChildrenInOrder.
+        const ChildNameIndex::NameMap& Children() const;
         // Deterministic child iteration order (insertion order).
         // Many panels assume child iteration order defines visual order.
         const std::vector<std::shared_ptr<Wnd>>& ChildrenInOrder() const;
+        // Controls in this subtree, this one included. Kept up to date by
+        // AddChild/RemoveChild/ClearChildren on every ancestor, so it costs
+        // nothing to read (parallel measure uses it to pick what to fork).
+        // A control has at most one parent at a time.
+        std::size_t SubtreeNodeCount() const { return m_subtreeNodes; }
 
         virtual void OnAttached(Backplate& backplate);
         virtual void OnDetached();
+        // Cancelled when this control is detached (or destroyed). Pass it with
+        // background work done for the control (Executor::Submit) so queued
+        // work is dropped and running work can bail out; a re-attached control
+        // hands out a fresh token.
+        CancellationToken LifetimeToken() const { return m_lifetime.Token(); }
         // Graphics device/target/renderer recreation. Default forwards to children.
         // App controls should drop stale GPU handles here and recreate on the next render.
         virtual void OnGraphicsInvalidated(GraphicsInvalidationReason reason, const GraphicsGeneration& generation);
@@ -212,6 +291,20 @@ namespace FD2D
 
     protected:
         Backplate* BackplateRef() const;
+        // Per-frame scratch memory for layout/render temporaries
+        // (std::pmr containers): the Backplate's FrameArena while attached,
+        // the default heap otherwise. Never keep it past the current call.
+        // Inside a concurrent measure (see MeasureChildren) it is always the
+        // default heap.
+        std::pmr::memory_resource* ScratchMemory() const;
+        // Measures children[0..count) against the same `available` size into
+        // out[0..count) (a null child measures as 0x0). For children that are
+        // measured independently of each other: with parallel layout on, the
+        // ones with large subtrees are forked onto the executor, and the
+        // results are the same as measuring them one after another.
+        void MeasureChildren(const std::shared_ptr<Wnd>* children, std::size_t count, Size available, Size* out) const;
+        // Same, with child i measured against available[i].
+        void MeasureChildren(const std::shared_ptr<Wnd>* children, std::size_t count, const Size* available, Size* out) const;
 
         // LayoutRect() as an FD2D::Rect (x/y/w/h).
         Rect BoundsRect() const;
@@ -229,10 +322,17 @@ namespace FD2D
         virtual bool RouteChildOverlayInput(const InputEvent& event, OverlayLayer layer);
 
     protected:
-        std::wstring m_name {};
+        NameId m_nameId { kNoName };
         Backplate* m_backplate { nullptr };
-        std::unordered_map<std::wstring, std::shared_ptr<Wnd>> m_children {};
+        CancellationSource m_lifetime {};
+        // Children are stored once, in visual order; m_childIndex answers
+        // lookups by name. Removal finds the position through the index but
+        // still shifts the tail, since the order is the visual order; a
+        // swap-with-last removal would reorder siblings. It stays a plain
+        // std::vector (no inline buffer) because ChildrenInOrder hands out a
+        // reference to it, and an empty one does not allocate.
         std::vector<std::shared_ptr<Wnd>> m_childrenOrdered {};
+        ChildNameIndex m_childIndex {};
         D2D1_RECT_F m_layoutDesired { 0.0f, 0.0f, 100.0f, 30.0f };
         D2D1_RECT_F m_layoutRect { 0.0f, 0.0f, 100.0f, 30.0f };
         Rect m_bounds { 0.0f, 0.0f, 100.0f, 30.0f };
@@ -246,6 +346,35 @@ namespace FD2D
         Thickness m_contentMargin {};
         AlignH m_contentAlignH { AlignH::Start };
         AlignV m_contentAlignV { AlignV::Start };
+
+    private:
+        friend class Backplate;
+
+        // MeasureChildren with the executor picked by the caller (nullptr =
+        // measure in order on this thread); Backplate uses it for its
+        // top-level controls. Child i gets available[i * availableStride].
+        static void MeasureIndependent(Executor* executor, const std::shared_ptr<Wnd>* children,
+                                       std::size_t count, const Size* available, std::size_t availableStride,
+                                       Size* out);
+        Executor* ParallelMeasureExecutor() const;
+        // Adds `delta` to the node count of this control and its ancestors.
+        void AdjustSubtreeNodes(std::ptrdiff_t delta);
+
+        Wnd* m_parent { nullptr };
+        std::size_t m_subtreeNodes { 1 };
     };
+
+    // Optional pooled allocation for controls. MakeWnd<T>(args...) is
+    // make_shared from size-class pools shared by all controls, so trees of
+    // thousands of same-sized nodes are packed into slabs instead of being
+    // scattered over the general heap. Thread-safe; the pool lives for the
+    // whole process.
+    std::pmr::memory_resource* WndPool();
+
+    template <typename T, typename... Args>
+    std::shared_ptr<T> MakeWnd(Args&&... args)
+    {
+        return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>(WndPool()), std::forward<Args>(args)...);
+    }
 }
 
@@ -0,0 +1,304 @@
+#include "LayoutBench.h"
+#include "DockPanel.h"
+#include "DynamicPanel.h"
+#include "GridPanel.h"
+#include "ScrollView.h"
+#include "SplitPanel.h"
+#include "StackPanel.h"
+#include "Text.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace FD2D
+{
+    namespace
+    {
+        struct BenchTree
+        {
+            std::shared_ptr<Wnd> root {};
+            // Leaves in creation order; the leaf pass edits the middle one.
+            std::vector<std::shared_ptr<Text>> leaves {};
+        };
+
+        std::shared_ptr<Text> MakeLeaf(BenchTree& tree)
+        {
+            const std::size_t index = tree.leaves.size();
+            auto leaf = std::make_shared<Text>(L"leaf" + std::to_wstring(index));
+            leaf->SetFont(L"Segoe UI", 14.0f);
+            leaf->SetText(LayoutBenchLeafText(index));
+            tree.leaves.push_back(leaf);
+            return leaf;
+        }
+
+        std::wstring PanelName(const wchar_t* kind, std::size_t index)
+        {
+            return std::wstring(kind) + std::to_wstring(index);
+        }
+
+        // Rows of four labels.
+        BenchTree BuildStack(std::size_t leaves)
+        {
+            BenchTree tree;
+            auto root = std::make_shared<StackPanel>(L"stack", Orientation::Vertical);
+            for (std::size_t row = 0; tree.leaves.size() < leaves; ++row)
+            {
+                auto line = std::make_shared<StackPanel>(PanelName(L"row", row), Orientation::Horizontal);
+                for (int i = 0; i < 4 && tree.leaves.size() < leaves; ++i)
+                {
+                    line->AddChild(MakeLeaf(tree));
+                }
+                root->AddChild(line);
+            }
+            tree.root = root;
+            return tree;
+        }
+
+        // A table: a title spanning every column, then auto-sized cells with
+        // the last column taking the remaining width.
+        BenchTree BuildGrid(std::size_t leaves)
+        {
+            constexpr int kColumns = 10;
+            BenchTree tree;
+            auto root = std::make_shared<GridPanel>(L"grid");
+
+            std::vector<GridLength> columns(kColumns, GridLength { GridLength::Type::Auto, 0.0f });
+            columns.back() = GridLength { GridLength::Type::Star, 1.0f };
+            root->SetColumns(columns);
+
+            auto title = MakeLeaf(tree);
+            root->AddChild(title);
+            root->SetChildCell(title, 0, 0, kColumns, 1);
+
+            int row = 1;
+            for (int col = 0; tree.leaves.size() < leaves; ++col)
+            {
+                if (col == kColumns)
+                {
+                    col = 0;
+                    ++row;
+                }
+                auto cell = MakeLeaf(tree);
+                root->AddChild(cell);
+                root->SetChildCell(cell, col, row);
+            }
+            root->SetRows(std::vector<GridLength>(static_cast<std::size_t>(row) + 1, GridLength { GridLength::Type::Auto, 0.0f }));
+            tree.root = root;
+            return tree;
+        }
+
+        // Nested docks: each level docks a toolbar, a side list and a status
+        // line around the next level; the innermost one fills with a list.
+        BenchTree BuildDock(std::size_t leaves)
+        {
+            constexpr std::size_t kPerStrip = 16;
+            BenchTree tree;
+
+            const auto strip = [&](const std::wstring& name, Orientation orientation)
+            {
+                auto panel = std::make_shared<StackPanel>(name, orientation);
+                for (std::size_t i = 0; i < kPerStrip && tree.leaves.size() < leaves; ++i)
+                {
+                    panel->AddChild(MakeLeaf(tree));
+                }
+                return panel;
+            };
+            const auto dock = [](const std::shared_ptr<DockPanel>& parent, const std::shared_ptr<Wnd>& child, Dock side)
+            {
+                parent->AddChild(child);
+                parent->SetChildDock(child, side);
+            };
+
+            auto root = std::make_shared<DockPanel>(L"dock0");
+            auto level = root;
+            for (std::size_t depth = 1; tree.leaves.size() < leaves; ++depth)
+            {
+                dock(level, strip(L"top", Orientation::Horizontal), Dock::Top);
+                dock(level, strip(L"left", Orientation::Vertical), Dock::Left);
+                dock(level, strip(L"bottom", Orientation::Horizontal), Dock::Bottom);
+                if (leaves - tree.leaves.size() <= kPerStrip * 3)
+                {
+                    dock(level, strip(L"fill", Orientation::Vertical), Dock::Fill);
+                    break;
+                }
+                auto inner = std::make_shared<DockPanel>(PanelName(L"dock", depth));
+                dock(level, inner, Dock::Fill);
+                level = inner;
+            }
+            tree.root = root;
+            return tree;
+        }
+
+        // A wrapping panel of chips, every fourth one flexible, grouped in
+        // nested wrapping sections.
+        BenchTree BuildDynamic(std::size_t leaves)
+        {
+            constexpr std::size_t kPerSection = 40;
+            BenchTree tree;
+            auto root = std::make_shared<DynamicPanel>(L"dynamic");
+            root->SetGaps(8.0f, 6.0f);
+            for (std::size_t section = 0; tree.leaves.size() < leaves; ++section)
+            {
+                auto group = std::make_shared<DynamicPanel>(PanelName(L"section", section));
+                group->SetGaps(4.0f, 4.0f);
+                group->SetJustifyContent(FlexJustify::SpaceBetween);
+                for (std::size_t i = 0; i < kPerSection && tree.leaves.size() < leaves; ++i)
+                {
+                    auto chip = MakeLeaf(tree);
+                    group->AddChild(chip);
+                    if (i % 4 == 0)
+                    {
+                        group->SetChildFlex(chip, 1.0f);
+                    }
+                }
+                root->AddChild(group);
+            }
+            tree.root = root;
+            return tree;
+        }
+
+        // A balanced tree of splits with alternating orientation; each pane
+        // holds a list of labels.
+        BenchTree BuildSplit(std::size_t leaves)
+        {
+            constexpr int kDepth = 5;
+            const std::size_t panes = std::size_t { 1 } << kDepth;
+            const std::size_t perPane = (std::max)(std::size_t { 1 }, leaves / panes);
+            BenchTree tree;
+            std::size_t panelCount = 0;
+
+            std::function<std::shared_ptr<Wnd>(int)> build = [&](int depth) -> std::shared_ptr<Wnd>
+            {
+                if (depth == kDepth)
+                {
+                    auto pane = std::make_shared<StackPanel>(PanelName(L"pane", panelCount++), Orientation::Vertical);
+                    for (std::size_t i = 0; i < perPane; ++i)
+                    {
+                        pane->AddChild(MakeLeaf(tree));
+                    }
+                    return pane;
+                }
+                auto split = std::make_shared<SplitPanel>(PanelName(L"split", panelCount++),
+                    (depth % 2 == 0) ? SplitterOrientation::Horizontal : SplitterOrientation::Vertical);
+                split->SetSplitRatio(0.3f + 0.1f * static_cast<float>(depth % 3));
+                split->SetFirstChild(build(depth + 1));
+                split->SetSecondChild(build(depth + 1));
+                return split;
+            };
+
+            tree.root = build(0);
+            return tree;
+        }
+
+        // A long scrolling list of rows (label + value).
+        BenchTree BuildScroll(std::size_t leaves)
+        {
+            BenchTree tree;
+            auto root = std::make_shared<ScrollView>(L"scroll");
+            auto list = std::make_shared<StackPanel>(L"list", Orientation::Vertical);
+            for (std::size_t row = 0; tree.leaves.size() < leaves; ++row)
+            {
+                auto line = std::make_shared<StackPanel>(PanelName(L"row", row), Orientation::Horizontal);
+                line->AddChild(MakeLeaf(tree));
+                if (tree.leaves.size() < leaves)
+                {
+                    line->AddChild(MakeLeaf(tree));
+                }
+                list->AddChild(line);
+            }
+            root->SetContent(list);
+            tree.root = root;
+            return tree;
+        }
+
+        std::uint64_t CountNodes(const Wnd& wnd)
+        {
+            std::uint64_t count = 1;
+            for (const auto& child : wnd.ChildrenInOrder())
+            {
+                if (child)
+                {
+                    count += CountNodes(*child);
+                }
+            }
+            return count;
+        }
+
+        void LayoutPass(Wnd& root, float width, float height)
+        {
+            (void)root.Measure({ width, height });
+            root.Arrange({ 0.0f, 0.0f, width, height });
+        }
+
+        double TimeUs(const std::function<void()>& pass)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            pass();
+            const auto end = std::chrono::steady_clock::now();
+            return std::chrono::duration<double, std::micro>(end - start).count();
+        }
+
+        void RunTree(const std::string& name, BenchTree tree, const LayoutBenchOptions& options,
+                     std::vector<LayoutBenchResult>& results)
+        {
+            Wnd& root = *tree.root;
+            const std::uint64_t nodes = CountNodes(root);
+            const float width = options.width;
+            const float height = options.height;
+            const int iterations = (std::max)(1, options.iterations);
+
+            // Warm-up: the first pass fills every cache the steady state
+            // relies on.
+            LayoutPass(root, width, height);
+
+            std::vector<double> samples;
+            samples.reserve(static_cast<std::size_t>((std::max)(iterations, options.resizeSteps)));
+            for (int i = 0; i < iterations; ++i)
+            {
+                samples.push_back(TimeUs([&] { LayoutPass(root, width, height); }));
+            }
+            results.push_back(SummarizeLayoutSamples(name + "/full", nodes, samples));
+
+            samples.clear();
+            Text& leaf = *tree.leaves[tree.leaves.size() / 2];
+            for (int i = 0; i < iterations; ++i)
+            {
+                // Alternate between two lengths so every pass sees a change.
+                leaf.SetText(LayoutBenchLeafText(static_cast<std::size_t>(i % 2)));
+                samples.push_back(TimeUs([&] { LayoutPass(root, width, height); }));
+            }
+            results.push_back(SummarizeLayoutSamples(name + "/leaf", nodes, samples));
+
+            samples.clear();
+            const int steps = (std::max)(2, options.resizeSteps);
+            for (int i = 0; i < steps; ++i)
+            {
+                const float t = static_cast<float>(i) / static_cast<float>(steps - 1);
+                const float stepWidth = width * (1.0f - 0.5f * t);
+                samples.push_back(TimeUs([&] { LayoutPass(root, stepWidth, height); }));
+            }
+            results.push_back(SummarizeLayoutSamples(name + "/resize", nodes, samples));
+        }
+    }
+
+    std::vector<LayoutBenchResult> RunLayoutBenchmarks(const LayoutBenchOptions& options)
+    {
+        const std::shared_ptr<TextMetricsProvider> previous = Text::MetricsProvider();
+        Text::SetMetricsProvider(std::make_shared<AdvanceTextMetrics>());
+
+        const std::size_t leaves = (std::max)(options.leaves, std::size_t { 1 });
+        std::vector<LayoutBenchResult> results;
+        RunTree("stack", BuildStack(leaves), options, results);
+        RunTree("grid", BuildGrid(leaves), options, results);
+        RunTree("dock", BuildDock(leaves), options, results);
+        RunTree("dynamic", BuildDynamic(leaves), options, results);
+        RunTree("split", BuildSplit(leaves), options, results);
+        RunTree("scroll", BuildScroll(leaves), options, results);
+
+        Text::SetMetricsProvider(previous);
+        return results;
+    }
+}
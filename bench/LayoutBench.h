@@ -0,0 +1,45 @@
+#pragma once
+
+// LayoutBench.h - synthetic layout benchmarks.
+//
+// RunLayoutBenchmarks (Windows) builds detached trees (no window, device or
+// Backplate) out of StackPanel, GridPanel, DockPanel, DynamicPanel,
+// SplitPanel and ScrollView with Text leaves. RunEngineLayoutBenchmarks
+// (any OS) builds the stack, dynamic and scroll shapes as LayoutEngine trees
+// ("engine/..."), the kinds the engine has. Both time three passes per tree:
+//
+//   <tree>/full    Measure + Arrange of the whole tree;
+//   <tree>/leaf    the same pass right after one leaf's text changed;
+//   <tree>/resize  one pass per width of a sweep from the full width down to
+//                  half of it.
+//
+// Text is sized by AdvanceTextMetrics' built-in tables for the run, so the
+// numbers depend on the layout code only, not on DirectWrite or the fonts
+// installed. Pair with LayoutBenchReport.h to write the results and gate
+// them against a baseline; the engine runs keep a gate on non-Windows CI.
+
+#include "LayoutBenchReport.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace FD2D
+{
+    struct LayoutBenchOptions
+    {
+        // Text leaves per tree (panels come on top).
+        std::size_t leaves { 2000 };
+        int iterations { 30 };
+        int resizeSteps { 48 };
+        float width { 1280.0f };
+        float height { 800.0f };
+    };
+
+    std::vector<LayoutBenchResult> RunLayoutBenchmarks(const LayoutBenchOptions& options = {});
+    std::vector<LayoutBenchResult> RunEngineLayoutBenchmarks(const LayoutBenchOptions& options = {});
+
+    // Label of the index-th leaf; lengths vary so rows and columns do not
+    // all come out the same width.
+    std::wstring LayoutBenchLeafText(std::size_t index);
+}
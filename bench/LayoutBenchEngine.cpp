@@ -0,0 +1,171 @@
+#include "LayoutBench.h"
+#include "LayoutEngine.h"
+#include "TextMetrics.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iterator>
+#include <string>
+
+namespace FD2D
+{
+    std::wstring LayoutBenchLeafText(std::size_t index)
+    {
+        static const wchar_t kWords[] = L"layout measure arrange panel column row dock split scroll wrap grid stack";
+        const std::size_t length = 4 + (index * 7) % 23;
+        const std::size_t start = (index * 13) % (std::size(kWords) - 1 - length);
+        return std::wstring(kWords + start, length);
+    }
+
+    namespace
+    {
+        struct EngineTree
+        {
+            LayoutEngine engine {};
+            LayoutNodeId root { kNoLayoutNode };
+            // Leaves in creation order; the leaf pass edits the middle one.
+            std::vector<LayoutNodeId> leaves {};
+        };
+
+        // Sized like a Text leaf of the panel runs (Segoe UI 14), from the
+        // same built-in tables.
+        void SizeLeaf(EngineTree& tree, AdvanceTextMetrics& metrics, LayoutNodeId leaf, std::size_t textIndex)
+        {
+            const TextExtent extent = metrics.Measure(L"Segoe UI", 14.0f, LayoutBenchLeafText(textIndex));
+            tree.engine.SetLeafSize(leaf, extent.width, extent.height);
+        }
+
+        LayoutNodeId MakeLeaf(EngineTree& tree, AdvanceTextMetrics& metrics, LayoutNodeId parent)
+        {
+            const LayoutNodeId leaf = tree.engine.CreateNode(LayoutKind::Leaf, parent);
+            SizeLeaf(tree, metrics, leaf, tree.leaves.size());
+            tree.leaves.push_back(leaf);
+            return leaf;
+        }
+
+        // Rows of four labels, as the panel run's "stack".
+        void BuildStack(EngineTree& tree, AdvanceTextMetrics& metrics, std::size_t leaves)
+        {
+            tree.root = tree.engine.CreateNode(LayoutKind::StackV);
+            while (tree.leaves.size() < leaves)
+            {
+                const LayoutNodeId line = tree.engine.CreateNode(LayoutKind::StackH, tree.root);
+                for (int i = 0; i < 4 && tree.leaves.size() < leaves; ++i)
+                {
+                    (void)MakeLeaf(tree, metrics, line);
+                }
+            }
+        }
+
+        // Wrapping sections of chips, as the panel run's "dynamic" (the
+        // engine's Wrap has no flex or justify, so rows are packed).
+        void BuildDynamic(EngineTree& tree, AdvanceTextMetrics& metrics, std::size_t leaves)
+        {
+            constexpr std::size_t kPerSection = 40;
+            tree.root = tree.engine.CreateNode(LayoutKind::Wrap);
+            tree.engine.SetSpacing(tree.root, 8.0f);
+            tree.engine.SetRowSpacing(tree.root, 6.0f);
+            while (tree.leaves.size() < leaves)
+            {
+                const LayoutNodeId group = tree.engine.CreateNode(LayoutKind::Wrap, tree.root);
+                tree.engine.SetSpacing(group, 4.0f);
+                tree.engine.SetRowSpacing(group, 4.0f);
+                for (std::size_t i = 0; i < kPerSection && tree.leaves.size() < leaves; ++i)
+                {
+                    (void)MakeLeaf(tree, metrics, group);
+                }
+            }
+        }
+
+        // A long list of rows (label + value) in an Overlay standing in for
+        // the scroll viewport, as the panel run's "scroll".
+        void BuildScroll(EngineTree& tree, AdvanceTextMetrics& metrics, std::size_t leaves)
+        {
+            tree.root = tree.engine.CreateNode(LayoutKind::Overlay);
+            const LayoutNodeId list = tree.engine.CreateNode(LayoutKind::StackV, tree.root);
+            while (tree.leaves.size() < leaves)
+            {
+                const LayoutNodeId line = tree.engine.CreateNode(LayoutKind::StackH, list);
+                (void)MakeLeaf(tree, metrics, line);
+                if (tree.leaves.size() < leaves)
+                {
+                    (void)MakeLeaf(tree, metrics, line);
+                }
+            }
+        }
+
+        void LayoutPass(EngineTree& tree, float width, float height)
+        {
+            tree.engine.Measure(tree.root, width, height);
+            tree.engine.Arrange(tree.root, { 0.0f, 0.0f, width, height });
+        }
+
+        double TimeUs(const std::function<void()>& pass)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            pass();
+            const auto end = std::chrono::steady_clock::now();
+            return std::chrono::duration<double, std::micro>(end - start).count();
+        }
+
+        // Same three passes as the panel runs. The engine re-lays the whole
+        // tree on every pass, so "leaf" differs from "full" only by the edit.
+        void RunTree(const std::string& name, EngineTree& tree, AdvanceTextMetrics& metrics,
+                     const LayoutBenchOptions& options, std::vector<LayoutBenchResult>& results)
+        {
+            const std::uint64_t nodes = tree.engine.NodeCount();
+            const float width = options.width;
+            const float height = options.height;
+            const int iterations = (std::max)(1, options.iterations);
+
+            LayoutPass(tree, width, height);
+
+            std::vector<double> samples;
+            samples.reserve(static_cast<std::size_t>((std::max)(iterations, options.resizeSteps)));
+            for (int i = 0; i < iterations; ++i)
+            {
+                samples.push_back(TimeUs([&] { LayoutPass(tree, width, height); }));
+            }
+            results.push_back(SummarizeLayoutSamples(name + "/full", nodes, samples));
+
+            samples.clear();
+            const LayoutNodeId leaf = tree.leaves[tree.leaves.size() / 2];
+            for (int i = 0; i < iterations; ++i)
+            {
+                SizeLeaf(tree, metrics, leaf, static_cast<std::size_t>(i % 2));
+                samples.push_back(TimeUs([&] { LayoutPass(tree, width, height); }));
+            }
+            results.push_back(SummarizeLayoutSamples(name + "/leaf", nodes, samples));
+
+            samples.clear();
+            const int steps = (std::max)(2, options.resizeSteps);
+            for (int i = 0; i < steps; ++i)
+            {
+                const float t = static_cast<float>(i) / static_cast<float>(steps - 1);
+                const float stepWidth = width * (1.0f - 0.5f * t);
+                samples.push_back(TimeUs([&] { LayoutPass(tree, stepWidth, height); }));
+            }
+            results.push_back(SummarizeLayoutSamples(name + "/resize", nodes, samples));
+        }
+
+        void RunShape(const std::string& name, void (*build)(EngineTree&, AdvanceTextMetrics&, std::size_t),
+                      AdvanceTextMetrics& metrics, const LayoutBenchOptions& options,
+                      std::vector<LayoutBenchResult>& results)
+        {
+            EngineTree tree;
+            build(tree, metrics, (std::max)(options.leaves, std::size_t { 1 }));
+            RunTree(name, tree, metrics, options, results);
+        }
+    }
+
+    std::vector<LayoutBenchResult> RunEngineLayoutBenchmarks(const LayoutBenchOptions& options)
+    {
+        AdvanceTextMetrics metrics;
+        std::vector<LayoutBenchResult> results;
+        RunShape("engine/stack", BuildStack, metrics, options, results);
+        RunShape("engine/dynamic", BuildDynamic, metrics, options, results);
+        RunShape("engine/scroll", BuildScroll, metrics, options, results);
+        return results;
+    }
+}
@@ -0,0 +1,138 @@
+#include "LayoutBench.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+
+// fd2d_layout_bench [--out FILE] [--baseline FILE] [--tolerance 0.10]
+//                   [--min-delta-us 5] [--leaves N] [--iterations N]
+//
+// Runs RunLayoutBenchmarks (Windows builds only) and
+// RunEngineLayoutBenchmarks, writes the JSON run to FILE (stdout without
+// --out) and, with --baseline, prints the comparison and returns 1 when any
+// scenario regressed, 2 on bad arguments or unreadable files. A baseline
+// taken on the other platform compares only the engine scenarios.
+
+namespace
+{
+    bool ReadFile(const char* path, std::string& out)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+        out.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    bool WriteFile(const char* path, const std::string& text)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << text;
+        return static_cast<bool>(file);
+    }
+
+    int Usage()
+    {
+        std::fprintf(stderr,
+            "usage: fd2d_layout_bench [--out FILE] [--baseline FILE] [--tolerance RATIO]\n"
+            "                         [--min-delta-us US] [--leaves N] [--iterations N]\n");
+        return 2;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    using namespace FD2D;
+
+    const char* outPath = nullptr;
+    const char* baselinePath = nullptr;
+    double tolerance = 0.10;
+    double minDeltaUs = 5.0;
+    LayoutBenchOptions options {};
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const bool hasValue = (i + 1 < argc);
+        if (std::strcmp(argv[i], "--out") == 0 && hasValue)
+        {
+            outPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--baseline") == 0 && hasValue)
+        {
+            baselinePath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--tolerance") == 0 && hasValue)
+        {
+            tolerance = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--min-delta-us") == 0 && hasValue)
+        {
+            minDeltaUs = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--leaves") == 0 && hasValue)
+        {
+            options.leaves = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--iterations") == 0 && hasValue)
+        {
+            options.iterations = std::atoi(argv[++i]);
+        }
+        else
+        {
+            return Usage();
+        }
+    }
+
+#if defined(FD2D_LAYOUT_BENCH_PANELS)
+    std::vector<LayoutBenchResult> results = RunLayoutBenchmarks(options);
+#else
+    std::vector<LayoutBenchResult> results;
+#endif
+    for (LayoutBenchResult& result : RunEngineLayoutBenchmarks(options))
+    {
+        results.push_back(std::move(result));
+    }
+    const std::string json = LayoutBenchToJson(results);
+    if (outPath)
+    {
+        if (!WriteFile(outPath, json))
+        {
+            std::fprintf(stderr, "cannot write %s\n", outPath);
+            return 2;
+        }
+    }
+    else
+    {
+        std::fwrite(json.data(), 1, json.size(), stdout);
+        std::fputc('\n', stdout);
+    }
+
+    if (!baselinePath)
+    {
+        return 0;
+    }
+
+    std::string baseline;
+    std::vector<LayoutBenchResult> parsed;
+    if (!ReadFile(baselinePath, baseline) || !ParseLayoutBench(baseline, &parsed))
+    {
+        std::fprintf(stderr, "cannot read baseline %s\n", baselinePath);
+        return 2;
+    }
+
+    std::vector<LayoutBaselineDelta> deltas;
+    const bool ok = CompareLayoutBaseline(baseline, results, tolerance, minDeltaUs, &deltas);
+    for (const LayoutBaselineDelta& delta : deltas)
+    {
+        std::fprintf(stderr, "%-20s %10.1f us -> %10.1f us  x%.2f%s\n",
+                     delta.name.c_str(), delta.baselineP50Us, delta.currentP50Us, delta.ratio,
+                     delta.regressed ? "  REGRESSED" : "");
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,407 @@
+#include "LayoutBenchReport.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace FD2D
+{
+    namespace
+    {
+        void AppendJsonString(std::string& out, const std::string& value)
+        {
+            out += '"';
+            for (const char c : value)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    out += '\\';
+                    out += c;
+                }
+                else if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char escaped[8] {};
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                    out += escaped;
+                }
+                else
+                {
+                    out += c;
+                }
+            }
+            out += '"';
+        }
+
+        void AppendNumber(std::string& out, double value)
+        {
+            char buffer[32] {};
+            std::snprintf(buffer, sizeof(buffer), "%.3f", value);
+            out += buffer;
+        }
+
+        // Just enough JSON for LayoutBenchToJson's output: objects, arrays,
+        // strings, numbers and literals; values the report does not use are
+        // skipped.
+        class JsonReader
+        {
+        public:
+            explicit JsonReader(const std::string& text) : m_text(text) {}
+
+            bool ReadReport(std::vector<LayoutBenchResult>* out)
+            {
+                if (!Expect('{'))
+                {
+                    return false;
+                }
+                if (Peek('}'))
+                {
+                    return Expect('}');
+                }
+                do
+                {
+                    std::string key;
+                    if (!ReadString(&key) || !Expect(':'))
+                    {
+                        return false;
+                    }
+                    const bool ok = (key == "results") ? ReadResults(out) : SkipValue();
+                    if (!ok)
+                    {
+                        return false;
+                    }
+                } while (Accept(','));
+                return Expect('}');
+            }
+
+        private:
+            bool ReadResults(std::vector<LayoutBenchResult>* out)
+            {
+                if (!Expect('['))
+                {
+                    return false;
+                }
+                if (Accept(']'))
+                {
+                    return true;
+                }
+                do
+                {
+                    LayoutBenchResult result;
+                    if (!ReadResult(&result))
+                    {
+                        return false;
+                    }
+                    out->push_back(std::move(result));
+                } while (Accept(','));
+                return Expect(']');
+            }
+
+            bool ReadResult(LayoutBenchResult* result)
+            {
+                if (!Expect('{'))
+                {
+                    return false;
+                }
+                if (Accept('}'))
+                {
+                    return true;
+                }
+                do
+                {
+                    std::string key;
+                    if (!ReadString(&key) || !Expect(':'))
+                    {
+                        return false;
+                    }
+                    double number = 0.0;
+                    bool ok = true;
+                    if (key == "name")
+                    {
+                        ok = ReadString(&result->name);
+                    }
+                    else if (key == "nodes" || key == "iterations" || key == "minUs" ||
+                             key == "meanUs" || key == "p50Us" || key == "p95Us")
+                    {
+                        ok = ReadNumber(&number);
+                        if (key == "nodes")
+                        {
+                            result->nodes = static_cast<std::uint64_t>(number);
+                        }
+                        else if (key == "iterations")
+                        {
+                            result->iterations = static_cast<std::uint64_t>(number);
+                        }
+                        else if (key == "minUs")
+                        {
+                            result->minUs = number;
+                        }
+                        else if (key == "meanUs")
+                        {
+                            result->meanUs = number;
+                        }
+                        else if (key == "p50Us")
+                        {
+                            result->p50Us = number;
+                        }
+                        else
+                        {
+                            result->p95Us = number;
+                        }
+                    }
+                    else
+                    {
+                        ok = SkipValue();
+                    }
+                    if (!ok)
+                    {
+                        return false;
+                    }
+                } while (Accept(','));
+                return Expect('}');
+            }
+
+            bool SkipValue()
+            {
+                SkipSpace();
+                if (m_pos >= m_text.size())
+                {
+                    return false;
+                }
+                const char c = m_text[m_pos];
+                if (c == '"')
+                {
+                    return ReadString(nullptr);
+                }
+                if (c == '{' || c == '[')
+                {
+                    const char close = (c == '{') ? '}' : ']';
+                    ++m_pos;
+                    if (Accept(close))
+                    {
+                        return true;
+                    }
+                    do
+                    {
+                        if (c == '{' && (!ReadString(nullptr) || !Expect(':')))
+                        {
+                            return false;
+                        }
+                        if (!SkipValue())
+                        {
+                            return false;
+                        }
+                    } while (Accept(','));
+                    return Expect(close);
+                }
+                if (c == '-' || std::isdigit(static_cast<unsigned char>(c)))
+                {
+                    double ignored = 0.0;
+                    return ReadNumber(&ignored);
+                }
+                for (const char* literal : { "true", "false", "null" })
+                {
+                    const std::string word(literal);
+                    if (m_text.compare(m_pos, word.size(), word) == 0)
+                    {
+                        m_pos += word.size();
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            bool ReadString(std::string* out)
+            {
+                if (!Expect('"'))
+                {
+                    return false;
+                }
+                while (m_pos < m_text.size())
+                {
+                    char c = m_text[m_pos++];
+                    if (c == '"')
+                    {
+                        return true;
+                    }
+                    if (c == '\\')
+                    {
+                        if (m_pos >= m_text.size())
+                        {
+                            return false;
+                        }
+                        c = m_text[m_pos++];
+                        if (c == 'u')
+                        {
+                            // Only the control characters AppendJsonString
+                            // writes come back through here.
+                            if (m_pos + 4 > m_text.size())
+                            {
+                                return false;
+                            }
+                            c = static_cast<char>(std::strtoul(m_text.substr(m_pos, 4).c_str(), nullptr, 16));
+                            m_pos += 4;
+                        }
+                        else if (c == 'n')
+                        {
+                            c = '\n';
+                        }
+                        else if (c == 't')
+                        {
+                            c = '\t';
+                        }
+                    }
+                    if (out != nullptr)
+                    {
+                        *out += c;
+                    }
+                }
+                return false;
+            }
+
+            bool ReadNumber(double* out)
+            {
+                SkipSpace();
+                const char* begin = m_text.c_str() + m_pos;
+                char* end = nullptr;
+                *out = std::strtod(begin, &end);
+                if (end == begin)
+                {
+                    return false;
+                }
+                m_pos += static_cast<std::size_t>(end - begin);
+                return true;
+            }
+
+            void SkipSpace()
+            {
+                while (m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos])))
+                {
+                    ++m_pos;
+                }
+            }
+
+            bool Peek(char c)
+            {
+                SkipSpace();
+                return m_pos < m_text.size() && m_text[m_pos] == c;
+            }
+
+            bool Accept(char c)
+            {
+                if (Peek(c))
+                {
+                    ++m_pos;
+                    return true;
+                }
+                return false;
+            }
+
+            bool Expect(char c) { return Accept(c); }
+
+            const std::string& m_text;
+            std::size_t m_pos { 0 };
+        };
+    }
+
+    LayoutBenchResult SummarizeLayoutSamples(std::string name, std::uint64_t nodes, std::vector<double>& samplesUs)
+    {
+        LayoutBenchResult result;
+        result.name = std::move(name);
+        result.nodes = nodes;
+        result.iterations = samplesUs.size();
+        if (samplesUs.empty())
+        {
+            return result;
+        }
+
+        std::sort(samplesUs.begin(), samplesUs.end());
+        double total = 0.0;
+        for (const double sample : samplesUs)
+        {
+            total += sample;
+        }
+        const auto percentile = [&](double p)
+        {
+            const std::size_t index = static_cast<std::size_t>(std::ceil(p * static_cast<double>(samplesUs.size()))) - 1;
+            return samplesUs[(std::min)(index, samplesUs.size() - 1)];
+        };
+        result.minUs = samplesUs.front();
+        result.meanUs = total / static_cast<double>(samplesUs.size());
+        result.p50Us = percentile(0.50);
+        result.p95Us = percentile(0.95);
+        return result;
+    }
+
+    std::string LayoutBenchToJson(const std::vector<LayoutBenchResult>& results)
+    {
+        std::string out = "{\"schema\":1,\"results\":[";
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const LayoutBenchResult& r = results[i];
+            out += (i == 0) ? "\n  {" : ",\n  {";
+            out += "\"name\":";
+            AppendJsonString(out, r.name);
+            out += ",\"nodes\":" + std::to_string(r.nodes);
+            out += ",\"iterations\":" + std::to_string(r.iterations);
+            out += ",\"minUs\":";
+            AppendNumber(out, r.minUs);
+            out += ",\"meanUs\":";
+            AppendNumber(out, r.meanUs);
+            out += ",\"p50Us\":";
+            AppendNumber(out, r.p50Us);
+            out += ",\"p95Us\":";
+            AppendNumber(out, r.p95Us);
+            out += "}";
+        }
+        out += results.empty() ? "]}\n" : "\n]}\n";
+        return out;
+    }
+
+    bool ParseLayoutBench(const std::string& json, std::vector<LayoutBenchResult>* out)
+    {
+        std::vector<LayoutBenchResult> results;
+        JsonReader reader(json);
+        if (!reader.ReadReport(&results))
+        {
+            return false;
+        }
+        *out = std::move(results);
+        return true;
+    }
+
+    bool CompareLayoutBaseline(const std::string& baselineJson, const std::vector<LayoutBenchResult>& current,
+                               double tolerance, double minDeltaUs, std::vector<LayoutBaselineDelta>* outDeltas)
+    {
+        std::vector<LayoutBenchResult> baseline;
+        if (!ParseLayoutBench(baselineJson, &baseline))
+        {
+            return false;
+        }
+
+        bool passed = true;
+        for (const LayoutBenchResult& now : current)
+        {
+            const auto before = std::find_if(baseline.begin(), baseline.end(),
+                [&](const LayoutBenchResult& b) { return b.name == now.name; });
+            if (before == baseline.end())
+            {
+                continue;
+            }
+
+            LayoutBaselineDelta delta;
+            delta.name = now.name;
+            delta.baselineP50Us = before->p50Us;
+            delta.currentP50Us = now.p50Us;
+            delta.ratio = (before->p50Us > 0.0) ? (now.p50Us / before->p50Us) : 1.0;
+            delta.regressed = now.p50Us > before->p50Us * (1.0 + tolerance) &&
+                              now.p50Us - before->p50Us >= minDeltaUs;
+            passed = passed && !delta.regressed;
+            if (outDeltas != nullptr)
+            {
+                outDeltas->push_back(std::move(delta));
+            }
+        }
+        return passed;
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+// LayoutBenchReport.h - layout benchmark results, JSON output and the
+// baseline gate.
+//
+// Platform-neutral (LayoutBench.h runs the scenarios; the fd2d_layout_bench
+// executable in this directory ties both together). A run is a list of
+// named results, each summarizing the per-iteration wall times of one
+// scenario. LayoutBenchToJson writes them in a stable, machine-readable form
+// ({"schema":1,"results":[{"name":...,"p50Us":...}, ...]}); a CI job keeps
+// one run as the baseline and fails a change whose run regresses against it
+// (CompareLayoutBaseline).
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace FD2D
+{
+    struct LayoutBenchResult
+    {
+        std::string name {};
+        std::uint64_t nodes { 0 };
+        std::uint64_t iterations { 0 };
+        double minUs { 0.0 };
+        double meanUs { 0.0 };
+        double p50Us { 0.0 };
+        double p95Us { 0.0 };
+    };
+
+    // Summary of per-iteration times in microseconds (`samplesUs` is sorted
+    // in place).
+    LayoutBenchResult SummarizeLayoutSamples(std::string name, std::uint64_t nodes, std::vector<double>& samplesUs);
+
+    std::string LayoutBenchToJson(const std::vector<LayoutBenchResult>& results);
+    // Reads LayoutBenchToJson output back; unknown keys are ignored. Returns
+    // false on malformed input.
+    bool ParseLayoutBench(const std::string& json, std::vector<LayoutBenchResult>* out);
+
+    struct LayoutBaselineDelta
+    {
+        std::string name {};
+        double baselineP50Us { 0.0 };
+        double currentP50Us { 0.0 };
+        double ratio { 1.0 };
+        bool regressed { false };
+    };
+
+    // A scenario regresses when its median is more than `tolerance` (0.10 =
+    // 10%) above the baseline's and at least `minDeltaUs` slower (timer noise
+    // on very short scenarios). Scenarios missing on either side are not
+    // compared. Returns false when any scenario regressed or the baseline
+    // does not parse; `outDeltas` (optional) receives every comparison.
+    bool CompareLayoutBaseline(const std::string& baselineJson, const std::vector<LayoutBenchResult>& current,
+                               double tolerance, double minDeltaUs, std::vector<LayoutBaselineDelta>* outDeltas);
+}
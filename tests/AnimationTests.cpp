@@ -0,0 +1,266 @@
+#include "Animation.h"
+#include "TestCheck.h"
+
+#include <cstdint>
+
+using namespace FD2D;
+
+namespace
+{
+    constexpr Easing kEasings[] = {
+        Easing::Linear,
+        Easing::EaseInQuad,
+        Easing::EaseOutQuad,
+        Easing::EaseInOutQuad,
+        Easing::EaseInCubic,
+        Easing::EaseOutCubic,
+        Easing::EaseInOutCubic,
+        Easing::Smoothstep,
+    };
+
+    struct Color
+    {
+        float r { 0.0f };
+        float g { 0.0f };
+        float b { 0.0f };
+        float a { 0.0f };
+    };
+
+    // Every curve starts at 0, ends at 1, clamps outside [0,1] and never
+    // runs backwards; the symmetric ones pass through the midpoint.
+    void EasingEndpoints()
+    {
+        for (Easing easing : kEasings)
+        {
+            FD2D_CHECK(Ease(easing, 0.0f) == 0.0f);
+            FD2D_CHECK(Ease(easing, 1.0f) == 1.0f);
+            FD2D_CHECK(Ease(easing, -0.5f) == 0.0f);
+            FD2D_CHECK(Ease(easing, 2.0f) == 1.0f);
+
+            float last = 0.0f;
+            for (int i = 1; i <= 100; ++i)
+            {
+                const float value = Ease(easing, static_cast<float>(i) / 100.0f);
+                FD2D_CHECK(value >= last);
+                last = value;
+            }
+        }
+
+        FD2D_CHECK_NEAR(Ease(Easing::Linear, 0.25f), 0.25, 1e-6);
+        FD2D_CHECK_NEAR(Ease(Easing::EaseInOutQuad, 0.5f), 0.5, 1e-6);
+        FD2D_CHECK_NEAR(Ease(Easing::EaseInOutCubic, 0.5f), 0.5, 1e-6);
+        FD2D_CHECK_NEAR(Ease(Easing::Smoothstep, 0.5f), 0.5, 1e-6);
+        FD2D_CHECK(Ease(Easing::EaseInCubic, 0.5f) < Ease(Easing::EaseOutCubic, 0.5f));
+    }
+
+    // A tween on a fake clock lands on exact values at exact times, and the
+    // result does not depend on how often Tick runs.
+    void TweenFollowsTheClock()
+    {
+        std::uint64_t now = 1000;
+        AnimationEngine engine([&now]() { return now; });
+        const int owner = 0;
+
+        float value = 0.0f;
+        engine.Animate(&owner, &value, 100.0f, Tween { 100, Easing::Linear });
+        FD2D_CHECK(engine.Active());
+        FD2D_CHECK(engine.Tick(1000));
+        FD2D_CHECK_NEAR(value, 0.0, 1e-4);
+        FD2D_CHECK(engine.Tick(1025));
+        FD2D_CHECK_NEAR(value, 25.0, 1e-4);
+        FD2D_CHECK(engine.Tick(1050));
+        FD2D_CHECK_NEAR(value, 50.0, 1e-4);
+        FD2D_CHECK(engine.Tick(1100));
+        FD2D_CHECK(value == 100.0f);
+        FD2D_CHECK(!engine.Active());
+
+        // Same animation, ticked once at the end versus every millisecond.
+        float coarse = 0.0f;
+        float fine = 0.0f;
+        std::uint64_t clock = 0;
+        AnimationEngine coarseEngine([&clock]() { return clock; });
+        AnimationEngine fineEngine([&clock]() { return clock; });
+        coarseEngine.Animate(&owner, &coarse, 1.0f, Tween { 300, Easing::EaseInOutCubic });
+        fineEngine.Animate(&owner, &fine, 1.0f, Tween { 300, Easing::EaseInOutCubic });
+        for (std::uint64_t ms = 1; ms <= 170; ++ms)
+        {
+            fineEngine.Tick(ms);
+        }
+        coarseEngine.Tick(170);
+        FD2D_CHECK(coarse == fine);
+        FD2D_CHECK_NEAR(fine, Ease(Easing::EaseInOutCubic, 170.0f / 300.0f), 1e-5);
+    }
+
+    // Springs settle onto the exact target well before the 10s snap, whether
+    // under-, critically or over-damped; only the under-damped one (the
+    // default) overshoots.
+    void SpringSettles()
+    {
+        const Spring springs[] = {
+            Spring {},
+            Spring { 300.0f, 2.0f * 17.320508f, 1.0f, 0.001f },
+            Spring { 300.0f, 80.0f, 1.0f, 0.001f },
+        };
+
+        for (const Spring& spring : springs)
+        {
+            std::uint64_t now = 0;
+            AnimationEngine engine([&now]() { return now; });
+            const int owner = 0;
+            float value = 0.0f;
+            float peak = 0.0f;
+            engine.Animate(&owner, &value, 100.0f, spring);
+            while (engine.Active() && now < 5000)
+            {
+                now += 16;
+                engine.Tick(now);
+                peak = (value > peak) ? value : peak;
+            }
+
+            FD2D_CHECK(!engine.Active());
+            FD2D_CHECK(value == 100.0f);
+            FD2D_CHECK(now < 4000);
+            if (spring.damping < 30.5f)
+            {
+                FD2D_CHECK(peak > 100.0f);
+            }
+            else
+            {
+                FD2D_CHECK(peak <= 100.0f + 0.001f);
+            }
+        }
+
+        // Zero damping never settles on its own and is snapped after 10s.
+        std::uint64_t now = 0;
+        AnimationEngine engine([&now]() { return now; });
+        const int owner = 0;
+        float value = 0.0f;
+        engine.Animate(&owner, &value, 1.0f, Spring { 300.0f, 0.0f, 1.0f, 0.001f });
+        now = 9999;
+        engine.Tick(now);
+        FD2D_CHECK(engine.Active());
+        now = 10000;
+        engine.Tick(now);
+        FD2D_CHECK(!engine.Active());
+        FD2D_CHECK(value == 1.0f);
+    }
+
+    // Retargeting starts from the current value (no jump) and a spring keeps
+    // its velocity; the track is reused, not duplicated.
+    void RetargetMidFlight()
+    {
+        std::uint64_t now = 0;
+        AnimationEngine engine([&now]() { return now; });
+        const int owner = 0;
+
+        float value = 0.0f;
+        engine.Animate(&owner, &value, 100.0f, Tween { 100, Easing::Linear });
+        now = 50;
+        engine.Tick(now);
+        FD2D_CHECK_NEAR(value, 50.0, 1e-4);
+
+        engine.Animate(&owner, &value, 0.0f, Tween { 100, Easing::Linear });
+        FD2D_CHECK(engine.Count() == 1);
+        engine.Tick(now);
+        FD2D_CHECK_NEAR(value, 50.0, 1e-4);
+        now = 100;
+        engine.Tick(now);
+        FD2D_CHECK_NEAR(value, 25.0, 1e-4);
+        now = 150;
+        engine.Tick(now);
+        FD2D_CHECK(value == 0.0f);
+        FD2D_CHECK(!engine.Active());
+
+        float spring = 0.0f;
+        now = 0;
+        engine.Animate(&owner, &spring, 100.0f, Spring {});
+        now = 30;
+        engine.Tick(now);
+        const float before = spring;
+        FD2D_CHECK(before > 0.0f && before < 100.0f);
+
+        // New target behind the spring: it keeps moving forward for a moment
+        // before turning back.
+        engine.Animate(&owner, &spring, 0.0f, Spring {});
+        FD2D_CHECK(engine.Count() == 1);
+        engine.Tick(now);
+        FD2D_CHECK_NEAR(spring, before, 1e-3);
+        now = 32;
+        engine.Tick(now);
+        FD2D_CHECK(spring > before);
+        while (engine.Active() && now < 5000)
+        {
+            now += 16;
+            engine.Tick(now);
+        }
+        FD2D_CHECK(spring == 0.0f);
+    }
+
+    // Active/IsAnimating track running animations; a property already at
+    // its target is written and never tracked; Stop and StopAll leave the
+    // value where it is.
+    void ActiveFlagFollowsTracks()
+    {
+        std::uint64_t now = 0;
+        AnimationEngine engine([&now]() { return now; });
+        const int ownerA = 0;
+        const int ownerB = 0;
+
+        FD2D_CHECK(!engine.Active());
+        FD2D_CHECK(!engine.Tick(now));
+
+        float still = 5.0f;
+        engine.Animate(&ownerA, &still, 5.0f, Tween {});
+        engine.Animate(&ownerA, &still, 5.0f, Spring {});
+        FD2D_CHECK(!engine.IsAnimating(&still));
+        FD2D_CHECK(!engine.Active());
+
+        float a = 0.0f;
+        float b = 0.0f;
+        Color color {};
+        engine.Animate(&ownerA, &a, 1.0f, Tween { 100, Easing::Linear });
+        engine.Animate(&ownerA, &color, Color { 1.0f, 0.5f, 0.25f, 1.0f }, Tween { 100, Easing::Linear });
+        engine.Animate(&ownerB, &b, 1.0f, Follow {});
+        FD2D_CHECK(engine.Active());
+        FD2D_CHECK(engine.Count() == 3);
+        FD2D_CHECK(engine.IsAnimating(&a));
+        FD2D_CHECK(engine.IsAnimating(&color));
+
+        now = 50;
+        engine.Tick(now);
+        FD2D_CHECK_NEAR(color.g, 0.25, 1e-5);
+        FD2D_CHECK(engine.Stop(&a));
+        FD2D_CHECK(!engine.Stop(&a));
+        FD2D_CHECK_NEAR(a, 0.5, 1e-5);
+
+        engine.StopAll(&ownerA);
+        FD2D_CHECK(!engine.IsAnimating(&color));
+        FD2D_CHECK(engine.IsAnimating(&b));
+        FD2D_CHECK(engine.Count() == 1);
+
+        // Retargeting onto the current value of a follow ends it in place.
+        engine.Animate(&ownerB, &b, b, Follow {});
+        FD2D_CHECK(!engine.Active());
+
+        // Without a clock, animations start at the last Tick time.
+        AnimationEngine clockless;
+        float c = 0.0f;
+        clockless.Tick(500);
+        clockless.Animate(&ownerA, &c, 1.0f, Tween { 100, Easing::Linear });
+        clockless.Tick(550);
+        FD2D_CHECK_NEAR(c, 0.5, 1e-5);
+        clockless.Tick(600);
+        FD2D_CHECK(c == 1.0f);
+        FD2D_CHECK(!clockless.Active());
+    }
+}
+
+int main()
+{
+    EasingEndpoints();
+    TweenFollowsTheClock();
+    SpringSettles();
+    RetargetMidFlight();
+    ActiveFlagFollowsTracks();
+    return Test::TestResult();
+}
@@ -0,0 +1,258 @@
+#include "ConstraintSolver.h"
+#include "TestCheck.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+using namespace FD2D;
+
+namespace
+{
+    // "left + width <= edge", the shape ConstraintPanel builds for a child
+    // against the panel.
+    ConstraintId RightAtMost(ConstraintSolver& solver, ConstraintVar left, ConstraintVar width, double edge)
+    {
+        return solver.AddConstraint(LinearExpr {}.Add(left).Add(width).Add(-edge), ConstraintOp::LessEqual);
+    }
+
+    void EditVariablesFollowSuggestions()
+    {
+        ConstraintSolver solver;
+        const ConstraintVar left = solver.AddVariable();
+        const ConstraintVar width = solver.AddVariable();
+        (void)solver.AddConstraint(LinearExpr {}.Add(left).Add(-10.0), ConstraintOp::Equal);
+        FD2D_CHECK(RightAtMost(solver, left, width, 100.0) != kNoConstraint);
+        FD2D_CHECK(solver.AddEditVariable(width, ConstraintStrength::Weak));
+
+        FD2D_CHECK(solver.SuggestValue(width, 50.0));
+        solver.UpdateVariables();
+        FD2D_CHECK_NEAR(solver.Value(width), 50.0, 1e-9);
+
+        // The required edge wins over the weak preference.
+        FD2D_CHECK(solver.SuggestValue(width, 500.0));
+        solver.UpdateVariables();
+        FD2D_CHECK_NEAR(solver.Value(left), 10.0, 1e-9);
+        FD2D_CHECK_NEAR(solver.Value(width), 90.0, 1e-9);
+
+        // Conflicting required constraints are refused and leave the solver as it was.
+        FD2D_CHECK(solver.AddConstraint(LinearExpr {}.Add(left).Add(-20.0), ConstraintOp::Equal) == kNoConstraint);
+        solver.UpdateVariables();
+        FD2D_CHECK_NEAR(solver.Value(left), 10.0, 1e-9);
+    }
+
+    // A removed box's variables are reused by the next one, which must not
+    // see anything of the old constraints.
+    void RemovedVariablesAreReusedClean()
+    {
+        ConstraintSolver solver;
+        ConstraintVar left = solver.AddVariable();
+        ConstraintVar width = solver.AddVariable();
+        const ConstraintId pin = solver.AddConstraint(LinearExpr {}.Add(left).Add(-30.0), ConstraintOp::Equal);
+        const ConstraintId edge = RightAtMost(solver, left, width, 40.0);
+        FD2D_CHECK(solver.AddEditVariable(width, ConstraintStrength::Weak));
+        FD2D_CHECK(solver.SuggestValue(width, 25.0));
+        solver.UpdateVariables();
+        FD2D_CHECK_NEAR(solver.Value(width), 10.0, 1e-9);
+
+        FD2D_CHECK(solver.RemoveEditVariable(width));
+        FD2D_CHECK(solver.RemoveConstraint(pin));
+        FD2D_CHECK(solver.RemoveConstraint(edge));
+        solver.RemoveVariable(left);
+        solver.RemoveVariable(width);
+        FD2D_CHECK(solver.ConstraintCount() == 0);
+
+        const ConstraintVar reusedA = solver.AddVariable();
+        const ConstraintVar reusedB = solver.AddVariable();
+        FD2D_CHECK((reusedA == left || reusedA == width) && (reusedB == left || reusedB == width));
+        FD2D_CHECK(reusedA != reusedB);
+        FD2D_CHECK(solver.AddVariable() == 2);
+
+        left = reusedA;
+        width = reusedB;
+        (void)solver.AddConstraint(LinearExpr {}.Add(left).Add(-5.0), ConstraintOp::Equal);
+        FD2D_CHECK(RightAtMost(solver, left, width, 200.0) != kNoConstraint);
+        FD2D_CHECK(solver.AddEditVariable(width, ConstraintStrength::Weak));
+        FD2D_CHECK(solver.SuggestValue(width, 120.0));
+        solver.UpdateVariables();
+        FD2D_CHECK_NEAR(solver.Value(left), 5.0, 1e-9);
+        FD2D_CHECK_NEAR(solver.Value(width), 120.0, 1e-9);
+    }
+
+    // Between two non-required constraints that disagree, the stronger one
+    // holds; removing it hands the variable back to the weaker one.
+    void WeakGivesWayToStrong()
+    {
+        ConstraintSolver solver;
+        const ConstraintVar x = solver.AddVariable();
+        FD2D_CHECK(solver.AddConstraint(LinearExpr {}.Add(x).Add(-10.0), ConstraintOp::Equal, ConstraintStrength::Weak) != kNoConstraint);
+        const ConstraintId strong = solver.AddConstraint(LinearExpr {}.Add(x).Add(-20.0), ConstraintOp::Equal, ConstraintStrength::Strong);
+        FD2D_CHECK(strong != kNoConstraint);
+        const ConstraintId medium = solver.AddConstraint(LinearExpr {}.Add(x).Add(-30.0), ConstraintOp::Equal, ConstraintStrength::Medium);
+        solver.UpdateVariables();
+        FD2D_CHECK_NEAR(solver.Value(x), 20.0, 1e-9);
+
+        FD2D_CHECK(solver.RemoveConstraint(strong));
+        solver.UpdateVariables();
+        FD2D_CHECK_NEAR(solver.Value(x), 30.0, 1e-9);
+        FD2D_CHECK(solver.RemoveConstraint(medium));
+        solver.UpdateVariables();
+        FD2D_CHECK_NEAR(solver.Value(x), 10.0, 1e-9);
+
+        // A weak inequality yields to a strong edit as well.
+        const ConstraintVar y = solver.AddVariable();
+        (void)solver.AddConstraint(LinearExpr {}.Add(y).Add(-5.0), ConstraintOp::LessEqual, ConstraintStrength::Weak);
+        FD2D_CHECK(solver.AddEditVariable(y, ConstraintStrength::Strong));
+        FD2D_CHECK(solver.SuggestValue(y, 40.0));
+        solver.UpdateVariables();
+        FD2D_CHECK_NEAR(solver.Value(y), 40.0, 1e-9);
+    }
+
+    // A required constraint that contradicts the required set is refused;
+    // the tableau, the constraint count and the solution are exactly as
+    // before, and the solver keeps working.
+    void ConflictingRequiredIsRolledBack()
+    {
+        ConstraintSolver solver;
+        const ConstraintVar x = solver.AddVariable();
+        const ConstraintVar y = solver.AddVariable();
+        (void)solver.AddConstraint(LinearExpr {}.Add(x), ConstraintOp::GreaterEqual);
+        (void)solver.AddConstraint(LinearExpr {}.Add(x).Add(y).Add(-100.0), ConstraintOp::Equal);
+        const ConstraintId pinY = solver.AddConstraint(LinearExpr {}.Add(y).Add(-30.0), ConstraintOp::Equal);
+        FD2D_CHECK(solver.AddConstraint(LinearExpr {}.Add(x).Add(-60.0), ConstraintOp::Equal, ConstraintStrength::Weak) != kNoConstraint);
+        solver.UpdateVariables();
+        FD2D_CHECK_NEAR(solver.Value(x), 70.0, 1e-9);
+        const std::size_t count = solver.ConstraintCount();
+
+        FD2D_CHECK(solver.AddConstraint(LinearExpr {}.Add(x).Add(-50.0), ConstraintOp::Equal) == kNoConstraint);
+        FD2D_CHECK(solver.AddConstraint(LinearExpr {}.Add(x).Add(1.0), ConstraintOp::LessEqual) == kNoConstraint);
+        FD2D_CHECK(solver.ConstraintCount() == count);
+        solver.UpdateVariables();
+        FD2D_CHECK_NEAR(solver.Value(x), 70.0, 1e-9);
+        FD2D_CHECK_NEAR(solver.Value(y), 30.0, 1e-9);
+
+        // Without the pin the same constraint is accepted, and the weak
+        // preference for x is overruled by it.
+        FD2D_CHECK(solver.RemoveConstraint(pinY));
+        const ConstraintId pinX = solver.AddConstraint(LinearExpr {}.Add(x).Add(-50.0), ConstraintOp::Equal);
+        FD2D_CHECK(pinX != kNoConstraint);
+        solver.UpdateVariables();
+        FD2D_CHECK_NEAR(solver.Value(x), 50.0, 1e-9);
+        FD2D_CHECK_NEAR(solver.Value(y), 50.0, 1e-9);
+        FD2D_CHECK(solver.RemoveConstraint(pinX));
+        solver.UpdateVariables();
+        FD2D_CHECK_NEAR(solver.Value(x), 60.0, 1e-9);
+    }
+
+    // A row of `count` boxes, `gap` apart, sharing the panel width equally
+    // (weakly) with a 10px minimum each; the panel width is an edit variable.
+    struct Row
+    {
+        ConstraintSolver solver {};
+        ConstraintVar panel { 0 };
+        std::vector<ConstraintVar> lefts {};
+        std::vector<ConstraintVar> widths {};
+    };
+
+    void BuildRow(Row& row, std::size_t count, double gap)
+    {
+        ConstraintSolver& solver = row.solver;
+        row.panel = solver.AddVariable();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            row.lefts.push_back(solver.AddVariable());
+            row.widths.push_back(solver.AddVariable());
+        }
+        (void)solver.AddConstraint(LinearExpr {}.Add(row.lefts[0]), ConstraintOp::Equal);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            (void)solver.AddConstraint(LinearExpr {}.Add(row.widths[i]).Add(-10.0), ConstraintOp::GreaterEqual);
+            if (i + 1 < count)
+            {
+                (void)solver.AddConstraint(
+                    LinearExpr {}.Add(row.lefts[i + 1]).Add(row.lefts[i], -1.0).Add(row.widths[i], -1.0).Add(-gap),
+                    ConstraintOp::Equal);
+                (void)solver.AddConstraint(
+                    LinearExpr {}.Add(row.widths[i]).Add(row.widths[i + 1], -1.0), ConstraintOp::Equal, ConstraintStrength::Weak);
+            }
+        }
+        const LinearExpr right = LinearExpr {}.Add(row.lefts.back()).Add(row.widths.back()).Add(row.panel, -1.0);
+        (void)solver.AddConstraint(right, ConstraintOp::LessEqual);
+        (void)solver.AddConstraint(right, ConstraintOp::Equal, ConstraintStrength::Medium);
+        (void)solver.AddEditVariable(row.panel, ConstraintStrength::Strong);
+    }
+
+    // Re-solving on each resize gives the same boxes as solving from scratch
+    // at that width.
+    void IncrementalResizeMatchesFreshSolve()
+    {
+        constexpr std::size_t kBoxes = 20;
+        Row incremental;
+        BuildRow(incremental, kBoxes, 4.0);
+        for (double width = 600.0; width >= 200.0; width -= 37.0)
+        {
+            FD2D_CHECK(incremental.solver.SuggestValue(incremental.panel, width));
+            incremental.solver.UpdateVariables();
+
+            Row fresh;
+            BuildRow(fresh, kBoxes, 4.0);
+            FD2D_CHECK(fresh.solver.SuggestValue(fresh.panel, width));
+            fresh.solver.UpdateVariables();
+
+            const double expected = (std::max)(10.0, (width - 4.0 * (kBoxes - 1)) / kBoxes);
+            for (std::size_t i = 0; i < kBoxes; ++i)
+            {
+                FD2D_CHECK_NEAR(incremental.solver.Value(incremental.widths[i]), fresh.solver.Value(fresh.widths[i]), 1e-6);
+                FD2D_CHECK_NEAR(incremental.solver.Value(incremental.lefts[i]), fresh.solver.Value(fresh.lefts[i]), 1e-6);
+                FD2D_CHECK_NEAR(incremental.solver.Value(incremental.widths[i]), expected, 1e-6);
+            }
+        }
+    }
+
+    void BenchResizeSweep()
+    {
+        constexpr std::size_t kBoxes = 200;
+        constexpr int kSteps = 200;
+        double start = Test::NowUs();
+        Row row;
+        BuildRow(row, kBoxes, 4.0);
+        const double buildUs = Test::NowUs() - start;
+
+        start = Test::NowUs();
+        for (int step = 0; step < kSteps; ++step)
+        {
+            (void)row.solver.SuggestValue(row.panel, 3000.0 + 25.0 * static_cast<double>(step));
+            row.solver.UpdateVariables();
+        }
+        const double resolveUs = (Test::NowUs() - start) / kSteps;
+
+        start = Test::NowUs();
+        constexpr int kFreshSteps = 3;
+        for (int step = 0; step < kFreshSteps; ++step)
+        {
+            Row fresh;
+            BuildRow(fresh, kBoxes, 4.0);
+            (void)fresh.solver.SuggestValue(fresh.panel, 3000.0 + 25.0 * static_cast<double>(step));
+            fresh.solver.UpdateVariables();
+        }
+        const double freshUs = (Test::NowUs() - start) / kFreshSteps;
+
+        std::printf("%zu-box row: build %.0f us; resize re-solve %.1f us, from scratch %.0f us (width %.1f)\n",
+                    kBoxes, buildUs, resolveUs, freshUs, row.solver.Value(row.widths[0]));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    EditVariablesFollowSuggestions();
+    RemovedVariablesAreReusedClean();
+    WeakGivesWayToStrong();
+    ConflictingRequiredIsRolledBack();
+    IncrementalResizeMatchesFreshSolve();
+    if (Test::BenchRequested(argc, argv))
+    {
+        BenchResizeSweep();
+    }
+    return Test::TestResult();
+}
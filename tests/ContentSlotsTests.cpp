@@ -0,0 +1,68 @@
+#include "ContentSlots.h"
+#include "TestCheck.h"
+
+using namespace FD2D;
+
+namespace
+{
+    using Placement = ContentSlots::Placement;
+
+    void PreviewThenFullFades()
+    {
+        ContentSlots slots;
+        slots.SetFadeDurationMs(100);
+        FD2D_CHECK(slots.Offer(ContentQuality::Preview, 1000) == Placement::ReplacePrimary);
+        FD2D_CHECK(!slots.IsFading());
+
+        FD2D_CHECK(slots.Offer(ContentQuality::Full, 2000) == Placement::StartFade);
+        FD2D_CHECK(slots.IsFading());
+        FD2D_CHECK(slots.FadeEndMs() == 2100);
+        FD2D_CHECK(!slots.Advance(2050));
+        FD2D_CHECK_NEAR(slots.PendingOpacity(), 0.5f, 1e-6);
+        FD2D_CHECK(slots.Advance(2100));
+        FD2D_CHECK(!slots.IsFading());
+        FD2D_CHECK(slots.PrimaryQuality() == ContentQuality::Full);
+        FD2D_CHECK(!slots.Advance(2200));
+    }
+
+    // The slots hold one source: the same quality again (a request re-issued
+    // after culling, a cache hit) is not faded in, nor is anything older.
+    void RepeatsAreNotFaded()
+    {
+        ContentSlots slots;
+        slots.SetFadeDurationMs(100);
+        FD2D_CHECK(slots.Offer(ContentQuality::Preview, 0) == Placement::ReplacePrimary);
+        FD2D_CHECK(slots.Offer(ContentQuality::Preview, 10) == Placement::Rejected);
+        FD2D_CHECK(!slots.IsFading());
+
+        FD2D_CHECK(slots.Offer(ContentQuality::Full, 20) == Placement::StartFade);
+        FD2D_CHECK(slots.Offer(ContentQuality::Full, 30) == Placement::Rejected);
+        FD2D_CHECK(slots.Offer(ContentQuality::Preview, 40) == Placement::Rejected);
+        FD2D_CHECK(slots.IsFading() && slots.FadeEndMs() == 120);
+
+        FD2D_CHECK(slots.Advance(120));
+        FD2D_CHECK(slots.Offer(ContentQuality::Full, 200) == Placement::Rejected);
+
+        // A new source starts from reset slots.
+        slots.Reset();
+        FD2D_CHECK(slots.Offer(ContentQuality::Full, 300) == Placement::ReplacePrimary);
+    }
+
+    void ZeroDurationSwaps()
+    {
+        ContentSlots slots;
+        slots.SetFadeDurationMs(0);
+        FD2D_CHECK(slots.Offer(ContentQuality::Preview, 0) == Placement::ReplacePrimary);
+        FD2D_CHECK(slots.Offer(ContentQuality::Full, 0) == Placement::ReplacePrimary);
+        FD2D_CHECK(!slots.IsFading());
+        FD2D_CHECK(slots.PrimaryQuality() == ContentQuality::Full);
+    }
+}
+
+int main()
+{
+    PreviewThenFullFades();
+    RepeatsAreNotFaded();
+    ZeroDurationSwaps();
+    return Test::TestResult();
+}
@@ -0,0 +1,196 @@
+#include "Executor.h"
+#include "TestCheck.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace FD2D;
+
+namespace
+{
+    template <typename Predicate>
+    bool WaitUntil(Predicate predicate, double timeoutUs = 5.0e6)
+    {
+        const double deadline = Test::NowUs() + timeoutUs;
+        while (!predicate())
+        {
+            if (Test::NowUs() > deadline)
+            {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    // A thread waiting on a group inside a frame must not pick up queued
+    // background work; that work starts once the frame ends.
+    void WaitInsideFrameSkipsBackgroundWork()
+    {
+        Executor executor(Executor::Options { 1 });
+        const std::thread::id caller = std::this_thread::get_id();
+
+        // Keep the only worker busy so everything else stays queued.
+        std::atomic<bool> release { false };
+        std::atomic<bool> blocking { false };
+        executor.Submit([&] {
+            blocking = true;
+            while (!release)
+            {
+                std::this_thread::yield();
+            }
+        }, WorkLane::Interactive);
+        FD2D_CHECK(WaitUntil([&] { return blocking.load(); }));
+
+        executor.BeginFrame();
+        std::atomic<bool> backgroundRan { false };
+        std::atomic<bool> backgroundOnCaller { false };
+        executor.Submit([&] {
+            backgroundOnCaller = std::this_thread::get_id() == caller;
+            backgroundRan = true;
+        }, WorkLane::Background);
+
+        std::atomic<int> groupRan { 0 };
+        std::atomic<int> groupOnCaller { 0 };
+        {
+            TaskGroup group(executor);
+            for (int i = 0; i < 4; ++i)
+            {
+                group.Run([&] {
+                    groupOnCaller += (std::this_thread::get_id() == caller) ? 1 : 0;
+                    ++groupRan;
+                });
+            }
+            group.Wait();
+        }
+        FD2D_CHECK(groupRan == 4);
+        FD2D_CHECK(groupOnCaller == 4); // the worker never got to them
+        FD2D_CHECK(!backgroundRan);
+        FD2D_CHECK(!executor.TryRunOne()); // background only, frame in progress
+
+        release = true;
+        executor.EndFrame();
+        FD2D_CHECK(WaitUntil([&] { return backgroundRan.load(); }));
+        FD2D_CHECK(!backgroundOnCaller);
+    }
+
+    // A background group waited on inside a frame still completes: the
+    // waiter runs its own tasks.
+    void BackgroundGroupCompletesInsideFrame()
+    {
+        Executor executor(Executor::Options { 2 });
+        executor.BeginFrame();
+        std::atomic<int> ran { 0 };
+        {
+            TaskGroup group(executor, WorkLane::Background);
+            for (int i = 0; i < 16; ++i)
+            {
+                group.Run([&] { ++ran; });
+            }
+            group.Wait();
+        }
+        FD2D_CHECK(ran == 16);
+        executor.EndFrame();
+    }
+
+    void SubmitReportsRejection()
+    {
+        std::atomic<bool> started { false };
+        std::atomic<bool> rejected { false };
+        std::atomic<bool> groupReturned { false };
+        {
+            Executor executor(Executor::Options { 1 });
+            FD2D_CHECK(!executor.Submit({}));
+            executor.Submit([&] {
+                started = true;
+                // Spin until the destructor has started shutting down.
+                while (executor.Submit([] {}, WorkLane::Background))
+                {
+                    std::this_thread::yield();
+                }
+                rejected = true;
+                TaskGroup group(executor);
+                group.Run([] {});
+                group.Wait(); // must not wait for a task that was never queued
+                groupReturned = true;
+            }, WorkLane::Interactive);
+            FD2D_CHECK(WaitUntil([&] { return started.load(); }));
+        }
+        FD2D_CHECK(rejected);
+        FD2D_CHECK(groupReturned);
+    }
+
+    // Recursive fork/join from workers and the caller.
+    std::uint64_t ParallelSum(Executor& executor, std::uint64_t begin, std::uint64_t end)
+    {
+        if (end - begin <= 64)
+        {
+            std::uint64_t sum = 0;
+            for (std::uint64_t i = begin; i < end; ++i)
+            {
+                sum += i;
+            }
+            return sum;
+        }
+        const std::uint64_t mid = begin + (end - begin) / 2;
+        std::uint64_t left = 0;
+        TaskGroup group(executor);
+        group.Run([&] { left = ParallelSum(executor, begin, mid); });
+        const std::uint64_t right = ParallelSum(executor, mid, end);
+        group.Wait();
+        return left + right;
+    }
+
+    void NestedForkJoin()
+    {
+        Executor executor(Executor::Options { 3 });
+        for (int round = 0; round < 20; ++round)
+        {
+            const std::uint64_t n = 20000 + static_cast<std::uint64_t>(round);
+            FD2D_CHECK(ParallelSum(executor, 0, n) == n * (n - 1) / 2);
+        }
+    }
+
+    void CancelledTasksAreSkipped()
+    {
+        Executor executor(Executor::Options { 1 });
+        CancellationSource source;
+        source.Cancel();
+        std::atomic<int> ran { 0 };
+        {
+            TaskGroup group(executor, WorkLane::Interactive, source.Token());
+            for (int i = 0; i < 8; ++i)
+            {
+                group.Run([&] { ++ran; });
+            }
+        } // ~TaskGroup waits
+        FD2D_CHECK(ran == 0);
+    }
+
+    void BenchForkJoin()
+    {
+        Executor executor;
+        const double start = Test::NowUs();
+        constexpr int kRounds = 50;
+        for (int round = 0; round < kRounds; ++round)
+        {
+            (void)ParallelSum(executor, 0, 1u << 18);
+        }
+        std::printf("fork/join sum of 2^18 in 64-element leaves: %.1f us per run (%zu workers)\n",
+                    (Test::NowUs() - start) / kRounds, executor.WorkerCount());
+    }
+}
+
+int main(int argc, char** argv)
+{
+    WaitInsideFrameSkipsBackgroundWork();
+    BackgroundGroupCompletesInsideFrame();
+    SubmitReportsRejection();
+    NestedForkJoin();
+    CancelledTasksAreSkipped();
+    if (Test::BenchRequested(argc, argv))
+    {
+        BenchForkJoin();
+    }
+    return Test::TestResult();
+}
@@ -0,0 +1,148 @@
+#include "FrameArena.h"
+#include "TestCheck.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+using namespace FD2D;
+
+// Counts every heap allocation in the process, so the steady-state check
+// covers the arena's own bookkeeping as well as its blocks.
+namespace
+{
+    std::atomic<std::uint64_t> g_heapAllocations { 0 };
+}
+
+void* operator new(std::size_t bytes)
+{
+    ++g_heapAllocations;
+    if (void* p = std::malloc(bytes == 0 ? 1 : bytes))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace
+{
+    // One frame's worth of scratch: a few growing vectors and many small
+    // ones, shaped by `frame` so consecutive frames differ a little.
+    std::size_t RunFrame(std::pmr::memory_resource* memory, int frame)
+    {
+        std::size_t checksum = 0;
+        std::pmr::vector<float> sizes(memory);
+        std::pmr::vector<std::uint32_t> order(memory);
+        const int items = 3000 + (frame % 7) * 150;
+        for (int i = 0; i < items; ++i)
+        {
+            sizes.push_back(static_cast<float>(i));
+            order.push_back(static_cast<std::uint32_t>(items - i));
+        }
+        for (int i = 0; i < 200; ++i)
+        {
+            std::pmr::vector<double> small(static_cast<std::size_t>(1 + (i + frame) % 17), 1.0, memory);
+            checksum += small.size();
+        }
+        return checksum + sizes.size() + order.size();
+    }
+
+    void SteadyStateStopsAllocating()
+    {
+        FrameArena arena(4 * 1024);
+        for (int frame = 0; frame < 8; ++frame)
+        {
+            arena.Reset();
+            (void)RunFrame(&arena, frame);
+        }
+
+        // Warm: the blocks have merged into one that fits a whole frame.
+        arena.Reset();
+        FD2D_CHECK(arena.BytesUsed() == 0);
+        const std::uint64_t blocks = arena.BlockAllocations();
+        const std::size_t capacity = arena.Capacity();
+        const std::uint64_t heap = g_heapAllocations.load();
+
+        std::size_t checksum = 0;
+        for (int frame = 0; frame < 1000; ++frame)
+        {
+            arena.Reset();
+            checksum += RunFrame(&arena, frame);
+            FD2D_CHECK(arena.BytesUsed() <= capacity);
+        }
+        FD2D_CHECK(checksum > 0);
+        FD2D_CHECK(arena.BlockAllocations() == blocks);
+        FD2D_CHECK(arena.Capacity() == capacity);
+        FD2D_CHECK(g_heapAllocations.load() == heap);
+    }
+
+    void ResetMergesBlocks()
+    {
+        FrameArena arena(1024);
+        FD2D_CHECK(arena.Capacity() == 0);
+
+        void* a = arena.allocate(100, 8);
+        void* b = arena.allocate(5000, 64);
+        FD2D_CHECK(reinterpret_cast<std::uintptr_t>(b) % 64 == 0);
+        FD2D_CHECK(a != b);
+        FD2D_CHECK(arena.BlockAllocations() == 2);
+        const std::size_t capacity = arena.Capacity();
+
+        arena.Reset();
+        FD2D_CHECK(arena.BlockAllocations() == 3);
+        FD2D_CHECK(arena.Capacity() == capacity);
+
+        // The same frame now fits the merged block.
+        (void)arena.allocate(100, 8);
+        (void)arena.allocate(5000, 64);
+        FD2D_CHECK(arena.BlockAllocations() == 3);
+    }
+
+    void BenchArena()
+    {
+        FrameArena arena;
+        constexpr int kFrames = 2000;
+        std::size_t sink = 0;
+
+        double start = Test::NowUs();
+        for (int frame = 0; frame < kFrames; ++frame)
+        {
+            arena.Reset();
+            sink += RunFrame(&arena, frame);
+        }
+        const double arenaUs = (Test::NowUs() - start) / kFrames;
+
+        start = Test::NowUs();
+        for (int frame = 0; frame < kFrames; ++frame)
+        {
+            sink += RunFrame(std::pmr::new_delete_resource(), frame);
+        }
+        const double heapUs = (Test::NowUs() - start) / kFrames;
+        std::printf("frame scratch: arena %.1f us per frame, heap %.1f us (%zu)\n", arenaUs, heapUs, sink);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    SteadyStateStopsAllocating();
+    ResetMergesBlocks();
+    if (Test::BenchRequested(argc, argv))
+    {
+        BenchArena();
+    }
+    return Test::TestResult();
+}
@@ -0,0 +1,135 @@
+#include "FramePacer.h"
+#include "TestCheck.h"
+
+#include <cstdint>
+#include <random>
+
+using namespace FD2D;
+
+namespace
+{
+    constexpr std::uint64_t kRefreshUs = 16000;
+
+    void IntervalPacingWithoutPhase()
+    {
+        FramePacer pacer;
+        FD2D_CHECK(pacer.NextFrameStartUs(0, kRefreshUs) == 0);
+
+        // No vblank seen yet.
+        pacer.SetRefreshIntervalUs(kRefreshUs);
+        FD2D_CHECK(!pacer.HasPhase());
+        FD2D_CHECK(pacer.NextFrameStartUs(500000, kRefreshUs) == 500000 + kRefreshUs);
+
+        // Frames that cost a whole refresh gain nothing from a deadline.
+        pacer.OnVblank(1000000);
+        FD2D_CHECK(pacer.HasPhase());
+        pacer.OnFrameRendered(20000);
+        FD2D_CHECK(pacer.PredictedFrameCostUs() >= kRefreshUs);
+        FD2D_CHECK(pacer.NextFrameStartUs(1000100, kRefreshUs) == 1000100 + kRefreshUs);
+    }
+
+    void DeadlineBeforeVblank()
+    {
+        FramePacer pacer;
+        pacer.SetRefreshIntervalUs(kRefreshUs);
+        pacer.OnVblank(1000000);
+        pacer.OnFrameRendered(2000);
+        const std::uint64_t cost = pacer.PredictedFrameCostUs();
+        FD2D_CHECK(cost > 2000 && cost < kRefreshUs);
+
+        // The previous frame made the vblank at 1000000; the next one starts
+        // just in time for the following vblank, and every other one at
+        // half the cadence.
+        const std::uint64_t lastStart = 1000000 - cost + 100;
+        FD2D_CHECK(pacer.NextFrameStartUs(lastStart, kRefreshUs) == 1016000 - cost);
+        FD2D_CHECK(pacer.NextFrameStartUs(lastStart, 2 * kRefreshUs) == 1032000 - cost);
+
+        // A phase anchor far ahead of the target steps back to the first
+        // vblank that still fits.
+        pacer.OnVblank(2000000);
+        FD2D_CHECK(pacer.NextFrameStartUs(1000000, kRefreshUs) == 1024000 - cost);
+
+        // The slow frame ages out of the cost window.
+        pacer.OnFrameRendered(12000);
+        FD2D_CHECK(pacer.PredictedFrameCostUs() > 12000);
+        for (int i = 0; i < 8; ++i)
+        {
+            pacer.OnFrameRendered(1000);
+        }
+        FD2D_CHECK(pacer.PredictedFrameCostUs() < cost);
+    }
+
+    // Any start, cost and phase: the frame ends on a vblank, no earlier than
+    // the cadence allows and no later than one refresh after that.
+    void DeadlineProperties()
+    {
+        std::mt19937_64 rng(40);
+        for (int i = 0; i < 10000; ++i)
+        {
+            FramePacer pacer;
+            pacer.SetRefreshIntervalUs(kRefreshUs);
+            const std::uint64_t phase = 1000000 + rng() % 5000000;
+            pacer.OnVblank(phase);
+            pacer.OnFrameRendered(rng() % 14000);
+            const std::uint64_t cost = pacer.PredictedFrameCostUs();
+            const std::uint64_t interval = kRefreshUs * (1 + rng() % 3);
+            const std::uint64_t lastStart = 500000 + rng() % 10000000;
+
+            const std::uint64_t start = pacer.NextFrameStartUs(lastStart, interval);
+            if (cost >= kRefreshUs)
+            {
+                FD2D_CHECK(start == lastStart + interval);
+                continue;
+            }
+            const std::uint64_t earliest = lastStart + interval - kRefreshUs / 2;
+            const std::uint64_t vblank = start + cost;
+            const std::uint64_t offset = (vblank > phase) ? (vblank - phase) : (phase - vblank);
+            FD2D_CHECK(offset % kRefreshUs == 0);
+            FD2D_CHECK(start >= earliest);
+            FD2D_CHECK(start < earliest + kRefreshUs);
+        }
+    }
+
+    void LatencySamples()
+    {
+        FramePacer pacer;
+        pacer.NotePresented(100);
+        FD2D_CHECK(pacer.Latency().samples == 0);
+
+        // The oldest input not yet shown opens the sample.
+        pacer.NoteInput(100);
+        pacer.NoteInput(50);
+        pacer.NoteInput(80);
+
+        // A present older than the input (reported late by the render
+        // thread) did not show it.
+        pacer.NotePresented(40);
+        FD2D_CHECK(pacer.Latency().samples == 0);
+
+        pacer.NotePresented(150);
+        FD2D_CHECK(pacer.Latency().samples == 1);
+        FD2D_CHECK(pacer.Latency().lastUs == 100);
+
+        pacer.NotePresented(200);
+        FD2D_CHECK(pacer.Latency().samples == 1);
+
+        pacer.NoteInput(300);
+        pacer.NotePresented(310);
+        const FramePacer::LatencyStats& stats = pacer.Latency();
+        FD2D_CHECK(stats.samples == 2);
+        FD2D_CHECK(stats.minUs == 10 && stats.maxUs == 100 && stats.lastUs == 10);
+        FD2D_CHECK(stats.totalUs == 110);
+
+        pacer.ResetLatency();
+        FD2D_CHECK(pacer.Latency().samples == 0);
+    }
+}
+
+int main()
+{
+    IntervalPacingWithoutPhase();
+    DeadlineBeforeVblank();
+    DeadlineProperties();
+    LatencySamples();
+    return Test::TestResult();
+}
@@ -0,0 +1,137 @@
+#include "FrameScheduler.h"
+#include "TestCheck.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace FD2D;
+
+namespace
+{
+    constexpr std::uint64_t kHeartbeatUs = 1000000;
+    constexpr std::uint64_t k60HzUs = 16667;
+    constexpr std::uint64_t k144HzUs = 6944;
+
+    // Targets snap to the nearest whole number of refreshes, never below one.
+    void AlignToRefreshSnapsToVsync()
+    {
+        FD2D_CHECK(FrameScheduler::AlignToRefresh(16000, k60HzUs) == k60HzUs);
+        FD2D_CHECK(FrameScheduler::AlignToRefresh(33000, k60HzUs) == 2 * k60HzUs);
+        FD2D_CHECK(FrameScheduler::AlignToRefresh(16000, k144HzUs) == 2 * k144HzUs);
+        FD2D_CHECK(FrameScheduler::AlignToRefresh(1000, k144HzUs) == k144HzUs);
+        FD2D_CHECK(FrameScheduler::AlignToRefresh(16000, 0) == 16000);
+
+        // Exactly half-way rounds up.
+        FD2D_CHECK(FrameScheduler::AlignToRefresh(15000, 10000) == 20000);
+        FD2D_CHECK(FrameScheduler::AlignToRefresh(14999, 10000) == 10000);
+    }
+
+    // A frame is due one interval after the last one; the first frame, a
+    // late frame and a clock that went backwards are all due now.
+    void AddFramePacesFromLastFrame()
+    {
+        std::uint64_t now = 5000000;
+        FrameScheduler scheduler([&now]() { return now; });
+
+        scheduler.Begin();
+        scheduler.AddFrame(now - 5000, k60HzUs);
+        FD2D_CHECK(scheduler.NextWakeUs() == now - 5000 + k60HzUs);
+        FD2D_CHECK(scheduler.WaitUs(kHeartbeatUs) == k60HzUs - 5000);
+
+        scheduler.Begin();
+        scheduler.AddFrame(0, k60HzUs);
+        FD2D_CHECK(scheduler.WaitUs(kHeartbeatUs) == 0);
+
+        scheduler.Begin();
+        scheduler.AddFrame(now - 40000, k60HzUs);
+        FD2D_CHECK(scheduler.NextWakeUs() == now);
+        FD2D_CHECK(scheduler.WaitUs(kHeartbeatUs) == 0);
+
+        scheduler.Begin();
+        scheduler.AddFrame(now + 1000, k60HzUs);
+        FD2D_CHECK(scheduler.WaitUs(kHeartbeatUs) == 0);
+
+        // The next round reads the fake clock again.
+        now += 10000;
+        scheduler.Begin();
+        scheduler.AddFrame(now - 10000, k60HzUs);
+        FD2D_CHECK(scheduler.NowUs() == now);
+        FD2D_CHECK(scheduler.WaitUs(kHeartbeatUs) == k60HzUs - 10000);
+    }
+
+    // The wait is the earliest of the animation frame and the timed events
+    // (tooltip dwell, toast expiry, autosave), whatever order they report in.
+    void WaitUsPicksEarliestDeadline()
+    {
+        std::uint64_t now = 1000000;
+        FrameScheduler scheduler([&now]() { return now; });
+
+        const std::uint64_t tooltipUs = now + 400000;
+        const std::uint64_t toastUs = now + 250000;
+        const std::uint64_t autosaveUs = now + 800000;
+        std::vector<std::uint64_t> timed { tooltipUs, toastUs, autosaveUs };
+        std::sort(timed.begin(), timed.end());
+        do
+        {
+            scheduler.Begin();
+            for (std::uint64_t deadline : timed)
+            {
+                scheduler.AddDeadline(deadline);
+            }
+            FD2D_CHECK(scheduler.WaitUs(kHeartbeatUs) == toastUs - now);
+
+            scheduler.AddFrame(now - 1000, k60HzUs);
+            FD2D_CHECK(scheduler.WaitUs(kHeartbeatUs) == k60HzUs - 1000);
+        } while (std::next_permutation(timed.begin(), timed.end()));
+
+        // Without the animation and the toast, the tooltip wins; an event
+        // already due wins over everything.
+        scheduler.Begin();
+        scheduler.AddDeadline(autosaveUs);
+        scheduler.AddDeadline(tooltipUs);
+        FD2D_CHECK(scheduler.WaitUs(kHeartbeatUs) == tooltipUs - now);
+        scheduler.AddDeadline(now - 1);
+        FD2D_CHECK(scheduler.NextWakeUs() == now);
+        FD2D_CHECK(scheduler.WaitUs(kHeartbeatUs) == 0);
+
+        // Each round starts empty.
+        scheduler.Begin();
+        FD2D_CHECK(scheduler.NextWakeUs() == FrameScheduler::kNoDeadline);
+    }
+
+    // Nothing scheduled, or only something far away, sleeps for the
+    // heartbeat and no longer.
+    void HeartbeatCapsTheWait()
+    {
+        std::uint64_t now = 1000000;
+        FrameScheduler scheduler([&now]() { return now; });
+
+        scheduler.Begin();
+        FD2D_CHECK(scheduler.WaitUs(kHeartbeatUs) == kHeartbeatUs);
+
+        scheduler.AddDeadline(now + 30 * kHeartbeatUs);
+        FD2D_CHECK(scheduler.WaitUs(kHeartbeatUs) == kHeartbeatUs);
+        FD2D_CHECK(scheduler.WaitUs(5 * kHeartbeatUs) == 5 * kHeartbeatUs);
+
+        scheduler.AddDeadline(now + kHeartbeatUs - 1);
+        FD2D_CHECK(scheduler.WaitUs(kHeartbeatUs) == kHeartbeatUs - 1);
+
+        // Without a clock Begin() keeps the previous round's time.
+        FrameScheduler clockless;
+        clockless.Begin(now);
+        clockless.Begin();
+        FD2D_CHECK(clockless.NowUs() == now);
+        clockless.AddDeadline(now + 500);
+        FD2D_CHECK(clockless.WaitUs(kHeartbeatUs) == 500);
+    }
+}
+
+int main()
+{
+    AlignToRefreshSnapsToVsync();
+    AddFramePacesFromLastFrame();
+    WaitUsPicksEarliestDeadline();
+    HeartbeatCapsTheWait();
+    return Test::TestResult();
+}
@@ -0,0 +1,245 @@
+#include "GridTracks.h"
+#include "LayoutEngine.h"
+#include "TestCheck.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+using namespace FD2D;
+
+namespace
+{
+    constexpr float kInf = std::numeric_limits<float>::infinity();
+
+    GridLength Track(GridLength::Type type, float value, float minSize = 0.0f, float maxSize = kInf)
+    {
+        return GridLength { type, value, minSize, maxSize };
+    }
+
+    std::vector<float> Share(const std::vector<float>& weights, const std::vector<float>& mins,
+                             const std::vector<float>& maxs, float space)
+    {
+        std::vector<float> sizes(weights.size(), 0.0f);
+        LayoutKernels::ShareStar(weights.data(), mins.data(), maxs.data(), weights.size(), space, sizes.data());
+        return sizes;
+    }
+
+    void StarSharesByWeight()
+    {
+        const std::vector<float> sizes = Share({ 1.0f, 2.0f, 1.0f }, { 0.0f, 0.0f, 0.0f }, { kInf, kInf, kInf }, 400.0f);
+        FD2D_CHECK_NEAR(sizes[0], 100.0f, 1e-4);
+        FD2D_CHECK_NEAR(sizes[1], 200.0f, 1e-4);
+        FD2D_CHECK_NEAR(sizes[2], 100.0f, 1e-4);
+
+        // Non-star entries are left alone.
+        std::vector<float> mixed { 77.0f, 0.0f };
+        const float weights[] = { 0.0f, 1.0f };
+        const float mins[] = { 0.0f, 0.0f };
+        const float maxs[] = { kInf, kInf };
+        LayoutKernels::ShareStar(weights, mins, maxs, 2, 50.0f, mixed.data());
+        FD2D_CHECK(mixed[0] == 77.0f);
+        FD2D_CHECK_NEAR(mixed[1], 50.0f, 1e-4);
+    }
+
+    void StarFreezesAtBounds()
+    {
+        // A minimum above the share freezes there; the rest re-share.
+        std::vector<float> sizes = Share({ 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 200.0f }, { kInf, kInf, kInf }, 300.0f);
+        FD2D_CHECK_NEAR(sizes[0], 50.0f, 1e-4);
+        FD2D_CHECK_NEAR(sizes[1], 50.0f, 1e-4);
+        FD2D_CHECK_NEAR(sizes[2], 200.0f, 1e-4);
+
+        // A maximum below the share freezes there; the rest takes the slack.
+        sizes = Share({ 1.0f, 2.0f }, { 0.0f, 0.0f }, { kInf, 120.0f }, 420.0f);
+        FD2D_CHECK_NEAR(sizes[0], 300.0f, 1e-4);
+        FD2D_CHECK_NEAR(sizes[1], 120.0f, 1e-4);
+
+        // Violations that cancel out freeze every track at once.
+        sizes = Share({ 1.0f, 1.0f, 1.0f }, { 0.0f, 150.0f, 0.0f }, { 50.0f, kInf, kInf }, 300.0f);
+        FD2D_CHECK_NEAR(sizes[0], 50.0f, 1e-4);
+        FD2D_CHECK_NEAR(sizes[1], 150.0f, 1e-4);
+        FD2D_CHECK_NEAR(sizes[2], 100.0f, 1e-4);
+
+        // Minimums win over too little space (the grid overflows).
+        sizes = Share({ 1.0f, 1.0f }, { 100.0f, 100.0f }, { kInf, kInf }, 50.0f);
+        FD2D_CHECK_NEAR(sizes[0], 100.0f, 1e-4);
+        FD2D_CHECK_NEAR(sizes[1], 100.0f, 1e-4);
+    }
+
+    void GrowTracksSpreadsEvenly()
+    {
+        float sizes[] = { 10.0f, 0.0f, 0.0f };
+        const float maxs[] = { kInf, kInf, kInf };
+        const std::uint8_t all[] = { 1, 1, 1 };
+        FD2D_CHECK(LayoutKernels::GrowTracks(sizes, maxs, all, 3, 30.0f) == 0.0f);
+        FD2D_CHECK_NEAR(sizes[0], 20.0f, 1e-4);
+        FD2D_CHECK_NEAR(sizes[1], 10.0f, 1e-4);
+        FD2D_CHECK_NEAR(sizes[2], 10.0f, 1e-4);
+
+        // A capped track hands its share to the others.
+        float capped[] = { 0.0f, 0.0f };
+        const float cappedMax[] = { 5.0f, kInf };
+        FD2D_CHECK(LayoutKernels::GrowTracks(capped, cappedMax, all, 2, 30.0f) == 0.0f);
+        FD2D_CHECK_NEAR(capped[0], 5.0f, 1e-4);
+        FD2D_CHECK_NEAR(capped[1], 25.0f, 1e-4);
+
+        // What no growable track can take is returned.
+        float partial[] = { 0.0f, 0.0f };
+        const float partialMax[] = { kInf, 10.0f };
+        const std::uint8_t second[] = { 0, 1 };
+        FD2D_CHECK_NEAR(LayoutKernels::GrowTracks(partial, partialMax, second, 2, 30.0f), 20.0f, 1e-4);
+        FD2D_CHECK(partial[0] == 0.0f);
+        FD2D_CHECK_NEAR(partial[1], 10.0f, 1e-4);
+
+        const std::uint8_t none[] = { 0, 0 };
+        FD2D_CHECK(LayoutKernels::GrowTracks(partial, partialMax, none, 2, 7.0f) == 7.0f);
+    }
+
+    void AxisDefinitions()
+    {
+        GridTrackAxis axis({ Track(GridLength::Type::Fixed, 300.0f, 0.0f, 200.0f),
+                             Track(GridLength::Type::Fixed, 10.0f, 40.0f),
+                             Track(GridLength::Type::Auto, 0.0f, 30.0f),
+                             Track(GridLength::Type::Star, 0.0f) },
+                           false);
+        FD2D_CHECK(axis.sizes[0] == 200.0f);
+        FD2D_CHECK(axis.sizes[1] == 40.0f);
+        FD2D_CHECK(axis.sizes[2] == 30.0f && axis.growable[2] == 1);
+        // A zero-weight Star track takes nothing.
+        FD2D_CHECK(axis.weights[3] == 0.0f && axis.growable[3] == 0);
+
+        axis.FitSingle(2, 10.0f);
+        FD2D_CHECK(axis.sizes[2] == 30.0f);
+        axis.FitSingle(0, 500.0f); // Fixed: not growable
+        FD2D_CHECK(axis.sizes[0] == 200.0f);
+    }
+
+    void SpansAcrossAutoAndFixed()
+    {
+        GridTrackAxis axis({ Track(GridLength::Type::Fixed, 100.0f), Track(GridLength::Type::Auto, 0.0f) }, false);
+        FD2D_CHECK(axis.SpanAvailable(0, 1, 500.0f) == 100.0f);
+        FD2D_CHECK(axis.SpanAvailable(0, 2, 500.0f) == 500.0f);
+        FD2D_CHECK(!axis.SpansStar(0, 2));
+
+        // Only the Auto track grows; the Fixed one counts toward the extent.
+        axis.FitSpan(0, 2, 160.0f);
+        FD2D_CHECK_NEAR(axis.sizes[1], 60.0f, 1e-4);
+        axis.FitSpan(0, 2, 120.0f); // already fits
+        FD2D_CHECK_NEAR(axis.sizes[1], 60.0f, 1e-4);
+
+        // Two Auto tracks, one capped, around a Fixed one.
+        GridTrackAxis capped({ Track(GridLength::Type::Auto, 0.0f, 0.0f, 20.0f),
+                               Track(GridLength::Type::Auto, 0.0f),
+                               Track(GridLength::Type::Fixed, 10.0f) },
+                             false);
+        capped.FitSpan(0, 3, 100.0f);
+        FD2D_CHECK_NEAR(capped.sizes[0], 20.0f, 1e-4);
+        FD2D_CHECK_NEAR(capped.sizes[1], 70.0f, 1e-4);
+        FD2D_CHECK_NEAR(capped.Total(), 100.0f, 1e-4);
+    }
+
+    void UnboundedStarSizesToContent()
+    {
+        const std::vector<GridLength> defs { Track(GridLength::Type::Star, 1.0f), Track(GridLength::Type::Star, 3.0f) };
+
+        GridTrackAxis unbounded(defs, true);
+        FD2D_CHECK(!unbounded.SpansStar(0, 2));
+        unbounded.FitSingle(0, 80.0f);
+        unbounded.FitSingle(1, 20.0f);
+        unbounded.ShareStar(1.0e9f);
+        FD2D_CHECK_NEAR(unbounded.sizes[0], 80.0f, 1e-4);
+        FD2D_CHECK_NEAR(unbounded.sizes[1], 20.0f, 1e-4);
+
+        GridTrackAxis bounded(defs, false);
+        FD2D_CHECK(bounded.SpansStar(1, 1));
+        bounded.ShareStar(400.0f);
+        FD2D_CHECK_NEAR(bounded.sizes[0], 100.0f, 1e-4);
+        FD2D_CHECK_NEAR(bounded.sizes[1], 300.0f, 1e-4);
+    }
+
+    // A whole axis as GridPanel resolves it: Fixed, Auto fitted to content,
+    // and two Star tracks with bounds, at a roomy and a cramped size.
+    void ReferenceAxis()
+    {
+        const std::vector<GridLength> defs { Track(GridLength::Type::Fixed, 100.0f),
+                                             Track(GridLength::Type::Auto, 0.0f),
+                                             Track(GridLength::Type::Star, 1.0f, 50.0f),
+                                             Track(GridLength::Type::Star, 2.0f, 0.0f, 120.0f) };
+        GridTrackAxis roomy(defs, false);
+        roomy.FitSingle(1, 80.0f);
+        roomy.ShareStar(600.0f);
+        const float expected[] = { 100.0f, 80.0f, 300.0f, 120.0f };
+        for (int i = 0; i < 4; ++i)
+        {
+            FD2D_CHECK_NEAR(roomy.sizes[i], expected[i], 1e-4);
+        }
+        FD2D_CHECK_NEAR(roomy.Total(), 600.0f, 1e-4);
+
+        GridTrackAxis cramped(defs, false);
+        cramped.FitSingle(1, 80.0f);
+        cramped.ShareStar(200.0f);
+        FD2D_CHECK_NEAR(cramped.sizes[2], 50.0f, 1e-4);
+        FD2D_CHECK_NEAR(cramped.sizes[3], 0.0f, 1e-4);
+        FD2D_CHECK_NEAR(cramped.Total(), 230.0f, 1e-4);
+    }
+
+    // The track work of one GridPanel measure over 1000 rows x 10 columns
+    // (every cell filled, every fifth one spanning two columns).
+    void BenchGrid()
+    {
+        constexpr int kRows = 1000;
+        constexpr int kColumns = 10;
+        std::vector<GridLength> columnDefs(kColumns, Track(GridLength::Type::Auto, 0.0f));
+        columnDefs[0] = Track(GridLength::Type::Fixed, 48.0f);
+        columnDefs[kColumns - 1] = Track(GridLength::Type::Star, 1.0f, 40.0f);
+        const std::vector<GridLength> rowDefs(kRows, Track(GridLength::Type::Auto, 0.0f));
+
+        constexpr int kPasses = 200;
+        float sink = 0.0f;
+        const double start = Test::NowUs();
+        for (int pass = 0; pass < kPasses; ++pass)
+        {
+            GridTrackAxis cols(columnDefs, false);
+            GridTrackAxis rows(rowDefs, false);
+            for (int r = 0; r < kRows; ++r)
+            {
+                for (int c = 0; c < kColumns - 1; ++c)
+                {
+                    const float w = 20.0f + static_cast<float>((r * 7 + c * 13 + pass) % 90);
+                    if ((r + c) % 5 == 0 && c + 2 < kColumns)
+                    {
+                        cols.FitSpan(c, 2, 1.6f * w);
+                    }
+                    else
+                    {
+                        cols.FitSingle(c, w);
+                    }
+                    rows.FitSingle(r, 12.0f + static_cast<float>((r + c) % 9));
+                }
+            }
+            cols.ShareStar(1600.0f);
+            rows.ShareStar(1.0e9f);
+            sink += cols.Total() + rows.Total();
+        }
+        std::printf("grid tracks, 1000x10 cells: %.1f us per measure (%g)\n",
+                    (Test::NowUs() - start) / kPasses, static_cast<double>(sink));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    StarSharesByWeight();
+    StarFreezesAtBounds();
+    GrowTracksSpreadsEvenly();
+    AxisDefinitions();
+    SpansAcrossAutoAndFixed();
+    UnboundedStarSizesToContent();
+    ReferenceAxis();
+    if (Test::BenchRequested(argc, argv))
+    {
+        BenchGrid();
+    }
+    return Test::TestResult();
+}
@@ -0,0 +1,399 @@
+#include "ImagePipeline.h"
+#include "TestCheck.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace FD2D;
+
+namespace
+{
+    // One opaque pixel per source, decoded instantly.
+    class PixelDecoder : public ImageDecoder
+    {
+    public:
+        bool Decode(const std::wstring& source, const std::atomic<bool>& cancelled, DecodedImage& out) override
+        {
+            (void)source;
+            (void)cancelled;
+            out.width = 1;
+            out.height = 1;
+            out.stride = 4;
+            out.pixels.assign(4, 0xFF);
+            return true;
+        }
+    };
+
+    // Records the order sources start decoding and holds every decode at a
+    // gate until the test opens it, so queue order can be observed with a
+    // single worker. "spin" instead waits for its cancel flag and bails out.
+    class GatedDecoder : public ImageDecoder
+    {
+    public:
+        bool Decode(const std::wstring& source, const std::atomic<bool>& cancelled, DecodedImage& out) override
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_started.push_back(source);
+                ++m_counts[source];
+                m_changed.notify_all();
+                if (source != L"spin")
+                {
+                    m_changed.wait(lock, [this]() { return m_open; });
+                }
+            }
+
+            if (source == L"spin")
+            {
+                const double deadline = Test::NowUs() + 5.0e6;
+                while (!cancelled.load() && Test::NowUs() < deadline)
+                {
+                    std::this_thread::yield();
+                }
+                m_sawCancel.store(cancelled.load());
+                return false;
+            }
+
+            out.width = 5;
+            out.height = 5;
+            out.stride = 20;
+            out.pixels.assign(100, 0xFF);
+            return true;
+        }
+
+        void Close()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_open = false;
+        }
+
+        void Open()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_open = true;
+            m_changed.notify_all();
+        }
+
+        bool WaitStarted(const std::wstring& source)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            return m_changed.wait_for(lock, std::chrono::seconds(5), [&]() { return m_counts.count(source) != 0; });
+        }
+
+        std::vector<std::wstring> Started()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_started;
+        }
+
+        int Count(const std::wstring& source)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_counts.find(source);
+            return it == m_counts.end() ? 0 : it->second;
+        }
+
+        bool SawCancel() const { return m_sawCancel.load(); }
+
+    private:
+        std::mutex m_mutex {};
+        std::condition_variable m_changed {};
+        bool m_open { true };
+        std::vector<std::wstring> m_started {};
+        std::map<std::wstring, int> m_counts {};
+        std::atomic<bool> m_sawCancel { false };
+    };
+
+    ImagePipeline::Options OneWorker()
+    {
+        ImagePipeline::Options options {};
+        options.workerCount = 1;
+        return options;
+    }
+
+    bool WaitIdle(const ImagePipeline& pipeline)
+    {
+        const double deadline = Test::NowUs() + 5.0e6;
+        for (;;)
+        {
+            const ImagePipeline::Stats stats = pipeline.GetStats();
+            if (stats.queuedJobs == 0 && stats.runningJobs == 0)
+            {
+                return true;
+            }
+            if (Test::NowUs() > deadline)
+            {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    bool WaitForDeliveries(const ImagePipeline& pipeline, ImagePipeline::Owner owner)
+    {
+        const double deadline = Test::NowUs() + 5.0e6;
+        while (!pipeline.HasPendingDeliveries(owner))
+        {
+            if (Test::NowUs() > deadline)
+            {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    // Two windows sharing one pipeline: each is woken for, and delivers,
+    // only its own requests.
+    void DeliveriesStayWithTheirOwner()
+    {
+        ImagePipeline pipeline(std::make_shared<PixelDecoder>(), ImagePipeline::Options {});
+        const int windowA = 0;
+        const int windowB = 0;
+        std::atomic<int> wakesA { 0 };
+        std::atomic<int> wakesB { 0 };
+        pipeline.SetWakeCallback(&windowA, [&] { wakesA.fetch_add(1); });
+        pipeline.SetWakeCallback(&windowB, [&] { wakesB.fetch_add(1); });
+
+        int deliveredA = 0;
+        int deliveredB = 0;
+        pipeline.Request(L"a", ImageLoadPriority::Visible, [&](std::shared_ptr<const DecodedImage>) { ++deliveredA; }, false, &windowA);
+        FD2D_CHECK(WaitForDeliveries(pipeline, &windowA));
+        FD2D_CHECK(wakesA.load() == 1);
+        FD2D_CHECK(wakesB.load() == 0);
+        FD2D_CHECK(!pipeline.HasPendingDeliveries(&windowB));
+
+        pipeline.Request(L"b", ImageLoadPriority::Visible, [&](std::shared_ptr<const DecodedImage>) { ++deliveredB; }, false, &windowB);
+        FD2D_CHECK(WaitForDeliveries(pipeline, &windowB));
+        FD2D_CHECK(wakesA.load() == 1);
+        FD2D_CHECK(wakesB.load() == 1);
+
+        FD2D_CHECK(!pipeline.DeliverCompleted(0, 0, &windowA));
+        FD2D_CHECK(deliveredA == 1);
+        FD2D_CHECK(deliveredB == 0);
+        FD2D_CHECK(pipeline.HasPendingDeliveries(&windowB));
+
+        FD2D_CHECK(!pipeline.DeliverCompleted(0, 0, &windowB));
+        FD2D_CHECK(deliveredB == 1);
+
+        // A detached window is no longer woken; the other still is.
+        pipeline.SetWakeCallback(&windowA, nullptr);
+        pipeline.Request(L"a", ImageLoadPriority::Visible, [&](std::shared_ptr<const DecodedImage>) { ++deliveredA; }, false, &windowA);
+        pipeline.Request(L"b", ImageLoadPriority::Visible, [&](std::shared_ptr<const DecodedImage>) { ++deliveredB; }, false, &windowB);
+        FD2D_CHECK(wakesA.load() == 1);
+        FD2D_CHECK(wakesB.load() == 2);
+        FD2D_CHECK(!pipeline.DeliverCompleted(0, 0, &windowB));
+        FD2D_CHECK(deliveredB == 2);
+        FD2D_CHECK(deliveredA == 1);
+    }
+
+    // An ownerless callback and ownerless requests keep the single-window
+    // behaviour: everything wakes it and any DeliverCompleted runs them.
+    void OwnerlessRequestsGoAnywhere()
+    {
+        ImagePipeline pipeline(std::make_shared<PixelDecoder>(), ImagePipeline::Options {});
+        const int window = 0;
+        std::atomic<int> wakesAll { 0 };
+        std::atomic<int> wakesWindow { 0 };
+        pipeline.SetWakeCallback([&] { wakesAll.fetch_add(1); });
+        pipeline.SetWakeCallback(&window, [&] { wakesWindow.fetch_add(1); });
+
+        int delivered = 0;
+        pipeline.Request(L"x", ImageLoadPriority::Visible, [&](std::shared_ptr<const DecodedImage>) { ++delivered; });
+        FD2D_CHECK(WaitForDeliveries(pipeline, &window));
+        FD2D_CHECK(wakesAll.load() == 1);
+        FD2D_CHECK(wakesWindow.load() == 1);
+        FD2D_CHECK(!pipeline.DeliverCompleted(1, 0, &window));
+        FD2D_CHECK(delivered == 1);
+    }
+
+    // Cancelling drops a result that is ready but not yet delivered.
+    void CancelDropsReadyDelivery()
+    {
+        ImagePipeline pipeline(std::make_shared<PixelDecoder>(), ImagePipeline::Options {});
+        const int window = 0;
+        int delivered = 0;
+        const ImagePipeline::RequestId request = pipeline.Request(
+            L"y", ImageLoadPriority::Visible, [&](std::shared_ptr<const DecodedImage>) { ++delivered; }, false, &window);
+        FD2D_CHECK(WaitForDeliveries(pipeline, &window));
+        pipeline.Cancel(request);
+        FD2D_CHECK(!pipeline.HasPendingDeliveries(&window));
+        FD2D_CHECK(!pipeline.DeliverCompleted(0, 0));
+        FD2D_CHECK(delivered == 0);
+    }
+
+    // With the only worker held, a Visible request queued after a Prefetch
+    // one still decodes first.
+    void VisibleRunsBeforePrefetch()
+    {
+        auto decoder = std::make_shared<GatedDecoder>();
+        ImagePipeline pipeline(decoder, OneWorker());
+        decoder->Close();
+        pipeline.Request(L"hold", ImageLoadPriority::Visible, nullptr);
+        FD2D_CHECK(decoder->WaitStarted(L"hold"));
+
+        pipeline.Request(L"prefetch", ImageLoadPriority::Prefetch, nullptr);
+        pipeline.Request(L"visible", ImageLoadPriority::Visible, nullptr);
+        decoder->Open();
+        FD2D_CHECK(WaitIdle(pipeline));
+
+        const std::vector<std::wstring> expected { L"hold", L"visible", L"prefetch" };
+        FD2D_CHECK(decoder->Started() == expected);
+    }
+
+    // Raising a queued request's priority moves its job ahead of older
+    // Prefetch work; lowering it again puts it back in sequence order.
+    void SetPriorityMovesQueuedJob()
+    {
+        auto decoder = std::make_shared<GatedDecoder>();
+        ImagePipeline pipeline(decoder, OneWorker());
+        decoder->Close();
+        pipeline.Request(L"hold", ImageLoadPriority::Visible, nullptr);
+        FD2D_CHECK(decoder->WaitStarted(L"hold"));
+
+        pipeline.Request(L"a", ImageLoadPriority::Prefetch, nullptr);
+        const ImagePipeline::RequestId b = pipeline.Request(L"b", ImageLoadPriority::Prefetch, nullptr);
+        const ImagePipeline::RequestId c = pipeline.Request(L"c", ImageLoadPriority::Visible, nullptr);
+        pipeline.SetPriority(b, ImageLoadPriority::Visible);
+        pipeline.SetPriority(c, ImageLoadPriority::Prefetch);
+        decoder->Open();
+        FD2D_CHECK(WaitIdle(pipeline));
+
+        const std::vector<std::wstring> expected { L"hold", L"b", L"a", L"c" };
+        FD2D_CHECK(decoder->Started() == expected);
+    }
+
+    // Two requests for one source join a single job: one decode, and both
+    // completions receive the same image.
+    void SameSourceSharesDecode()
+    {
+        auto decoder = std::make_shared<GatedDecoder>();
+        ImagePipeline pipeline(decoder, OneWorker());
+        decoder->Close();
+        pipeline.Request(L"hold", ImageLoadPriority::Visible, nullptr);
+        FD2D_CHECK(decoder->WaitStarted(L"hold"));
+
+        std::shared_ptr<const DecodedImage> first;
+        std::shared_ptr<const DecodedImage> second;
+        pipeline.Request(L"s", ImageLoadPriority::Prefetch, [&](std::shared_ptr<const DecodedImage> image) { first = image; });
+        pipeline.Request(L"s", ImageLoadPriority::Visible, [&](std::shared_ptr<const DecodedImage> image) { second = image; });
+        FD2D_CHECK(pipeline.GetStats().queuedJobs == 1);
+        decoder->Open();
+        FD2D_CHECK(WaitIdle(pipeline));
+
+        FD2D_CHECK(decoder->Count(L"s") == 1);
+        FD2D_CHECK(!pipeline.DeliverCompleted(0, 0));
+        FD2D_CHECK(first != nullptr);
+        FD2D_CHECK(first == second);
+        FD2D_CHECK(pipeline.GetStats().decodes == 2);
+    }
+
+    std::shared_ptr<const DecodedImage> Image(std::size_t bytes)
+    {
+        auto image = std::make_shared<DecodedImage>();
+        image->pixels.assign(bytes, 0);
+        return image;
+    }
+
+    // Inserts past the budget evict from the cold end; a Find refreshes an
+    // entry, and an image bigger than the whole budget is not cached.
+    void CacheEvictsLeastRecentlyUsed()
+    {
+        DecodedImageCache cache;
+        cache.SetBudget(250);
+        cache.Insert(L"a", Image(100));
+        cache.Insert(L"b", Image(100));
+        FD2D_CHECK(cache.Bytes() == 200);
+
+        FD2D_CHECK(cache.Find(L"a") != nullptr);
+        cache.Insert(L"c", Image(100));
+        FD2D_CHECK(cache.Bytes() <= cache.Budget());
+        FD2D_CHECK(cache.Count() == 2);
+        FD2D_CHECK(cache.Find(L"b") == nullptr);
+        FD2D_CHECK(cache.Find(L"a") != nullptr);
+        FD2D_CHECK(cache.Find(L"c") != nullptr);
+
+        cache.Insert(L"d", Image(200));
+        FD2D_CHECK(cache.Bytes() == 200);
+        FD2D_CHECK(cache.Count() == 1);
+        FD2D_CHECK(cache.Find(L"d") != nullptr);
+
+        cache.Insert(L"huge", Image(300));
+        FD2D_CHECK(cache.Find(L"huge") == nullptr);
+        FD2D_CHECK(cache.Find(L"d") != nullptr);
+
+        cache.SetBudget(100);
+        FD2D_CHECK(cache.Count() == 0);
+        FD2D_CHECK(cache.Bytes() == 0);
+    }
+
+    // A job cancelled while still queued never reaches the decoder.
+    void CancelQueuedJobNeverRuns()
+    {
+        auto decoder = std::make_shared<GatedDecoder>();
+        ImagePipeline pipeline(decoder, OneWorker());
+        decoder->Close();
+        pipeline.Request(L"hold", ImageLoadPriority::Visible, nullptr);
+        FD2D_CHECK(decoder->WaitStarted(L"hold"));
+
+        int delivered = 0;
+        const ImagePipeline::RequestId request = pipeline.Request(
+            L"x", ImageLoadPriority::Visible, [&](std::shared_ptr<const DecodedImage>) { ++delivered; });
+        pipeline.Request(L"after", ImageLoadPriority::Prefetch, nullptr);
+        pipeline.Cancel(request);
+        decoder->Open();
+        FD2D_CHECK(WaitIdle(pipeline));
+
+        FD2D_CHECK(decoder->Count(L"x") == 0);
+        FD2D_CHECK(decoder->Count(L"after") == 1);
+        FD2D_CHECK(pipeline.GetStats().cancelledJobs == 1);
+        pipeline.DeliverCompleted(0, 0);
+        FD2D_CHECK(delivered == 0);
+    }
+
+    // Cancelling a running job raises the flag the decoder polls, and the
+    // abandoned job is neither delivered nor counted as a failure.
+    void CancelRunningJobIsSeen()
+    {
+        auto decoder = std::make_shared<GatedDecoder>();
+        ImagePipeline pipeline(decoder, OneWorker());
+        int delivered = 0;
+        const ImagePipeline::RequestId request = pipeline.Request(
+            L"spin", ImageLoadPriority::Visible, [&](std::shared_ptr<const DecodedImage>) { ++delivered; });
+        FD2D_CHECK(decoder->WaitStarted(L"spin"));
+        FD2D_CHECK(pipeline.GetStats().runningJobs == 1);
+
+        pipeline.Cancel(request);
+        FD2D_CHECK(WaitIdle(pipeline));
+
+        FD2D_CHECK(decoder->SawCancel());
+        const ImagePipeline::Stats stats = pipeline.GetStats();
+        FD2D_CHECK(stats.cancelledJobs == 1);
+        FD2D_CHECK(stats.decodeFailures == 0);
+        FD2D_CHECK(stats.cacheEntries == 0);
+        FD2D_CHECK(!pipeline.HasPendingDeliveries());
+        pipeline.DeliverCompleted(0, 0);
+        FD2D_CHECK(delivered == 0);
+    }
+}
+
+int main()
+{
+    DeliveriesStayWithTheirOwner();
+    OwnerlessRequestsGoAnywhere();
+    CancelDropsReadyDelivery();
+    VisibleRunsBeforePrefetch();
+    SetPriorityMovesQueuedJob();
+    SameSourceSharesDecode();
+    CacheEvictsLeastRecentlyUsed();
+    CancelQueuedJobNeverRuns();
+    CancelRunningJobIsSeen();
+    return Test::TestResult();
+}
@@ -0,0 +1,88 @@
+#include "LayoutBenchReport.h"
+#include "TestCheck.h"
+
+#include <string>
+#include <vector>
+
+using namespace FD2D;
+
+namespace
+{
+    LayoutBenchResult Result(const char* name, double p50Us)
+    {
+        LayoutBenchResult result;
+        result.name = name;
+        result.nodes = 100;
+        result.iterations = 10;
+        result.minUs = p50Us * 0.9;
+        result.meanUs = p50Us;
+        result.p50Us = p50Us;
+        result.p95Us = p50Us * 1.5;
+        return result;
+    }
+
+    void SummaryPercentiles()
+    {
+        std::vector<double> samples { 9.0, 1.0, 5.0, 3.0, 7.0, 2.0, 8.0, 4.0, 10.0, 6.0 };
+        const LayoutBenchResult result = SummarizeLayoutSamples("grid/full", 42, samples);
+        FD2D_CHECK(result.name == "grid/full");
+        FD2D_CHECK(result.nodes == 42);
+        FD2D_CHECK(result.iterations == 10);
+        FD2D_CHECK_NEAR(result.minUs, 1.0, 0.0);
+        FD2D_CHECK_NEAR(result.meanUs, 5.5, 1e-12);
+        FD2D_CHECK_NEAR(result.p50Us, 5.0, 0.0);
+        FD2D_CHECK_NEAR(result.p95Us, 10.0, 0.0);
+
+        std::vector<double> none;
+        FD2D_CHECK(SummarizeLayoutSamples("empty", 1, none).iterations == 0);
+    }
+
+    void JsonRoundTrip()
+    {
+        std::vector<LayoutBenchResult> results { Result("stack/full", 120.25), Result("we\"ird\\name", 3.5) };
+        const std::string json = LayoutBenchToJson(results);
+
+        std::vector<LayoutBenchResult> parsed;
+        FD2D_CHECK(ParseLayoutBench(json, &parsed));
+        FD2D_CHECK(parsed.size() == results.size());
+        for (std::size_t i = 0; i < parsed.size() && i < results.size(); ++i)
+        {
+            FD2D_CHECK(parsed[i].name == results[i].name);
+            FD2D_CHECK(parsed[i].nodes == results[i].nodes);
+            FD2D_CHECK(parsed[i].iterations == results[i].iterations);
+            FD2D_CHECK_NEAR(parsed[i].p50Us, results[i].p50Us, 1e-6);
+            FD2D_CHECK_NEAR(parsed[i].p95Us, results[i].p95Us, 1e-6);
+        }
+
+        std::vector<LayoutBenchResult> untouched { Result("keep", 1.0) };
+        FD2D_CHECK(!ParseLayoutBench("{\"schema\":1,\"results\":[{\"name\":", &untouched));
+        FD2D_CHECK(untouched.size() == 1);
+    }
+
+    void BaselineGate()
+    {
+        const std::string baseline = LayoutBenchToJson({ Result("a", 100.0), Result("b", 2.0), Result("gone", 50.0) });
+
+        // a: +5% (within tolerance); b: +50% but only 1 us (noise floor);
+        // new: no baseline to compare against.
+        std::vector<LayoutBaselineDelta> deltas;
+        FD2D_CHECK(CompareLayoutBaseline(baseline, { Result("a", 105.0), Result("b", 3.0), Result("new", 999.0) },
+                                         0.10, 5.0, &deltas));
+        FD2D_CHECK(deltas.size() == 2);
+
+        deltas.clear();
+        FD2D_CHECK(!CompareLayoutBaseline(baseline, { Result("a", 120.0), Result("b", 2.0) }, 0.10, 5.0, &deltas));
+        FD2D_CHECK(deltas.size() == 2 && deltas[0].regressed && !deltas[1].regressed);
+        FD2D_CHECK_NEAR(deltas[0].ratio, 1.2, 1e-9);
+
+        FD2D_CHECK(!CompareLayoutBaseline("not json", { Result("a", 1.0) }, 0.10, 5.0, nullptr));
+    }
+}
+
+int main()
+{
+    SummaryPercentiles();
+    JsonRoundTrip();
+    BaselineGate();
+    return Test::TestResult();
+}
@@ -0,0 +1,747 @@
+#include "LayoutEngine.h"
+#include "TestCheck.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <vector>
+
+using namespace FD2D;
+
+namespace
+{
+    constexpr float kInf = std::numeric_limits<float>::infinity();
+    constexpr float kUnbounded = 1.0e9f;
+
+    // The recursive layout the engine replaces: one heap object per node,
+    // virtual calls per panel kind, children measured depth-first before
+    // their parent. Same box model and arithmetic as LayoutEngine, so both
+    // must agree on every box.
+    struct RefNode
+    {
+        virtual ~RefNode() = default;
+
+        float margin { 0.0f };
+        float padding { 0.0f };
+        float spacing { 0.0f };
+        float rowSpacing { 0.0f };
+        std::vector<std::unique_ptr<RefNode>> children {};
+        float desiredW { 0.0f };
+        float desiredH { 0.0f };
+        LayoutEngine::Box box {};
+
+        void Measure(float availW, float availH)
+        {
+            const float chrome = 2.0f * (margin + padding);
+            const bool unconstrained = !(availW < kUnbounded);
+            const float innerW = unconstrained ? kUnbounded : (std::max)(0.0f, availW - chrome);
+            const float innerH = !(availH < kUnbounded) ? kUnbounded : (std::max)(0.0f, availH - chrome);
+            const float childH = WrapsChildren() ? kUnbounded : innerH;
+            for (const auto& child : children)
+            {
+                child->Measure(innerW, childH);
+            }
+            float w = 0.0f;
+            float h = 0.0f;
+            MeasureContent(innerW, unconstrained, w, h);
+            desiredW = w + chrome;
+            desiredH = h + chrome;
+        }
+
+        void Arrange(const LayoutEngine::Box& rect)
+        {
+            box = rect;
+            if (children.empty())
+            {
+                return;
+            }
+            const float inset = margin + padding;
+            ArrangeChildren(box.x + inset, box.y + inset,
+                (std::max)(0.0f, box.w - 2.0f * inset), (std::max)(0.0f, box.h - 2.0f * inset));
+        }
+
+        virtual bool WrapsChildren() const { return false; }
+        virtual void MeasureContent(float innerW, bool unconstrained, float& w, float& h) = 0;
+        virtual void ArrangeChildren(float cx, float cy, float cw, float ch) = 0;
+    };
+
+    struct RefLeaf : RefNode
+    {
+        float leafW { 0.0f };
+        float leafH { 0.0f };
+
+        void MeasureContent(float, bool, float& w, float& h) override
+        {
+            w = leafW;
+            h = leafH;
+        }
+        void ArrangeChildren(float, float, float, float) override {}
+    };
+
+    struct RefOverlay : RefNode
+    {
+        void MeasureContent(float, bool, float& w, float& h) override
+        {
+            for (const auto& child : children)
+            {
+                w = (std::max)(w, child->desiredW);
+                h = (std::max)(h, child->desiredH);
+            }
+        }
+        void ArrangeChildren(float cx, float cy, float cw, float ch) override
+        {
+            for (const auto& child : children)
+            {
+                child->Arrange({ cx, cy, cw, ch });
+            }
+        }
+    };
+
+    struct RefStack : RefNode
+    {
+        bool vertical { true };
+
+        void MeasureContent(float, bool, float& w, float& h) override
+        {
+            float offset = 0.0f;
+            float cross = 0.0f;
+            for (const auto& child : children)
+            {
+                offset += (vertical ? child->desiredH : child->desiredW) + spacing;
+                cross = (std::max)(cross, vertical ? child->desiredW : child->desiredH);
+            }
+            const float main = children.empty() ? 0.0f : offset - spacing;
+            w = vertical ? cross : main;
+            h = vertical ? main : cross;
+        }
+        void ArrangeChildren(float cx, float cy, float cw, float ch) override
+        {
+            float offset = vertical ? cy : cx;
+            for (const auto& child : children)
+            {
+                if (vertical)
+                {
+                    child->Arrange({ cx, offset, cw, child->desiredH });
+                    offset += child->desiredH + spacing;
+                }
+                else
+                {
+                    child->Arrange({ offset, cy, child->desiredW, ch });
+                    offset += child->desiredW + spacing;
+                }
+            }
+        }
+    };
+
+    struct RefWrap : RefNode
+    {
+        bool WrapsChildren() const override { return true; }
+
+        // Walks the rows; place(i, x, y) for every child. Returns the height.
+        template <typename Place>
+        float Flow(float contentWidth, float& usedW, Place&& place)
+        {
+            float x = 0.0f, y = 0.0f, rowH = 0.0f;
+            usedW = 0.0f;
+            bool rowEmpty = true;
+            for (std::size_t i = 0; i < children.size(); ++i)
+            {
+                const RefNode& child = *children[i];
+                if (!rowEmpty && (x + spacing + child.desiredW) > contentWidth)
+                {
+                    usedW = (std::max)(usedW, x);
+                    x = 0.0f;
+                    y += rowH + rowSpacing;
+                    rowH = 0.0f;
+                    rowEmpty = true;
+                }
+                if (!rowEmpty)
+                {
+                    x += spacing;
+                }
+                place(i, x, y);
+                x += child.desiredW;
+                rowH = (std::max)(rowH, child.desiredH);
+                rowEmpty = false;
+            }
+            usedW = (std::max)(usedW, x);
+            return y + rowH;
+        }
+
+        void MeasureContent(float innerW, bool unconstrained, float& w, float& h) override
+        {
+            float usedW = 0.0f;
+            h = Flow(innerW, usedW, [](std::size_t, float, float) {});
+            w = unconstrained ? usedW : (std::min)(usedW, innerW);
+        }
+        void ArrangeChildren(float cx, float cy, float cw, float) override
+        {
+            float usedW = 0.0f;
+            (void)Flow(cw, usedW, [&](std::size_t i, float x, float y)
+            {
+                RefNode& child = *children[i];
+                child.Arrange({ cx + x, cy + y, child.desiredW, child.desiredH });
+            });
+        }
+    };
+
+    struct Random
+    {
+        std::uint32_t state { 1 };
+        std::uint32_t Next()
+        {
+            state = state * 1664525u + 1013904223u;
+            return state >> 8;
+        }
+        float Whole(std::uint32_t lo, std::uint32_t hi) { return static_cast<float>(lo + Next() % (hi - lo + 1)); }
+    };
+
+    // The same synthetic tree in both representations: a vertical stack of
+    // nested stacks, overlays and wrap panels, breadth-first up to `count`
+    // nodes, at most `maxDepth` containers deep. refs[id] is the reference
+    // node for engine node `id`.
+    std::unique_ptr<RefNode> BuildTree(std::size_t count, std::uint32_t seed, std::size_t maxDepth,
+        LayoutEngine& engine, std::vector<RefNode*>& refs)
+    {
+        Random random { seed };
+        engine.Clear();
+        engine.Reserve(count);
+        refs.clear();
+        refs.reserve(count);
+
+        auto root = std::make_unique<RefStack>();
+        engine.CreateNode(LayoutKind::StackV);
+        refs.push_back(root.get());
+
+        struct Open
+        {
+            LayoutNodeId id;
+            std::size_t depth;
+        };
+        std::deque<Open> open { Open { 0, 0 } };
+        while (refs.size() < count)
+        {
+            if (open.empty())
+            {
+                open.push_back(Open { 0, 0 });
+            }
+            const Open parent = open.front();
+            open.pop_front();
+
+            const std::size_t fanout = 2 + random.Next() % 11;
+            for (std::size_t i = 0; i < fanout && refs.size() < count; ++i)
+            {
+                const bool container = parent.depth + 1 < maxDepth && random.Next() % 10 < 3;
+                const LayoutKind kind = container
+                    ? static_cast<LayoutKind>(1 + random.Next() % 4)
+                    : LayoutKind::Leaf;
+                const LayoutNodeId id = engine.CreateNode(kind, parent.id);
+
+                std::unique_ptr<RefNode> node;
+                switch (kind)
+                {
+                case LayoutKind::Leaf:
+                {
+                    auto leaf = std::make_unique<RefLeaf>();
+                    leaf->leafW = random.Whole(10, 120);
+                    leaf->leafH = random.Whole(10, 60);
+                    engine.SetLeafSize(id, leaf->leafW, leaf->leafH);
+                    node = std::move(leaf);
+                    break;
+                }
+                case LayoutKind::Overlay:
+                    node = std::make_unique<RefOverlay>();
+                    break;
+                case LayoutKind::StackV:
+                case LayoutKind::StackH:
+                {
+                    auto stack = std::make_unique<RefStack>();
+                    stack->vertical = (kind == LayoutKind::StackV);
+                    node = std::move(stack);
+                    break;
+                }
+                case LayoutKind::Wrap:
+                    node = std::make_unique<RefWrap>();
+                    break;
+                }
+
+                node->margin = random.Whole(0, 3);
+                node->padding = random.Whole(0, 3);
+                node->spacing = random.Whole(0, 6);
+                node->rowSpacing = random.Whole(0, 6);
+                engine.SetMargin(id, node->margin);
+                engine.SetPadding(id, node->padding);
+                engine.SetSpacing(id, node->spacing);
+                engine.SetRowSpacing(id, node->rowSpacing);
+
+                refs.push_back(node.get());
+                refs[parent.id]->children.push_back(std::move(node));
+                if (container)
+                {
+                    open.push_back(Open { id, parent.depth + 1 });
+                }
+            }
+        }
+        return root;
+    }
+
+    // Largest difference between the engine and the reference over every
+    // node's desired size and box.
+    float MaxDifference(const LayoutEngine& engine, const std::vector<RefNode*>& refs)
+    {
+        float worst = 0.0f;
+        for (LayoutNodeId id = 0; id < refs.size(); ++id)
+        {
+            const RefNode& ref = *refs[id];
+            const LayoutEngine::Box box = engine.GetBox(id);
+            for (const float d : { engine.DesiredW(id) - ref.desiredW, engine.DesiredH(id) - ref.desiredH,
+                                   box.x - ref.box.x, box.y - ref.box.y, box.w - ref.box.w, box.h - ref.box.h })
+            {
+                worst = (std::max)(worst, std::fabs(d));
+            }
+        }
+        return worst;
+    }
+
+    // Hand-computed breaks and the width interval over which they hold.
+    void BreakRowsMatchesHandLayout()
+    {
+        std::uint32_t ends[8] {};
+        float minW = 0.0f;
+        float maxW = 0.0f;
+
+        // 30+10+40 = 80 fits in 100; adding 50 would need 140. 50+10+20 = 80.
+        const float widths[] = { 30.0f, 40.0f, 50.0f, 20.0f };
+        FD2D_CHECK(LayoutKernels::BreakRows(widths, 4, 100.0f, 10.0f, false, ends, &minW, &maxW) == 2);
+        FD2D_CHECK(ends[0] == 2 && ends[1] == 4);
+        FD2D_CHECK(minW == 80.0f);
+        FD2D_CHECK(maxW == 140.0f);
+
+        // An over-wide child gets a row of its own and sets no lower bound.
+        const float wide[] = { 150.0f, 20.0f };
+        FD2D_CHECK(LayoutKernels::BreakRows(wide, 2, 100.0f, 0.0f, false, ends, &minW, &maxW) == 2);
+        FD2D_CHECK(ends[0] == 1 && ends[1] == 2);
+        FD2D_CHECK(minW == 0.0f);
+        FD2D_CHECK(maxW == 170.0f);
+
+        // Everything fits: one row, valid from the row's width upwards.
+        FD2D_CHECK(LayoutKernels::BreakRows(widths, 4, 500.0f, 10.0f, false, ends, &minW, &maxW) == 1);
+        FD2D_CHECK(ends[0] == 4);
+        FD2D_CHECK(minW == 170.0f);
+        FD2D_CHECK(maxW == kInf);
+
+        // Single column: one child per row at any width.
+        FD2D_CHECK(LayoutKernels::BreakRows(widths, 3, 500.0f, 10.0f, true, ends, &minW, &maxW) == 3);
+        FD2D_CHECK(ends[0] == 1 && ends[1] == 2 && ends[2] == 3);
+        FD2D_CHECK(minW == 0.0f);
+        FD2D_CHECK(maxW == kInf);
+
+        FD2D_CHECK(LayoutKernels::BreakRows(widths, 0, 100.0f, 10.0f, false, ends, &minW, &maxW) == 0);
+    }
+
+    void JustifyMatchesHandLayout()
+    {
+        const struct
+        {
+            FlexJustify justify;
+            float lead;
+            float between;
+        } cases[] = {
+            { FlexJustify::Start, 0.0f, 0.0f },
+            { FlexJustify::End, 60.0f, 0.0f },
+            { FlexJustify::Center, 30.0f, 0.0f },
+            { FlexJustify::SpaceBetween, 0.0f, 30.0f },
+            { FlexJustify::SpaceAround, 10.0f, 20.0f },
+            { FlexJustify::SpaceEvenly, 15.0f, 15.0f },
+        };
+        for (const auto& c : cases)
+        {
+            float lead = -1.0f;
+            float between = -1.0f;
+            LayoutKernels::Justify(c.justify, 60.0f, 3, &lead, &between);
+            FD2D_CHECK_NEAR(lead, c.lead, 1e-5);
+            FD2D_CHECK_NEAR(between, c.between, 1e-5);
+
+            // Overflow or nothing to place packs at the start.
+            LayoutKernels::Justify(c.justify, -10.0f, 3, &lead, &between);
+            FD2D_CHECK(lead == 0.0f && between == 0.0f);
+            LayoutKernels::Justify(c.justify, 60.0f, 0, &lead, &between);
+            FD2D_CHECK(lead == 0.0f && between == 0.0f);
+        }
+
+        // A lone item has no gap to spread into.
+        float lead = -1.0f;
+        float between = -1.0f;
+        LayoutKernels::Justify(FlexJustify::SpaceBetween, 60.0f, 1, &lead, &between);
+        FD2D_CHECK(lead == 0.0f && between == 0.0f);
+    }
+
+    void FlexRowMatchesHandLayout()
+    {
+        float x[3] {};
+        float w[3] {};
+
+        // 320 used of 440: the 120 left goes 0:1:3.
+        const float basis[] = { 100.0f, 100.0f, 100.0f };
+        const float grow[] = { 0.0f, 1.0f, 3.0f };
+        const float shrink[] = { 1.0f, 1.0f, 1.0f };
+        LayoutKernels::FlexRow(basis, grow, shrink, 3, 440.0f, 10.0f, FlexJustify::Center, x, w);
+        FD2D_CHECK_NEAR(w[0], 100.0, 1e-4);
+        FD2D_CHECK_NEAR(w[1], 130.0, 1e-4);
+        FD2D_CHECK_NEAR(w[2], 190.0, 1e-4);
+        FD2D_CHECK_NEAR(x[0], 0.0, 1e-4);
+        FD2D_CHECK_NEAR(x[1], 110.0, 1e-4);
+        FD2D_CHECK_NEAR(x[2], 250.0, 1e-4);
+
+        // 100 too wide: shrink by shrink * basis, 100:200.
+        const float shrinkBasis[] = { 100.0f, 200.0f };
+        const float none[] = { 0.0f, 0.0f };
+        const float ones[] = { 1.0f, 1.0f };
+        LayoutKernels::FlexRow(shrinkBasis, none, ones, 2, 210.0f, 10.0f, FlexJustify::Start, x, w);
+        FD2D_CHECK_NEAR(w[0], 200.0 / 3.0, 1e-3);
+        FD2D_CHECK_NEAR(w[1], 400.0 / 3.0, 1e-3);
+        FD2D_CHECK_NEAR(x[1], 200.0 / 3.0 + 10.0, 1e-3);
+    }
+
+    // Widths drawn from whole pixels keep the sums exact, so the interval
+    // bounds can be probed at their edges.
+    std::vector<float> RandomWidths(std::size_t count, std::uint32_t seed, std::uint32_t range)
+    {
+        std::vector<float> widths(count);
+        for (float& w : widths)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            w = static_cast<float>(4u + (seed >> 8) % range);
+        }
+        return widths;
+    }
+
+    // Inside [min, max) the breaks are those of a fresh BreakRows; at max,
+    // and just below a non-zero min, they are not.
+    void BreakRowsIntervalHolds()
+    {
+        std::vector<std::uint32_t> ends;
+        std::vector<std::uint32_t> fresh;
+        for (std::uint32_t seed = 1; seed <= 40; ++seed)
+        {
+            const std::vector<float> widths = RandomWidths(60, seed, 120);
+            const float hgap = static_cast<float>(seed % 3) * 4.0f;
+            ends.resize(widths.size());
+            fresh.resize(widths.size());
+            for (float width = 20.0f; width < 2000.0f; width += 37.0f)
+            {
+                float minW = 0.0f;
+                float maxW = 0.0f;
+                const std::size_t rows = LayoutKernels::BreakRows(widths.data(), widths.size(), width, hgap,
+                    false, ends.data(), &minW, &maxW);
+                FD2D_CHECK(minW <= width && width < maxW);
+
+                auto sameBreaks = [&](float probe)
+                {
+                    float probeMin = 0.0f;
+                    float probeMax = 0.0f;
+                    const std::size_t probeRows = LayoutKernels::BreakRows(widths.data(), widths.size(), probe,
+                        hgap, false, fresh.data(), &probeMin, &probeMax);
+                    return probeRows == rows && std::equal(ends.begin(), ends.begin() + rows, fresh.begin());
+                };
+
+                const float top = (maxW < kInf) ? maxW : minW + 5000.0f;
+                for (const float probe : { minW, (minW + top) * 0.5f, std::nextafter(top, 0.0f) })
+                {
+                    FD2D_CHECK(sameBreaks(probe));
+                }
+                if (maxW < kInf)
+                {
+                    FD2D_CHECK(!sameBreaks(maxW));
+                }
+                if (minW > 0.0f)
+                {
+                    FD2D_CHECK(!sameBreaks(std::nextafter(minW, 0.0f)));
+                }
+            }
+        }
+    }
+
+    // Growth fills the row exactly whatever the justify; shrinking keeps
+    // zero-factor items at their basis and never goes below zero; leftover
+    // space without growth is placed by Justify.
+    void FlexRowGrowShrinkJustify()
+    {
+        constexpr std::size_t kCount = 12;
+        constexpr float kGap = 6.0f;
+        const std::vector<float> basis = RandomWidths(kCount, 47, 90);
+        float used = kGap * static_cast<float>(kCount - 1);
+        for (const float b : basis)
+        {
+            used += b;
+        }
+
+        std::vector<float> grow(kCount);
+        std::vector<float> shrink(kCount);
+        std::vector<float> none(kCount, 0.0f);
+        for (std::size_t i = 0; i < kCount; ++i)
+        {
+            grow[i] = static_cast<float>(i % 4);
+            shrink[i] = (i % 3 == 0) ? 0.0f : 1.0f;
+        }
+
+        std::vector<float> x(kCount);
+        std::vector<float> w(kCount);
+        auto checkContiguous = [&](float lead, float between)
+        {
+            float at = lead;
+            for (std::size_t i = 0; i < kCount; ++i)
+            {
+                FD2D_CHECK_NEAR(x[i], at, 1e-3);
+                at += w[i] + kGap + between;
+            }
+        };
+
+        for (const FlexJustify justify : { FlexJustify::Start, FlexJustify::Center, FlexJustify::SpaceEvenly })
+        {
+            LayoutKernels::FlexRow(basis.data(), grow.data(), shrink.data(), kCount, used + 300.0f, kGap, justify,
+                x.data(), w.data());
+            float total = kGap * static_cast<float>(kCount - 1);
+            for (std::size_t i = 0; i < kCount; ++i)
+            {
+                FD2D_CHECK(w[i] >= basis[i]);
+                if (grow[i] == 0.0f)
+                {
+                    FD2D_CHECK(w[i] == basis[i]);
+                }
+                total += w[i];
+            }
+            FD2D_CHECK_NEAR(total, used + 300.0f, 1e-2);
+            checkContiguous(0.0f, 0.0f);
+        }
+
+        LayoutKernels::FlexRow(basis.data(), none.data(), shrink.data(), kCount, used - 120.0f, kGap,
+            FlexJustify::End, x.data(), w.data());
+        float total = kGap * static_cast<float>(kCount - 1);
+        for (std::size_t i = 0; i < kCount; ++i)
+        {
+            FD2D_CHECK(w[i] <= basis[i]);
+            if (shrink[i] == 0.0f)
+            {
+                FD2D_CHECK(w[i] == basis[i]);
+            }
+            total += w[i];
+        }
+        FD2D_CHECK_NEAR(total, used - 120.0f, 1e-2);
+        checkContiguous(0.0f, 0.0f);
+
+        // No shrink factors: the row overflows at its basis, from the start.
+        LayoutKernels::FlexRow(basis.data(), none.data(), none.data(), kCount, used - 120.0f, kGap,
+            FlexJustify::Center, x.data(), w.data());
+        FD2D_CHECK(std::equal(w.begin(), w.end(), basis.begin()));
+        checkContiguous(0.0f, 0.0f);
+
+        // A tiny item asked to take the whole overflow clamps at zero.
+        const float tiny[] = { 10.0f, 100.0f };
+        const float heavy[] = { 100.0f, 0.0f };
+        const float zero[] = { 0.0f, 0.0f };
+        float x2[2] {};
+        float w2[2] {};
+        LayoutKernels::FlexRow(tiny, zero, heavy, 2, 60.0f, 0.0f, FlexJustify::Start, x2, w2);
+        FD2D_CHECK(w2[0] == 0.0f && w2[1] == 100.0f);
+        FD2D_CHECK(x2[0] == 0.0f && x2[1] == 0.0f);
+
+        // Leftover space with nothing to grow goes where Justify puts it.
+        for (const FlexJustify justify : { FlexJustify::Start, FlexJustify::End, FlexJustify::Center,
+                                           FlexJustify::SpaceBetween, FlexJustify::SpaceAround,
+                                           FlexJustify::SpaceEvenly })
+        {
+            LayoutKernels::FlexRow(basis.data(), none.data(), shrink.data(), kCount, used + 240.0f, kGap, justify,
+                x.data(), w.data());
+            float lead = 0.0f;
+            float between = 0.0f;
+            LayoutKernels::Justify(justify, 240.0f, kCount, &lead, &between);
+            FD2D_CHECK(std::equal(w.begin(), w.end(), basis.begin()));
+            checkContiguous(lead, between);
+        }
+    }
+
+    void GrowTracksMatchesHandLayout()
+    {
+        // Round one gives 10 each; track 0 caps at 15, so its 5 spare goes
+        // to track 1. Track 2 is not growable.
+        float sizes[] = { 10.0f, 10.0f, 10.0f };
+        const float maxSizes[] = { 15.0f, 100.0f, 100.0f };
+        const std::uint8_t growable[] = { 1, 1, 0 };
+        FD2D_CHECK(LayoutKernels::GrowTracks(sizes, maxSizes, growable, 3, 20.0f) == 0.0f);
+        FD2D_CHECK_NEAR(sizes[0], 15.0, 1e-5);
+        FD2D_CHECK_NEAR(sizes[1], 25.0, 1e-5);
+        FD2D_CHECK(sizes[2] == 10.0f);
+
+        // Everything capped: the rest is handed back.
+        float capped[] = { 0.0f, 0.0f };
+        const float caps[] = { 5.0f, 5.0f };
+        const std::uint8_t both[] = { 1, 1 };
+        FD2D_CHECK_NEAR(LayoutKernels::GrowTracks(capped, caps, both, 2, 20.0f), 10.0, 1e-5);
+        FD2D_CHECK(capped[0] == 5.0f && capped[1] == 5.0f);
+
+        const std::uint8_t neither[] = { 0, 0 };
+        float fixed[] = { 0.0f, 0.0f };
+        FD2D_CHECK(LayoutKernels::GrowTracks(fixed, caps, neither, 2, 7.0f) == 7.0f);
+    }
+
+    void ShareStarMatchesHandLayout()
+    {
+        // 1* 2* (auto) 1* over 400; the auto track is left alone.
+        const float weights[] = { 1.0f, 2.0f, 0.0f, 1.0f };
+        const float zero[] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        const float unbounded[] = { kInf, kInf, kInf, kInf };
+        float sizes[] = { 0.0f, 0.0f, 77.0f, 0.0f };
+        LayoutKernels::ShareStar(weights, zero, unbounded, 4, 400.0f, sizes);
+        FD2D_CHECK_NEAR(sizes[0], 100.0, 1e-4);
+        FD2D_CHECK_NEAR(sizes[1], 200.0, 1e-4);
+        FD2D_CHECK(sizes[2] == 77.0f);
+        FD2D_CHECK_NEAR(sizes[3], 100.0, 1e-4);
+
+        // A max freezes its track; the others re-share the remainder.
+        const float equal[] = { 1.0f, 1.0f, 1.0f };
+        const float maxed[] = { 50.0f, kInf, kInf };
+        float three[3] {};
+        LayoutKernels::ShareStar(equal, zero, maxed, 3, 300.0f, three);
+        FD2D_CHECK_NEAR(three[0], 50.0, 1e-4);
+        FD2D_CHECK_NEAR(three[1], 125.0, 1e-4);
+        FD2D_CHECK_NEAR(three[2], 125.0, 1e-4);
+
+        // So does a min.
+        const float mins[] = { 200.0f, 0.0f };
+        float two[2] {};
+        LayoutKernels::ShareStar(equal, mins, unbounded, 2, 300.0f, two);
+        FD2D_CHECK_NEAR(two[0], 200.0, 1e-4);
+        FD2D_CHECK_NEAR(two[1], 100.0, 1e-4);
+
+        // Mins beyond the space still hold.
+        const float bigMins[] = { 100.0f, 100.0f };
+        LayoutKernels::ShareStar(equal, bigMins, unbounded, 2, 100.0f, two);
+        FD2D_CHECK(two[0] == 100.0f && two[1] == 100.0f);
+    }
+
+    // Iterative passes and the recursive reference agree on a few thousand
+    // random nodes, bounded and unbounded.
+    void EngineMatchesRecursion()
+    {
+        LayoutEngine engine;
+        std::vector<RefNode*> refs;
+        for (std::uint32_t seed = 1; seed <= 8; ++seed)
+        {
+            const std::unique_ptr<RefNode> root = BuildTree(3000, seed, 6, engine, refs);
+            FD2D_CHECK(engine.NodeCount() == refs.size());
+            for (const float width : { 900.0f, 240.0f, kUnbounded })
+            {
+                engine.Measure(0, width, kUnbounded);
+                root->Measure(width, kUnbounded);
+                const LayoutEngine::Box box { 0.0f, 0.0f, engine.DesiredW(0), engine.DesiredH(0) };
+                engine.Arrange(0, box);
+                root->Arrange(box);
+                FD2D_CHECK(MaxDifference(engine, refs) <= 1e-3f);
+            }
+
+            // A node created after a pass joins the next one.
+            const float before = engine.DesiredH(0);
+            const LayoutNodeId extra = engine.CreateNode(LayoutKind::Leaf, 0);
+            engine.SetLeafSize(extra, 10.0f, 50.0f);
+            engine.Measure(0, kUnbounded, kUnbounded);
+            FD2D_CHECK_NEAR(engine.DesiredH(0), before + 50.0f, 1e-2);
+        }
+    }
+
+    // A window dragged from 200 to 2000 px over 1000 items: BreakRows on
+    // every width against only when the width leaves the cached interval
+    // (as DynamicPanel::EnsureRows does).
+    void BenchResizeSweep()
+    {
+        constexpr std::size_t kItems = 1000;
+        const std::vector<float> widths = RandomWidths(kItems, 47, 160);
+        std::vector<std::uint32_t> ends(kItems);
+
+        double everyUs = 0.0;
+        double cachedUs = 0.0;
+        std::size_t checksum = 0;
+        std::size_t recomputes = 0;
+        std::size_t steps = 0;
+        for (int round = 0; round < 5; ++round)
+        {
+            float minW = 0.0f;
+            float maxW = 0.0f;
+            double start = Test::NowUs();
+            for (float width = 200.0f; width <= 2000.0f; width += 1.0f)
+            {
+                checksum += LayoutKernels::BreakRows(widths.data(), kItems, width, 8.0f, false, ends.data(),
+                    &minW, &maxW);
+            }
+            everyUs += Test::NowUs() - start;
+
+            bool valid = false;
+            start = Test::NowUs();
+            for (float width = 200.0f; width <= 2000.0f; width += 1.0f)
+            {
+                if (!valid || width < minW || !(width < maxW))
+                {
+                    LayoutKernels::BreakRows(widths.data(), kItems, width, 8.0f, false, ends.data(), &minW, &maxW);
+                    valid = true;
+                    ++recomputes;
+                }
+                ++steps;
+            }
+            cachedUs += Test::NowUs() - start;
+        }
+        std::printf("%zu items, %zu widths: BreakRows every width %.0f us, on leaving the interval %.0f us "
+                    "(%zu of %zu steps recomputed, checksum %zu)\n",
+                    kItems, steps / 5, everyUs / 5, cachedUs / 5, recomputes / 5, steps / 5, checksum);
+    }
+
+    void BenchAgainstRecursion()
+    {
+        constexpr std::size_t kNodes = 100000;
+        constexpr int kRounds = 10;
+        LayoutEngine engine;
+        std::vector<RefNode*> refs;
+        const std::unique_ptr<RefNode> root = BuildTree(kNodes, 7, 8, engine, refs);
+
+        double engineUs = 0.0;
+        double recursiveUs = 0.0;
+        for (int round = 0; round < kRounds; ++round)
+        {
+            const float width = 800.0f + 40.0f * static_cast<float>(round);
+
+            double start = Test::NowUs();
+            engine.Measure(0, width, kUnbounded);
+            engine.Arrange(0, { 0.0f, 0.0f, engine.DesiredW(0), engine.DesiredH(0) });
+            engineUs += Test::NowUs() - start;
+
+            start = Test::NowUs();
+            root->Measure(width, kUnbounded);
+            root->Arrange({ 0.0f, 0.0f, root->desiredW, root->desiredH });
+            recursiveUs += Test::NowUs() - start;
+        }
+        std::printf("%zu nodes measure+arrange: engine %.0f us, recursive %.0f us (diff %g)\n",
+                    kNodes, engineUs / kRounds, recursiveUs / kRounds,
+                    static_cast<double>(MaxDifference(engine, refs)));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    BreakRowsMatchesHandLayout();
+    JustifyMatchesHandLayout();
+    BreakRowsIntervalHolds();
+    FlexRowMatchesHandLayout();
+    FlexRowGrowShrinkJustify();
+    GrowTracksMatchesHandLayout();
+    ShareStarMatchesHandLayout();
+    EngineMatchesRecursion();
+    if (Test::BenchRequested(argc, argv))
+    {
+        BenchAgainstRecursion();
+        BenchResizeSweep();
+    }
+    return Test::TestResult();
+}
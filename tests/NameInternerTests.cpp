@@ -0,0 +1,180 @@
+#include "NameInterner.h"
+#include "TestCheck.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace FD2D;
+
+namespace
+{
+    std::wstring Name(int i)
+    {
+        return L"panel/row" + std::to_wstring(i) + L"/label";
+    }
+
+    void InternIsStable()
+    {
+        NameInterner interner;
+        FD2D_CHECK(interner.Size() == 1); // kNoName
+        FD2D_CHECK(interner.Intern(L"") == kNoName);
+        FD2D_CHECK(interner.NameOf(kNoName).empty());
+
+        const NameId a = interner.Intern(L"alpha");
+        const NameId b = interner.Intern(L"beta");
+        FD2D_CHECK(a != kNoName && b != kNoName && a != b);
+        FD2D_CHECK(interner.Intern(std::wstring(L"alpha")) == a);
+        FD2D_CHECK(interner.NameOf(a) == L"alpha");
+        FD2D_CHECK(interner.NameOf(12345).empty());
+
+        // Find never adds.
+        FD2D_CHECK(interner.Find(L"gamma") == kNoName);
+        FD2D_CHECK(interner.Size() == 3);
+        FD2D_CHECK(interner.Find(L"beta") == b);
+
+        // References stay valid as the table grows.
+        const std::wstring& alpha = interner.NameOf(a);
+        for (int i = 0; i < 10000; ++i)
+        {
+            (void)interner.Intern(Name(i));
+        }
+        FD2D_CHECK(alpha == L"alpha");
+        FD2D_CHECK(&alpha == &interner.NameOf(a));
+    }
+
+    // Threads interning overlapping names agree on every id.
+    void ConcurrentInternAgrees()
+    {
+        constexpr int kThreads = 4;
+        constexpr int kNames = 5000;
+        NameInterner interner;
+        std::vector<std::vector<NameId>> ids(kThreads, std::vector<NameId>(kNames));
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t)
+        {
+            threads.emplace_back([&, t] {
+                for (int k = 0; k < kNames; ++k)
+                {
+                    const int i = (t % 2 == 0) ? k : kNames - 1 - k;
+                    ids[t][i] = interner.Intern(Name(i));
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        std::unordered_set<NameId> distinct;
+        for (int i = 0; i < kNames; ++i)
+        {
+            for (int t = 1; t < kThreads; ++t)
+            {
+                FD2D_CHECK(ids[t][i] == ids[0][i]);
+            }
+            FD2D_CHECK(interner.NameOf(ids[0][i]) == Name(i));
+            distinct.insert(ids[0][i]);
+        }
+        FD2D_CHECK(distinct.size() == kNames);
+        FD2D_CHECK(interner.Size() == kNames + 1);
+    }
+
+    // The lookups Wnd does per child: by name string before, by id now, and
+    // the duplicate check of ReorderChildren over a large panel.
+    void BenchLookups()
+    {
+        constexpr int kChildren = 20000;
+        constexpr int kRounds = 20;
+        NameInterner interner;
+        std::vector<std::wstring> names;
+        std::vector<NameId> ids;
+        for (int i = 0; i < kChildren; ++i)
+        {
+            names.push_back(Name(i));
+            ids.push_back(interner.Intern(names.back()));
+        }
+
+        std::unordered_map<std::wstring, int> byName;
+        std::unordered_map<NameId, int> byId;
+        for (int i = 0; i < kChildren; ++i)
+        {
+            byName.emplace(names[i], i);
+            byId.emplace(ids[i], i);
+        }
+
+        std::int64_t sink = 0;
+        double start = Test::NowUs();
+        for (int round = 0; round < kRounds; ++round)
+        {
+            for (const std::wstring& name : names)
+            {
+                sink += byName.find(name)->second;
+            }
+        }
+        const double nameUs = (Test::NowUs() - start) / kRounds;
+
+        start = Test::NowUs();
+        for (int round = 0; round < kRounds; ++round)
+        {
+            for (const NameId id : ids)
+            {
+                sink += byId.find(id)->second;
+            }
+        }
+        const double idUs = (Test::NowUs() - start) / kRounds;
+
+        // ReorderChildren's "seen" set: wstring keys before, a bit per id now.
+        start = Test::NowUs();
+        for (int round = 0; round < kRounds; ++round)
+        {
+            std::unordered_map<std::wstring, bool> seen;
+            for (const std::wstring& name : names)
+            {
+                sink += seen.emplace(name, true).second ? 1 : 0;
+            }
+        }
+        const double seenNameUs = (Test::NowUs() - start) / kRounds;
+
+        start = Test::NowUs();
+        for (int round = 0; round < kRounds; ++round)
+        {
+            std::vector<bool> seen(interner.Size(), false);
+            for (const NameId id : ids)
+            {
+                sink += seen[id] ? 0 : 1;
+                seen[id] = true;
+            }
+        }
+        const double seenIdUs = (Test::NowUs() - start) / kRounds;
+
+        start = Test::NowUs();
+        for (int round = 0; round < kRounds; ++round)
+        {
+            for (const std::wstring& name : names)
+            {
+                sink += interner.Intern(name);
+            }
+        }
+        const double internUs = (Test::NowUs() - start) / kRounds;
+
+        std::printf("%d children: lookup by name %.0f us, by id %.0f us; reorder check by name %.0f us, by id %.0f us; "
+                    "re-intern %.0f us (%lld)\n",
+                    kChildren, nameUs, idUs, seenNameUs, seenIdUs, internUs, static_cast<long long>(sink));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    InternIsStable();
+    ConcurrentInternAgrees();
+    if (Test::BenchRequested(argc, argv))
+    {
+        BenchLookups();
+    }
+    return Test::TestResult();
+}
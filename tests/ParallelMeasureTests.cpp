@@ -0,0 +1,241 @@
+#include "ParallelMeasure.h"
+#include "TestCheck.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace FD2D;
+
+namespace
+{
+    // Same threshold as Wnd: smaller subtrees are measured inline.
+    constexpr std::size_t kForkMinNodes = 64;
+
+    // A control stand-in: a vertical stack whose leaves do a little float
+    // work (text shaping in real controls) and whose measure writes only
+    // its own node.
+    struct Node
+    {
+        float leafW { 0.0f };
+        std::vector<std::unique_ptr<Node>> children {};
+        std::size_t subtreeNodes { 1 };
+        float desiredW { 0.0f };
+        float desiredH { 0.0f };
+        int measures { 0 };
+    };
+
+    void Measure(Node& node, float available, Executor* executor)
+    {
+        ++node.measures;
+        if (node.children.empty())
+        {
+            float w = node.leafW;
+            for (int k = 1; k <= 40; ++k)
+            {
+                w = w * 0.999f + std::sqrt(static_cast<float>(k) + w) * 0.01f;
+            }
+            node.desiredW = (std::min)(w, available);
+            node.desiredH = 16.0f + std::fmod(w, 7.0f);
+            return;
+        }
+
+        const auto& children = node.children;
+        ParallelMeasure::Run(
+            executor,
+            children.size(),
+            [&children](std::size_t i) { return children[i]->subtreeNodes >= kForkMinNodes; },
+            [&children, available, executor](std::size_t i) { Measure(*children[i], available - 4.0f, executor); });
+
+        float w = 0.0f;
+        float h = 0.0f;
+        for (const auto& child : children)
+        {
+            w = (std::max)(w, child->desiredW);
+            h += child->desiredH;
+        }
+        node.desiredW = w + 4.0f;
+        node.desiredH = h + 4.0f;
+    }
+
+    // `columns` subtrees of `groups` groups of `leaves` leaves under one
+    // root, each followed by a single leaf (never forked).
+    std::unique_ptr<Node> BuildColumns(std::size_t columns, std::size_t groups, std::size_t leaves)
+    {
+        std::uint32_t seed = 45;
+        auto next = [&seed]()
+        {
+            seed = seed * 1664525u + 1013904223u;
+            return static_cast<float>((seed >> 8) % 400);
+        };
+
+        auto root = std::make_unique<Node>();
+        for (std::size_t c = 0; c < columns; ++c)
+        {
+            auto column = std::make_unique<Node>();
+            for (std::size_t g = 0; g < groups; ++g)
+            {
+                auto group = std::make_unique<Node>();
+                for (std::size_t l = 0; l < leaves; ++l)
+                {
+                    auto leaf = std::make_unique<Node>();
+                    leaf->leafW = next();
+                    group->children.push_back(std::move(leaf));
+                }
+                group->subtreeNodes += leaves;
+                column->subtreeNodes += group->subtreeNodes;
+                column->children.push_back(std::move(group));
+            }
+            root->subtreeNodes += column->subtreeNodes;
+            root->children.push_back(std::move(column));
+
+            auto spacer = std::make_unique<Node>();
+            spacer->leafW = next();
+            root->children.push_back(std::move(spacer));
+            ++root->subtreeNodes;
+        }
+        return root;
+    }
+
+    template <typename Visit>
+    void ForEach(Node& node, Visit&& visit)
+    {
+        visit(node);
+        for (auto& child : node.children)
+        {
+            ForEach(*child, visit);
+        }
+    }
+
+    struct Result
+    {
+        float w;
+        float h;
+    };
+
+    std::vector<Result> Snapshot(Node& root)
+    {
+        std::vector<Result> results;
+        ForEach(root, [&results](Node& node) { results.push_back({ node.desiredW, node.desiredH }); });
+        return results;
+    }
+
+    bool SameBits(const std::vector<Result>& a, const std::vector<Result>& b)
+    {
+        return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(Result)) == 0;
+    }
+
+    // Forked measure gives bit-identical sizes to measuring in order, and
+    // measures every node exactly once, however the pool schedules it.
+    void ForkedMeasureIsDeterministic()
+    {
+        const std::unique_ptr<Node> root = BuildColumns(12, 6, 12);
+        Measure(*root, 300.0f, nullptr);
+        const std::vector<Result> serial = Snapshot(*root);
+
+        for (const std::size_t workers : { 1u, 3u, 8u })
+        {
+            Executor executor(Executor::Options { workers });
+            for (int pass = 0; pass < 20; ++pass)
+            {
+                ForEach(*root, [](Node& node)
+                {
+                    node.desiredW = 0.0f;
+                    node.desiredH = 0.0f;
+                    node.measures = 0;
+                });
+                Measure(*root, 300.0f, &executor);
+                FD2D_CHECK(SameBits(Snapshot(*root), serial));
+
+                bool once = true;
+                ForEach(*root, [&once](Node& node) { once = once && node.measures == 1; });
+                FD2D_CHECK(once);
+            }
+        }
+    }
+
+    // Which items run where: small items and the last large one on the
+    // calling thread, in order; the other large ones as forked tasks.
+    void ForksAllButTheLastLargeItem()
+    {
+        const bool large[] = { true, false, true, true, false };
+        std::atomic<int> ran[5] {};
+        std::atomic<bool> forked[5] {};
+        std::vector<std::size_t> inline_;
+
+        Executor executor(Executor::Options { 2 });
+        ParallelMeasure::Run(
+            &executor,
+            5,
+            [&large](std::size_t i) { return large[i]; },
+            [&](std::size_t i)
+            {
+                ran[i].fetch_add(1);
+                forked[i].store(ParallelMeasure::InForkedMeasure());
+                if (!ParallelMeasure::InForkedMeasure())
+                {
+                    inline_.push_back(i);
+                }
+            });
+
+        for (std::size_t i = 0; i < 5; ++i)
+        {
+            FD2D_CHECK(ran[i].load() == 1);
+        }
+        FD2D_CHECK(forked[0].load());
+        FD2D_CHECK(forked[2].load());
+        FD2D_CHECK(!forked[1].load());
+        FD2D_CHECK(!forked[3].load());
+        FD2D_CHECK(!forked[4].load());
+        FD2D_CHECK(inline_ == std::vector<std::size_t>({ 1, 4, 3 }));
+        FD2D_CHECK(!ParallelMeasure::InForkedMeasure());
+
+        // No executor: everything inline, in order.
+        std::vector<std::size_t> order;
+        ParallelMeasure::Run(nullptr, 4, [](std::size_t) { return true; }, [&order](std::size_t i)
+        {
+            FD2D_CHECK(!ParallelMeasure::InForkedMeasure());
+            order.push_back(i);
+        });
+        FD2D_CHECK(order == std::vector<std::size_t>({ 0, 1, 2, 3 }));
+    }
+
+    void BenchSerialAgainstForked()
+    {
+        constexpr int kRounds = 10;
+        const std::unique_ptr<Node> root = BuildColumns(16, 40, 100);
+        Executor executor;
+
+        double serialUs = 0.0;
+        double forkedUs = 0.0;
+        for (int round = 0; round < kRounds; ++round)
+        {
+            const float width = 200.0f + 20.0f * static_cast<float>(round);
+            double start = Test::NowUs();
+            Measure(*root, width, nullptr);
+            serialUs += Test::NowUs() - start;
+
+            start = Test::NowUs();
+            Measure(*root, width, &executor);
+            forkedUs += Test::NowUs() - start;
+        }
+        std::printf("%zu nodes: serial %.0f us, forked on %zu workers %.0f us\n",
+                    root->subtreeNodes, serialUs / kRounds, executor.WorkerCount(), forkedUs / kRounds);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    ForkedMeasureIsDeterministic();
+    ForksAllButTheLastLargeItem();
+    if (Test::BenchRequested(argc, argv))
+    {
+        BenchSerialAgainstForked();
+    }
+    return Test::TestResult();
+}
@@ -0,0 +1,150 @@
+#include "PixelCopy.h"
+#include "TestCheck.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace FD2D;
+
+namespace
+{
+    constexpr std::uint8_t kPadding = 0xCD;
+
+    // The documented conversions, one byte at a time.
+    void ReferenceRows(std::uint8_t* dst, std::size_t dstStride, const std::uint8_t* src, std::size_t srcStride,
+                       std::size_t rowBytes, std::size_t rows, Pixels::RowConversion conversion)
+    {
+        for (std::size_t row = 0; row < rows; ++row)
+        {
+            std::uint8_t* d = dst + row * dstStride;
+            const std::uint8_t* s = src + row * srcStride;
+            for (std::size_t i = 0; i < rowBytes; ++i)
+            {
+                d[i] = s[i];
+            }
+            if (conversion == Pixels::RowConversion::Copy)
+            {
+                continue;
+            }
+            for (std::size_t i = 0; i + 4 <= rowBytes; i += 4)
+            {
+                if (conversion == Pixels::RowConversion::SwapRedBlue)
+                {
+                    d[i] = s[i + 2];
+                    d[i + 2] = s[i];
+                }
+                else
+                {
+                    d[i + 3] = 0xFF;
+                }
+            }
+        }
+    }
+
+    // Every conversion, every width from 1 to 40 pixels (around the 4- and
+    // 16-pixel vector steps) and padded strides, against the reference bit
+    // for bit; the destination padding must stay untouched.
+    void MatchesScalarReference()
+    {
+        std::mt19937 rng(26);
+        const Pixels::RowConversion conversions[] = {
+            Pixels::RowConversion::Copy, Pixels::RowConversion::SwapRedBlue, Pixels::RowConversion::ForceOpaque
+        };
+
+        std::uint64_t mismatches = 0;
+        for (const Pixels::RowConversion conversion : conversions)
+        {
+            for (std::size_t width = 1; width <= 40; ++width)
+            {
+                for (const std::size_t pad : { 0u, 1u, 3u, 4u, 12u, 17u })
+                {
+                    // Plain copies take any byte count; odd ones too.
+                    const std::size_t rowBytes = (conversion == Pixels::RowConversion::Copy && pad % 2 == 1)
+                        ? width * 4 - 1
+                        : width * 4;
+                    const std::size_t rows = 1 + width % 5;
+                    const std::size_t srcStride = rowBytes + pad;
+                    const std::size_t dstStride = rowBytes + (pad * 3) % 7;
+
+                    // Offset by one so vector loads and stores are unaligned.
+                    std::vector<std::uint8_t> src(srcStride * rows + 1);
+                    for (std::uint8_t& byte : src)
+                    {
+                        byte = static_cast<std::uint8_t>(rng());
+                    }
+                    std::vector<std::uint8_t> actual(dstStride * rows + 1, kPadding);
+                    std::vector<std::uint8_t> expected(actual);
+
+                    Pixels::CopyRows(actual.data() + 1, dstStride, src.data() + 1, srcStride, rowBytes, rows, conversion);
+                    ReferenceRows(expected.data() + 1, dstStride, src.data() + 1, srcStride, rowBytes, rows, conversion);
+                    mismatches += (actual == expected) ? 0 : 1;
+                }
+            }
+        }
+        FD2D_CHECK(mismatches == 0);
+    }
+
+    void EmptyInputsDoNothing()
+    {
+        std::vector<std::uint8_t> dst(16, kPadding);
+        const std::vector<std::uint8_t> src(16, 1);
+        Pixels::CopyRows(dst.data(), 16, src.data(), 16, 0, 4, Pixels::RowConversion::SwapRedBlue);
+        Pixels::CopyRows(dst.data(), 16, src.data(), 16, 16, 0);
+        Pixels::CopyRows(nullptr, 16, src.data(), 16, 16, 1);
+        FD2D_CHECK(dst == std::vector<std::uint8_t>(16, kPadding));
+    }
+
+    // A 1080p readback with a padded pitch, per conversion, against the
+    // byte-wise reference.
+    void BenchConversions()
+    {
+        constexpr std::size_t kWidth = 1920;
+        constexpr std::size_t kHeight = 1080;
+        constexpr std::size_t kRowBytes = kWidth * 4;
+        constexpr std::size_t kPitch = kRowBytes + 256;
+        constexpr int kRounds = 20;
+        std::vector<std::uint8_t> src(kPitch * kHeight, 0x5A);
+        std::vector<std::uint8_t> dst(kRowBytes * kHeight);
+
+        const struct
+        {
+            const char* name;
+            Pixels::RowConversion conversion;
+        } cases[] = {
+            { "copy", Pixels::RowConversion::Copy },
+            { "swap red/blue", Pixels::RowConversion::SwapRedBlue },
+            { "force opaque", Pixels::RowConversion::ForceOpaque },
+        };
+        for (const auto& c : cases)
+        {
+            double start = Test::NowUs();
+            for (int round = 0; round < kRounds; ++round)
+            {
+                Pixels::CopyRows(dst.data(), kRowBytes, src.data(), kPitch, kRowBytes, kHeight, c.conversion);
+            }
+            const double fastUs = (Test::NowUs() - start) / kRounds;
+
+            start = Test::NowUs();
+            for (int round = 0; round < kRounds; ++round)
+            {
+                ReferenceRows(dst.data(), kRowBytes, src.data(), kPitch, kRowBytes, kHeight, c.conversion);
+            }
+            const double referenceUs = (Test::NowUs() - start) / kRounds;
+            std::printf("1080p %s: %.0f us, byte-wise %.0f us (%u)\n", c.name, fastUs, referenceUs,
+                        static_cast<unsigned>(dst[kRowBytes / 2]));
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    MatchesScalarReference();
+    EmptyInputsDoNothing();
+    if (Test::BenchRequested(argc, argv))
+    {
+        BenchConversions();
+    }
+    return Test::TestResult();
+}
@@ -0,0 +1,206 @@
+#include "RedrawSignal.h"
+#include "TestCheck.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace FD2D;
+
+namespace
+{
+    void SignalCoalescesUntilConsumed()
+    {
+        int wakes = 0;
+        RedrawSignal signal([&] { ++wakes; });
+
+        FD2D_CHECK(signal.Signal());
+        FD2D_CHECK(!signal.Signal());
+        FD2D_CHECK(signal.Pending());
+        FD2D_CHECK(wakes == 1);
+
+        FD2D_CHECK(signal.Consume());
+        FD2D_CHECK(!signal.Consume());
+        FD2D_CHECK(signal.Signal());
+        FD2D_CHECK(wakes == 2);
+
+        signal.Close();
+        FD2D_CHECK(signal.Closed());
+        FD2D_CHECK(signal.Consume());
+        FD2D_CHECK(!signal.Signal());
+        FD2D_CHECK(wakes == 2);
+    }
+
+    // Producers publish a counter and signal; the consumer reads every
+    // counter after each Consume. A producer waits until the consumer has
+    // seen its latest value, so a lost wake (or a consume that does not
+    // observe the writes before the signal) stalls it past the deadline.
+    void StressNoLostWakes()
+    {
+        constexpr int kProducers = 4;
+        constexpr std::uint32_t kRounds = 5000;
+
+        std::atomic<std::uint32_t> wakes { 0 };
+        RedrawSignal signal([&] {
+            wakes.fetch_add(1, std::memory_order_relaxed);
+            wakes.notify_one();
+        });
+
+        std::atomic<std::uint32_t> published[kProducers] {};
+        std::atomic<std::uint32_t> seen[kProducers] {};
+        std::atomic<int> running { kProducers };
+        std::atomic<bool> stalled { false };
+        std::uint32_t consumed = 0;
+
+        std::thread consumer([&] {
+            std::uint32_t observed = 0;
+            for (;;)
+            {
+                wakes.wait(observed, std::memory_order_relaxed);
+                observed = wakes.load(std::memory_order_relaxed);
+                if (signal.Consume())
+                {
+                    ++consumed;
+                }
+                for (int p = 0; p < kProducers; ++p)
+                {
+                    const std::uint32_t value = published[p].load(std::memory_order_relaxed);
+                    seen[p].store(value, std::memory_order_relaxed);
+                    seen[p].notify_all();
+                }
+                if (running.load(std::memory_order_acquire) == 0 && !signal.Pending())
+                {
+                    break;
+                }
+            }
+        });
+
+        std::atomic<std::uint32_t> issuedByProducers { 0 };
+        std::vector<std::thread> producers;
+        for (int p = 0; p < kProducers; ++p)
+        {
+            producers.emplace_back([&, p] {
+                const double deadline = Test::NowUs() + 10.0e6;
+                for (std::uint32_t round = 1; round <= kRounds; ++round)
+                {
+                    published[p].store(round, std::memory_order_relaxed);
+                    if (signal.Signal())
+                    {
+                        issuedByProducers.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    while (seen[p].load(std::memory_order_relaxed) < round)
+                    {
+                        if (Test::NowUs() > deadline)
+                        {
+                            stalled.store(true);
+                            return;
+                        }
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (auto& producer : producers)
+        {
+            producer.join();
+        }
+
+        // Release the consumer: it exits once nothing is pending.
+        running.store(0, std::memory_order_release);
+        wakes.fetch_add(1, std::memory_order_relaxed);
+        wakes.notify_one();
+        consumer.join();
+
+        const std::uint32_t issued = issuedByProducers.load();
+        FD2D_CHECK(!stalled.load());
+        FD2D_CHECK(issued >= 1);
+        FD2D_CHECK(consumed == issued);
+        FD2D_CHECK(!signal.Pending());
+    }
+
+    // Mutex + flag equivalent of RedrawSignal, for the contention numbers.
+    class LockedSignal
+    {
+    public:
+        bool Signal()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_pending)
+            {
+                return false;
+            }
+            m_pending = true;
+            return true;
+        }
+
+        bool Consume()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const bool was = m_pending;
+            m_pending = false;
+            return was;
+        }
+
+    private:
+        std::mutex m_mutex {};
+        bool m_pending { false };
+    };
+
+    template <typename Signal>
+    double NsPerSignal(Signal& signal, int threads, int perThread)
+    {
+        std::atomic<bool> done { false };
+        std::thread consumer([&] {
+            while (!done.load(std::memory_order_relaxed))
+            {
+                (void)signal.Consume();
+                std::this_thread::yield();
+            }
+        });
+
+        const double start = Test::NowUs();
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&] {
+                for (int i = 0; i < perThread; ++i)
+                {
+                    (void)signal.Signal();
+                }
+            });
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        const double elapsedUs = Test::NowUs() - start;
+        done.store(true);
+        consumer.join();
+        return elapsedUs * 1000.0 / (static_cast<double>(threads) * perThread);
+    }
+
+    void BenchContention()
+    {
+        constexpr int kPerThread = 200000;
+        for (const int threads : { 1, 2, 4, 8 })
+        {
+            RedrawSignal lockFree([] {});
+            LockedSignal locked;
+            std::printf("signal contention, %d thread(s): wait-free %.1f ns/op, mutex %.1f ns/op\n",
+                        threads, NsPerSignal(lockFree, threads, kPerThread), NsPerSignal(locked, threads, kPerThread));
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    SignalCoalescesUntilConsumed();
+    StressNoLostWakes();
+    if (Test::BenchRequested(argc, argv))
+    {
+        BenchContention();
+    }
+    return Test::TestResult();
+}
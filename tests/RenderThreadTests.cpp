@@ -0,0 +1,191 @@
+#include "RenderThread.h"
+#include "TestCheck.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+using namespace FD2D;
+
+namespace
+{
+    // A frame the producer fills in place; every word carries the sequence
+    // number, so a slot written while the consumer reads it shows up torn.
+    struct Frame
+    {
+        std::uint64_t seq { 0 };
+        std::uint64_t words[15] {};
+    };
+
+    void Fill(Frame& frame, std::uint64_t seq)
+    {
+        frame.seq = seq;
+        for (std::uint64_t& word : frame.words)
+        {
+            word = seq * 0x9E3779B97F4A7C15ull;
+        }
+    }
+
+    bool Intact(const Frame& frame)
+    {
+        for (const std::uint64_t word : frame.words)
+        {
+            if (word != frame.seq * 0x9E3779B97F4A7C15ull)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void MailboxBasics()
+    {
+        FrameMailbox<Frame> mailbox;
+        FD2D_CHECK(mailbox.TakeLatest() == nullptr);
+
+        Fill(mailbox.Back(), 1);
+        FD2D_CHECK(mailbox.Publish());
+        Fill(mailbox.Back(), 2);
+        FD2D_CHECK(!mailbox.Publish()); // frame 1 never taken: dropped
+
+        Frame* frame = mailbox.TakeLatest();
+        FD2D_CHECK(frame != nullptr && frame->seq == 2);
+        FD2D_CHECK(mailbox.TakeLatest() == nullptr);
+
+        // The producer's new back slot is neither the taken frame nor a
+        // slot the consumer can still see.
+        FD2D_CHECK(&mailbox.Back() != frame);
+        Fill(mailbox.Back(), 3);
+        FD2D_CHECK(mailbox.Publish());
+        FD2D_CHECK(mailbox.WaitForFrame()->seq == 3);
+
+        mailbox.Close();
+        FD2D_CHECK(mailbox.WaitForFrame() == nullptr);
+    }
+
+    // Producer publishes as fast as it can while the consumer takes frames:
+    // frames arrive in order, never torn, and the last one always arrives.
+    void MailboxStress()
+    {
+        constexpr std::uint64_t kFrames = 200000;
+        FrameMailbox<Frame> mailbox;
+        std::atomic<bool> producing { true };
+        std::uint64_t dropped = 0;
+
+        std::thread producer([&] {
+            for (std::uint64_t seq = 1; seq <= kFrames; ++seq)
+            {
+                Fill(mailbox.Back(), seq);
+                dropped += mailbox.Publish() ? 0 : 1;
+            }
+            producing.store(false, std::memory_order_release);
+        });
+
+        std::uint64_t last = 0;
+        std::uint64_t taken = 0;
+        std::uint64_t torn = 0;
+        std::uint64_t backwards = 0;
+        for (;;)
+        {
+            const bool done = !producing.load(std::memory_order_acquire);
+            while (const Frame* frame = mailbox.TakeLatest())
+            {
+                torn += Intact(*frame) ? 0 : 1;
+                backwards += (frame->seq > last) ? 0 : 1;
+                last = frame->seq;
+                ++taken;
+            }
+            if (done)
+            {
+                break;
+            }
+            std::this_thread::yield();
+        }
+        producer.join();
+
+        FD2D_CHECK(torn == 0);
+        FD2D_CHECK(backwards == 0);
+        FD2D_CHECK(last == kFrames);
+        FD2D_CHECK(taken + dropped == kFrames);
+    }
+
+    // The render thread presents every frame it takes; with a slow presenter
+    // the producer never waits and the surplus is dropped.
+    void RenderThreadCountsFrames()
+    {
+        constexpr std::uint64_t kFrames = 20000;
+        std::atomic<std::uint64_t> lastPresented { 0 };
+        std::atomic<std::uint64_t> torn { 0 };
+        std::atomic<std::uint64_t> backwards { 0 };
+        std::uint64_t presented = 0;
+        std::uint64_t dropped = 0;
+        {
+            RenderThread<Frame> thread([&](Frame& frame) {
+                torn += Intact(frame) ? 0 : 1;
+                backwards += (frame.seq > lastPresented.load()) ? 0 : 1;
+                lastPresented.store(frame.seq);
+                if (frame.seq % 64 == 0)
+                {
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                }
+            });
+            for (std::uint64_t seq = 1; seq <= kFrames; ++seq)
+            {
+                Fill(thread.Back(), seq);
+                thread.Publish();
+            }
+
+            // Let the last frame through before shutting down.
+            const double deadline = Test::NowUs() + 5.0e6;
+            while (thread.PresentedFrames() + thread.DroppedFrames() < kFrames && Test::NowUs() < deadline)
+            {
+                std::this_thread::yield();
+            }
+            presented = thread.PresentedFrames();
+            dropped = thread.DroppedFrames();
+        }
+
+        FD2D_CHECK(torn == 0);
+        FD2D_CHECK(backwards == 0);
+        FD2D_CHECK(lastPresented.load() == kFrames);
+        FD2D_CHECK(presented + dropped == kFrames);
+    }
+
+    void BenchMailbox()
+    {
+        constexpr std::uint64_t kFrames = 2000000;
+        FrameMailbox<Frame> mailbox;
+        std::atomic<bool> producing { true };
+        std::uint64_t taken = 0;
+        const double start = Test::NowUs();
+        std::thread consumer([&] {
+            while (producing.load(std::memory_order_acquire))
+            {
+                taken += (mailbox.TakeLatest() != nullptr) ? 1 : 0;
+            }
+        });
+        for (std::uint64_t seq = 1; seq <= kFrames; ++seq)
+        {
+            mailbox.Back().seq = seq;
+            (void)mailbox.Publish();
+        }
+        producing.store(false, std::memory_order_release);
+        consumer.join();
+        std::printf("frame mailbox: %.1f ns per publish, %.1f%% taken\n",
+                    (Test::NowUs() - start) * 1000.0 / kFrames, 100.0 * static_cast<double>(taken) / kFrames);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    MailboxBasics();
+    MailboxStress();
+    RenderThreadCountsFrames();
+    if (Test::BenchRequested(argc, argv))
+    {
+        BenchMailbox();
+    }
+    return Test::TestResult();
+}
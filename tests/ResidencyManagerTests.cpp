@@ -0,0 +1,84 @@
+#include "ResidencyManager.h"
+#include "TestCheck.h"
+
+#include <vector>
+
+using namespace FD2D;
+
+namespace
+{
+    void EvictsLeastRecentlyDrawnFirst()
+    {
+        ResidencyManager residency;
+        residency.SetBudget(250);
+        std::vector<int> evicted;
+        const auto a = residency.Register(100, 1, [&] { evicted.push_back(1); });
+        const auto b = residency.Register(100, 1, [&] { evicted.push_back(2); });
+        const auto c = residency.Register(100, 1, [&] { evicted.push_back(3); });
+        residency.MarkDrawn(a, 2);
+
+        // b is the least recently drawn; evicting it is enough.
+        FD2D_CHECK(residency.EnforceBudget(3) == 1);
+        FD2D_CHECK(evicted == std::vector<int>({ 2 }));
+        FD2D_CHECK(!residency.IsRegistered(b));
+        FD2D_CHECK(residency.IsRegistered(a) && residency.IsRegistered(c));
+        FD2D_CHECK(residency.GetStats().residentBytes == 200);
+
+        // Content drawn in the enforced frame is never evicted.
+        residency.UpdateSize(a, 400);
+        residency.MarkDrawn(a, 4);
+        residency.MarkDrawn(c, 4);
+        FD2D_CHECK(residency.EnforceBudget(4) == 0);
+        FD2D_CHECK(residency.GetStats().residentBytes == 500);
+    }
+
+    // Content registered without a callback is counted against the budget
+    // but skipped by eviction, which moves on to evictable content behind it.
+    void PinnedContentIsCountedNotEvicted()
+    {
+        ResidencyManager residency;
+        residency.SetBudget(150);
+        int evicted = 0;
+        const auto pinned = residency.Register(100, 1, nullptr);
+        const auto evictable = residency.Register(100, 2, [&] { ++evicted; });
+
+        FD2D_CHECK(residency.GetStats().residentBytes == 200);
+        FD2D_CHECK(residency.EnforceBudget(5) == 1);
+        FD2D_CHECK(evicted == 1);
+        FD2D_CHECK(residency.IsRegistered(pinned));
+        FD2D_CHECK(!residency.IsRegistered(evictable));
+        FD2D_CHECK(residency.GetStats().residentBytes == 100);
+
+        // Over budget with only pinned content left: nothing to do.
+        residency.UpdateSize(pinned, 300);
+        FD2D_CHECK(residency.EnforceBudget(6) == 0);
+        FD2D_CHECK(residency.IsRegistered(pinned));
+        FD2D_CHECK(residency.GetStats().peakResidentBytes == 300);
+    }
+
+    // After partial frames, enforcing against the last full frame keeps what
+    // it drew (still on screen) and evicts only older content.
+    void PartialFramesKeepLastFullFrame()
+    {
+        ResidencyManager residency;
+        residency.SetBudget(100);
+        std::vector<int> evicted;
+        const auto old = residency.Register(100, 1, [&] { evicted.push_back(1); });
+        const auto shown = residency.Register(100, 5, [&] { evicted.push_back(2); });
+        const auto animated = residency.Register(100, 5, [&] { evicted.push_back(3); });
+        residency.MarkDrawn(animated, 7); // frames 6 and 7 were partial
+
+        FD2D_CHECK(residency.EnforceBudget(5) == 1);
+        FD2D_CHECK(evicted == std::vector<int>({ 1 }));
+        FD2D_CHECK(!residency.IsRegistered(old));
+        FD2D_CHECK(residency.IsRegistered(shown) && residency.IsRegistered(animated));
+    }
+}
+
+int main()
+{
+    EvictsLeastRecentlyDrawnFirst();
+    PinnedContentIsCountedNotEvicted();
+    PartialFramesKeepLastFullFrame();
+    return Test::TestResult();
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+// TestCheck.h - the few checks the platform-neutral tests need.
+//
+// No framework: each test is an executable whose main runs its cases and
+// returns TestResult(), non-zero when any FD2D_CHECK failed. BenchRequested
+// tells a test whether to run its timing section (--bench); timings are
+// printed, never checked.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace FD2D::Test
+{
+    inline int& Failures()
+    {
+        static int failures = 0;
+        return failures;
+    }
+
+    inline bool BenchRequested(int argc, char** argv)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            if (std::strcmp(argv[i], "--bench") == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    inline int TestResult()
+    {
+        if (Failures() != 0)
+        {
+            std::fprintf(stderr, "%d check(s) failed\n", Failures());
+            return 1;
+        }
+        return 0;
+    }
+
+    // Microseconds since an arbitrary epoch, for the timing sections.
+    inline double NowUs()
+    {
+        using namespace std::chrono;
+        return duration<double, std::micro>(steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+#define FD2D_CHECK(condition)                                                              \
+    do                                                                                     \
+    {                                                                                      \
+        if (!(condition))                                                                  \
+        {                                                                                  \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            ++::FD2D::Test::Failures();                                                    \
+        }                                                                                  \
+    } while (false)
+
+#define FD2D_CHECK_NEAR(actual, expected, tolerance)                                       \
+    do                                                                                     \
+    {                                                                                      \
+        const double fd2dActual = static_cast<double>(actual);                             \
+        const double fd2dExpected = static_cast<double>(expected);                         \
+        if (!(std::fabs(fd2dActual - fd2dExpected) <= (tolerance)))                        \
+        {                                                                                  \
+            std::fprintf(stderr, "%s:%d: check failed: %s = %g, expected %g\n",            \
+                         __FILE__, __LINE__, #actual, fd2dActual, fd2dExpected);           \
+            ++::FD2D::Test::Failures();                                                    \
+        }                                                                                  \
+    } while (false)
@@ -0,0 +1,175 @@
+#include "TextMetrics.h"
+#include "TestCheck.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace FD2D;
+
+namespace
+{
+    // The documented order of SumAdvances, in plain scalar code: four lanes
+    // over whole groups of four, (l0 + l1) + (l2 + l3), then the tail.
+    float ReferenceSum(const float* table, std::size_t count, const wchar_t* text, std::size_t length)
+    {
+        const auto at = [&](std::size_t i)
+        {
+            const std::size_t unit = static_cast<std::size_t>(static_cast<std::make_unsigned_t<wchar_t>>(text[i]));
+            return table[unit < count ? unit : count];
+        };
+
+        float lanes[4] {};
+        std::size_t i = 0;
+        for (; i + 4 <= length; i += 4)
+        {
+            lanes[0] += at(i);
+            lanes[1] += at(i + 1);
+            lanes[2] += at(i + 2);
+            lanes[3] += at(i + 3);
+        }
+        float total = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        for (; i < length; ++i)
+        {
+            total += at(i);
+        }
+        return total;
+    }
+
+    bool SameBits(float a, float b)
+    {
+        std::uint32_t x = 0;
+        std::uint32_t y = 0;
+        std::memcpy(&x, &a, sizeof(x));
+        std::memcpy(&y, &b, sizeof(y));
+        return x == y;
+    }
+
+    // Whatever path this build takes (SSE2, NEON or scalar), the sum matches
+    // the scalar reference bit for bit: random tables with awkward values,
+    // every length around the four-lane boundary, code units past the table.
+    void SimdMatchesScalar()
+    {
+        std::mt19937 rng(50);
+        std::uniform_real_distribution<float> advance(0.0f, 1.5f);
+        FontAdvances font;
+        for (float& value : font.advance)
+        {
+            value = advance(rng) * ((rng() % 7 == 0) ? 1.0e-3f : 1.0f);
+        }
+
+        std::uint64_t mismatches = 0;
+        for (int round = 0; round < 4000; ++round)
+        {
+            const std::size_t length = static_cast<std::size_t>(round % 67);
+            std::wstring text(length, L' ');
+            for (wchar_t& unit : text)
+            {
+                const unsigned pick = rng() % 10;
+                if (pick < 6)
+                {
+                    unit = static_cast<wchar_t>(0x20 + rng() % 0x5F);
+                }
+                else if (pick < 9)
+                {
+                    unit = static_cast<wchar_t>(rng() % FontAdvances::kTableSize);
+                }
+                else
+                {
+                    unit = static_cast<wchar_t>(0xD800 + rng() % 0x2800); // surrogates and beyond
+                }
+            }
+            const float simd = SumAdvances(font.advance.data(), FontAdvances::kTableSize, text.data(), text.size());
+            const float scalar = ReferenceSum(font.advance.data(), FontAdvances::kTableSize, text.data(), text.size());
+            mismatches += SameBits(simd, scalar) ? 0 : 1;
+        }
+        FD2D_CHECK(mismatches == 0);
+
+        // Everything past the table shares its last entry.
+        const wchar_t high[] = { static_cast<wchar_t>(0xFFFF), static_cast<wchar_t>(FontAdvances::kTableSize) };
+        FD2D_CHECK(SumAdvances(font.advance.data(), FontAdvances::kTableSize, high, 2) ==
+                   font.advance[FontAdvances::kTableSize] + font.advance[FontAdvances::kTableSize]);
+    }
+
+    void AdvanceProviderMeasures()
+    {
+        AdvanceTextMetrics metrics;
+        FD2D_CHECK(metrics.Measure(L"Segoe UI", 12.0f, L"").width == 0.0f);
+
+        const TextExtent one = metrics.Measure(L"Segoe UI", 10.0f, L"Hello");
+        const TextExtent twice = metrics.Measure(L"Segoe UI", 20.0f, L"Hello");
+        FD2D_CHECK(one.width > 0.0f);
+        FD2D_CHECK_NEAR(twice.width, 2.0f * one.width, 1e-4);
+        FD2D_CHECK_NEAR(one.height, 12.0f, 1e-4); // default line height 1.2 em
+
+        // A source overrides known families; the rest fall back to defaults.
+        AdvanceTextMetrics custom([](std::wstring_view family, FontAdvances& out)
+        {
+            if (family != L"Mono")
+            {
+                return false;
+            }
+            out.advance.fill(0.5f);
+            out.lineHeight = 1.0f;
+            return true;
+        });
+        const TextExtent mono = custom.Measure(L"Mono", 10.0f, L"abcd");
+        FD2D_CHECK_NEAR(mono.width, 20.0f, 1e-4);
+        FD2D_CHECK_NEAR(mono.height, 10.0f, 1e-4);
+        FD2D_CHECK_NEAR(custom.Measure(L"Other", 10.0f, L"Hello").width, one.width, 1e-4);
+    }
+
+    // Sizing a 10k-row label column through the provider.
+    void BenchLabelColumn()
+    {
+        std::vector<std::wstring> labels;
+        for (int i = 0; i < 10000; ++i)
+        {
+            labels.push_back(L"Row " + std::to_wstring(i) + L": " + std::wstring(static_cast<std::size_t>(5 + i % 40), L'x'));
+        }
+
+        AdvanceTextMetrics metrics;
+        constexpr int kRounds = 20;
+        float widest = 0.0f;
+        double start = Test::NowUs();
+        for (int round = 0; round < kRounds; ++round)
+        {
+            for (const std::wstring& label : labels)
+            {
+                const float width = metrics.Measure(L"Segoe UI", 12.0f, label).width;
+                widest = (widest < width) ? width : widest;
+            }
+        }
+        const double providerUs = (Test::NowUs() - start) / kRounds;
+
+        FontAdvances font;
+        DefaultFontAdvances(font);
+        float total = 0.0f;
+        start = Test::NowUs();
+        for (int round = 0; round < kRounds; ++round)
+        {
+            for (const std::wstring& label : labels)
+            {
+                total += ReferenceSum(font.advance.data(), FontAdvances::kTableSize, label.data(), label.size());
+            }
+        }
+        const double scalarUs = (Test::NowUs() - start) / kRounds;
+        std::printf("10k labels: provider %.0f us per column, scalar sum alone %.0f us (%g %g)\n",
+                    providerUs, scalarUs, static_cast<double>(widest), static_cast<double>(total));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    SimdMatchesScalar();
+    AdvanceProviderMeasures();
+    if (Test::BenchRequested(argc, argv))
+    {
+        BenchLabelColumn();
+    }
+    return Test::TestResult();
+}
@@ -0,0 +1,254 @@
+#include "TimerWheel.h"
+#include "TestCheck.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace FD2D;
+
+namespace
+{
+    constexpr std::uint64_t kSpanMs = 1ull << 24;   // four levels of 64 slots
+    constexpr std::uint64_t kRebaseGapMs = 4096;
+
+    // Reference semantics, one entry per pending timer: every tick fires the
+    // timers due at or before it; a long gap fires the overdue ones once.
+    struct ModelTimer
+    {
+        std::uint64_t due { 0 };
+        std::uint64_t period { 0 };
+    };
+
+    class Model
+    {
+    public:
+        explicit Model(std::uint64_t nowMs) : m_current(nowMs) {}
+
+        void Schedule(std::uint64_t key, std::uint64_t due, std::uint64_t period)
+        {
+            m_timers[key] = { due, period };
+        }
+
+        bool Cancel(std::uint64_t key) { return m_timers.erase(key) != 0; }
+
+        // Fire counts per timer for Advance(nowMs).
+        std::map<std::uint64_t, int> Advance(std::uint64_t nowMs)
+        {
+            std::map<std::uint64_t, int> fired;
+            if (nowMs < m_current)
+            {
+                // Same tick again: what was scheduled for it since fires now.
+                if (nowMs + 1 == m_current)
+                {
+                    FireAt(nowMs, fired);
+                }
+                return fired;
+            }
+
+            if (!m_timers.empty() && nowMs - m_current >= kRebaseGapMs)
+            {
+                FireAt(nowMs, fired);
+            }
+            else if (!m_timers.empty())
+            {
+                for (std::uint64_t tick = m_current; tick <= nowMs; ++tick)
+                {
+                    // Only ticks that hold a due timer matter.
+                    std::uint64_t next = TimerWheel::kNoDeadline;
+                    for (const auto& entry : m_timers)
+                    {
+                        next = (std::min)(next, (std::max)(entry.second.due, tick));
+                    }
+                    if (next > nowMs)
+                    {
+                        break;
+                    }
+                    tick = next;
+                    FireAt(tick, fired);
+                }
+            }
+            m_current = nowMs + 1;
+            return fired;
+        }
+
+        std::uint64_t NextDeadline() const
+        {
+            std::uint64_t best = TimerWheel::kNoDeadline;
+            for (const auto& entry : m_timers)
+            {
+                best = (std::min)(best, (entry.second.due < m_current) ? m_current - 1 : entry.second.due);
+            }
+            return best;
+        }
+
+        std::size_t Count() const { return m_timers.size(); }
+
+    private:
+        void FireAt(std::uint64_t tick, std::map<std::uint64_t, int>& fired)
+        {
+            for (auto it = m_timers.begin(); it != m_timers.end();)
+            {
+                ModelTimer& timer = it->second;
+                if (timer.due > tick)
+                {
+                    ++it;
+                    continue;
+                }
+                ++fired[it->first];
+                if (timer.period == 0)
+                {
+                    it = m_timers.erase(it);
+                    continue;
+                }
+                timer.due += timer.period;
+                if (timer.due <= tick)
+                {
+                    timer.due = tick + timer.period;
+                }
+                ++it;
+            }
+        }
+
+        std::uint64_t m_current { 0 };
+        std::map<std::uint64_t, ModelTimer> m_timers {};
+    };
+
+    // Scheduling for the tick that was just advanced to fires on the next
+    // Advance of that same tick, not a millisecond later.
+    void ScheduleForCurrentTickFiresOnRepeatAdvance()
+    {
+        TimerWheel wheel(1000);
+        int fired = 0;
+        FD2D_CHECK(wheel.Advance(1000) == 0);
+
+        const TimerWheel::TimerId now = wheel.Schedule(1000, 0, [&] { ++fired; });
+        const TimerWheel::TimerId past = wheel.Schedule(990, 0, [&] { ++fired; });
+        const TimerWheel::TimerId next = wheel.Schedule(1001, 0, [&] { ++fired; });
+        FD2D_CHECK(wheel.NextDeadline() == 1000);
+        FD2D_CHECK(wheel.Advance(1000) == 2);
+        FD2D_CHECK(wheel.NextDeadline() == 1001);
+        FD2D_CHECK(fired == 2);
+        FD2D_CHECK(!wheel.IsPending(now) && !wheel.IsPending(past));
+        FD2D_CHECK(wheel.IsPending(next));
+
+        FD2D_CHECK(wheel.Advance(1001) == 1);
+        FD2D_CHECK(fired == 3);
+
+        // A clock that went backwards fires nothing.
+        (void)wheel.Schedule(500, 0, [&] { ++fired; });
+        FD2D_CHECK(wheel.Advance(900) == 0);
+        FD2D_CHECK(wheel.Count() == 1);
+    }
+
+    // Timers beyond the wheel's span are parked in the top level; they still
+    // count for NextDeadline and fire on time after being re-placed.
+    void ParkedTimersKeepTheirDeadline()
+    {
+        TimerWheel wheel(12345);
+        int fired = 0;
+        const std::uint64_t far = 12345 + 3 * kSpanMs + 777;
+        const TimerWheel::TimerId parked = wheel.Schedule(far, 0, [&] { ++fired; });
+        FD2D_CHECK(wheel.NextDeadline() == far);
+
+        // Step (not rebase) through more than a span, in uneven strides.
+        std::uint64_t now = 12345;
+        while (now + 4000 < far)
+        {
+            now += 3001 + (now % 997);
+            FD2D_CHECK(wheel.Advance(now) == 0);
+            FD2D_CHECK(wheel.NextDeadline() == far);
+        }
+        FD2D_CHECK(wheel.Advance(far - 1) == 0);
+        FD2D_CHECK(wheel.Advance(far) == 1);
+        FD2D_CHECK(fired == 1 && !wheel.IsPending(parked));
+    }
+
+    // Random schedules, cancels and advances (steps and long gaps) against
+    // the reference model.
+    void MatchesModel()
+    {
+        std::mt19937_64 rng(71);
+        std::uint64_t now = 1ull << 20;
+        TimerWheel wheel(now);
+        Model model(now);
+        // Timers are keyed by a sequence number the callback can capture.
+        std::map<std::uint64_t, int> fired;
+        std::vector<std::pair<std::uint64_t, TimerWheel::TimerId>> timers;
+        std::uint64_t nextKey = 0;
+
+        const std::uint64_t horizons[] = { 1, 64, 4096, 1ull << 18, kSpanMs, 4 * kSpanMs };
+        for (int step = 0; step < 20000; ++step)
+        {
+            const unsigned action = static_cast<unsigned>(rng() % 16);
+            // Keep the population bounded: the model is a linear scan.
+            if (action < 5 && model.Count() < 128)
+            {
+                const std::uint64_t horizon = horizons[rng() % std::size(horizons)];
+                std::uint64_t due = now + rng() % horizon;
+                if (rng() % 8 == 0)
+                {
+                    due = now - (std::min)(now, rng() % 100);
+                }
+                const std::uint64_t period = (rng() % 4 == 0) ? 16 + rng() % 5000 : 0;
+                const std::uint64_t key = nextKey++;
+                const TimerWheel::TimerId id = wheel.Schedule(due, period, [&fired, key] { ++fired[key]; });
+                model.Schedule(key, due, period);
+                timers.push_back({ key, id });
+            }
+            else if (action < 9 && !timers.empty())
+            {
+                // Includes timers that already fired (one-shots are gone).
+                const std::size_t pick = rng() % timers.size();
+                FD2D_CHECK(wheel.Cancel(timers[pick].second) == model.Cancel(timers[pick].first));
+                timers[pick] = timers.back();
+                timers.pop_back();
+            }
+            else
+            {
+                const unsigned stride = static_cast<unsigned>(rng() % 8);
+                if (stride == 0)
+                {
+                    // Repeat the current tick.
+                }
+                else if (stride < 5)
+                {
+                    now += rng() % 64;
+                }
+                else if (stride < 7)
+                {
+                    now += rng() % kRebaseGapMs;
+                }
+                else
+                {
+                    now += kRebaseGapMs + rng() % (2 * kSpanMs);
+                }
+
+                fired.clear();
+                const std::size_t count = wheel.Advance(now);
+                const std::map<std::uint64_t, int> expected = model.Advance(now);
+                std::size_t expectedCount = 0;
+                for (const auto& entry : expected)
+                {
+                    expectedCount += static_cast<std::size_t>(entry.second);
+                }
+                FD2D_CHECK(count == expectedCount);
+                FD2D_CHECK(fired == expected);
+            }
+
+            FD2D_CHECK(wheel.Count() == model.Count());
+            FD2D_CHECK(wheel.NextDeadline() == model.NextDeadline());
+        }
+    }
+}
+
+int main()
+{
+    ScheduleForCurrentTickFiresOnRepeatAdvance();
+    ParkedTimersKeepTheirDeadline();
+    MatchesModel();
+    return Test::TestResult();
+}
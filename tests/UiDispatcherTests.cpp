@@ -0,0 +1,194 @@
+#include "UiDispatcher.h"
+#include "TestCheck.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace FD2D;
+
+namespace
+{
+    constexpr int kLaneCount = 3;
+
+    // Producers flood every lane while the consumer drains in small slices:
+    // every task runs exactly once, each producer's tasks keep their order
+    // within a lane, and wakeups are coalesced.
+    void StressNoLossInOrder()
+    {
+        constexpr int kProducers = 4;
+        constexpr int kPerProducer = 40000;
+
+        UiDispatcher dispatcher;
+        std::atomic<std::uint64_t> wakes { 0 };
+        dispatcher.SetWakeCallback([&] { wakes.fetch_add(1, std::memory_order_relaxed); });
+
+        // Touched by the tasks only, so only on this (the consumer) thread.
+        std::vector<int> lastSeen(kProducers * kLaneCount, -1);
+        std::vector<std::uint8_t> ran(static_cast<std::size_t>(kProducers) * kPerProducer, 0);
+        std::uint64_t outOfOrder = 0;
+        std::uint64_t duplicates = 0;
+
+        std::atomic<int> finished { 0 };
+        std::atomic<int> rejected { 0 };
+        std::vector<std::thread> producers;
+        for (int p = 0; p < kProducers; ++p)
+        {
+            producers.emplace_back([&, p] {
+                for (int i = 0; i < kPerProducer; ++i)
+                {
+                    const int lane = i % kLaneCount;
+                    const bool posted = dispatcher.Post([&, p, i, lane] {
+                        int& last = lastSeen[static_cast<std::size_t>(p * kLaneCount + lane)];
+                        outOfOrder += (i <= last) ? 1 : 0;
+                        last = i;
+                        std::uint8_t& flag = ran[static_cast<std::size_t>(p) * kPerProducer + static_cast<std::size_t>(i)];
+                        duplicates += flag;
+                        flag = 1;
+                    }, static_cast<TaskPriority>(lane));
+                    rejected += posted ? 0 : 1;
+                }
+                finished.fetch_add(1, std::memory_order_release);
+            });
+        }
+
+        while (finished.load(std::memory_order_acquire) < kProducers || dispatcher.Pending())
+        {
+            if (!dispatcher.Drain(200, 256))
+            {
+                std::this_thread::yield();
+            }
+        }
+        for (std::thread& producer : producers)
+        {
+            producer.join();
+        }
+
+        std::size_t count = 0;
+        for (const std::uint8_t flag : ran)
+        {
+            count += flag;
+        }
+        FD2D_CHECK(rejected == 0);
+        FD2D_CHECK(count == ran.size());
+        FD2D_CHECK(duplicates == 0);
+        FD2D_CHECK(outOfOrder == 0);
+        FD2D_CHECK(wakes.load() >= 1 && wakes.load() <= ran.size());
+        FD2D_CHECK(!dispatcher.Pending());
+    }
+
+    // A slice runs one task of every waiting lane before favouring High, so
+    // a flood of High posts cannot starve Low.
+    void SlicesServeEveryLane()
+    {
+        UiDispatcher dispatcher;
+        std::vector<int> order;
+        for (int i = 0; i < 10; ++i)
+        {
+            (void)dispatcher.Post([&] { order.push_back(2); }, TaskPriority::Low);
+            (void)dispatcher.Post([&] { order.push_back(1); }, TaskPriority::Normal);
+            (void)dispatcher.Post([&] { order.push_back(0); }, TaskPriority::High);
+        }
+
+        FD2D_CHECK(dispatcher.Drain(1000000, 3));
+        FD2D_CHECK(order == std::vector<int>({ 0, 1, 2 }));
+
+        // Then strictly by priority once each lane had its turn.
+        order.clear();
+        FD2D_CHECK(dispatcher.Drain(1000000, 12));
+        FD2D_CHECK(order == std::vector<int>({ 0, 1, 2, 0, 0, 0, 0, 0, 0, 0, 0, 1 }));
+
+        order.clear();
+        FD2D_CHECK(!dispatcher.Drain(1000000));
+        FD2D_CHECK(order.size() == 15);
+    }
+
+    // The time budget bounds a slice; at least one task always runs.
+    void BudgetBoundsSlice()
+    {
+        std::uint64_t now = 0;
+        UiDispatcher dispatcher([&] { return now; });
+        int ran = 0;
+        for (int i = 0; i < 10; ++i)
+        {
+            (void)dispatcher.Post([&] { ++ran; now += 40; });
+        }
+
+        FD2D_CHECK(dispatcher.Drain(0));
+        FD2D_CHECK(ran == 1);
+        FD2D_CHECK(dispatcher.Drain(100));
+        FD2D_CHECK(ran == 4); // 40, 80, then 120 >= 100
+        FD2D_CHECK(!dispatcher.Drain(1000));
+        FD2D_CHECK(ran == 10);
+    }
+
+    // Close drops queued tasks without running them and rejects new ones.
+    void CloseDropsQueuedTasks()
+    {
+        UiDispatcher dispatcher;
+        auto token = std::make_shared<int>(0);
+        bool ran = false;
+        for (int i = 0; i < 5; ++i)
+        {
+            (void)dispatcher.Post([token, &ran] { ran = true; });
+        }
+        FD2D_CHECK(token.use_count() == 6);
+        dispatcher.Close();
+        FD2D_CHECK(dispatcher.Closed());
+        FD2D_CHECK(!dispatcher.Pending());
+        FD2D_CHECK(token.use_count() == 1);
+        FD2D_CHECK(!dispatcher.Post([&ran] { ran = true; }));
+        FD2D_CHECK(!dispatcher.Drain(1000));
+        FD2D_CHECK(!ran);
+    }
+
+    void BenchThroughput()
+    {
+        constexpr int kPerProducer = 200000;
+        for (const int producerCount : { 1, 2, 4 })
+        {
+            UiDispatcher dispatcher;
+            std::atomic<int> finished { 0 };
+            std::uint64_t ran = 0;
+            const double start = Test::NowUs();
+            std::vector<std::thread> producers;
+            for (int p = 0; p < producerCount; ++p)
+            {
+                producers.emplace_back([&] {
+                    for (int i = 0; i < kPerProducer; ++i)
+                    {
+                        (void)dispatcher.Post([&ran] { ++ran; }, static_cast<TaskPriority>(i % kLaneCount));
+                    }
+                    finished.fetch_add(1, std::memory_order_release);
+                });
+            }
+            while (finished.load(std::memory_order_acquire) < producerCount || dispatcher.Pending())
+            {
+                (void)dispatcher.Drain(1000);
+            }
+            for (std::thread& producer : producers)
+            {
+                producer.join();
+            }
+            const double elapsedUs = Test::NowUs() - start;
+            std::printf("dispatcher, %d producer(s): %.1f ns per task (%llu tasks)\n", producerCount,
+                        elapsedUs * 1000.0 / static_cast<double>(ran), static_cast<unsigned long long>(ran));
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    StressNoLossInOrder();
+    SlicesServeEveryLane();
+    BudgetBoundsSlice();
+    CloseDropsQueuedTasks();
+    if (Test::BenchRequested(argc, argv))
+    {
+        BenchThroughput();
+    }
+    return Test::TestResult();
+}
@@ -0,0 +1,402 @@
+#include "Backplate.h"
+#include "StackPanel.h"
+#include "Text.h"
+#include "TestCheck.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace FD2D;
+
+namespace
+{
+    // Live heap bytes, counted by the operator new/delete below, so the
+    // storage bench can report bytes per node.
+    std::atomic<std::int64_t> g_liveBytes { 0 };
+    constexpr std::size_t kAllocHeader = 16;
+}
+
+void* operator new(std::size_t size)
+{
+    void* block = std::malloc(size + kAllocHeader);
+    if (block == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    *static_cast<std::size_t*>(block) = size;
+    g_liveBytes.fetch_add(static_cast<std::int64_t>(size), std::memory_order_relaxed);
+    return static_cast<char*>(block) + kAllocHeader;
+}
+
+void operator delete(void* p) noexcept
+{
+    if (p == nullptr)
+    {
+        return;
+    }
+    void* block = static_cast<char*>(p) - kAllocHeader;
+    g_liveBytes.fetch_sub(static_cast<std::int64_t>(*static_cast<std::size_t*>(block)), std::memory_order_relaxed);
+    std::free(block);
+}
+
+void operator delete(void* p, std::size_t) noexcept { operator delete(p); }
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete[](void* p) noexcept { operator delete(p); }
+void operator delete[](void* p, std::size_t) noexcept { operator delete(p); }
+
+namespace
+{
+    std::size_t CountNodes(const Wnd& wnd)
+    {
+        std::size_t count = 1;
+        for (const auto& child : wnd.ChildrenInOrder())
+        {
+            if (child)
+            {
+                count += CountNodes(*child);
+            }
+        }
+        return count;
+    }
+
+    bool CountsMatch(const Wnd& wnd)
+    {
+        if (wnd.SubtreeNodeCount() != CountNodes(wnd))
+        {
+            return false;
+        }
+        for (const auto& child : wnd.ChildrenInOrder())
+        {
+            if (child && !CountsMatch(*child))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Random adds, removals and clears anywhere in a tree; every ancestor's
+    // count must match a recount after each step.
+    void SubtreeCountsFollowEdits()
+    {
+        std::mt19937 rng(45);
+        auto root = std::make_shared<StackPanel>(L"root");
+        std::vector<std::shared_ptr<Wnd>> nodes { root };
+        std::uint32_t nextName = 0;
+
+        for (int step = 0; step < 2000; ++step)
+        {
+            const std::shared_ptr<Wnd> target = nodes[rng() % nodes.size()];
+            const unsigned action = rng() % 10;
+            if (action < 6)
+            {
+                auto child = std::make_shared<StackPanel>(L"n" + std::to_wstring(nextName++));
+                if (target->AddChild(child))
+                {
+                    nodes.push_back(child);
+                }
+            }
+            else if (action < 9 && !target->ChildrenInOrder().empty())
+            {
+                const auto& children = target->ChildrenInOrder();
+                (void)target->RemoveChild(children[rng() % children.size()]->Id());
+            }
+            else if (action == 9 && target != root)
+            {
+                target->ClearChildren();
+            }
+            FD2D_CHECK(CountsMatch(*root));
+        }
+
+        // A detached subtree keeps its own count; re-adding it adds it all.
+        if (!root->ChildrenInOrder().empty())
+        {
+            std::shared_ptr<Wnd> moved = root->ChildrenInOrder().front();
+            const std::size_t before = root->SubtreeNodeCount();
+            (void)root->RemoveChild(moved->Id());
+            FD2D_CHECK(root->SubtreeNodeCount() == before - moved->SubtreeNodeCount());
+            FD2D_CHECK(moved->SubtreeNodeCount() == CountNodes(*moved));
+            (void)root->AddChild(moved);
+            FD2D_CHECK(root->SubtreeNodeCount() == before);
+        }
+    }
+
+    // A parented control is refused elsewhere until removed, and no control
+    // can be added under itself.
+    void AddChildRefusesSecondParent()
+    {
+        auto a = std::make_shared<StackPanel>(L"a");
+        auto b = std::make_shared<StackPanel>(L"b");
+        auto child = std::make_shared<StackPanel>(L"child");
+        FD2D_CHECK(a->AddChild(child));
+        FD2D_CHECK(!b->AddChild(child));
+        FD2D_CHECK(!b->HasChild(L"child"));
+        FD2D_CHECK(a->SubtreeNodeCount() == 2);
+        FD2D_CHECK(b->SubtreeNodeCount() == 1);
+
+        FD2D_CHECK(a->RemoveChild(L"child"));
+        FD2D_CHECK(b->AddChild(child));
+        FD2D_CHECK(b->SubtreeNodeCount() == 2);
+
+        FD2D_CHECK(!child->AddChild(b));
+        FD2D_CHECK(!b->AddChild(b));
+        FD2D_CHECK(CountsMatch(*b));
+    }
+
+    // Takes itself out of its parent when detached.
+    class SelfRemoving : public StackPanel
+    {
+    public:
+        using StackPanel::StackPanel;
+
+        Wnd* removeFrom { nullptr };
+
+        void OnDetached() override
+        {
+            StackPanel::OnDetached();
+            if (Wnd* parent = std::exchange(removeFrom, nullptr))
+            {
+                removed = parent->RemoveChild(Id());
+            }
+        }
+
+        bool removed { false };
+    };
+
+    // RemoveChild reports true only for the call that actually erased the
+    // child, even when OnDetached removed it re-entrantly.
+    void RemoveChildReportsTheErase()
+    {
+        Backplate backplate(L"remove");
+        auto host = std::make_shared<StackPanel>(L"host");
+        FD2D_CHECK(backplate.AddWnd(host));
+
+        auto child = std::make_shared<SelfRemoving>(L"self");
+        child->removeFrom = host.get();
+        FD2D_CHECK(host->AddChild(child));
+        FD2D_CHECK(host->AddChild(std::make_shared<StackPanel>(L"other")));
+
+        FD2D_CHECK(!host->RemoveChild(L"self"));
+        FD2D_CHECK(child->removed);
+        FD2D_CHECK(!host->HasChild(L"self"));
+        FD2D_CHECK(host->HasChild(L"other"));
+        FD2D_CHECK(CountsMatch(*host));
+
+        FD2D_CHECK(host->RemoveChild(L"other"));
+        FD2D_CHECK(!host->RemoveChild(L"other"));
+        FD2D_CHECK(host->SubtreeNodeCount() == 1);
+    }
+
+    // Child storage on a wide tree: the cost of AddChild into the vector
+    // plus lazy id index, against the map-plus-vector layout it replaced
+    // (a name-keyed map and an order vector per parent, filled on every add).
+    void BenchChildStorage()
+    {
+        constexpr std::size_t kParents = 500;
+        constexpr std::size_t kChildren = 100;
+        constexpr std::size_t kNodes = 1 + kParents * (1 + kChildren);
+
+        std::vector<std::shared_ptr<Wnd>> parents;
+        std::vector<std::shared_ptr<Wnd>> children;
+        parents.reserve(kParents);
+        children.reserve(kParents * kChildren);
+
+        std::int64_t bytes = g_liveBytes.load();
+        double start = Test::NowUs();
+        auto root = std::make_shared<StackPanel>(L"root");
+        for (std::size_t p = 0; p < kParents; ++p)
+        {
+            parents.push_back(std::make_shared<StackPanel>(L"p" + std::to_wstring(p)));
+            for (std::size_t c = 0; c < kChildren; ++c)
+            {
+                children.push_back(std::make_shared<StackPanel>(L"c" + std::to_wstring(p) + L"_" + std::to_wstring(c)));
+            }
+        }
+        const double createUs = Test::NowUs() - start;
+        const std::int64_t controlBytes = g_liveBytes.load() - bytes;
+
+        bytes = g_liveBytes.load();
+        start = Test::NowUs();
+        for (std::size_t p = 0; p < kParents; ++p)
+        {
+            for (std::size_t c = 0; c < kChildren; ++c)
+            {
+                (void)parents[p]->AddChild(children[p * kChildren + c]);
+            }
+            (void)root->AddChild(parents[p]);
+        }
+        const double addUs = Test::NowUs() - start;
+        const std::int64_t storageBytes = g_liveBytes.load() - bytes;
+
+        struct OldStorage
+        {
+            std::unordered_map<std::wstring, std::shared_ptr<Wnd>> byName {};
+            std::vector<std::shared_ptr<Wnd>> ordered {};
+        };
+        std::vector<OldStorage> old;
+        old.reserve(kParents + 1);
+
+        bytes = g_liveBytes.load();
+        start = Test::NowUs();
+        old.emplace_back();
+        for (std::size_t p = 0; p < kParents; ++p)
+        {
+            old.emplace_back();
+            for (std::size_t c = 0; c < kChildren; ++c)
+            {
+                const std::shared_ptr<Wnd>& child = children[p * kChildren + c];
+                if (old.back().byName.emplace(child->Name(), child).second)
+                {
+                    old.back().ordered.push_back(child);
+                }
+            }
+            if (old.front().byName.emplace(parents[p]->Name(), parents[p]).second)
+            {
+                old.front().ordered.push_back(parents[p]);
+            }
+        }
+        const double oldUs = Test::NowUs() - start;
+        const std::int64_t oldBytes = g_liveBytes.load() - bytes;
+
+        const double n = static_cast<double>(kNodes);
+        std::printf("%zu nodes: controls %.0f us, %.0f B/node\n", kNodes, createUs, static_cast<double>(controlBytes) / n);
+        std::printf("  child storage: vector + id index %.0f us, %.1f B/node; old map + vector %.0f us, %.1f B/node\n",
+                    addUs, static_cast<double>(storageBytes) / n, oldUs, static_cast<double>(oldBytes) / n);
+        FD2D_CHECK(root->SubtreeNodeCount() == kNodes);
+    }
+
+    // Columns of labels, large enough that parallel measure forks them.
+    std::shared_ptr<Wnd> BuildColumns()
+    {
+        auto root = std::make_shared<StackPanel>(L"columns", Orientation::Horizontal);
+        for (int column = 0; column < 6; ++column)
+        {
+            auto list = std::make_shared<StackPanel>(L"column" + std::to_wstring(column), Orientation::Vertical);
+            for (int row = 0; row < 150; ++row)
+            {
+                auto label = std::make_shared<Text>(L"label" + std::to_wstring(column) + L"_" + std::to_wstring(row));
+                label->SetFont(L"Segoe UI", 12.0f + static_cast<float>((row + column) % 5));
+                label->SetText(std::wstring(static_cast<std::size_t>(3 + (row * 7 + column) % 19), L'x'));
+                list->AddChild(label);
+            }
+            root->AddChild(list);
+        }
+        return root;
+    }
+
+    bool SameLayout(const Wnd& a, const Wnd& b)
+    {
+        const D2D1_RECT_F ra = a.LayoutRect();
+        const D2D1_RECT_F rb = b.LayoutRect();
+        if (ra.left != rb.left || ra.top != rb.top || ra.right != rb.right || ra.bottom != rb.bottom)
+        {
+            return false;
+        }
+        const auto& ca = a.ChildrenInOrder();
+        const auto& cb = b.ChildrenInOrder();
+        if (ca.size() != cb.size())
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < ca.size(); ++i)
+        {
+            if (!SameLayout(*ca[i], *cb[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Parallel measure must produce exactly the serial layout, pass after pass.
+    void ParallelMeasureIsDeterministic()
+    {
+        const std::shared_ptr<TextMetricsProvider> previous = Text::MetricsProvider();
+        Text::SetMetricsProvider(std::make_shared<AdvanceTextMetrics>());
+
+        Backplate serial(L"serial");
+        Backplate parallel(L"parallel");
+        Executor::Options options {};
+        options.workerCount = 4;
+        parallel.SetExecutor(std::make_shared<Executor>(options));
+        parallel.SetParallelLayout(true);
+        FD2D_CHECK(parallel.ParallelLayout());
+
+        auto serialTree = BuildColumns();
+        auto parallelTree = BuildColumns();
+        FD2D_CHECK(serial.AddWnd(serialTree));
+        FD2D_CHECK(parallel.AddWnd(parallelTree));
+
+        for (int pass = 0; pass < 20; ++pass)
+        {
+            const float width = 900.0f + 37.0f * static_cast<float>(pass);
+            for (Wnd* root : { serialTree.get(), parallelTree.get() })
+            {
+                (void)root->Measure({ width, 700.0f });
+                root->Arrange({ 0.0f, 0.0f, width, 700.0f });
+            }
+            FD2D_CHECK(SameLayout(*serialTree, *parallelTree));
+        }
+
+        Text::SetMetricsProvider(previous);
+    }
+
+    std::vector<std::wstring> Names(const Wnd& wnd)
+    {
+        std::vector<std::wstring> names;
+        for (const auto& child : wnd.ChildrenInOrder())
+        {
+            names.push_back(child->Name());
+        }
+        return names;
+    }
+
+    // Partial reorders keep the unlisted children behind the listed ones,
+    // and the name map follows adds and removals.
+    void ChildStorageKeepsOldContract()
+    {
+        StackPanel panel(L"panel");
+        for (const wchar_t* name : { L"a", L"b", L"c", L"d" })
+        {
+            FD2D_CHECK(panel.AddChild(std::make_shared<StackPanel>(name)));
+        }
+
+        FD2D_CHECK(panel.ReorderChildren(std::vector<std::wstring> { L"c", L"a" }));
+        FD2D_CHECK(Names(panel) == std::vector<std::wstring>({ L"c", L"a", L"b", L"d" }));
+        FD2D_CHECK(!panel.ReorderChildren(std::vector<std::wstring> { L"d", L"d" }));
+        FD2D_CHECK(!panel.ReorderChildren(std::vector<std::wstring> { L"b", L"x" }));
+        FD2D_CHECK(!panel.ReorderChildren(std::vector<std::wstring> { L"" }));
+        FD2D_CHECK(Names(panel) == std::vector<std::wstring>({ L"c", L"a", L"b", L"d" }));
+
+        FD2D_CHECK(panel.Children().size() == 4);
+        FD2D_CHECK(panel.Children().at(L"b") == panel.FindChild(L"b"));
+        FD2D_CHECK(panel.AddChild(std::make_shared<StackPanel>(L"e")));
+        FD2D_CHECK(panel.Children().count(L"e") == 1);
+        FD2D_CHECK(panel.RemoveChild(L"a"));
+        FD2D_CHECK(panel.Children().count(L"a") == 0);
+        FD2D_CHECK(panel.Children().size() == 4);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    SubtreeCountsFollowEdits();
+    AddChildRefusesSecondParent();
+    ChildStorageKeepsOldContract();
+    RemoveChildReportsTheErase();
+    ParallelMeasureIsDeterministic();
+    if (Test::BenchRequested(argc, argv))
+    {
+        BenchChildStorage();
+    }
+    return Test::TestResult();
+}